@@ -290,6 +290,8 @@ print_bearer_info (MMBearer *bearer)
         gchar   *total_bytes_tx = NULL;
         gchar   *uplink_speed = NULL;
         gchar   *downlink_speed = NULL;
+        gchar   *rx_rate = NULL;
+        gchar   *tx_rate = NULL;
 
         if (stats) {
             guint64 val;
@@ -326,6 +328,12 @@ print_bearer_info (MMBearer *bearer)
             val = mm_bearer_stats_get_downlink_speed (stats);
             if (val)
                 downlink_speed = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_rx_rate (stats);
+            if (val)
+                rx_rate = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_tx_rate (stats);
+            if (val)
+                tx_rate = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
         }
 
         if (start_date)
@@ -340,6 +348,8 @@ print_bearer_info (MMBearer *bearer)
         mmcli_output_string_take (MMC_F_BEARER_STATS_TOTAL_BYTES_TX,  total_bytes_tx);
         mmcli_output_string_take (MMC_F_BEARER_STATS_UPLINK_SPEED,    uplink_speed);
         mmcli_output_string_take (MMC_F_BEARER_STATS_DOWNLINK_SPEED,  downlink_speed);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_RX_RATE,         rx_rate);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_TX_RATE,         tx_rate);
     }
 
     mmcli_output_dump ();
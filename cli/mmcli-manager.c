@@ -44,6 +44,11 @@
 typedef struct {
     MMManager *manager;
     GCancellable *cancellable;
+    /* monitor all */
+    GDBusConnection *connection;
+    guint properties_changed_id;
+    guint object_manager_id;
+    guint name_watch_id;
 #if defined WITH_UDEV
     GUdevClient *udev;
 #endif
@@ -54,7 +59,11 @@ static Context *ctx;
 static gboolean get_daemon_version_flag;
 static gboolean list_modems_flag;
 static gboolean monitor_modems_flag;
+static gboolean monitor_all_flag;
 static gboolean scan_modems_flag;
+static gboolean snapshot_flag;
+static gboolean command_stats_flag;
+static gboolean memory_usage_flag;
 static gchar *set_logging_str;
 static gchar *inhibit_device_str;
 static gchar *report_kernel_event_str;
@@ -70,7 +79,7 @@ static GOptionEntry entries[] = {
     },
     { "set-logging", 'G', 0, G_OPTION_ARG_STRING, &set_logging_str,
       "Set logging level in the ModemManager daemon",
-      "[ERR,WARN,MSG,INFO,DEBUG]",
+      "[ERR,WARN,MSG,INFO,DEBUG][,OBJECT=LEVEL][,module:NAME=LEVEL]",
     },
     { "list-modems", 'L', 0, G_OPTION_ARG_NONE, &list_modems_flag,
       "List available modems",
@@ -80,10 +89,26 @@ static GOptionEntry entries[] = {
       "List available modems and monitor additions and removals",
       NULL
     },
+    { "monitor-all", 0, 0, G_OPTION_ARG_NONE, &monitor_all_flag,
+      "Report all modems, SIMs and bearers, and monitor object and property changes in all of them",
+      NULL
+    },
     { "scan-modems", 'S', 0, G_OPTION_ARG_NONE, &scan_modems_flag,
       "Request to re-scan looking for modems",
       NULL
     },
+    { "snapshot", 0, 0, G_OPTION_ARG_NONE, &snapshot_flag,
+      "Get the state of all modems, SIMs and bearers in a single request",
+      NULL
+    },
+    { "command-stats", 0, 0, G_OPTION_ARG_NONE, &command_stats_flag,
+      "Get latency, error, timeout and retry statistics of the commands sent to all modems",
+      NULL
+    },
+    { "memory-usage", 0, 0, G_OPTION_ARG_NONE, &memory_usage_flag,
+      "Get the memory allocated by each subsystem of all modems",
+      NULL
+    },
     { "inhibit-device", 'I', 0, G_OPTION_ARG_STRING, &inhibit_device_str,
       "Inhibit device given a unique device identifier",
       "[UID]"
@@ -129,7 +154,11 @@ mmcli_manager_options_enabled (void)
     n_actions = (get_daemon_version_flag +
                  list_modems_flag +
                  monitor_modems_flag +
+                 monitor_all_flag +
                  scan_modems_flag +
+                 snapshot_flag +
+                 command_stats_flag +
+                 memory_usage_flag +
                  !!set_logging_str +
                  !!inhibit_device_str +
                  !!report_kernel_event_str);
@@ -151,6 +180,13 @@ mmcli_manager_options_enabled (void)
             exit (EXIT_FAILURE);
         }
         mmcli_force_async_operation ();
+    } else if (monitor_all_flag) {
+        if (mmcli_output_get () != MMC_OUTPUT_TYPE_HUMAN &&
+            mmcli_output_get () != MMC_OUTPUT_TYPE_JSONL) {
+            g_printerr ("error: monitoring all objects only available in human or JSON lines output\n");
+            exit (EXIT_FAILURE);
+        }
+        mmcli_force_async_operation ();
     } else if (inhibit_device_str)
         mmcli_force_async_operation ();
 
@@ -174,6 +210,14 @@ context_free (void)
         g_object_unref (ctx->udev);
 #endif
 
+    if (ctx->name_watch_id)
+        g_bus_unwatch_name (ctx->name_watch_id);
+    if (ctx->properties_changed_id)
+        g_dbus_connection_signal_unsubscribe (ctx->connection, ctx->properties_changed_id);
+    if (ctx->object_manager_id)
+        g_dbus_connection_signal_unsubscribe (ctx->connection, ctx->object_manager_id);
+    if (ctx->connection)
+        g_object_unref (ctx->connection);
     if (ctx->manager)
         g_object_unref (ctx->manager);
     if (ctx->cancellable)
@@ -321,6 +365,90 @@ scan_devices_ready (MMManager    *manager,
     mmcli_async_operation_done ();
 }
 
+static void
+get_snapshot_process_reply (GVariant     *result,
+                            const GError *error)
+{
+    if (!result) {
+        g_printerr ("error: couldn't get snapshot: '%s'\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    mmcli_output_snapshot (result);
+}
+
+static void
+get_snapshot_ready (MMManager    *manager,
+                    GAsyncResult *result,
+                    gpointer      nothing)
+{
+    GVariant *operation_result;
+    GError   *error = NULL;
+
+    operation_result = mm_manager_get_snapshot_finish (manager, result, &error);
+    get_snapshot_process_reply (operation_result, error);
+
+    g_variant_unref (operation_result);
+    mmcli_async_operation_done ();
+}
+
+static void
+get_command_stats_process_reply (GVariant     *result,
+                                 const GError *error)
+{
+    if (!result) {
+        g_printerr ("error: couldn't get command statistics: '%s'\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    mmcli_output_command_stats (result);
+}
+
+static void
+get_command_stats_ready (MMManager    *manager,
+                         GAsyncResult *result,
+                         gpointer      nothing)
+{
+    GVariant *operation_result;
+    GError   *error = NULL;
+
+    operation_result = mm_manager_get_command_stats_finish (manager, result, &error);
+    get_command_stats_process_reply (operation_result, error);
+
+    g_variant_unref (operation_result);
+    mmcli_async_operation_done ();
+}
+
+static void
+get_memory_usage_process_reply (GVariant     *result,
+                                const GError *error)
+{
+    if (!result) {
+        g_printerr ("error: couldn't get memory usage: '%s'\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    mmcli_output_memory_usage (result);
+}
+
+static void
+get_memory_usage_ready (MMManager    *manager,
+                        GAsyncResult *result,
+                        gpointer      nothing)
+{
+    GVariant *operation_result;
+    GError   *error = NULL;
+
+    operation_result = mm_manager_get_memory_usage_finish (manager, result, &error);
+    get_memory_usage_process_reply (operation_result, error);
+
+    g_variant_unref (operation_result);
+    mmcli_async_operation_done ();
+}
+
 #define FOUND_ACTION_PREFIX   "    "
 #define ADDED_ACTION_PREFIX   "(+) "
 #define REMOVED_ACTION_PREFIX "(-) "
@@ -404,6 +532,222 @@ handle_uevent (GUdevClient *client,
 
 #endif
 
+/*
+ * Monitoring all objects doesn't use the MMManager, as there is no need to
+ * create proxies for every object and interface; instead, one single signal
+ * subscription for each of the ObjectManager and PropertiesChanged signals
+ * is used, for all objects exported by the daemon.
+ */
+
+static void
+output_object_added (const gchar *path,
+                     GVariant    *interfaces)
+{
+    mmcli_output_event ("object-added", path, "interfaces", interfaces, NULL);
+}
+
+static void
+output_objects_added (GVariant *objects)
+{
+    GVariantIter  iter;
+    const gchar  *path;
+    GVariant     *interfaces;
+
+    g_variant_iter_init (&iter, objects);
+    while (g_variant_iter_next (&iter, "{&o@a{sa{sv}}}", &path, &interfaces)) {
+        output_object_added (path, interfaces);
+        g_variant_unref (interfaces);
+    }
+}
+
+static void
+monitor_all_get_managed_objects_ready (GDBusConnection *connection,
+                                       GAsyncResult    *res)
+{
+    GVariant *reply;
+    GVariant *objects;
+    GError   *error = NULL;
+
+    reply = g_dbus_connection_call_finish (connection, res, &error);
+    if (!reply) {
+        if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            g_printerr ("error: couldn't list objects: '%s'\n", error->message);
+        g_error_free (error);
+        return;
+    }
+
+    objects = g_variant_get_child_value (reply, 0);
+    output_objects_added (objects);
+    g_variant_unref (objects);
+    g_variant_unref (reply);
+}
+
+static void
+monitor_all_get_snapshot_ready (GDBusConnection *connection,
+                                GAsyncResult    *res)
+{
+    GVariant *reply;
+    GVariant *objects = NULL;
+    guint     version = 0;
+    GError   *error = NULL;
+
+    reply = g_dbus_connection_call_finish (connection, res, &error);
+    if (reply) {
+        g_variant_get (reply, "((u@a{oa{sa{sv}}}))", &version, &objects);
+        g_variant_unref (reply);
+        if (version == 1) {
+            output_objects_added (objects);
+            g_variant_unref (objects);
+            return;
+        }
+        g_variant_unref (objects);
+    } else if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free (error);
+        return;
+    } else
+        g_clear_error (&error);
+
+    /* Daemon without snapshot support, or with an unknown snapshot format;
+     * only the objects in the object manager can be reported */
+    g_dbus_connection_call (connection,
+                            MM_DBUS_SERVICE,
+                            MM_DBUS_PATH,
+                            "org.freedesktop.DBus.ObjectManager",
+                            "GetManagedObjects",
+                            NULL,
+                            G_VARIANT_TYPE ("(a{oa{sa{sv}}})"),
+                            G_DBUS_CALL_FLAGS_NONE,
+                            -1,
+                            ctx->cancellable,
+                            (GAsyncReadyCallback)monitor_all_get_managed_objects_ready,
+                            NULL);
+}
+
+static void
+monitor_all_name_appeared (GDBusConnection *connection,
+                           const gchar     *name,
+                           const gchar     *name_owner)
+{
+    mmcli_output_event ("daemon-appeared", NULL, "owner", g_variant_new_string (name_owner), NULL);
+
+    /* Report the initial state; the signal subscriptions are already in place,
+     * so no change is lost in between */
+    g_dbus_connection_call (connection,
+                            MM_DBUS_SERVICE,
+                            MM_DBUS_PATH,
+                            MM_DBUS_INTERFACE,
+                            "GetSnapshot",
+                            NULL,
+                            G_VARIANT_TYPE ("((ua{oa{sa{sv}}}))"),
+                            G_DBUS_CALL_FLAGS_NONE,
+                            -1,
+                            ctx->cancellable,
+                            (GAsyncReadyCallback)monitor_all_get_snapshot_ready,
+                            NULL);
+}
+
+static void
+monitor_all_name_vanished (GDBusConnection *connection,
+                           const gchar     *name)
+{
+    mmcli_output_event ("daemon-vanished", NULL, NULL);
+}
+
+static void
+monitor_all_properties_changed (GDBusConnection *connection,
+                                const gchar     *sender_name,
+                                const gchar     *object_path,
+                                const gchar     *interface_name,
+                                const gchar     *signal_name,
+                                GVariant        *parameters)
+{
+    const gchar *interface;
+    GVariant    *changed;
+    GVariant    *invalidated;
+
+    if (!g_variant_is_of_type (parameters, G_VARIANT_TYPE ("(sa{sv}as)")))
+        return;
+
+    g_variant_get (parameters, "(&s@a{sv}@as)", &interface, &changed, &invalidated);
+    mmcli_output_event ("properties-changed", object_path,
+                        "interface",   g_variant_new_string (interface),
+                        "changed",     changed,
+                        "invalidated", invalidated,
+                        NULL);
+    g_variant_unref (changed);
+    g_variant_unref (invalidated);
+}
+
+static void
+monitor_all_object_manager_signal (GDBusConnection *connection,
+                                   const gchar     *sender_name,
+                                   const gchar     *object_path,
+                                   const gchar     *interface_name,
+                                   const gchar     *signal_name,
+                                   GVariant        *parameters)
+{
+    const gchar *path;
+    GVariant    *interfaces;
+
+    if (g_str_equal (signal_name, "InterfacesAdded") &&
+        g_variant_is_of_type (parameters, G_VARIANT_TYPE ("(oa{sa{sv}})"))) {
+        g_variant_get (parameters, "(&o@a{sa{sv}})", &path, &interfaces);
+        output_object_added (path, interfaces);
+        g_variant_unref (interfaces);
+    } else if (g_str_equal (signal_name, "InterfacesRemoved") &&
+               g_variant_is_of_type (parameters, G_VARIANT_TYPE ("(oas)"))) {
+        g_variant_get (parameters, "(&o@as)", &path, &interfaces);
+        mmcli_output_event ("object-removed", path, "interfaces", interfaces, NULL);
+        g_variant_unref (interfaces);
+    }
+}
+
+static void
+monitor_all_start (GDBusConnection *connection)
+{
+    ctx->connection = g_object_ref (connection);
+
+    ctx->properties_changed_id =
+        g_dbus_connection_signal_subscribe (connection,
+                                            MM_DBUS_SERVICE,
+                                            "org.freedesktop.DBus.Properties",
+                                            "PropertiesChanged",
+                                            NULL, /* all objects */
+                                            NULL,
+                                            G_DBUS_SIGNAL_FLAGS_NONE,
+                                            (GDBusSignalCallback)monitor_all_properties_changed,
+                                            NULL,
+                                            NULL);
+    ctx->object_manager_id =
+        g_dbus_connection_signal_subscribe (connection,
+                                            MM_DBUS_SERVICE,
+                                            "org.freedesktop.DBus.ObjectManager",
+                                            NULL, /* all signals */
+                                            MM_DBUS_PATH,
+                                            NULL,
+                                            G_DBUS_SIGNAL_FLAGS_NONE,
+                                            (GDBusSignalCallback)monitor_all_object_manager_signal,
+                                            NULL,
+                                            NULL);
+
+    /* The initial state is reported once the daemon is found in the bus, and
+     * again every time it's restarted */
+    ctx->name_watch_id =
+        g_bus_watch_name_on_connection (connection,
+                                        MM_DBUS_SERVICE,
+                                        G_BUS_NAME_WATCHER_FLAGS_NONE,
+                                        (GBusNameAppearedCallback)monitor_all_name_appeared,
+                                        (GBusNameVanishedCallback)monitor_all_name_vanished,
+                                        NULL,
+                                        NULL);
+
+    /* If we get cancelled, operation done */
+    g_cancellable_connect (ctx->cancellable,
+                           G_CALLBACK (cancelled),
+                           NULL,
+                           NULL);
+}
+
 static void
 get_manager_ready (GObject      *source,
                    GAsyncResult *result,
@@ -433,6 +777,33 @@ get_manager_ready (GObject      *source,
         return;
     }
 
+    /* Request to get snapshot? */
+    if (snapshot_flag) {
+        mm_manager_get_snapshot (ctx->manager,
+                                 ctx->cancellable,
+                                 (GAsyncReadyCallback)get_snapshot_ready,
+                                 NULL);
+        return;
+    }
+
+    /* Request to get command statistics? */
+    if (command_stats_flag) {
+        mm_manager_get_command_stats (ctx->manager,
+                                      ctx->cancellable,
+                                      (GAsyncReadyCallback)get_command_stats_ready,
+                                      NULL);
+        return;
+    }
+
+    /* Request to get memory usage? */
+    if (memory_usage_flag) {
+        mm_manager_get_memory_usage (ctx->manager,
+                                     ctx->cancellable,
+                                     (GAsyncReadyCallback)get_memory_usage_ready,
+                                     NULL);
+        return;
+    }
+
     /* Request to report kernel event? */
     if (report_kernel_event_str) {
         MMKernelEventProperties *properties;
@@ -532,6 +903,12 @@ mmcli_manager_run_asynchronous (GDBusConnection *connection,
     if (cancellable)
         ctx->cancellable = g_object_ref (cancellable);
 
+    /* Request to monitor all objects? */
+    if (monitor_all_flag) {
+        monitor_all_start (connection);
+        return;
+    }
+
     /* Create a new Manager object asynchronously */
     mmcli_get_manager (connection,
                        cancellable,
@@ -544,7 +921,7 @@ mmcli_manager_run_synchronous (GDBusConnection *connection)
 {
     GError *error = NULL;
 
-    if (monitor_modems_flag) {
+    if (monitor_modems_flag || monitor_all_flag) {
         g_printerr ("error: monitoring modems cannot be done synchronously\n");
         exit (EXIT_FAILURE);
     }
@@ -592,6 +969,36 @@ mmcli_manager_run_synchronous (GDBusConnection *connection)
         return;
     }
 
+    /* Request to get snapshot? */
+    if (snapshot_flag) {
+        GVariant *result;
+
+        result = mm_manager_get_snapshot_sync (ctx->manager, NULL, &error);
+        get_snapshot_process_reply (result, error);
+        g_variant_unref (result);
+        return;
+    }
+
+    /* Request to get command statistics? */
+    if (command_stats_flag) {
+        GVariant *result;
+
+        result = mm_manager_get_command_stats_sync (ctx->manager, NULL, &error);
+        get_command_stats_process_reply (result, error);
+        g_variant_unref (result);
+        return;
+    }
+
+    /* Request to get memory usage? */
+    if (memory_usage_flag) {
+        GVariant *result;
+
+        result = mm_manager_get_memory_usage_sync (ctx->manager, NULL, &error);
+        get_memory_usage_process_reply (result, error);
+        g_variant_unref (result);
+        return;
+    }
+
     /* Request to report kernel event? */
     if (report_kernel_event_str) {
         MMKernelEventProperties *properties;
@@ -55,7 +55,7 @@ static GOptionEntry entries[] = {
       "[Rate]"
     },
     { "signal-setup-thresholds", 0, 0, G_OPTION_ARG_STRING, &setup_thresholds_str,
-      "Setup signal quality information thresholds (allowed keys: rssi-threshold, error-rate-threshold)",
+      "Setup signal quality information thresholds (allowed keys: rssi-threshold, error-rate-threshold, rsrp-threshold, snr-threshold, max-interval)",
       "[\"key=value,...\"]"
     },
     { "signal-get", 0, 0, G_OPTION_ARG_NONE, &get_flag,
@@ -147,6 +147,9 @@ print_signal_info (void)
     gchar    *refresh_rate;
     gchar    *rssi_threshold;
     gchar    *error_rate_threshold;
+    gchar    *rsrp_threshold;
+    gchar    *snr_threshold;
+    gchar    *threshold_max_interval;
     gchar    *cdma1x_rssi = NULL;
     gchar    *cdma1x_ecio = NULL;
     gchar    *cdma1x_error_rate = NULL;
@@ -175,6 +178,9 @@ print_signal_info (void)
     refresh_rate         = g_strdup_printf ("%u", mm_modem_signal_get_rate                 (ctx->modem_signal));
     rssi_threshold       = g_strdup_printf ("%u", mm_modem_signal_get_rssi_threshold       (ctx->modem_signal));
     error_rate_threshold = g_strdup_printf ("%s", mm_modem_signal_get_error_rate_threshold (ctx->modem_signal) ? "yes" : "no");
+    rsrp_threshold         = g_strdup_printf ("%u", mm_modem_signal_get_rsrp_threshold         (ctx->modem_signal));
+    snr_threshold          = g_strdup_printf ("%u", mm_modem_signal_get_snr_threshold          (ctx->modem_signal));
+    threshold_max_interval = g_strdup_printf ("%u", mm_modem_signal_get_threshold_max_interval (ctx->modem_signal));
 
     signal = mm_modem_signal_peek_cdma (ctx->modem_signal);
     if (signal) {
@@ -251,6 +257,9 @@ print_signal_info (void)
     mmcli_output_string_take_typed (MMC_F_SIGNAL_REFRESH_RATE,         refresh_rate,         "seconds");
     mmcli_output_string_take_typed (MMC_F_SIGNAL_RSSI_THRESHOLD,       rssi_threshold,       "dBm");
     mmcli_output_string_take       (MMC_F_SIGNAL_ERROR_RATE_THRESHOLD, error_rate_threshold);
+    mmcli_output_string_take_typed (MMC_F_SIGNAL_RSRP_THRESHOLD,       rsrp_threshold,       "dB");
+    mmcli_output_string_take_typed (MMC_F_SIGNAL_SNR_THRESHOLD,        snr_threshold,        "dB");
+    mmcli_output_string_take_typed (MMC_F_SIGNAL_THRESHOLD_MAX_INTERVAL, threshold_max_interval, "seconds");
     mmcli_output_string_take_typed (MMC_F_SIGNAL_CDMA1X_RSSI,          cdma1x_rssi,          "dBm");
     mmcli_output_string_take_typed (MMC_F_SIGNAL_CDMA1X_ECIO,          cdma1x_ecio,          "dBm");
     mmcli_output_string_take_typed (MMC_F_SIGNAL_CDMA1X_ERROR_RATE,    cdma1x_error_rate,    "%%");
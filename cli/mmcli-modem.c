@@ -65,6 +65,7 @@ static gchar *set_preferred_mode_str;
 static gchar *set_current_bands_str;
 static gint set_primary_sim_slot_int;
 static gboolean get_cell_info_flag;
+static gchar *setup_cell_info_str;
 static gboolean inhibit_flag;
 
 static GOptionEntry entries[] = {
@@ -136,6 +137,10 @@ static GOptionEntry entries[] = {
       "Get cell info",
       NULL
     },
+    { "setup-cell-info", 0, 0, G_OPTION_ARG_STRING, &setup_cell_info_str,
+      "Setup cell info monitoring refresh rate, in milliseconds (0 to disable)",
+      "[RATE]"
+    },
     { "inhibit", 0, 0, G_OPTION_ARG_NONE, &inhibit_flag,
       "Inhibit the modem",
       NULL
@@ -185,6 +190,7 @@ mmcli_modem_options_enabled (void)
                  !!set_current_bands_str +
                  (set_primary_sim_slot_int > 0) +
                  get_cell_info_flag +
+                 !!setup_cell_info_str +
                  inhibit_flag);
 
     if (n_actions == 0 && mmcli_get_common_modem_string ()) {
@@ -1011,6 +1017,45 @@ get_cell_info_ready (MMModem      *modem,
     mmcli_async_operation_done ();
 }
 
+static void
+setup_cell_info_process_reply (gboolean      result,
+                               const GError *error)
+{
+    if (!result) {
+        g_printerr ("error: couldn't setup cell info monitoring: '%s'\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    g_print ("successfully setup cell info monitoring\n");
+}
+
+static void
+setup_cell_info_ready (MMModem      *modem,
+                       GAsyncResult *result)
+{
+    gboolean          operation_result;
+    g_autoptr(GError) error = NULL;
+
+    operation_result = mm_modem_setup_cell_info_finish (modem, result, &error);
+    setup_cell_info_process_reply (operation_result, error);
+
+    mmcli_async_operation_done ();
+}
+
+static guint
+parse_cell_info_rate (void)
+{
+    guint rate;
+
+    if (!mm_get_uint_from_str (setup_cell_info_str, &rate)) {
+        g_printerr ("error: couldn't setup cell info monitoring: invalid rate given: '%s'\n",
+                    setup_cell_info_str);
+        exit (EXIT_FAILURE);
+    }
+    return rate;
+}
+
 static void
 state_changed (MMModem                  *modem,
                MMModemState              old_state,
@@ -1272,6 +1317,16 @@ get_modem_ready (GObject      *source,
         return;
     }
 
+    /* Request to setup cell info monitoring? */
+    if (setup_cell_info_str) {
+        mm_modem_setup_cell_info (ctx->modem,
+                                  parse_cell_info_rate (),
+                                  ctx->cancellable,
+                                  (GAsyncReadyCallback)setup_cell_info_ready,
+                                  NULL);
+        return;
+    }
+
     /* Request to inhibit the modem? */
     if (inhibit_flag) {
         gchar *uid;
@@ -1549,5 +1604,14 @@ mmcli_modem_run_synchronous (GDBusConnection *connection)
         return;
     }
 
+    /* Request to setup cell info monitoring? */
+    if (setup_cell_info_str) {
+        gboolean result;
+
+        result = mm_modem_setup_cell_info_sync (ctx->modem, parse_cell_info_rate (), NULL, &error);
+        setup_cell_info_process_reply (result, error);
+        return;
+    }
+
     g_warn_if_reached ();
 }
@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 
 #define _LIBMM_INSIDE_MMCLI
 #include <libmm-glib.h>
@@ -184,6 +185,9 @@ static FieldInfo field_infos[] = {
     [MMC_F_SIGNAL_REFRESH_RATE]                      = { "modem.signal.refresh.rate",                       "refresh rate",             MMC_S_MODEM_SIGNAL,               },
     [MMC_F_SIGNAL_RSSI_THRESHOLD]                    = { "modem.signal.threshold.rssi",                     "rssi threshold",           MMC_S_MODEM_SIGNAL,               },
     [MMC_F_SIGNAL_ERROR_RATE_THRESHOLD]              = { "modem.signal.threshold.error-rate",               "error rate threshold",     MMC_S_MODEM_SIGNAL,               },
+    [MMC_F_SIGNAL_RSRP_THRESHOLD]                    = { "modem.signal.threshold.rsrp",                     "rsrp threshold",           MMC_S_MODEM_SIGNAL,               },
+    [MMC_F_SIGNAL_SNR_THRESHOLD]                     = { "modem.signal.threshold.snr",                      "snr threshold",            MMC_S_MODEM_SIGNAL,               },
+    [MMC_F_SIGNAL_THRESHOLD_MAX_INTERVAL]            = { "modem.signal.threshold.max-interval",             "threshold max interval",   MMC_S_MODEM_SIGNAL,               },
     [MMC_F_SIGNAL_CDMA1X_RSSI]                       = { "modem.signal.cdma1x.rssi",                        "rssi",                     MMC_S_MODEM_SIGNAL_CDMA1X,        },
     [MMC_F_SIGNAL_CDMA1X_ECIO]                       = { "modem.signal.cdma1x.ecio",                        "ecio",                     MMC_S_MODEM_SIGNAL_CDMA1X,        },
     [MMC_F_SIGNAL_CDMA1X_ERROR_RATE]                 = { "modem.signal.cdma1x.error-rate",                  "error rate",               MMC_S_MODEM_SIGNAL_CDMA1X,        },
@@ -276,6 +280,8 @@ static FieldInfo field_infos[] = {
     [MMC_F_BEARER_STATS_DURATION]                    = { "bearer.stats.duration",                           "duration",                 MMC_S_BEARER_STATS,               },
     [MMC_F_BEARER_STATS_UPLINK_SPEED]                = { "bearer.stats.uplink-speed",                       "uplink-speed",             MMC_S_BEARER_STATS,               },
     [MMC_F_BEARER_STATS_DOWNLINK_SPEED]              = { "bearer.stats.downlink-speed",                     "downlink-speed",           MMC_S_BEARER_STATS,               },
+    [MMC_F_BEARER_STATS_RX_RATE]                     = { "bearer.stats.rx-rate",                            "rx rate",                  MMC_S_BEARER_STATS,               },
+    [MMC_F_BEARER_STATS_TX_RATE]                     = { "bearer.stats.tx-rate",                            "tx rate",                  MMC_S_BEARER_STATS,               },
     [MMC_F_BEARER_STATS_BYTES_RX]                    = { "bearer.stats.bytes-rx",                           "bytes rx",                 MMC_S_BEARER_STATS,               },
     [MMC_F_BEARER_STATS_BYTES_TX]                    = { "bearer.stats.bytes-tx",                           "bytes tx",                 MMC_S_BEARER_STATS,               },
     [MMC_F_BEARER_STATS_ATTEMPTS]                    = { "bearer.stats.attempts",                           "attempts",                 MMC_S_BEARER_STATS,               },
@@ -750,7 +756,7 @@ build_network_info (MMModem3gppNetwork *network)
                                operator_name ? operator_name : "name n/a",
                                access_technologies,
                                availability);
-    } else if (selected_type == MMC_OUTPUT_TYPE_JSON) {
+    } else if (selected_type == MMC_OUTPUT_TYPE_JSON || selected_type == MMC_OUTPUT_TYPE_JSONL) {
         GString *str;
         gchar *escape;
 
@@ -1101,6 +1107,492 @@ mmcli_output_cell_info (GList *cell_info_list)
         output_item_new_take_multiple (MMC_F_CELL_INFO, cell_infos, TRUE, FALSE);
 }
 
+/******************************************************************************/
+/* Snapshot output
+ *
+ * The snapshot is printed right away, it does not go through the list of
+ * output items, as the set of fields is not known in advance.
+ */
+
+static void
+build_json_value (GString  *str,
+                  GVariant *value)
+{
+    GVariantIter  iter;
+    GVariant     *child;
+    gboolean      first = TRUE;
+    gchar        *escaped;
+
+    switch (g_variant_classify (value)) {
+    case G_VARIANT_CLASS_BOOLEAN:
+        g_string_append (str, g_variant_get_boolean (value) ? "true" : "false");
+        break;
+    case G_VARIANT_CLASS_BYTE:
+        g_string_append_printf (str, "%u", (guint) g_variant_get_byte (value));
+        break;
+    case G_VARIANT_CLASS_INT16:
+        g_string_append_printf (str, "%d", (gint) g_variant_get_int16 (value));
+        break;
+    case G_VARIANT_CLASS_UINT16:
+        g_string_append_printf (str, "%u", (guint) g_variant_get_uint16 (value));
+        break;
+    case G_VARIANT_CLASS_INT32:
+        g_string_append_printf (str, "%d", g_variant_get_int32 (value));
+        break;
+    case G_VARIANT_CLASS_UINT32:
+        g_string_append_printf (str, "%u", g_variant_get_uint32 (value));
+        break;
+    case G_VARIANT_CLASS_INT64:
+        g_string_append_printf (str, "%" G_GINT64_FORMAT, g_variant_get_int64 (value));
+        break;
+    case G_VARIANT_CLASS_UINT64:
+        g_string_append_printf (str, "%" G_GUINT64_FORMAT, g_variant_get_uint64 (value));
+        break;
+    case G_VARIANT_CLASS_HANDLE:
+        g_string_append_printf (str, "%d", g_variant_get_handle (value));
+        break;
+    case G_VARIANT_CLASS_DOUBLE: {
+        gdouble dbl;
+        gchar   buf[G_ASCII_DTOSTR_BUF_SIZE];
+
+        /* JSON has no representation for NaN or infinite values */
+        dbl = g_variant_get_double (value);
+        if (isnan (dbl) || isinf (dbl))
+            g_string_append (str, "null");
+        else
+            g_string_append (str, g_ascii_dtostr (buf, sizeof (buf), dbl));
+        break;
+    }
+    case G_VARIANT_CLASS_STRING:
+    case G_VARIANT_CLASS_OBJECT_PATH:
+    case G_VARIANT_CLASS_SIGNATURE:
+        escaped = json_strescape (g_variant_get_string (value, NULL));
+        g_string_append_printf (str, "\"%s\"", escaped);
+        g_free (escaped);
+        break;
+    case G_VARIANT_CLASS_VARIANT:
+        child = g_variant_get_variant (value);
+        build_json_value (str, child);
+        g_variant_unref (child);
+        break;
+    case G_VARIANT_CLASS_MAYBE:
+        child = g_variant_get_maybe (value);
+        if (child) {
+            build_json_value (str, child);
+            g_variant_unref (child);
+        } else
+            g_string_append (str, "null");
+        break;
+    case G_VARIANT_CLASS_ARRAY:
+        /* Dictionaries are printed as objects, all others as arrays */
+        if (g_variant_type_is_dict_entry (g_variant_type_element (g_variant_get_type (value)))) {
+            g_string_append_c (str, '{');
+            g_variant_iter_init (&iter, value);
+            while ((child = g_variant_iter_next_value (&iter))) {
+                GVariant *key;
+                GVariant *item;
+
+                key = g_variant_get_child_value (child, 0);
+                item = g_variant_get_child_value (child, 1);
+                if (!first)
+                    g_string_append_c (str, ',');
+                /* Object keys must be strings */
+                if (g_variant_is_of_type (key, G_VARIANT_TYPE_STRING) ||
+                    g_variant_is_of_type (key, G_VARIANT_TYPE_OBJECT_PATH))
+                    build_json_value (str, key);
+                else {
+                    gchar *printed;
+
+                    printed = g_variant_print (key, FALSE);
+                    escaped = json_strescape (printed);
+                    g_string_append_printf (str, "\"%s\"", escaped);
+                    g_free (escaped);
+                    g_free (printed);
+                }
+                g_string_append_c (str, ':');
+                build_json_value (str, item);
+                g_variant_unref (key);
+                g_variant_unref (item);
+                g_variant_unref (child);
+                first = FALSE;
+            }
+            g_string_append_c (str, '}');
+            break;
+        }
+        /* fall through */
+    case G_VARIANT_CLASS_TUPLE:
+    case G_VARIANT_CLASS_DICT_ENTRY:
+        g_string_append_c (str, '[');
+        g_variant_iter_init (&iter, value);
+        while ((child = g_variant_iter_next_value (&iter))) {
+            if (!first)
+                g_string_append_c (str, ',');
+            build_json_value (str, child);
+            g_variant_unref (child);
+            first = FALSE;
+        }
+        g_string_append_c (str, ']');
+        break;
+    default:
+        g_assert_not_reached ();
+    }
+}
+
+static void
+output_snapshot_json (guint     version,
+                      GVariant *objects)
+{
+    GString *str;
+
+    str = g_string_new (NULL);
+    g_string_append_printf (str, "{\"snapshot\":{\"version\":%u,\"objects\":", version);
+    build_json_value (str, objects);
+    g_string_append (str, "}}\n");
+    g_print ("%s", str->str);
+    g_string_free (str, TRUE);
+}
+
+static void
+output_snapshot_text (guint     version,
+                      GVariant *objects)
+{
+    GVariantIter  objects_iter;
+    const gchar  *path;
+    GVariant     *interfaces;
+    gboolean      keyvalue;
+
+    keyvalue = (selected_type == MMC_OUTPUT_TYPE_KEYVALUE);
+
+    if (keyvalue)
+        g_print ("snapshot.version : %u\n", version);
+    else
+        g_print ("snapshot version: %u\n", version);
+
+    g_variant_iter_init (&objects_iter, objects);
+    while (g_variant_iter_next (&objects_iter, "{&o@a{sa{sv}}}", &path, &interfaces)) {
+        GVariantIter  interfaces_iter;
+        const gchar  *interface;
+        GVariant     *properties;
+
+        if (!keyvalue)
+            g_print ("\n%s\n", path);
+
+        g_variant_iter_init (&interfaces_iter, interfaces);
+        while (g_variant_iter_next (&interfaces_iter, "{&s@a{sv}}", &interface, &properties)) {
+            GVariantIter  properties_iter;
+            const gchar  *property;
+            GVariant     *value;
+
+            if (!keyvalue)
+                g_print ("  %s\n", interface);
+
+            g_variant_iter_init (&properties_iter, properties);
+            while (g_variant_iter_next (&properties_iter, "{&sv}", &property, &value)) {
+                gchar *printed;
+
+                printed = g_variant_print (value, FALSE);
+                if (keyvalue)
+                    g_print ("snapshot.%s.%s.%s : %s\n", path, interface, property, printed);
+                else
+                    g_print ("    %s: %s\n", property, printed);
+                g_free (printed);
+                g_variant_unref (value);
+            }
+            g_variant_unref (properties);
+        }
+        g_variant_unref (interfaces);
+    }
+}
+
+void
+mmcli_output_snapshot (GVariant *snapshot)
+{
+    guint     version = 0;
+    GVariant *objects = NULL;
+
+    g_variant_get (snapshot, "(u@a{oa{sa{sv}}})", &version, &objects);
+
+    switch (selected_type) {
+    case MMC_OUTPUT_TYPE_NONE:
+        break;
+    case MMC_OUTPUT_TYPE_HUMAN:
+    case MMC_OUTPUT_TYPE_KEYVALUE:
+        output_snapshot_text (version, objects);
+        break;
+    case MMC_OUTPUT_TYPE_JSON:
+    case MMC_OUTPUT_TYPE_JSONL:
+        output_snapshot_json (version, objects);
+        break;
+    default:
+        g_assert_not_reached ();
+    }
+
+    g_variant_unref (objects);
+    fflush (stdout);
+}
+
+/******************************************************************************/
+/* Command statistics output */
+
+static guint64
+command_stats_lookup_uint64 (GVariant    *entry,
+                             const gchar *key)
+{
+    guint64 value = 0;
+
+    g_variant_lookup (entry, key, "t", &value);
+    return value;
+}
+
+static void
+output_command_stats_json (GVariant *stats)
+{
+    GString *str;
+
+    str = g_string_new ("{\"command-stats\":");
+    build_json_value (str, stats);
+    g_string_append (str, "}\n");
+    g_print ("%s", str->str);
+    g_string_free (str, TRUE);
+}
+
+static void
+output_command_stats_text (GVariant *stats)
+{
+    GVariantIter  iter;
+    GVariant     *entry;
+    gchar        *last_modem = NULL;
+    gboolean      keyvalue;
+
+    keyvalue = (selected_type == MMC_OUTPUT_TYPE_KEYVALUE);
+
+    if (!keyvalue && !g_variant_n_children (stats)) {
+        g_print ("No command statistics found\n");
+        return;
+    }
+
+    g_variant_iter_init (&iter, stats);
+    while (g_variant_iter_next (&iter, "@a{sv}", &entry)) {
+        const gchar *modem = "";
+        const gchar *port = "";
+        const gchar *command = "";
+
+        g_variant_lookup (entry, "modem", "&o", &modem);
+        g_variant_lookup (entry, "port", "&s", &port);
+        g_variant_lookup (entry, "command", "&s", &command);
+
+        if (keyvalue) {
+            GVariantIter  values_iter;
+            const gchar  *key;
+            GVariant     *value;
+
+            g_variant_iter_init (&values_iter, entry);
+            while (g_variant_iter_next (&values_iter, "{&sv}", &key, &value)) {
+                if (g_variant_is_of_type (value, G_VARIANT_TYPE_UINT64))
+                    g_print ("command-stats.%s.%s.%s.%s : %" G_GUINT64_FORMAT "\n",
+                             modem, port, command, key, g_variant_get_uint64 (value));
+                g_variant_unref (value);
+            }
+        } else {
+            if (g_strcmp0 (last_modem, modem) != 0) {
+                g_print ("\n%s\n", modem);
+                g_free (last_modem);
+                last_modem = g_strdup (modem);
+            }
+            g_print ("  %s %s: %" G_GUINT64_FORMAT " responses, %" G_GUINT64_FORMAT " errors, "
+                     "%" G_GUINT64_FORMAT " timeouts, %" G_GUINT64_FORMAT " retries\n",
+                     port, command,
+                     command_stats_lookup_uint64 (entry, "count"),
+                     command_stats_lookup_uint64 (entry, "errors"),
+                     command_stats_lookup_uint64 (entry, "timeouts"),
+                     command_stats_lookup_uint64 (entry, "retries"));
+            if (command_stats_lookup_uint64 (entry, "count"))
+                g_print ("    latency: %" G_GUINT64_FORMAT " us (min), %" G_GUINT64_FORMAT " us (mean), "
+                         "%" G_GUINT64_FORMAT " us (p50), %" G_GUINT64_FORMAT " us (p90), "
+                         "%" G_GUINT64_FORMAT " us (p99), %" G_GUINT64_FORMAT " us (max)\n",
+                         command_stats_lookup_uint64 (entry, "latency-min"),
+                         command_stats_lookup_uint64 (entry, "latency-mean"),
+                         command_stats_lookup_uint64 (entry, "latency-p50"),
+                         command_stats_lookup_uint64 (entry, "latency-p90"),
+                         command_stats_lookup_uint64 (entry, "latency-p99"),
+                         command_stats_lookup_uint64 (entry, "latency-max"));
+        }
+        g_variant_unref (entry);
+    }
+    g_free (last_modem);
+}
+
+void
+mmcli_output_command_stats (GVariant *stats)
+{
+    switch (selected_type) {
+    case MMC_OUTPUT_TYPE_NONE:
+        break;
+    case MMC_OUTPUT_TYPE_HUMAN:
+    case MMC_OUTPUT_TYPE_KEYVALUE:
+        output_command_stats_text (stats);
+        break;
+    case MMC_OUTPUT_TYPE_JSON:
+    case MMC_OUTPUT_TYPE_JSONL:
+        output_command_stats_json (stats);
+        break;
+    default:
+        g_assert_not_reached ();
+    }
+
+    fflush (stdout);
+}
+
+/******************************************************************************/
+/* Memory usage output */
+
+static void
+output_memory_usage_json (GVariant *usage)
+{
+    GString *str;
+
+    str = g_string_new ("{\"memory-usage\":");
+    build_json_value (str, usage);
+    g_string_append (str, "}\n");
+    g_print ("%s", str->str);
+    g_string_free (str, TRUE);
+}
+
+static void
+output_memory_usage_text (GVariant *usage)
+{
+    GVariantIter  iter;
+    GVariant     *entry;
+    gboolean      keyvalue;
+
+    keyvalue = (selected_type == MMC_OUTPUT_TYPE_KEYVALUE);
+
+    if (!keyvalue && !g_variant_n_children (usage)) {
+        g_print ("No memory usage found\n");
+        return;
+    }
+
+    g_variant_iter_init (&iter, usage);
+    while (g_variant_iter_next (&iter, "@a{sv}", &entry)) {
+        GVariantIter  values_iter;
+        const gchar  *modem = "";
+        const gchar  *key;
+        GVariant     *value;
+
+        g_variant_lookup (entry, "modem", "&o", &modem);
+        if (!keyvalue)
+            g_print ("\n%s\n", modem);
+
+        g_variant_iter_init (&values_iter, entry);
+        while (g_variant_iter_next (&values_iter, "{&sv}", &key, &value)) {
+            if (g_variant_is_of_type (value, G_VARIANT_TYPE_UINT64)) {
+                if (keyvalue)
+                    g_print ("memory-usage.%s.%s : %" G_GUINT64_FORMAT "\n",
+                             modem, key, g_variant_get_uint64 (value));
+                else if (g_variant_get_uint64 (value))
+                    g_print ("  %s: %.1f KiB\n", key, (gdouble) g_variant_get_uint64 (value) / 1024.0);
+            }
+            g_variant_unref (value);
+        }
+        g_variant_unref (entry);
+    }
+}
+
+void
+mmcli_output_memory_usage (GVariant *usage)
+{
+    switch (selected_type) {
+    case MMC_OUTPUT_TYPE_NONE:
+        break;
+    case MMC_OUTPUT_TYPE_HUMAN:
+    case MMC_OUTPUT_TYPE_KEYVALUE:
+        output_memory_usage_text (usage);
+        break;
+    case MMC_OUTPUT_TYPE_JSON:
+    case MMC_OUTPUT_TYPE_JSONL:
+        output_memory_usage_json (usage);
+        break;
+    default:
+        g_assert_not_reached ();
+    }
+
+    fflush (stdout);
+}
+
+/******************************************************************************/
+/* Event output
+ *
+ * Events are printed right away, in a single line each; in JSON lines output
+ * each event is a JSON object, and all the given values are included as
+ * members of that object.
+ */
+
+static void
+output_event_valist (const gchar *event,
+                     const gchar *path,
+                     const gchar *first_key,
+                     va_list      args)
+{
+    GString     *str;
+    const gchar *key;
+    gint64       now;
+    gboolean     json;
+    gchar       *escaped;
+
+    json = (selected_type == MMC_OUTPUT_TYPE_JSON || selected_type == MMC_OUTPUT_TYPE_JSONL);
+    now = g_get_real_time ();
+
+    str = g_string_new (NULL);
+    if (json) {
+        g_string_append_printf (str, "{\"timestamp\":%" G_GINT64_FORMAT ".%06d,\"event\":\"%s\"",
+                                now / G_USEC_PER_SEC, (gint) (now % G_USEC_PER_SEC), event);
+        if (path) {
+            escaped = json_strescape (path);
+            g_string_append_printf (str, ",\"path\":\"%s\"", escaped);
+            g_free (escaped);
+        }
+    } else {
+        g_string_append_printf (str, "[%" G_GINT64_FORMAT ".%03d] %s", now / G_USEC_PER_SEC,
+                                (gint) ((now % G_USEC_PER_SEC) / 1000), event);
+        if (path)
+            g_string_append_printf (str, " %s", path);
+    }
+
+    for (key = first_key; key; key = va_arg (args, const gchar *)) {
+        GVariant *value;
+
+        value = g_variant_ref_sink (va_arg (args, GVariant *));
+        if (json) {
+            g_string_append_printf (str, ",\"%s\":", key);
+            build_json_value (str, value);
+        } else {
+            g_string_append_printf (str, " %s: ", key);
+            g_variant_print_string (value, str, FALSE);
+        }
+        g_variant_unref (value);
+    }
+
+    g_string_append (str, json ? "}\n" : "\n");
+    g_print ("%s", str->str);
+    g_string_free (str, TRUE);
+
+    /* Each event must be readable as soon as it's printed */
+    fflush (stdout);
+}
+
+void
+mmcli_output_event (const gchar *event,
+                    const gchar *path,
+                    const gchar *first_key,
+                    ...)
+{
+    va_list args;
+
+    va_start (args, first_key);
+    output_event_valist (event, path, first_key, args);
+    va_end (args);
+}
+
 /******************************************************************************/
 /* Human-friendly output */
 
@@ -1615,6 +2107,7 @@ mmcli_output_dump (void)
         dump_output_keyvalue ();
         break;
     case MMC_OUTPUT_TYPE_JSON:
+    case MMC_OUTPUT_TYPE_JSONL:
         dump_output_json ();
         break;
     default:
@@ -1640,6 +2133,7 @@ mmcli_output_list_dump (MmcF field)
         dump_output_list_keyvalue (field);
         break;
     case MMC_OUTPUT_TYPE_JSON:
+    case MMC_OUTPUT_TYPE_JSONL:
         dump_output_list_json (field);
         break;
     default:
@@ -196,6 +196,9 @@ typedef enum {
     MMC_F_SIGNAL_REFRESH_RATE,
     MMC_F_SIGNAL_RSSI_THRESHOLD,
     MMC_F_SIGNAL_ERROR_RATE_THRESHOLD,
+    MMC_F_SIGNAL_RSRP_THRESHOLD,
+    MMC_F_SIGNAL_SNR_THRESHOLD,
+    MMC_F_SIGNAL_THRESHOLD_MAX_INTERVAL,
     MMC_F_SIGNAL_CDMA1X_RSSI,
     MMC_F_SIGNAL_CDMA1X_ECIO,
     MMC_F_SIGNAL_CDMA1X_ERROR_RATE,
@@ -295,6 +298,8 @@ typedef enum {
     MMC_F_BEARER_STATS_DURATION,
     MMC_F_BEARER_STATS_UPLINK_SPEED,
     MMC_F_BEARER_STATS_DOWNLINK_SPEED,
+    MMC_F_BEARER_STATS_RX_RATE,
+    MMC_F_BEARER_STATS_TX_RATE,
     MMC_F_BEARER_STATS_BYTES_RX,
     MMC_F_BEARER_STATS_BYTES_TX,
     MMC_F_BEARER_STATS_ATTEMPTS,
@@ -365,7 +370,8 @@ typedef enum {
     MMC_OUTPUT_TYPE_NONE,
     MMC_OUTPUT_TYPE_HUMAN,
     MMC_OUTPUT_TYPE_KEYVALUE,
-    MMC_OUTPUT_TYPE_JSON
+    MMC_OUTPUT_TYPE_JSON,
+    MMC_OUTPUT_TYPE_JSONL
 } MmcOutputType;
 
 void          mmcli_output_set (MmcOutputType type);
@@ -421,6 +427,16 @@ void mmcli_output_preferred_networks (GList                     *preferred_nets_
 void mmcli_output_profile_list       (GList                     *profile_list);
 void mmcli_output_profile_set        (MM3gppProfile             *profile);
 void mmcli_output_cell_info          (GList                     *cell_info_list);
+void mmcli_output_snapshot           (GVariant                  *snapshot);
+void mmcli_output_command_stats      (GVariant                  *stats);
+void mmcli_output_memory_usage       (GVariant                  *usage);
+
+/* Values given as key (const gchar *) and value (GVariant *) pairs, ending
+ * with NULL; floating values are consumed */
+void mmcli_output_event              (const gchar               *event,
+                                      const gchar               *path,
+                                      const gchar               *first_key,
+                                      ...) G_GNUC_NULL_TERMINATED;
 
 /******************************************************************************/
 /* Dump output */
@@ -46,6 +46,7 @@ static GCancellable *cancellable;
 /* Main context */
 static gboolean output_keyvalue_flag;
 static gboolean output_json_flag;
+static gboolean output_jsonl_flag;
 static gboolean verbose_flag;
 static gboolean version_flag;
 static gboolean async_flag;
@@ -60,6 +61,10 @@ static GOptionEntry main_entries[] = {
       "Run action with machine-friendly json output",
       NULL
     },
+    { "output-jsonl", 0, 0, G_OPTION_ARG_NONE, &output_jsonl_flag,
+      "Run action with machine-friendly json output, one line per event",
+      NULL
+    },
     { "verbose", 'v', 0, G_OPTION_ARG_NONE, &verbose_flag,
       "Run action with verbose logs",
       NULL
@@ -285,7 +290,7 @@ main (gint argc, gchar **argv)
         g_log_set_handler (G_LOG_DOMAIN, G_LOG_LEVEL_MASK, log_handler, NULL);
 
     /* Setup output */
-    if (output_keyvalue_flag && output_json_flag) {
+    if ((output_keyvalue_flag + output_json_flag + output_jsonl_flag) > 1) {
         g_printerr ("error: only one output type supported at the same time\n");
         exit (EXIT_FAILURE);
     }
@@ -302,6 +307,13 @@ main (gint argc, gchar **argv)
             exit (EXIT_FAILURE);
         }
         mmcli_output_set (MMC_OUTPUT_TYPE_JSON);
+    }
+    else if (output_jsonl_flag) {
+        if (verbose_flag) {
+            g_printerr ("error: cannot set verbose output in JSON lines output type\n");
+            exit (EXIT_FAILURE);
+        }
+        mmcli_output_set (MMC_OUTPUT_TYPE_JSONL);
     } else {
         mmcli_output_set (MMC_OUTPUT_TYPE_HUMAN);
     }
@@ -52,6 +52,8 @@ G_DEFINE_TYPE (MMBearerStats, mm_bearer_stats, G_TYPE_OBJECT)
 #define PROPERTY_TOTAL_TX_BYTES  "total-tx-bytes"
 #define PROPERTY_UPLINK_SPEED    "uplink-speed"
 #define PROPERTY_DOWNLINK_SPEED  "downlink-speed"
+#define PROPERTY_RX_RATE         "rx-rate"
+#define PROPERTY_TX_RATE         "tx-rate"
 
 struct _MMBearerStatsPrivate {
     guint   duration;
@@ -65,6 +67,8 @@ struct _MMBearerStatsPrivate {
     guint64 total_tx_bytes;
     guint64 uplink_speed;
     guint64 downlink_speed;
+    guint64 rx_rate;
+    guint64 tx_rate;
 };
 
 /*****************************************************************************/
@@ -424,6 +428,72 @@ mm_bearer_stats_set_downlink_speed (MMBearerStats *self,
 
 /*****************************************************************************/
 
+/**
+ * mm_bearer_stats_get_rx_rate:
+ * @self: a #MMBearerStats.
+ *
+ * Gets the receive throughput measured in the last statistics update of the
+ * ongoing connection, in bits per second.
+ *
+ * Returns: a #guint64.
+ *
+ * Since: 1.26
+ */
+guint64
+mm_bearer_stats_get_rx_rate (MMBearerStats *self)
+{
+    g_return_val_if_fail (MM_IS_BEARER_STATS (self), 0);
+
+    return self->priv->rx_rate;
+}
+
+/**
+ * mm_bearer_stats_set_rx_rate: (skip)
+ */
+void
+mm_bearer_stats_set_rx_rate (MMBearerStats *self,
+                             guint64        rate)
+{
+    g_return_if_fail (MM_IS_BEARER_STATS (self));
+
+    self->priv->rx_rate = rate;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_bearer_stats_get_tx_rate:
+ * @self: a #MMBearerStats.
+ *
+ * Gets the transmit throughput measured in the last statistics update of the
+ * ongoing connection, in bits per second.
+ *
+ * Returns: a #guint64.
+ *
+ * Since: 1.26
+ */
+guint64
+mm_bearer_stats_get_tx_rate (MMBearerStats *self)
+{
+    g_return_val_if_fail (MM_IS_BEARER_STATS (self), 0);
+
+    return self->priv->tx_rate;
+}
+
+/**
+ * mm_bearer_stats_set_tx_rate: (skip)
+ */
+void
+mm_bearer_stats_set_tx_rate (MMBearerStats *self,
+                             guint64        rate)
+{
+    g_return_if_fail (MM_IS_BEARER_STATS (self));
+
+    self->priv->tx_rate = rate;
+}
+
+/*****************************************************************************/
+
 /**
  * mm_bearer_stats_get_dictionary: (skip)
  */
@@ -481,6 +551,14 @@ mm_bearer_stats_get_dictionary (MMBearerStats *self)
                             "{sv}",
                             PROPERTY_DOWNLINK_SPEED,
                             g_variant_new_uint64 (self->priv->downlink_speed));
+    g_variant_builder_add  (&builder,
+                            "{sv}",
+                            PROPERTY_RX_RATE,
+                            g_variant_new_uint64 (self->priv->rx_rate));
+    g_variant_builder_add  (&builder,
+                            "{sv}",
+                            PROPERTY_TX_RATE,
+                            g_variant_new_uint64 (self->priv->tx_rate));
     return g_variant_builder_end (&builder);
 }
 
@@ -558,6 +636,14 @@ mm_bearer_stats_new_from_dictionary (GVariant *dictionary,
             mm_bearer_stats_set_downlink_speed (
                 self,
                 g_variant_get_uint64 (value));
+        } else if (g_str_equal (key, PROPERTY_RX_RATE)) {
+            mm_bearer_stats_set_rx_rate (
+                self,
+                g_variant_get_uint64 (value));
+        } else if (g_str_equal (key, PROPERTY_TX_RATE)) {
+            mm_bearer_stats_set_tx_rate (
+                self,
+                g_variant_get_uint64 (value));
         }
 
         g_free (key);
@@ -76,6 +76,8 @@ guint64 mm_bearer_stats_get_total_rx_bytes  (MMBearerStats *self);
 guint64 mm_bearer_stats_get_total_tx_bytes  (MMBearerStats *self);
 guint64 mm_bearer_stats_get_uplink_speed    (MMBearerStats *self);
 guint64 mm_bearer_stats_get_downlink_speed  (MMBearerStats *self);
+guint64 mm_bearer_stats_get_rx_rate         (MMBearerStats *self);
+guint64 mm_bearer_stats_get_tx_rate         (MMBearerStats *self);
 
 /*****************************************************************************/
 /* ModemManager/libmm-glib/mmcli specific methods */
@@ -99,6 +101,8 @@ void mm_bearer_stats_set_total_rx_bytes       (MMBearerStats *self, guint64 rx_b
 void mm_bearer_stats_set_total_tx_bytes       (MMBearerStats *self, guint64 tx_bytes);
 void mm_bearer_stats_set_uplink_speed         (MMBearerStats *self, guint64 speed);
 void mm_bearer_stats_set_downlink_speed       (MMBearerStats *self, guint64 speed);
+void mm_bearer_stats_set_rx_rate              (MMBearerStats *self, guint64 rate);
+void mm_bearer_stats_set_tx_rate              (MMBearerStats *self, guint64 rate);
 
 GVariant *mm_bearer_stats_get_dictionary (MMBearerStats *self);
 
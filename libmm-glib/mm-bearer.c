@@ -21,6 +21,7 @@
  * Copyright (C) 2012 Google, Inc.
  */
 
+#include "mm-errors-types.h"
 #include "mm-helpers.h"
 #include "mm-common-helpers.h"
 #include "mm-bearer.h"
@@ -702,6 +703,155 @@ mm_bearer_disconnect_sync (MMBearer *self,
 
 /*****************************************************************************/
 
+static gboolean
+stats_history_variant_to_array (GVariant             *variant,
+                                MMBearerStatsSample **samples,
+                                guint                *n_samples,
+                                GError              **error)
+{
+    GVariantIter         iter;
+    MMBearerStatsSample *array;
+    gsize                n;
+    guint                i = 0;
+
+    if (!g_variant_is_of_type (variant, G_VARIANT_TYPE ("a(tttttuu)"))) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                     "Cannot read stats history: invalid variant type received");
+        return FALSE;
+    }
+
+    n = g_variant_iter_init (&iter, variant);
+    array = g_new0 (MMBearerStatsSample, n);
+    while (i < n) {
+        guint32 access_technologies = 0;
+
+        if (!g_variant_iter_next (&iter,
+                                  "(tttttuu)",
+                                  &array[i].timestamp,
+                                  &array[i].rx_bytes,
+                                  &array[i].tx_bytes,
+                                  &array[i].rx_rate,
+                                  &array[i].tx_rate,
+                                  &array[i].signal_quality,
+                                  &access_technologies))
+            break;
+        array[i].access_technologies = (MMModemAccessTechnology) access_technologies;
+        i++;
+    }
+
+    *samples = array;
+    *n_samples = i;
+    return TRUE;
+}
+
+/**
+ * mm_bearer_get_stats_history_finish:
+ * @self: A #MMBearer.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_bearer_get_stats_history().
+ * @samples: (out) (array length=n_samples) (transfer full): Return location
+ *  for the array of #MMBearerStatsSample values, oldest first. The returned
+ *  array should be freed with g_free() when no longer needed.
+ * @n_samples: (out): Return location for the number of values in @samples.
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_bearer_get_stats_history().
+ *
+ * Returns: %TRUE if the operation succeeded, %FALSE if @error is set.
+ *
+ * Since: 1.26
+ */
+gboolean
+mm_bearer_get_stats_history_finish (MMBearer             *self,
+                                    GAsyncResult         *res,
+                                    MMBearerStatsSample **samples,
+                                    guint                *n_samples,
+                                    GError              **error)
+{
+    g_autoptr(GVariant) history = NULL;
+
+    g_return_val_if_fail (MM_IS_BEARER (self), FALSE);
+    g_return_val_if_fail (samples != NULL && n_samples != NULL, FALSE);
+
+    if (!mm_gdbus_bearer_call_get_stats_history_finish (MM_GDBUS_BEARER (self), &history, res, error))
+        return FALSE;
+
+    return stats_history_variant_to_array (history, samples, n_samples, error);
+}
+
+/**
+ * mm_bearer_get_stats_history:
+ * @self: A #MMBearer.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously requests the latest statistics samples of the ongoing
+ * connection, in one single call.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_bearer_get_stats_history_finish() to get the result of the operation.
+ *
+ * See mm_bearer_get_stats_history_sync() for the synchronous, blocking version
+ * of this method.
+ *
+ * Since: 1.26
+ */
+void
+mm_bearer_get_stats_history (MMBearer            *self,
+                             GCancellable        *cancellable,
+                             GAsyncReadyCallback  callback,
+                             gpointer             user_data)
+{
+    g_return_if_fail (MM_IS_BEARER (self));
+
+    mm_gdbus_bearer_call_get_stats_history (MM_GDBUS_BEARER (self), cancellable, callback, user_data);
+}
+
+/**
+ * mm_bearer_get_stats_history_sync:
+ * @self: A #MMBearer.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @samples: (out) (array length=n_samples) (transfer full): Return location
+ *  for the array of #MMBearerStatsSample values, oldest first. The returned
+ *  array should be freed with g_free() when no longer needed.
+ * @n_samples: (out): Return location for the number of values in @samples.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously requests the latest statistics samples of the ongoing
+ * connection, in one single call.
+ *
+ * The calling thread is blocked until a reply is received.
+ * See mm_bearer_get_stats_history() for the asynchronous version of this
+ * method.
+ *
+ * Returns: %TRUE if the operation succeeded, %FALSE if @error is set.
+ *
+ * Since: 1.26
+ */
+gboolean
+mm_bearer_get_stats_history_sync (MMBearer             *self,
+                                  GCancellable         *cancellable,
+                                  MMBearerStatsSample **samples,
+                                  guint                *n_samples,
+                                  GError              **error)
+{
+    g_autoptr(GVariant) history = NULL;
+
+    g_return_val_if_fail (MM_IS_BEARER (self), FALSE);
+    g_return_val_if_fail (samples != NULL && n_samples != NULL, FALSE);
+
+    if (!mm_gdbus_bearer_call_get_stats_history_sync (MM_GDBUS_BEARER (self), &history, cancellable, error))
+        return FALSE;
+
+    return stats_history_variant_to_array (history, samples, n_samples, error);
+}
+
+/*****************************************************************************/
+
 static void
 mm_bearer_init (MMBearer *self)
 {
@@ -34,6 +34,7 @@
 #include "mm-bearer-properties.h"
 #include "mm-bearer-ip-config.h"
 #include "mm-bearer-stats.h"
+#include "mm-helper-types.h"
 
 G_BEGIN_DECLS
 
@@ -112,6 +113,21 @@ gboolean mm_bearer_disconnect_sync   (MMBearer *self,
                                       GCancellable *cancellable,
                                       GError **error);
 
+void     mm_bearer_get_stats_history        (MMBearer             *self,
+                                             GCancellable         *cancellable,
+                                             GAsyncReadyCallback   callback,
+                                             gpointer              user_data);
+gboolean mm_bearer_get_stats_history_finish (MMBearer             *self,
+                                             GAsyncResult         *res,
+                                             MMBearerStatsSample **samples,
+                                             guint                *n_samples,
+                                             GError              **error);
+gboolean mm_bearer_get_stats_history_sync   (MMBearer             *self,
+                                             GCancellable         *cancellable,
+                                             MMBearerStatsSample **samples,
+                                             guint                *n_samples,
+                                             GError              **error);
+
 MMBearerProperties *mm_bearer_get_properties   (MMBearer *self);
 MMBearerProperties *mm_bearer_peek_properties  (MMBearer *self);
 
@@ -2250,6 +2250,48 @@ mm_common_str_array_human_keys (GPtrArray *array)
     }
 }
 
+static gchar *
+build_property_name (const gchar *dbus_name)
+{
+    GString *str;
+    guint    i;
+
+    str = g_string_sized_new (strlen (dbus_name) + 4);
+    for (i = 0; dbus_name[i]; i++) {
+        if (g_ascii_isupper (dbus_name[i])) {
+            if (i > 0)
+                g_string_append_c (str, '-');
+            g_string_append_c (str, g_ascii_tolower (dbus_name[i]));
+        } else
+            g_string_append_c (str, dbus_name[i]);
+    }
+    return g_string_free (str, FALSE);
+}
+
+gchar **
+mm_common_build_property_names_from_changes (GVariant            *changed_properties,
+                                             const gchar * const *invalidated_properties)
+{
+    GPtrArray    *names;
+    GVariantIter  iter;
+    const gchar  *dbus_name;
+    guint         i;
+
+    names = g_ptr_array_new ();
+
+    if (changed_properties) {
+        g_variant_iter_init (&iter, changed_properties);
+        while (g_variant_iter_next (&iter, "{&sv}", &dbus_name, NULL))
+            g_ptr_array_add (names, build_property_name (dbus_name));
+    }
+
+    for (i = 0; invalidated_properties && invalidated_properties[i]; i++)
+        g_ptr_array_add (names, build_property_name (invalidated_properties[i]));
+
+    g_ptr_array_add (names, NULL);
+    return (gchar **) g_ptr_array_free (names, FALSE);
+}
+
 /*****************************************************************************/
 /* DBus error handling */
 
@@ -184,6 +184,11 @@ const gchar *mm_common_str_personal_info    (const gchar *str,
                                              gboolean     show_personal_info);
 void         mm_common_str_array_human_keys (GPtrArray   *array);
 
+/* Builds the GObject property names (e.g. "current-bands") of the D-Bus
+ * properties (e.g. "CurrentBands") reported in a PropertiesChanged signal */
+gchar **mm_common_build_property_names_from_changes (GVariant            *changed_properties,
+                                                     const gchar * const *invalidated_properties);
+
 /******************************************************************************/
 /* Common parsers */
 
@@ -96,4 +96,32 @@ struct _MMCellBroadcastChannels {
     guint end;
 };
 
+/**
+ * MMBearerStatsSample:
+ * @timestamp: Time when the sample was taken, in milliseconds since the epoch.
+ * @rx_bytes: Number of bytes received in the ongoing connection.
+ * @tx_bytes: Number of bytes transmitted in the ongoing connection.
+ * @rx_rate: Receive throughput since the previous sample, in bits per second.
+ * @tx_rate: Transmit throughput since the previous sample, in bits per second.
+ * @signal_quality: Signal quality of the modem when the sample was taken, in
+ *  percentage.
+ * @access_technologies: Mask of #MMModemAccessTechnology values in use when
+ *  the sample was taken.
+ *
+ * #MMBearerStatsSample is a simple struct holding one entry of the bearer
+ * statistics history.
+ *
+ * Since: 1.26
+ */
+typedef struct _MMBearerStatsSample MMBearerStatsSample;
+struct _MMBearerStatsSample {
+    guint64                 timestamp;
+    guint64                 rx_bytes;
+    guint64                 tx_bytes;
+    guint64                 rx_rate;
+    guint64                 tx_rate;
+    guint                   signal_quality;
+    MMModemAccessTechnology access_technologies;
+};
+
 #endif /* _MM_HELPER_TYPES_H_ */
@@ -568,6 +568,411 @@ mm_manager_scan_devices_sync (MMManager     *manager,
 
 /*****************************************************************************/
 
+/**
+ * mm_manager_get_snapshot_finish:
+ * @manager: A #MMManager.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_manager_get_snapshot().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_manager_get_snapshot().
+ *
+ * Returns: (transfer full): A #GVariant of type "(ua{oa{sa{sv}}})" with the
+ * snapshot version and the state of all objects, or %NULL if @error is set.
+ * The returned value should be freed with g_variant_unref().
+ *
+ * Since: 1.26
+ */
+GVariant *
+mm_manager_get_snapshot_finish (MMManager     *manager,
+                                GAsyncResult  *res,
+                                GError       **error)
+{
+    g_return_val_if_fail (MM_IS_MANAGER (manager), NULL);
+
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+get_snapshot_ready (MmGdbusOrgFreedesktopModemManager1 *manager_iface_proxy,
+                    GAsyncResult                       *res,
+                    GTask                              *task)
+{
+    GError   *error = NULL;
+    GVariant *snapshot = NULL;
+
+    if (!mm_gdbus_org_freedesktop_modem_manager1_call_get_snapshot_finish (
+            manager_iface_proxy,
+            &snapshot,
+            res,
+            &error))
+        g_task_return_error (task, error);
+    else
+        g_task_return_pointer (task, snapshot, (GDestroyNotify) g_variant_unref);
+
+    g_object_unref (task);
+}
+
+/**
+ * mm_manager_get_snapshot:
+ * @manager: A #MMManager.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously requests the state of all modems, SIMs and bearers in a
+ * single call.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_manager_get_snapshot_finish() to get the result of the operation.
+ *
+ * See mm_manager_get_snapshot_sync() for the synchronous, blocking version of
+ * this method.
+ *
+ * Since: 1.26
+ */
+void
+mm_manager_get_snapshot (MMManager           *manager,
+                         GCancellable        *cancellable,
+                         GAsyncReadyCallback  callback,
+                         gpointer             user_data)
+{
+    GTask *task;
+    GError *inner_error = NULL;
+
+    g_return_if_fail (MM_IS_MANAGER (manager));
+
+    task = g_task_new (manager, cancellable, callback, user_data);
+
+    if (!ensure_modem_manager1_proxy (manager, &inner_error)) {
+        g_task_return_error (task, inner_error);
+        g_object_unref (task);
+        return;
+    }
+
+    mm_gdbus_org_freedesktop_modem_manager1_call_get_snapshot (
+        manager->priv->manager_iface_proxy,
+        cancellable,
+        (GAsyncReadyCallback)get_snapshot_ready,
+        task);
+}
+
+/**
+ * mm_manager_get_snapshot_sync:
+ * @manager: A #MMManager.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously requests the state of all modems, SIMs and bearers in a
+ * single call.
+ *
+ * The calling thread is blocked until a reply is received.
+ *
+ * See mm_manager_get_snapshot() for the asynchronous version of this method.
+ *
+ * Returns: (transfer full): A #GVariant of type "(ua{oa{sa{sv}}})" with the
+ * snapshot version and the state of all objects, or %NULL if @error is set.
+ * The returned value should be freed with g_variant_unref().
+ *
+ * Since: 1.26
+ */
+GVariant *
+mm_manager_get_snapshot_sync (MMManager     *manager,
+                              GCancellable  *cancellable,
+                              GError       **error)
+{
+    GVariant *snapshot = NULL;
+
+    g_return_val_if_fail (MM_IS_MANAGER (manager), NULL);
+
+    if (!ensure_modem_manager1_proxy (manager, error))
+        return NULL;
+
+    if (!mm_gdbus_org_freedesktop_modem_manager1_call_get_snapshot_sync (
+            manager->priv->manager_iface_proxy,
+            &snapshot,
+            cancellable,
+            error))
+        return NULL;
+
+    return snapshot;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_manager_get_command_stats_finish:
+ * @manager: A #MMManager.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_manager_get_command_stats().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_manager_get_command_stats().
+ *
+ * Returns: (transfer full): A #GVariant of type "aa{sv}" with one dictionary
+ * per command type and port, or %NULL if @error is set. The returned value
+ * should be freed with g_variant_unref().
+ *
+ * Since: 1.26
+ */
+GVariant *
+mm_manager_get_command_stats_finish (MMManager     *manager,
+                                     GAsyncResult  *res,
+                                     GError       **error)
+{
+    g_return_val_if_fail (MM_IS_MANAGER (manager), NULL);
+
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+get_command_stats_ready (MmGdbusOrgFreedesktopModemManager1 *manager_iface_proxy,
+                         GAsyncResult                       *res,
+                         GTask                              *task)
+{
+    GError   *error = NULL;
+    GVariant *stats = NULL;
+
+    if (!mm_gdbus_org_freedesktop_modem_manager1_call_get_command_stats_finish (
+            manager_iface_proxy,
+            &stats,
+            res,
+            &error))
+        g_task_return_error (task, error);
+    else
+        g_task_return_pointer (task, stats, (GDestroyNotify) g_variant_unref);
+
+    g_object_unref (task);
+}
+
+/**
+ * mm_manager_get_command_stats:
+ * @manager: A #MMManager.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously requests the latency, error, timeout and retry statistics
+ * of the commands sent through the serial ports of all modems.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_manager_get_command_stats_finish() to get the result of the operation.
+ *
+ * See mm_manager_get_command_stats_sync() for the synchronous, blocking
+ * version of this method.
+ *
+ * Since: 1.26
+ */
+void
+mm_manager_get_command_stats (MMManager           *manager,
+                              GCancellable        *cancellable,
+                              GAsyncReadyCallback  callback,
+                              gpointer             user_data)
+{
+    GTask *task;
+    GError *inner_error = NULL;
+
+    g_return_if_fail (MM_IS_MANAGER (manager));
+
+    task = g_task_new (manager, cancellable, callback, user_data);
+
+    if (!ensure_modem_manager1_proxy (manager, &inner_error)) {
+        g_task_return_error (task, inner_error);
+        g_object_unref (task);
+        return;
+    }
+
+    mm_gdbus_org_freedesktop_modem_manager1_call_get_command_stats (
+        manager->priv->manager_iface_proxy,
+        cancellable,
+        (GAsyncReadyCallback)get_command_stats_ready,
+        task);
+}
+
+/**
+ * mm_manager_get_command_stats_sync:
+ * @manager: A #MMManager.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously requests the latency, error, timeout and retry statistics
+ * of the commands sent through the serial ports of all modems.
+ *
+ * The calling thread is blocked until a reply is received.
+ *
+ * See mm_manager_get_command_stats() for the asynchronous version of this
+ * method.
+ *
+ * Returns: (transfer full): A #GVariant of type "aa{sv}" with one dictionary
+ * per command type and port, or %NULL if @error is set. The returned value
+ * should be freed with g_variant_unref().
+ *
+ * Since: 1.26
+ */
+GVariant *
+mm_manager_get_command_stats_sync (MMManager     *manager,
+                                   GCancellable  *cancellable,
+                                   GError       **error)
+{
+    GVariant *stats = NULL;
+
+    g_return_val_if_fail (MM_IS_MANAGER (manager), NULL);
+
+    if (!ensure_modem_manager1_proxy (manager, error))
+        return NULL;
+
+    if (!mm_gdbus_org_freedesktop_modem_manager1_call_get_command_stats_sync (
+            manager->priv->manager_iface_proxy,
+            &stats,
+            cancellable,
+            error))
+        return NULL;
+
+    return stats;
+}
+
+/**
+ * mm_manager_get_memory_usage_finish:
+ * @manager: A #MMManager.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_manager_get_memory_usage().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_manager_get_memory_usage().
+ *
+ * Returns: (transfer full): A #GVariant of type "aa{sv}" with one dictionary
+ * per modem, or %NULL if @error is set. The returned value should be freed
+ * with g_variant_unref().
+ *
+ * Since: 1.26
+ */
+GVariant *
+mm_manager_get_memory_usage_finish (MMManager     *manager,
+                                    GAsyncResult  *res,
+                                    GError       **error)
+{
+    g_return_val_if_fail (MM_IS_MANAGER (manager), NULL);
+
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+get_memory_usage_ready (MmGdbusOrgFreedesktopModemManager1 *manager_iface_proxy,
+                        GAsyncResult                       *res,
+                        GTask                              *task)
+{
+    GError   *error = NULL;
+    GVariant *usage = NULL;
+
+    if (!mm_gdbus_org_freedesktop_modem_manager1_call_get_memory_usage_finish (
+            manager_iface_proxy,
+            &usage,
+            res,
+            &error))
+        g_task_return_error (task, error);
+    else
+        g_task_return_pointer (task, usage, (GDestroyNotify) g_variant_unref);
+
+    g_object_unref (task);
+}
+
+/**
+ * mm_manager_get_memory_usage:
+ * @manager: A #MMManager.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously requests the approximate memory allocated by each subsystem
+ * of all modems.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_manager_get_memory_usage_finish() to get the result of the operation.
+ *
+ * See mm_manager_get_memory_usage_sync() for the synchronous, blocking
+ * version of this method.
+ *
+ * Since: 1.26
+ */
+void
+mm_manager_get_memory_usage (MMManager           *manager,
+                             GCancellable        *cancellable,
+                             GAsyncReadyCallback  callback,
+                             gpointer             user_data)
+{
+    GTask *task;
+    GError *inner_error = NULL;
+
+    g_return_if_fail (MM_IS_MANAGER (manager));
+
+    task = g_task_new (manager, cancellable, callback, user_data);
+
+    if (!ensure_modem_manager1_proxy (manager, &inner_error)) {
+        g_task_return_error (task, inner_error);
+        g_object_unref (task);
+        return;
+    }
+
+    mm_gdbus_org_freedesktop_modem_manager1_call_get_memory_usage (
+        manager->priv->manager_iface_proxy,
+        cancellable,
+        (GAsyncReadyCallback)get_memory_usage_ready,
+        task);
+}
+
+/**
+ * mm_manager_get_memory_usage_sync:
+ * @manager: A #MMManager.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously requests the approximate memory allocated by each subsystem
+ * of all modems.
+ *
+ * The calling thread is blocked until a reply is received.
+ *
+ * See mm_manager_get_memory_usage() for the asynchronous version of this
+ * method.
+ *
+ * Returns: (transfer full): A #GVariant of type "aa{sv}" with one dictionary
+ * per modem, or %NULL if @error is set. The returned value should be freed
+ * with g_variant_unref().
+ *
+ * Since: 1.26
+ */
+GVariant *
+mm_manager_get_memory_usage_sync (MMManager     *manager,
+                                  GCancellable  *cancellable,
+                                  GError       **error)
+{
+    GVariant *usage = NULL;
+
+    g_return_val_if_fail (MM_IS_MANAGER (manager), NULL);
+
+    if (!ensure_modem_manager1_proxy (manager, error))
+        return NULL;
+
+    if (!mm_gdbus_org_freedesktop_modem_manager1_call_get_memory_usage_sync (
+            manager->priv->manager_iface_proxy,
+            &usage,
+            cancellable,
+            error))
+        return NULL;
+
+    return usage;
+}
+
+/*****************************************************************************/
+
 /**
  * mm_manager_report_kernel_event_finish:
  * @manager: A #MMManager.
@@ -151,6 +151,39 @@ gboolean mm_manager_uninhibit_device_sync   (MMManager           *manager,
                                              GCancellable        *cancellable,
                                              GError             **error);
 
+void      mm_manager_get_snapshot        (MMManager           *manager,
+                                          GCancellable        *cancellable,
+                                          GAsyncReadyCallback  callback,
+                                          gpointer             user_data);
+GVariant *mm_manager_get_snapshot_finish (MMManager           *manager,
+                                          GAsyncResult        *res,
+                                          GError             **error);
+GVariant *mm_manager_get_snapshot_sync   (MMManager           *manager,
+                                          GCancellable        *cancellable,
+                                          GError             **error);
+
+void      mm_manager_get_command_stats        (MMManager           *manager,
+                                               GCancellable        *cancellable,
+                                               GAsyncReadyCallback  callback,
+                                               gpointer             user_data);
+GVariant *mm_manager_get_command_stats_finish (MMManager           *manager,
+                                               GAsyncResult        *res,
+                                               GError             **error);
+GVariant *mm_manager_get_command_stats_sync   (MMManager           *manager,
+                                               GCancellable        *cancellable,
+                                               GError             **error);
+
+void      mm_manager_get_memory_usage        (MMManager           *manager,
+                                              GCancellable        *cancellable,
+                                              GAsyncReadyCallback  callback,
+                                              gpointer             user_data);
+GVariant *mm_manager_get_memory_usage_finish (MMManager           *manager,
+                                              GAsyncResult        *res,
+                                              GError             **error);
+GVariant *mm_manager_get_memory_usage_sync   (MMManager           *manager,
+                                              GCancellable        *cancellable,
+                                              GError             **error);
+
 G_END_DECLS
 
 #endif /* _MM_MANAGER_H_ */
@@ -345,6 +345,73 @@ mm_modem_signal_get_error_rate_threshold (MMModemSignal *self)
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_signal_get_rsrp_threshold:
+ * @self: A #MMModemSignal.
+ *
+ * Gets the currently configured RSRP threshold, in dB.
+ *
+ * A value of 0 indicates the threshold is disabled.
+ *
+ * Returns: the RSRP threshold.
+ *
+ * Since: 1.26
+ */
+guint
+mm_modem_signal_get_rsrp_threshold (MMModemSignal *self)
+{
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), 0);
+
+    return mm_gdbus_modem_signal_get_rsrp_threshold (MM_GDBUS_MODEM_SIGNAL (self));
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_modem_signal_get_snr_threshold:
+ * @self: A #MMModemSignal.
+ *
+ * Gets the currently configured SNR threshold, in dB.
+ *
+ * A value of 0 indicates the threshold is disabled.
+ *
+ * Returns: the SNR threshold.
+ *
+ * Since: 1.26
+ */
+guint
+mm_modem_signal_get_snr_threshold (MMModemSignal *self)
+{
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), 0);
+
+    return mm_gdbus_modem_signal_get_snr_threshold (MM_GDBUS_MODEM_SIGNAL (self));
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_modem_signal_get_threshold_max_interval:
+ * @self: A #MMModemSignal.
+ *
+ * Gets the maximum time, in seconds, that a signal quality report update may
+ * be held back by the configured thresholds.
+ *
+ * A value of 0 indicates there is no limit.
+ *
+ * Returns: the maximum interval.
+ *
+ * Since: 1.26
+ */
+guint
+mm_modem_signal_get_threshold_max_interval (MMModemSignal *self)
+{
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), 0);
+
+    return mm_gdbus_modem_signal_get_threshold_max_interval (MM_GDBUS_MODEM_SIGNAL (self));
+}
+
+/*****************************************************************************/
+
 /**
  * mm_modem_signal_get_cdma:
  * @self: A #MMModem.
@@ -72,6 +72,9 @@ gchar       *mm_modem_signal_dup_path                 (MMModemSignal *self);
 guint        mm_modem_signal_get_rate                 (MMModemSignal *self);
 guint        mm_modem_signal_get_rssi_threshold       (MMModemSignal *self);
 gboolean     mm_modem_signal_get_error_rate_threshold (MMModemSignal *self);
+guint        mm_modem_signal_get_rsrp_threshold       (MMModemSignal *self);
+guint        mm_modem_signal_get_snr_threshold        (MMModemSignal *self);
+guint        mm_modem_signal_get_threshold_max_interval (MMModemSignal *self);
 
 void     mm_modem_signal_setup                   (MMModemSignal                *self,
                                                   guint                         rate,
@@ -38,10 +38,23 @@
  *
  * When the modem is exposed and available in the bus, it is ensured that at
  * least this interface is also available.
+ *
+ * Values of complex properties (e.g. bands, ports, modes or unlock retries)
+ * are decoded only once after every change, and the peek() methods return
+ * the decoded values without any copy. Clients that want to know which
+ * properties changed in a given update may use the
+ * #MMModem::properties-updated signal.
  */
 
 G_DEFINE_TYPE (MMModem, mm_modem, MM_GDBUS_TYPE_MODEM_PROXY)
 
+enum {
+    SIGNAL_PROPERTIES_UPDATED,
+    SIGNAL_LAST
+};
+
+static guint signals[SIGNAL_LAST] = { 0 };
+
 struct _MMModemPrivate {
     /* Common mutex to sync access */
     GMutex mutex;
@@ -3462,6 +3475,112 @@ mm_modem_get_cell_info_sync (MMModem       *self,
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_setup_cell_info_finish:
+ * @self: A #MMModem.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_modem_setup_cell_info().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_setup_cell_info().
+ *
+ * Returns: %TRUE if the setup was successful, %FALSE if @error is set.
+ *
+ * Since: 1.26
+ */
+gboolean
+mm_modem_setup_cell_info_finish (MMModem       *self,
+                                 GAsyncResult  *res,
+                                 GError       **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM (self), FALSE);
+
+    return mm_gdbus_modem_call_setup_cell_info_finish (MM_GDBUS_MODEM (self), res, error);
+}
+
+/**
+ * mm_modem_setup_cell_info:
+ * @self: A #MMModem.
+ * @rate: Refresh rate, in milliseconds (at least 250), or 0 to disable.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously enables or disables the cell info monitoring. While
+ * enabled, the changes in the list of cells are reported in the
+ * #MmGdbusModem::cell-info-updated signal.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_modem_setup_cell_info_finish() to get the result of the operation.
+ *
+ * See mm_modem_setup_cell_info_sync() for the synchronous, blocking version of
+ * this method.
+ *
+ * Since: 1.26
+ */
+void
+mm_modem_setup_cell_info (MMModem             *self,
+                          guint                rate,
+                          GCancellable        *cancellable,
+                          GAsyncReadyCallback  callback,
+                          gpointer             user_data)
+{
+    g_return_if_fail (MM_IS_MODEM (self));
+
+    mm_gdbus_modem_call_setup_cell_info (MM_GDBUS_MODEM (self), rate, cancellable, callback, user_data);
+}
+
+/**
+ * mm_modem_setup_cell_info_sync:
+ * @self: A #MMModem.
+ * @rate: Refresh rate, in milliseconds (at least 250), or 0 to disable.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously enables or disables the cell info monitoring. While
+ * enabled, the changes in the list of cells are reported in the
+ * #MmGdbusModem::cell-info-updated signal.
+ *
+ * The calling thread is blocked until a reply is received. See
+ * mm_modem_setup_cell_info() for the asynchronous version of this method.
+ *
+ * Returns: %TRUE if the setup was successful, %FALSE if @error is set.
+ *
+ * Since: 1.26
+ */
+gboolean
+mm_modem_setup_cell_info_sync (MMModem       *self,
+                               guint          rate,
+                               GCancellable  *cancellable,
+                               GError       **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM (self), FALSE);
+
+    return mm_gdbus_modem_call_setup_cell_info_sync (MM_GDBUS_MODEM (self), rate, cancellable, error);
+}
+
+/*****************************************************************************/
+
+static void
+properties_changed (MMModem             *self,
+                    GVariant            *changed_properties,
+                    const gchar * const *invalidated_properties)
+{
+    g_auto(GStrv) names = NULL;
+
+    /* The decoded values of the changed properties were already flagged for
+     * refresh by the property notifications, which are emitted before this
+     * handler runs. */
+    names = mm_common_build_property_names_from_changes (changed_properties, invalidated_properties);
+    if (names[0])
+        g_signal_emit (self, signals[SIGNAL_PROPERTIES_UPDATED], 0, names);
+}
+
+/*****************************************************************************/
+
 static void
 mm_modem_init (MMModem *self)
 {
@@ -3475,6 +3594,11 @@ mm_modem_init (MMModem *self)
     PROPERTY_INITIALIZE (supported_bands,        "supported-bands")
     PROPERTY_INITIALIZE (current_bands,          "current-bands")
     PROPERTY_INITIALIZE (unlock_retries,         "unlock-retries")
+
+    g_signal_connect_after (self,
+                            "g-properties-changed",
+                            G_CALLBACK (properties_changed),
+                            NULL);
 }
 
 static void
@@ -3505,4 +3629,24 @@ mm_modem_class_init (MMModemClass *modem_class)
 
     /* Virtual methods */
     object_class->finalize = finalize;
+
+    /**
+     * MMModem::properties-updated:
+     * @self: the #MMModem.
+     * @properties: (array zero-terminated=1) (element-type utf8): the names of
+     *  the properties that changed, e.g. "current-bands".
+     *
+     * Emitted once for each set of property changes reported by the daemon,
+     * after all the per-property notifications. The getters and peekers
+     * return the new values when this signal is emitted.
+     *
+     * Since: 1.26
+     */
+    signals[SIGNAL_PROPERTIES_UPDATED] =
+        g_signal_new ("properties-updated",
+                      G_OBJECT_CLASS_TYPE (object_class),
+                      G_SIGNAL_RUN_LAST,
+                      0, NULL, NULL,
+                      g_cclosure_marshal_generic,
+                      G_TYPE_NONE, 1, G_TYPE_STRV);
 }
@@ -395,6 +395,19 @@ GList *mm_modem_get_cell_info_sync   (MMModem              *self,
                                       GCancellable         *cancellable,
                                       GError              **error);
 
+void     mm_modem_setup_cell_info        (MMModem              *self,
+                                          guint                 rate,
+                                          GCancellable         *cancellable,
+                                          GAsyncReadyCallback   callback,
+                                          gpointer              user_data);
+gboolean mm_modem_setup_cell_info_finish (MMModem              *self,
+                                          GAsyncResult         *res,
+                                          GError              **error);
+gboolean mm_modem_setup_cell_info_sync   (MMModem              *self,
+                                          guint                 rate,
+                                          GCancellable         *cancellable,
+                                          GError              **error);
+
 G_END_DECLS
 
 #endif /* _MM_MODEM_H_ */
@@ -43,12 +43,21 @@ G_DEFINE_TYPE (MMSignalThresholdProperties, mm_signal_threshold_properties, G_TY
 
 #define PROPERTY_RSSI_THRESHOLD       "rssi-threshold"
 #define PROPERTY_ERROR_RATE_THRESHOLD "error-rate-threshold"
+#define PROPERTY_RSRP_THRESHOLD       "rsrp-threshold"
+#define PROPERTY_SNR_THRESHOLD        "snr-threshold"
+#define PROPERTY_MAX_INTERVAL         "max-interval"
 
 struct _MMSignalThresholdPropertiesPrivate {
     guint    rssi_threshold;
     gboolean rssi_threshold_set;
     gboolean error_rate_threshold;
     gboolean error_rate_threshold_set;
+    guint    rsrp_threshold;
+    gboolean rsrp_threshold_set;
+    guint    snr_threshold;
+    gboolean snr_threshold_set;
+    guint    max_interval;
+    gboolean max_interval_set;
 };
 
 /*****************************************************************************/
@@ -131,6 +140,127 @@ mm_signal_threshold_properties_get_error_rate (MMSignalThresholdProperties *self
 
 /*****************************************************************************/
 
+/**
+ * mm_signal_threshold_properties_set_rsrp:
+ * @self: a #MMSignalThresholdProperties.
+ * @rsrp_threshold: the RSRP threshold, in dB, or 0 to disable.
+ *
+ * Sets the RSRP threshold, in dB.
+ *
+ * Since: 1.26
+ */
+void
+mm_signal_threshold_properties_set_rsrp (MMSignalThresholdProperties *self,
+                                        guint                        rsrp_threshold)
+{
+    g_return_if_fail (MM_IS_SIGNAL_THRESHOLD_PROPERTIES (self));
+
+    self->priv->rsrp_threshold = rsrp_threshold;
+    self->priv->rsrp_threshold_set = TRUE;
+}
+
+/**
+ * mm_signal_threshold_properties_get_rsrp:
+ * @self: a #MMSignalThresholdProperties.
+ *
+ * Gets the RSRP threshold, in dB.
+ *
+ * Returns: the RSRP threshold, or 0 if disabled.
+ *
+ * Since: 1.26
+ */
+guint
+mm_signal_threshold_properties_get_rsrp (MMSignalThresholdProperties *self)
+{
+    g_return_val_if_fail (MM_IS_SIGNAL_THRESHOLD_PROPERTIES (self), 0);
+
+    return self->priv->rsrp_threshold;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_signal_threshold_properties_set_snr:
+ * @self: a #MMSignalThresholdProperties.
+ * @snr_threshold: the SNR threshold, in dB, or 0 to disable.
+ *
+ * Sets the SNR threshold, in dB.
+ *
+ * The threshold applies both to SNR and SINR measurements.
+ *
+ * Since: 1.26
+ */
+void
+mm_signal_threshold_properties_set_snr (MMSignalThresholdProperties *self,
+                                       guint                        snr_threshold)
+{
+    g_return_if_fail (MM_IS_SIGNAL_THRESHOLD_PROPERTIES (self));
+
+    self->priv->snr_threshold = snr_threshold;
+    self->priv->snr_threshold_set = TRUE;
+}
+
+/**
+ * mm_signal_threshold_properties_get_snr:
+ * @self: a #MMSignalThresholdProperties.
+ *
+ * Gets the SNR threshold, in dB.
+ *
+ * Returns: the SNR threshold, or 0 if disabled.
+ *
+ * Since: 1.26
+ */
+guint
+mm_signal_threshold_properties_get_snr (MMSignalThresholdProperties *self)
+{
+    g_return_val_if_fail (MM_IS_SIGNAL_THRESHOLD_PROPERTIES (self), 0);
+
+    return self->priv->snr_threshold;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_signal_threshold_properties_set_max_interval:
+ * @self: a #MMSignalThresholdProperties.
+ * @max_interval: the maximum interval, in seconds, or 0 to disable.
+ *
+ * Sets the maximum time, in seconds, that signal quality updates may be
+ * held back by the configured thresholds.
+ *
+ * Since: 1.26
+ */
+void
+mm_signal_threshold_properties_set_max_interval (MMSignalThresholdProperties *self,
+                                                 guint                        max_interval)
+{
+    g_return_if_fail (MM_IS_SIGNAL_THRESHOLD_PROPERTIES (self));
+
+    self->priv->max_interval = max_interval;
+    self->priv->max_interval_set = TRUE;
+}
+
+/**
+ * mm_signal_threshold_properties_get_max_interval:
+ * @self: a #MMSignalThresholdProperties.
+ *
+ * Gets the maximum time, in seconds, that signal quality updates may be
+ * held back by the configured thresholds.
+ *
+ * Returns: the maximum interval, or 0 if disabled.
+ *
+ * Since: 1.26
+ */
+guint
+mm_signal_threshold_properties_get_max_interval (MMSignalThresholdProperties *self)
+{
+    g_return_val_if_fail (MM_IS_SIGNAL_THRESHOLD_PROPERTIES (self), 0);
+
+    return self->priv->max_interval;
+}
+
+/*****************************************************************************/
+
 /**
  * mm_signal_threshold_properties_get_dictionary: (skip)
  */
@@ -159,6 +289,24 @@ mm_signal_threshold_properties_get_dictionary (MMSignalThresholdProperties *self
                                PROPERTY_ERROR_RATE_THRESHOLD,
                                g_variant_new_boolean (self->priv->error_rate_threshold));
 
+    if (self->priv->rsrp_threshold_set)
+        g_variant_builder_add (&builder,
+                               "{sv}",
+                               PROPERTY_RSRP_THRESHOLD,
+                               g_variant_new_uint32 (self->priv->rsrp_threshold));
+
+    if (self->priv->snr_threshold_set)
+        g_variant_builder_add (&builder,
+                               "{sv}",
+                               PROPERTY_SNR_THRESHOLD,
+                               g_variant_new_uint32 (self->priv->snr_threshold));
+
+    if (self->priv->max_interval_set)
+        g_variant_builder_add (&builder,
+                               "{sv}",
+                               PROPERTY_MAX_INTERVAL,
+                               g_variant_new_uint32 (self->priv->max_interval));
+
     return g_variant_ref_sink (g_variant_builder_end (&builder));
 }
 
@@ -198,6 +346,42 @@ key_value_foreach (const gchar          *key,
         return TRUE;
     }
 
+    if (g_str_equal (key, PROPERTY_RSRP_THRESHOLD)) {
+        guint rsrp_threshold;
+
+        if (!mm_get_uint_from_str (value, &rsrp_threshold)) {
+            g_set_error (&ctx->error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "invalid RSRP threshold value given: %s", value);
+            return FALSE;
+        }
+        mm_signal_threshold_properties_set_rsrp (ctx->properties, rsrp_threshold);
+        return TRUE;
+    }
+
+    if (g_str_equal (key, PROPERTY_SNR_THRESHOLD)) {
+        guint snr_threshold;
+
+        if (!mm_get_uint_from_str (value, &snr_threshold)) {
+            g_set_error (&ctx->error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "invalid SNR threshold value given: %s", value);
+            return FALSE;
+        }
+        mm_signal_threshold_properties_set_snr (ctx->properties, snr_threshold);
+        return TRUE;
+    }
+
+    if (g_str_equal (key, PROPERTY_MAX_INTERVAL)) {
+        guint max_interval;
+
+        if (!mm_get_uint_from_str (value, &max_interval)) {
+            g_set_error (&ctx->error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "invalid maximum interval value given: %s", value);
+            return FALSE;
+        }
+        mm_signal_threshold_properties_set_max_interval (ctx->properties, max_interval);
+        return TRUE;
+    }
+
     g_set_error (&ctx->error, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
                  "Invalid properties string, unsupported key '%s'", key);
     return FALSE;
@@ -240,6 +424,12 @@ consume_variant (MMSignalThresholdProperties  *self,
         mm_signal_threshold_properties_set_rssi (self, g_variant_get_uint32 (value));
     else if (g_str_equal (key, PROPERTY_ERROR_RATE_THRESHOLD))
         mm_signal_threshold_properties_set_error_rate (self, g_variant_get_boolean (value));
+    else if (g_str_equal (key, PROPERTY_RSRP_THRESHOLD))
+        mm_signal_threshold_properties_set_rsrp (self, g_variant_get_uint32 (value));
+    else if (g_str_equal (key, PROPERTY_SNR_THRESHOLD))
+        mm_signal_threshold_properties_set_snr (self, g_variant_get_uint32 (value));
+    else if (g_str_equal (key, PROPERTY_MAX_INTERVAL))
+        mm_signal_threshold_properties_set_max_interval (self, g_variant_get_uint32 (value));
     else {
         /* Set error */
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
@@ -73,6 +73,16 @@ void     mm_signal_threshold_properties_set_error_rate (MMSignalThresholdPropert
 guint    mm_signal_threshold_properties_get_rssi       (MMSignalThresholdProperties *self);
 gboolean mm_signal_threshold_properties_get_error_rate (MMSignalThresholdProperties *self);
 
+void     mm_signal_threshold_properties_set_rsrp         (MMSignalThresholdProperties *self,
+                                                          guint                        rsrp_threshold);
+void     mm_signal_threshold_properties_set_snr          (MMSignalThresholdProperties *self,
+                                                          guint                        snr_threshold);
+void     mm_signal_threshold_properties_set_max_interval (MMSignalThresholdProperties *self,
+                                                          guint                        max_interval);
+guint    mm_signal_threshold_properties_get_rsrp         (MMSignalThresholdProperties *self);
+guint    mm_signal_threshold_properties_get_snr          (MMSignalThresholdProperties *self);
+guint    mm_signal_threshold_properties_get_max_interval (MMSignalThresholdProperties *self);
+
 /*****************************************************************************/
 /* ModemManager/libmm-glib/mmcli specific methods */
 
@@ -1361,6 +1361,32 @@ cell_broadcast_channels_from_string (void)
 
 /**************************************************************/
 
+static void
+property_names_from_changes (void)
+{
+    g_autoptr(GVariant) changed = NULL;
+    g_auto(GStrv)       names = NULL;
+    GVariantBuilder     builder;
+    const gchar        *invalidated[] = { "UnlockRetries", NULL };
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+    g_variant_builder_add (&builder, "{sv}", "State", g_variant_new_int32 (8));
+    g_variant_builder_add (&builder, "{sv}", "SupportedIpFamilies", g_variant_new_uint32 (7));
+    changed = g_variant_ref_sink (g_variant_builder_end (&builder));
+
+    names = mm_common_build_property_names_from_changes (changed, invalidated);
+    g_assert_cmpuint (g_strv_length (names), ==, 3);
+    g_assert_cmpstr (names[0], ==, "state");
+    g_assert_cmpstr (names[1], ==, "supported-ip-families");
+    g_assert_cmpstr (names[2], ==, "unlock-retries");
+    g_clear_pointer (&names, g_strfreev);
+
+    names = mm_common_build_property_names_from_changes (NULL, NULL);
+    g_assert_cmpuint (g_strv_length (names), ==, 0);
+}
+
+/**************************************************************/
+
 int main (int argc, char **argv)
 {
     g_test_init (&argc, &argv, NULL);
@@ -1441,5 +1467,7 @@ int main (int argc, char **argv)
     g_test_add_func ("/MM/Common/StrConvFrom/profile_source",            profile_source_from_string);
     g_test_add_func ("/MM/Common/StrConvFrom/cb_channels",               cell_broadcast_channels_from_string);
 
+    g_test_add_func ("/MM/Common/PropertyNames/from-changes", property_names_from_changes);
+
     return g_test_run ();
 }
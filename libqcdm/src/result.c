@@ -21,10 +21,15 @@
 #include "result.h"
 #include "result-private.h"
 #include "errors.h"
+#include "utils.h"
 
 /*********************************************************/
 
-typedef struct Val Val;
+/* All the data of a result lives in a single arena: the result structure
+ * itself embeds the field table, its hash index and a first arena block for
+ * keys, strings and arrays, so that decoding a typical response needs a
+ * single allocation. Fields are found through an open-addressing hash index
+ * on the key, and values never move once added. */
 
 typedef enum {
     VAL_TYPE_NONE = 0,
@@ -35,161 +40,213 @@ typedef enum {
     VAL_TYPE_U16_ARRAY = 5,
 } ValType;
 
-struct Val {
-    char *key;
+typedef struct {
+    const char *key;
+    uint32_t hash;
     uint8_t type;
     union {
-        char *s;
+        const char *s;
         uint8_t u8;
         uint32_t u32;
-        uint8_t *u8_array;
-        uint16_t *u16_array;
+        const uint8_t *u8_array;
+        const uint16_t *u16_array;
     } u;
     uint32_t array_len;
-    Val *next;
+} Field;
+
+/* Additional arena blocks, once the embedded one is full */
+typedef struct Block Block;
+struct Block {
+    Block *next;
+    uint64_t data[];
 };
 
-static void
-val_free (Val *v)
+#define INLINE_FIELDS     16
+#define INLINE_ARENA_SIZE 512
+#define MIN_BLOCK_SIZE    1024
+
+#define ALIGN8(n) (((n) + 7) & ~((size_t) 7))
+
+struct QcdmResult {
+    uint32_t refcount;
+
+    Field *fields;
+    uint32_t n_fields;
+    uint32_t fields_size;
+    /* Field number + 1 for each slot, 0 if empty; twice the fields size */
+    uint16_t *index;
+
+    uint8_t *arena_pos;
+    uint8_t *arena_end;
+    Block *blocks;
+
+    Field inline_fields[INLINE_FIELDS];
+    uint16_t inline_index[2 * INLINE_FIELDS];
+    uint64_t inline_arena[INLINE_ARENA_SIZE / 8];
+};
+
+static uint32_t
+key_hash (const char *key)
 {
-    if (v->type == VAL_TYPE_STRING) {
-        free (v->u.s);
-    } else if (v->type == VAL_TYPE_U8_ARRAY) {
-        free (v->u.u8_array);
-    } else if (v->type == VAL_TYPE_U16_ARRAY) {
-        free (v->u.u16_array);
+    uint32_t h = 2166136261u;
+
+    /* FNV-1a */
+    while (*key) {
+        h ^= (uint8_t) *key++;
+        h *= 16777619u;
     }
-    free (v->key);
-    memset (v, 0, sizeof (*v));
-    free (v);
+    return h;
 }
 
-static Val *
-val_new_string (const char *key, const char *value)
+static void *
+arena_alloc (QcdmResult *r, size_t len)
 {
-    Val *v;
+    void *p;
+
+    len = ALIGN8 (len);
+    if ((size_t) (r->arena_end - r->arena_pos) < len) {
+        Block *b;
+        size_t size;
+
+        size = len > MIN_BLOCK_SIZE ? len : MIN_BLOCK_SIZE;
+        b = malloc (sizeof (Block) + size);
+        if (b == NULL)
+            return NULL;
+        b->next = r->blocks;
+        r->blocks = b;
+        r->arena_pos = (uint8_t *) b->data;
+        r->arena_end = r->arena_pos + size;
+    }
 
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
-    qcdm_return_val_if_fail (value != NULL, NULL);
+    p = r->arena_pos;
+    r->arena_pos += len;
+    return p;
+}
 
-    v = calloc (1, sizeof (Val));
-    if (v == NULL)
-        return NULL;
+static void *
+arena_dup (QcdmResult *r, const void *data, size_t len)
+{
+    void *p;
 
-    v->key = strdup (key);
-    v->type = VAL_TYPE_STRING;
-    v->u.s = strdup (value);
-    return v;
+    p = arena_alloc (r, len);
+    if (p)
+        memcpy (p, data, len);
+    return p;
 }
 
-static Val *
-val_new_u8 (const char *key, uint8_t u)
+/* Returns the index slot holding the key, or the empty slot where it would go */
+static uint32_t
+find_slot (QcdmResult *r, const char *key, uint32_t hash)
 {
-    Val *v;
+    uint32_t mask = 2 * r->fields_size - 1;
+    uint32_t i;
 
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
+    for (i = hash & mask; r->index[i]; i = (i + 1) & mask) {
+        const Field *f = &r->fields[r->index[i] - 1];
 
-    v = calloc (1, sizeof (Val));
-    if (v == NULL)
-        return NULL;
-
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U8;
-    v->u.u8 = u;
-    return v;
+        if (f->hash == hash && strcmp (f->key, key) == 0)
+            break;
+    }
+    return i;
 }
 
-static Val *
-val_new_u8_array (const char *key, const uint8_t *array, size_t array_len)
+static qcdmbool
+grow_fields (QcdmResult *r)
 {
-    Val *v;
-
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
-    qcdm_return_val_if_fail (array != NULL, NULL);
-    qcdm_return_val_if_fail (array_len > 0, NULL);
-
-    v = calloc (1, sizeof (Val));
-    if (v == NULL)
-        return NULL;
+    Field *fields;
+    uint16_t *index;
+    uint32_t size, i;
+
+    size = 2 * r->fields_size;
+    qcdm_return_val_if_fail (size <= 0x8000, FALSE);
+
+    fields = malloc (size * sizeof (Field));
+    index = calloc (2 * size, sizeof (uint16_t));
+    if (fields == NULL || index == NULL) {
+        free (fields);
+        free (index);
+        return FALSE;
+    }
+    memcpy (fields, r->fields, r->n_fields * sizeof (Field));
 
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U8_ARRAY;
-    v->u.u8_array = malloc (array_len);
-    if (v->u.u8_array == NULL) {
-        val_free (v);
-        return NULL;
+    if (r->fields != r->inline_fields) {
+        free (r->fields);
+        free (r->index);
     }
-    memcpy (v->u.u8_array, array, array_len);
-    v->array_len = array_len;
+    r->fields = fields;
+    r->fields_size = size;
+    r->index = index;
 
-    return v;
+    for (i = 0; i < r->n_fields; i++)
+        r->index[find_slot (r, fields[i].key, fields[i].hash)] = i + 1;
+    return TRUE;
 }
 
-static Val *
-val_new_u32 (const char *key, uint32_t u)
+/* Returns the field for the key, a new one if not found; any previous value
+ * of the key is replaced */
+static Field *
+add_field (QcdmResult *r, const char *key, ValType type)
 {
-    Val *v;
+    uint32_t hash, slot;
+    Field *f;
+
+    hash = key_hash (key);
+    slot = find_slot (r, key, hash);
+    if (r->index[slot]) {
+        f = &r->fields[r->index[slot] - 1];
+        f->type = type;
+        return f;
+    }
 
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
+    if (r->n_fields == r->fields_size) {
+        if (!grow_fields (r))
+            return NULL;
+        slot = find_slot (r, key, hash);
+    }
 
-    v = calloc (1, sizeof (Val));
-    if (v == NULL)
+    f = &r->fields[r->n_fields];
+    f->key = arena_dup (r, key, strlen (key) + 1);
+    if (f->key == NULL)
         return NULL;
-
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U32;
-    v->u.u32 = u;
-    return v;
+    f->hash = hash;
+    f->type = type;
+    f->array_len = 0;
+    r->index[slot] = ++r->n_fields;
+    return f;
 }
 
-static Val *
-val_new_u16_array (const char *key, const uint16_t *array, size_t array_len)
+static const Field *
+find_field (QcdmResult *r, const char *key, ValType expected_type)
 {
-    Val *v;
-    size_t sz;
-
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
-    qcdm_return_val_if_fail (array != NULL, NULL);
-    qcdm_return_val_if_fail (array_len > 0, NULL);
+    uint32_t slot;
+    const Field *f;
 
-    v = calloc (1, sizeof (Val));
-    if (v == NULL)
+    slot = find_slot (r, key, key_hash (key));
+    if (!r->index[slot])
         return NULL;
 
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U16_ARRAY;
-    sz = sizeof (uint16_t) * array_len;
-    v->u.u16_array = malloc (sz);
-    if (v->u.u16_array == NULL) {
-        val_free (v);
-        return NULL;
-    }
-    memcpy (v->u.u16_array, array, sz);
-    v->array_len = array_len;
-
-    return v;
+    f = &r->fields[r->index[slot] - 1];
+    /* Check type */
+    qcdm_return_val_if_fail (f->type == expected_type, NULL);
+    return f;
 }
 
 /*********************************************************/
 
-struct QcdmResult {
-    uint32_t refcount;
-    Val *first;
-};
-
 QcdmResult *
 qcdm_result_new (void)
 {
     QcdmResult *r;
 
     r = calloc (1, sizeof (QcdmResult));
-    if (r)
+    if (r) {
         r->refcount = 1;
+        r->fields = r->inline_fields;
+        r->fields_size = INLINE_FIELDS;
+        r->index = r->inline_index;
+        r->arena_pos = (uint8_t *) r->inline_arena;
+        r->arena_end = r->arena_pos + sizeof (r->inline_arena);
+    }
     return r;
 }
 
@@ -206,13 +263,17 @@ qcdm_result_ref (QcdmResult *r)
 static void
 qcdm_result_free (QcdmResult *r)
 {
-    Val *v, *n;
+    Block *b, *n;
 
-    v = r->first;
-    while (v) {
-        n = v->next;
-        val_free (v);
-        v = n;
+    b = r->blocks;
+    while (b) {
+        n = b->next;
+        free (b);
+        b = n;
+    }
+    if (r->fields != r->inline_fields) {
+        free (r->fields);
+        free (r->index);
     }
     memset (r, 0, sizeof (*r));
     free (r);
@@ -229,40 +290,25 @@ qcdm_result_unref (QcdmResult *r)
         qcdm_result_free (r);
 }
 
-static Val *
-find_val (QcdmResult *r, const char *key, ValType expected_type)
-{
-    Val *v, *n;
-
-    v = r->first;
-    while (v) {
-        n = v->next;
-        if (strcmp (v->key, key) == 0) {
-            /* Check type */
-            qcdm_return_val_if_fail (v->type == expected_type, NULL);
-            return v;
-        }
-        v = n;
-    }
-    return NULL;
-}
-
 void
 qcdm_result_add_string (QcdmResult *r,
                        const char *key,
                        const char *str)
 {
-    Val *v;
+    Field *f;
+    const char *s;
 
     qcdm_return_if_fail (r != NULL);
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
+    qcdm_return_if_fail (key[0] != '\0');
     qcdm_return_if_fail (str != NULL);
 
-    v = val_new_string (key, str);
-    qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    s = arena_dup (r, str, strlen (str) + 1);
+    qcdm_return_if_fail (s != NULL);
+    f = add_field (r, key, VAL_TYPE_STRING);
+    qcdm_return_if_fail (f != NULL);
+    f->u.s = s;
 }
 
 int
@@ -270,7 +316,7 @@ qcdm_result_get_string (QcdmResult *r,
                        const char *key,
                        const char **out_val)
 {
-    Val *v;
+    const Field *f;
 
     qcdm_return_val_if_fail (r != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (r->refcount > 0, -QCDM_ERROR_INVALID_ARGUMENTS);
@@ -278,11 +324,11 @@ qcdm_result_get_string (QcdmResult *r,
     qcdm_return_val_if_fail (out_val != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (*out_val == NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
 
-    v = find_val (r, key, VAL_TYPE_STRING);
-    if (v == NULL)
+    f = find_field (r, key, VAL_TYPE_STRING);
+    if (f == NULL)
         return -QCDM_ERROR_VALUE_NOT_FOUND;
 
-    *out_val = v->u.s;
+    *out_val = f->u.s;
     return 0;
 }
 
@@ -291,16 +337,16 @@ qcdm_result_add_u8 (QcdmResult *r,
                    const char *key,
                    uint8_t num)
 {
-    Val *v;
+    Field *f;
 
     qcdm_return_if_fail (r != NULL);
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
+    qcdm_return_if_fail (key[0] != '\0');
 
-    v = val_new_u8 (key, num);
-    qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    f = add_field (r, key, VAL_TYPE_U8);
+    qcdm_return_if_fail (f != NULL);
+    f->u.u8 = num;
 }
 
 int
@@ -308,18 +354,18 @@ qcdm_result_get_u8  (QcdmResult *r,
                     const char *key,
                     uint8_t *out_val)
 {
-    Val *v;
+    const Field *f;
 
     qcdm_return_val_if_fail (r != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (r->refcount > 0, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (key != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (out_val != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
 
-    v = find_val (r, key, VAL_TYPE_U8);
-    if (v == NULL)
+    f = find_field (r, key, VAL_TYPE_U8);
+    if (f == NULL)
         return -QCDM_ERROR_VALUE_NOT_FOUND;
 
-    *out_val = v->u.u8;
+    *out_val = f->u.u8;
     return 0;
 }
 
@@ -329,17 +375,22 @@ qcdm_result_add_u8_array (QcdmResult *r,
                           const uint8_t *array,
                           size_t array_len)
 {
-    Val *v;
+    Field *f;
+    const uint8_t *a;
 
     qcdm_return_if_fail (r != NULL);
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
+    qcdm_return_if_fail (key[0] != '\0');
     qcdm_return_if_fail (array != NULL);
-
-    v = val_new_u8_array (key, array, array_len);
-    qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    qcdm_return_if_fail (array_len > 0);
+
+    a = arena_dup (r, array, array_len);
+    qcdm_return_if_fail (a != NULL);
+    f = add_field (r, key, VAL_TYPE_U8_ARRAY);
+    qcdm_return_if_fail (f != NULL);
+    f->u.u8_array = a;
+    f->array_len = array_len;
 }
 
 int
@@ -348,7 +399,7 @@ qcdm_result_get_u8_array (QcdmResult *r,
                           const uint8_t **out_val,
                           size_t *out_len)
 {
-    Val *v;
+    const Field *f;
 
     qcdm_return_val_if_fail (r != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (r->refcount > 0, -QCDM_ERROR_INVALID_ARGUMENTS);
@@ -356,12 +407,12 @@ qcdm_result_get_u8_array (QcdmResult *r,
     qcdm_return_val_if_fail (out_val != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (out_len != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
 
-    v = find_val (r, key, VAL_TYPE_U8_ARRAY);
-    if (v == NULL)
+    f = find_field (r, key, VAL_TYPE_U8_ARRAY);
+    if (f == NULL)
         return -QCDM_ERROR_VALUE_NOT_FOUND;
 
-    *out_val = v->u.u8_array;
-    *out_len = v->array_len;
+    *out_val = f->u.u8_array;
+    *out_len = f->array_len;
     return 0;
 }
 
@@ -370,16 +421,16 @@ qcdm_result_add_u32 (QcdmResult *r,
                     const char *key,
                     uint32_t num)
 {
-    Val *v;
+    Field *f;
 
     qcdm_return_if_fail (r != NULL);
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
+    qcdm_return_if_fail (key[0] != '\0');
 
-    v = val_new_u32 (key, num);
-    qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    f = add_field (r, key, VAL_TYPE_U32);
+    qcdm_return_if_fail (f != NULL);
+    f->u.u32 = num;
 }
 
 int
@@ -387,18 +438,18 @@ qcdm_result_get_u32 (QcdmResult *r,
                     const char *key,
                     uint32_t *out_val)
 {
-    Val *v;
+    const Field *f;
 
     qcdm_return_val_if_fail (r != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (r->refcount > 0, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (key != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (out_val != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
 
-    v = find_val (r, key, VAL_TYPE_U32);
-    if (v == NULL)
+    f = find_field (r, key, VAL_TYPE_U32);
+    if (f == NULL)
         return -QCDM_ERROR_VALUE_NOT_FOUND;
 
-    *out_val = v->u.u32;
+    *out_val = f->u.u32;
     return 0;
 }
 
@@ -408,17 +459,22 @@ qcdm_result_add_u16_array (QcdmResult *r,
                            const uint16_t *array,
                            size_t array_len)
 {
-    Val *v;
+    Field *f;
+    const uint16_t *a;
 
     qcdm_return_if_fail (r != NULL);
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
+    qcdm_return_if_fail (key[0] != '\0');
     qcdm_return_if_fail (array != NULL);
-
-    v = val_new_u16_array (key, array, array_len);
-    qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    qcdm_return_if_fail (array_len > 0);
+
+    a = arena_dup (r, array, sizeof (uint16_t) * array_len);
+    qcdm_return_if_fail (a != NULL);
+    f = add_field (r, key, VAL_TYPE_U16_ARRAY);
+    qcdm_return_if_fail (f != NULL);
+    f->u.u16_array = a;
+    f->array_len = array_len;
 }
 
 int
@@ -427,7 +483,7 @@ qcdm_result_get_u16_array (QcdmResult *r,
                            const uint16_t **out_val,
                            size_t *out_len)
 {
-    Val *v;
+    const Field *f;
 
     qcdm_return_val_if_fail (r != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (r->refcount > 0, -QCDM_ERROR_INVALID_ARGUMENTS);
@@ -435,11 +491,11 @@ qcdm_result_get_u16_array (QcdmResult *r,
     qcdm_return_val_if_fail (out_val != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (out_len != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
 
-    v = find_val (r, key, VAL_TYPE_U16_ARRAY);
-    if (v == NULL)
+    f = find_field (r, key, VAL_TYPE_U16_ARRAY);
+    if (f == NULL)
         return -QCDM_ERROR_VALUE_NOT_FOUND;
 
-    *out_val = v->u.u16_array;
-    *out_len = v->array_len;
+    *out_val = f->u.u16_array;
+    *out_len = f->array_len;
     return 0;
 }
@@ -0,0 +1,358 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * Copyright (C) 2026 ModemManager contributors
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of version 2 of the GNU General Public
+ * License as published by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <endian.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "stream.h"
+#include "errors.h"
+
+#define DIAG_ESC_CHAR 0x7D
+#define DIAG_ESC_MASK 0x20
+
+/**********************************************************************/
+
+struct QcdmStream {
+    /* Unescaped contents of the frame being received, CRC included */
+    char *frame;
+    size_t frame_len;
+    qcdmbool escaping;
+    /* Frame too long, skip until the next control character */
+    qcdmbool overflow;
+
+    uint64_t frames;
+    uint64_t crc_errors;
+    uint64_t dropped;
+};
+
+#define FRAME_BUFFER_LEN (QCDM_STREAM_MAX_FRAME_LEN + 2)
+
+QcdmStream *
+qcdm_stream_new (void)
+{
+    QcdmStream *stream;
+
+    stream = calloc (1, sizeof (QcdmStream));
+    if (!stream)
+        return NULL;
+
+    stream->frame = malloc (FRAME_BUFFER_LEN);
+    if (!stream->frame) {
+        free (stream);
+        return NULL;
+    }
+    return stream;
+}
+
+void
+qcdm_stream_free (QcdmStream *stream)
+{
+    qcdm_return_if_fail (stream != NULL);
+
+    free (stream->frame);
+    free (stream);
+}
+
+void
+qcdm_stream_reset (QcdmStream *stream)
+{
+    qcdm_return_if_fail (stream != NULL);
+
+    stream->frame_len = 0;
+    stream->escaping = FALSE;
+    stream->overflow = FALSE;
+}
+
+/* Unescapes a chunk of frame data not containing any control character */
+static void
+stream_append (QcdmStream *stream, const char *src, size_t len)
+{
+    const char *end = src + len;
+
+    while (src < end && !stream->overflow) {
+        const char *esc;
+        size_t run;
+
+        if (stream->escaping) {
+            if (stream->frame_len == FRAME_BUFFER_LEN) {
+                stream->overflow = TRUE;
+                break;
+            }
+            stream->frame[stream->frame_len++] = *src++ ^ DIAG_ESC_MASK;
+            stream->escaping = FALSE;
+            continue;
+        }
+
+        esc = memchr (src, DIAG_ESC_CHAR, end - src);
+        run = (esc ? esc : end) - src;
+        if (run > FRAME_BUFFER_LEN - stream->frame_len) {
+            stream->overflow = TRUE;
+            break;
+        }
+        memcpy (&stream->frame[stream->frame_len], src, run);
+        stream->frame_len += run;
+        src += run;
+        if (esc) {
+            stream->escaping = TRUE;
+            src++;
+        }
+    }
+}
+
+/* Called when the control character ending a frame is found */
+static qcdmbool
+stream_finish_frame (QcdmStream *stream,
+                     QcdmStreamFrameFn frame_fn,
+                     void *user_data)
+{
+    qcdmbool reported = FALSE;
+    uint16_t crc, pkt_crc;
+
+    /* Back-to-back control characters (e.g. an opening flag) are not frames */
+    if (!stream->frame_len && !stream->escaping && !stream->overflow)
+        goto out;
+
+    /* Too long, escape without escaped byte, or too short for data and CRC */
+    if (stream->overflow || stream->escaping || stream->frame_len < 3) {
+        qcdm_dbg (0, "dropping malformed DM frame (%zu bytes)", stream->frame_len);
+        stream->dropped++;
+        goto out;
+    }
+
+    crc = dm_crc16 (stream->frame, stream->frame_len - 2);
+    pkt_crc = stream->frame[stream->frame_len - 2] & 0xFF;
+    pkt_crc |= (stream->frame[stream->frame_len - 1] & 0xFF) << 8;
+    if (crc != pkt_crc) {
+        qcdm_dbg (0, "dropping DM frame with invalid CRC (%zu bytes)", stream->frame_len);
+        stream->crc_errors++;
+        goto out;
+    }
+
+    stream->frames++;
+    if (frame_fn)
+        frame_fn (stream->frame, stream->frame_len - 2, user_data);
+    reported = TRUE;
+
+out:
+    qcdm_stream_reset (stream);
+    return reported;
+}
+
+size_t
+qcdm_stream_feed (QcdmStream *stream,
+                  const char *buf,
+                  size_t len,
+                  QcdmStreamFrameFn frame_fn,
+                  void *user_data)
+{
+    const char *src = buf;
+    const char *end = buf + len;
+    size_t n_frames = 0;
+
+    qcdm_return_val_if_fail (stream != NULL, 0);
+    qcdm_return_val_if_fail (buf != NULL || len == 0, 0);
+
+    while (src < end) {
+        const char *control;
+
+        control = memchr (src, DIAG_CONTROL_CHAR, end - src);
+        stream_append (stream, src, (control ? control : end) - src);
+        if (!control)
+            break;
+
+        if (stream_finish_frame (stream, frame_fn, user_data))
+            n_frames++;
+        src = control + 1;
+    }
+
+    return n_frames;
+}
+
+uint64_t
+qcdm_stream_get_frames (QcdmStream *stream)
+{
+    qcdm_return_val_if_fail (stream != NULL, 0);
+    return stream->frames;
+}
+
+uint64_t
+qcdm_stream_get_crc_errors (QcdmStream *stream)
+{
+    qcdm_return_val_if_fail (stream != NULL, 0);
+    return stream->crc_errors;
+}
+
+uint64_t
+qcdm_stream_get_dropped (QcdmStream *stream)
+{
+    qcdm_return_val_if_fail (stream != NULL, 0);
+    return stream->dropped;
+}
+
+/**********************************************************************/
+
+typedef struct {
+    char     magic[8];
+    uint32_t header_size;
+    uint32_t reserved;
+    uint64_t data_size;
+    uint64_t write_offset;
+    uint64_t wraps;
+    uint64_t records;
+} LogFileHeader;
+
+typedef struct {
+    uint32_t len;
+    uint32_t reserved;
+    uint64_t timestamp;
+} LogFileRecord;
+
+#define ALIGN8(n) (((n) + 7) & ~((size_t) 7))
+
+struct QcdmLogFile {
+    int fd;
+    uint8_t *map;
+    size_t map_size;
+    LogFileHeader *header;
+    uint8_t *data;
+    size_t data_size;
+    size_t offset;
+    uint64_t wraps;
+    uint64_t records;
+};
+
+QcdmLogFile *
+qcdm_log_file_open (const char *path, size_t size)
+{
+    QcdmLogFile *file;
+    int saved_errno;
+
+    qcdm_return_val_if_fail (path != NULL, NULL);
+
+    if (size < sizeof (LogFileHeader) + 2 * sizeof (LogFileRecord)) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    file = calloc (1, sizeof (QcdmLogFile));
+    if (!file)
+        return NULL;
+
+    file->fd = open (path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (file->fd < 0)
+        goto error;
+
+    if (ftruncate (file->fd, size) < 0)
+        goto error;
+
+    file->map = mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+    if (file->map == MAP_FAILED) {
+        file->map = NULL;
+        goto error;
+    }
+    file->map_size = size;
+
+    file->header = (LogFileHeader *) file->map;
+    file->data = file->map + sizeof (LogFileHeader);
+    file->data_size = (size - sizeof (LogFileHeader)) & ~((size_t) 7);
+
+    memcpy (file->header->magic, QCDM_LOG_FILE_MAGIC, sizeof (file->header->magic));
+    file->header->header_size = htole32 (sizeof (LogFileHeader));
+    file->header->data_size = htole64 (file->data_size);
+    return file;
+
+error:
+    saved_errno = errno;
+    if (file->fd >= 0)
+        close (file->fd);
+    free (file);
+    errno = saved_errno;
+    return NULL;
+}
+
+void
+qcdm_log_file_close (QcdmLogFile *file)
+{
+    qcdm_return_if_fail (file != NULL);
+
+    msync (file->map, file->map_size, MS_SYNC);
+    munmap (file->map, file->map_size);
+    close (file->fd);
+    free (file);
+}
+
+qcdmbool
+qcdm_log_file_append (QcdmLogFile *file,
+                      const char *buf,
+                      size_t len,
+                      uint64_t timestamp)
+{
+    LogFileRecord *record;
+    size_t record_size;
+
+    qcdm_return_val_if_fail (file != NULL, FALSE);
+    qcdm_return_val_if_fail (buf != NULL, FALSE);
+
+    record_size = sizeof (LogFileRecord) + ALIGN8 (len);
+    if (len >= QCDM_LOG_FILE_RECORD_WRAP || record_size > file->data_size)
+        return FALSE;
+
+    /* Wrap around, marking where the newest data ends if possible */
+    if (record_size > file->data_size - file->offset) {
+        if (file->data_size - file->offset >= sizeof (LogFileRecord)) {
+            record = (LogFileRecord *) &file->data[file->offset];
+            record->len = htole32 (QCDM_LOG_FILE_RECORD_WRAP);
+            record->reserved = 0;
+            record->timestamp = htole64 (timestamp);
+        }
+        file->offset = 0;
+        file->wraps++;
+    }
+
+    record = (LogFileRecord *) &file->data[file->offset];
+    record->len = htole32 ((uint32_t) len);
+    record->reserved = 0;
+    record->timestamp = htole64 (timestamp);
+    memcpy (&file->data[file->offset + sizeof (LogFileRecord)], buf, len);
+    file->offset += record_size;
+    file->records++;
+
+    /* Header updated once the record is complete */
+    file->header->write_offset = htole64 (file->offset);
+    file->header->wraps = htole64 (file->wraps);
+    file->header->records = htole64 (file->records);
+    return TRUE;
+}
+
+uint64_t
+qcdm_log_file_get_records (QcdmLogFile *file)
+{
+    qcdm_return_val_if_fail (file != NULL, 0);
+    return file->records;
+}
+
+uint64_t
+qcdm_log_file_get_wraps (QcdmLogFile *file)
+{
+    qcdm_return_val_if_fail (file != NULL, 0);
+    return file->wraps;
+}
@@ -0,0 +1,96 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * Copyright (C) 2026 ModemManager contributors
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of version 2 of the GNU General Public
+ * License as published by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBQCDM_STREAM_H
+#define LIBQCDM_STREAM_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "utils.h"
+
+/**********************************************************************/
+
+/* Incremental deframer for a continuous stream of DM frames, e.g. log
+ * packets received once log masks are enabled. Data is fed in chunks as read
+ * from the port; every byte is inspected only once, and complete frames with
+ * a valid CRC are reported without the CRC and trailing control character.
+ */
+
+/* Frames longer than this are dropped */
+#define QCDM_STREAM_MAX_FRAME_LEN 65536
+
+typedef struct QcdmStream QcdmStream;
+
+typedef void (*QcdmStreamFrameFn) (const char *frame,
+                                   size_t len,
+                                   void *user_data);
+
+QcdmStream *qcdm_stream_new          (void);
+void        qcdm_stream_free         (QcdmStream *stream);
+
+/* Returns the number of frames reported */
+size_t      qcdm_stream_feed         (QcdmStream *stream,
+                                      const char *buf,
+                                      size_t len,
+                                      QcdmStreamFrameFn frame_fn,
+                                      void *user_data);
+
+/* Forget any partially received frame */
+void        qcdm_stream_reset        (QcdmStream *stream);
+
+uint64_t    qcdm_stream_get_frames      (QcdmStream *stream);
+uint64_t    qcdm_stream_get_crc_errors  (QcdmStream *stream);
+uint64_t    qcdm_stream_get_dropped     (QcdmStream *stream);
+
+/**********************************************************************/
+
+/* Rolling capture file of fixed size, memory-mapped so that appending a
+ * packet is a plain memory copy. Once full, writing wraps around to the
+ * start of the data area, overwriting the oldest packets.
+ *
+ * Layout (all fields little endian):
+ *   header:  8-byte magic "QCDMLOG1", u32 header size, u32 reserved,
+ *            u64 size of the data area, u64 write offset in the data area,
+ *            u64 number of wraps, u64 number of records written
+ *   records: u32 payload length, u32 reserved, u64 timestamp (usecs),
+ *            payload padded to 8 bytes
+ * A record with payload length 0xFFFFFFFF marks the point where writing
+ * wrapped around, if there was space left for it.
+ */
+
+#define QCDM_LOG_FILE_MAGIC       "QCDMLOG1"
+#define QCDM_LOG_FILE_RECORD_WRAP 0xFFFFFFFF
+
+typedef struct QcdmLogFile QcdmLogFile;
+
+/* Returns NULL and sets errno on failure */
+QcdmLogFile *qcdm_log_file_open         (const char *path,
+                                         size_t size);
+void         qcdm_log_file_close        (QcdmLogFile *file);
+
+qcdmbool     qcdm_log_file_append       (QcdmLogFile *file,
+                                         const char *buf,
+                                         size_t len,
+                                         uint64_t timestamp);
+
+uint64_t     qcdm_log_file_get_records  (QcdmLogFile *file);
+uint64_t     qcdm_log_file_get_wraps    (QcdmLogFile *file);
+
+/**********************************************************************/
+
+#endif  /* LIBQCDM_STREAM_H */
@@ -68,14 +68,57 @@ static const uint16_t crc_table[256] = {
     0x7bc7, 0x6a4e, 0x58d5, 0x495c, 0x3de3, 0x2c6a, 0x1ef1, 0x0f78
 };
 
+/* Slicing-by-8 tables: crc_slice_table[k][b] is the CRC contribution of byte
+ * 'b' followed by 'k' zero bytes, so that 8 input bytes can be folded into the
+ * CRC with independent table lookups. Built from crc_table on first use; a
+ * concurrent build by another thread writes the very same values. */
+static uint16_t crc_slice_table[8][256];
+static qcdmbool crc_slice_table_ready;
+
+static void
+crc_slice_table_init (void)
+{
+    unsigned int i, k;
+
+    for (i = 0; i < 256; i++)
+        crc_slice_table[0][i] = crc_table[i];
+    for (k = 1; k < 8; k++) {
+        for (i = 0; i < 256; i++) {
+            uint16_t prev = crc_slice_table[k - 1][i];
+
+            crc_slice_table[k][i] = (prev >> 8) ^ crc_table[prev & 0xff];
+        }
+    }
+    __atomic_store_n (&crc_slice_table_ready, TRUE, __ATOMIC_RELEASE);
+}
+
 /* Calculate the CRC for a buffer using a seed of 0xffff */
 uint16_t
 dm_crc16 (const char *buffer, size_t len)
 {
+    const uint8_t *p = (const uint8_t *) buffer;
     uint16_t crc = 0xffff;
 
+    if (len >= 16) {
+        if (!__atomic_load_n (&crc_slice_table_ready, __ATOMIC_ACQUIRE))
+            crc_slice_table_init ();
+
+        while (len >= 8) {
+            crc = crc_slice_table[7][(p[0] ^ crc) & 0xff] ^
+                  crc_slice_table[6][(p[1] ^ (crc >> 8)) & 0xff] ^
+                  crc_slice_table[5][p[2]] ^
+                  crc_slice_table[4][p[3]] ^
+                  crc_slice_table[3][p[4]] ^
+                  crc_slice_table[2][p[5]] ^
+                  crc_slice_table[1][p[6]] ^
+                  crc_slice_table[0][p[7]];
+            p += 8;
+            len -= 8;
+        }
+    }
+
     while (len--)
-            crc = crc_table[(crc ^ *buffer++) & 0xff] ^ (crc >> 8);
+        crc = crc_table[(crc ^ *p++) & 0xff] ^ (crc >> 8);
     return ~crc;
 }
 
@@ -144,26 +187,41 @@ dm_unescape (const char *inbuf,
              size_t outbuf_len,
              qcdmbool *escaping)
 {
-    size_t i, outsize;
+    const char *src = inbuf;
+    const char *end = inbuf + inbuf_len;
+    size_t outsize = 0;
 
     qcdm_return_val_if_fail (inbuf_len > 0, 0);
     qcdm_return_val_if_fail (outbuf_len >= inbuf_len, 0);
     qcdm_return_val_if_fail (escaping != NULL, 0);
 
-    for (i = 0, outsize = 0; i < inbuf_len; i++) {
+    /* Escape characters are rare, so copy whole runs of plain data between
+     * them; memchr() scans several bytes at a time. */
+    while (src < end) {
+        const char *esc;
+        size_t run;
+
         if (*escaping) {
-            outbuf[outsize++] = inbuf[i] ^ DIAG_ESC_MASK;
+            outbuf[outsize++] = *src++ ^ DIAG_ESC_MASK;
             *escaping = FALSE;
-        } else if (inbuf[i] == DIAG_ESC_CHAR)
-            *escaping = TRUE;
-        else
-            outbuf[outsize++] = inbuf[i];
+            continue;
+        }
 
-        /* About to overrun output buffer size */
-        if (outsize >= outbuf_len)
-            return 0;
+        esc = memchr (src, DIAG_ESC_CHAR, end - src);
+        run = (esc ? esc : end) - src;
+        memcpy (&outbuf[outsize], src, run);
+        outsize += run;
+        src += run;
+        if (esc) {
+            *escaping = TRUE;
+            src++;
+        }
     }
 
+    /* Output buffer size overrun */
+    if (outsize >= outbuf_len)
+        return 0;
+
     return outsize;
 }
 
@@ -241,6 +299,7 @@ dm_decapsulate_buffer (const char *inbuf,
                        qcdmbool *out_need_more)
 {
     qcdmbool escaping = FALSE;
+    const char *control;
     size_t i, pkt_len = 0, unesc_len;
     uint16_t crc, pkt_crc;
 
@@ -261,20 +320,20 @@ dm_decapsulate_buffer (const char *inbuf,
     }
 
     /* Find the async control character */
-    for (i = 0; i < inbuf_len; i++) {
-        if (inbuf[i] == DIAG_CONTROL_CHAR) {
-            /* If the control character shows up in a position before a valid
-             * QCDM packet length (4), the packet is malformed.
-             */
-            if (i < 3) {
-                /* Tell the caller to advance the buffer past the control char */
-                *out_used = i + 1;
-                return FALSE;
-            }
-
-            pkt_len = i;
-            break;
+    control = memchr (inbuf, DIAG_CONTROL_CHAR, inbuf_len);
+    if (control) {
+        i = control - inbuf;
+
+        /* If the control character shows up in a position before a valid
+         * QCDM packet length (4), the packet is malformed.
+         */
+        if (i < 3) {
+            /* Tell the caller to advance the buffer past the control char */
+            *out_used = i + 1;
+            return FALSE;
         }
+
+        pkt_len = i;
     }
 
     /* No control char yet, need more data */
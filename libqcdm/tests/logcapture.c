@@ -0,0 +1,299 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+/* Captures DM log packets into a rolling capture file until interrupted.
+ * Log packets are deframed incrementally as they are read from the port, so
+ * capturing keeps up with the high data rates seen with many log items
+ * enabled. */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "utils.h"
+#include "errors.h"
+#include "commands.h"
+#include "com.h"
+#include "dm-commands.h"
+#include "stream.h"
+
+#define DEFAULT_CAPTURE_SIZE_MB 64
+#define MAX_LOG_ITEMS           64
+
+static int debug = 0;
+static volatile sig_atomic_t quit = 0;
+
+typedef struct {
+    QcdmLogFile *file;
+    /* Reply to the last log config command */
+    char reply[512];
+    size_t reply_len;
+    uint64_t log_packets;
+    uint64_t log_bytes;
+} Capture;
+
+static void
+signal_handler (int signo)
+{
+    quit = 1;
+}
+
+static int
+com_setup (const char *port)
+{
+    int ret, fd;
+
+    errno = 0;
+    fd = open (port, O_RDWR | O_EXCL | O_NONBLOCK | O_NOCTTY);
+    if (fd < 0) {
+        fprintf (stderr, "E: failed to open port %s\n", port);
+        return -1;
+    }
+
+    ret = ioctl (fd, TIOCEXCL);
+    if (ret) {
+        fprintf (stderr, "E: failed to lock port %s\n", port);
+        close (fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static uint64_t
+timestamp_usecs (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_REALTIME, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/******************************************************************/
+
+static void
+frame_cb (const char *frame, size_t len, void *user_data)
+{
+    Capture *capture = user_data;
+
+    switch ((uint8_t) frame[0]) {
+    case DIAG_CMD_LOG:
+        if (len < sizeof (DMCmdLog))
+            break;
+        if (qcdm_log_file_append (capture->file, frame, len, timestamp_usecs ())) {
+            capture->log_packets++;
+            capture->log_bytes += len;
+        }
+        break;
+    case DIAG_CMD_LOG_CONFIG:
+        if (len <= sizeof (capture->reply)) {
+            memcpy (capture->reply, frame, len);
+            capture->reply_len = len;
+        }
+        break;
+    default:
+        if (debug)
+            fprintf (stdout, "ignoring DM frame 0x%02x (%zu)\n", frame[0] & 0xFF, len);
+        break;
+    }
+}
+
+/* Reads from the port and feeds the stream; returns -1 on error */
+static int
+capture_read (int fd, QcdmStream *stream, Capture *capture, int timeout_ms)
+{
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    char buf[16384];
+    ssize_t bytes_read;
+    int ret;
+
+    ret = poll (&pfd, 1, timeout_ms);
+    if (ret < 0)
+        return errno == EINTR ? 0 : -1;
+    if (ret == 0)
+        return 0;
+
+    /* Drain everything available before polling again */
+    while ((bytes_read = read (fd, buf, sizeof (buf))) > 0)
+        qcdm_stream_feed (stream, buf, bytes_read, frame_cb, capture);
+
+    if (bytes_read == 0 || (errno != EAGAIN && errno != EINTR))
+        return -1;
+    return 0;
+}
+
+static qcdmbool
+capture_set_mask (int fd,
+                  QcdmStream *stream,
+                  Capture *capture,
+                  uint32_t equip_id,
+                  uint16_t items[])
+{
+    char buf[1024];
+    size_t len, written = 0;
+    QcdmResult *result;
+    int err = QCDM_SUCCESS;
+    unsigned int retries;
+
+    len = qcdm_cmd_log_config_set_mask_new (buf, sizeof (buf), equip_id, items);
+    if (!len)
+        return FALSE;
+
+    while (written < len) {
+        ssize_t ret;
+
+        ret = write (fd, &buf[written], len - written);
+        if (ret < 0) {
+            if (errno != EAGAIN && errno != EINTR)
+                return FALSE;
+            usleep (1000);
+            continue;
+        }
+        written += ret;
+    }
+
+    /* Log packets may already be flowing, so wait for the reply in the stream */
+    capture->reply_len = 0;
+    for (retries = 0; !capture->reply_len && retries < 20; retries++) {
+        if (capture_read (fd, stream, capture, 100) < 0)
+            return FALSE;
+    }
+    if (!capture->reply_len)
+        return FALSE;
+
+    result = qcdm_cmd_log_config_set_mask_result (capture->reply, capture->reply_len, &err);
+    if (!result) {
+        fprintf (stderr, "E: failed to parse Log Config command reply: %d\n", err);
+        return FALSE;
+    }
+    qcdm_result_unref (result);
+    return TRUE;
+}
+
+/******************************************************************/
+
+static void
+usage (const char *prog)
+{
+    fprintf (stderr, "Usage: %s <DM port> <capture file> <equip ID> <log code> [<log code>...] [--size <MB>] [--debug]\n", prog);
+}
+
+int
+main (int argc, char *argv[])
+{
+    const char *dmport, *path;
+    uint16_t items[MAX_LOG_ITEMS + 1] = { 0 };
+    uint16_t no_items[1] = { 0 };
+    unsigned int n_items = 0;
+    unsigned long size_mb = DEFAULT_CAPTURE_SIZE_MB;
+    unsigned long equip_id;
+    QcdmStream *stream;
+    Capture capture = { 0 };
+    struct sigaction sa;
+    int fd, err, i;
+
+    if (argc < 5) {
+        usage (argv[0]);
+        return 1;
+    }
+
+    dmport = argv[1];
+    path = argv[2];
+    equip_id = strtoul (argv[3], NULL, 0);
+
+    for (i = 4; i < argc; i++) {
+        if (strcasecmp (argv[i], "--debug") == 0)
+            debug = 1;
+        else if (strcasecmp (argv[i], "--size") == 0 && i + 1 < argc)
+            size_mb = strtoul (argv[++i], NULL, 0);
+        else if (n_items < MAX_LOG_ITEMS)
+            items[n_items++] = (uint16_t) strtoul (argv[i], NULL, 0);
+    }
+
+    if (!n_items || !size_mb) {
+        usage (argv[0]);
+        return 1;
+    }
+
+    if (debug)
+        putenv ((char *)"QCDM_DEBUG=1");
+
+    fd = com_setup (dmport);
+    if (fd < 0)
+        return 1;
+
+    err = qcdm_port_setup (fd);
+    if (err != QCDM_SUCCESS) {
+        fprintf (stderr, "E: failed to set up DM port %s: %d\n", dmport, err);
+        return 1;
+    }
+
+    capture.file = qcdm_log_file_open (path, size_mb * 1024 * 1024);
+    if (!capture.file) {
+        fprintf (stderr, "E: failed to open capture file %s: %s\n", path, strerror (errno));
+        return 1;
+    }
+
+    stream = qcdm_stream_new ();
+
+    memset (&sa, 0, sizeof (sa));
+    sa.sa_handler = signal_handler;
+    sigaction (SIGINT, &sa, NULL);
+    sigaction (SIGTERM, &sa, NULL);
+
+    if (!capture_set_mask (fd, stream, &capture, equip_id, items)) {
+        fprintf (stderr, "E: failed to enable log items\n");
+        err = 1;
+        goto out;
+    }
+
+    printf ("capturing %u log items into %s, interrupt to stop...\n", n_items, path);
+    while (!quit) {
+        if (capture_read (fd, stream, &capture, 1000) < 0) {
+            fprintf (stderr, "E: failed to read from DM port %s\n", dmport);
+            err = 1;
+            break;
+        }
+    }
+
+    if (!capture_set_mask (fd, stream, &capture, equip_id, no_items))
+        fprintf (stderr, "W: failed to disable log items\n");
+
+out:
+    printf ("captured %llu log packets (%llu bytes), %llu wraps\n",
+            (unsigned long long) capture.log_packets,
+            (unsigned long long) capture.log_bytes,
+            (unsigned long long) qcdm_log_file_get_wraps (capture.file));
+    printf ("frames: %llu, CRC errors: %llu, dropped: %llu\n",
+            (unsigned long long) qcdm_stream_get_frames (stream),
+            (unsigned long long) qcdm_stream_get_crc_errors (stream),
+            (unsigned long long) qcdm_stream_get_dropped (stream));
+
+    qcdm_stream_free (stream);
+    qcdm_log_file_close (capture.file);
+    close (fd);
+    return err;
+}
@@ -63,3 +63,72 @@ test_crc16_1 (void *f, void *data)
     g_assert (crc == expected);
 }
 
+
+/* Plain bytewise CRC, for comparison with the table-sliced implementation */
+static guint16
+crc16_bitwise (const char *buf, gsize len)
+{
+    guint16 crc = 0xffff;
+    gsize i;
+    guint j;
+
+    for (i = 0; i < len; i++) {
+        crc ^= (guint8) buf[i];
+        for (j = 0; j < 8; j++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : (crc >> 1);
+    }
+    return ~crc;
+}
+
+void
+test_crc16_random (void *f, void *data)
+{
+    char buf[300];
+    gsize i;
+
+    for (i = 0; i < sizeof (buf); i++)
+        buf[i] = (char) g_test_rand_int_range (0, 256);
+
+    /* Every length, so that all the tail lengths are covered */
+    for (i = 0; i <= sizeof (buf); i++)
+        g_assert_cmphex (dm_crc16 (buf, i), ==, crc16_bitwise (buf, i));
+}
+
+#define THROUGHPUT_BUFFER_SIZE (1024 * 1024)
+#define THROUGHPUT_ROUNDS      16
+
+void
+test_crc16_throughput (void *f, void *data)
+{
+    char *buf;
+    gsize i;
+    gdouble elapsed, reference;
+    guint16 crc = 0, crc_reference = 0;
+
+    /* Benchmark, only run with -m perf */
+    if (!g_test_perf ()) {
+        g_test_skip ("run with -m perf");
+        return;
+    }
+
+    buf = g_malloc (THROUGHPUT_BUFFER_SIZE);
+    for (i = 0; i < THROUGHPUT_BUFFER_SIZE; i++)
+        buf[i] = (char) g_test_rand_int_range (0, 256);
+
+    g_test_timer_start ();
+    for (i = 0; i < THROUGHPUT_ROUNDS; i++)
+        crc ^= dm_crc16 (buf, THROUGHPUT_BUFFER_SIZE);
+    elapsed = g_test_timer_elapsed ();
+
+    g_test_timer_start ();
+    for (i = 0; i < THROUGHPUT_ROUNDS; i++)
+        crc_reference ^= crc16_bitwise (buf, THROUGHPUT_BUFFER_SIZE);
+    reference = g_test_timer_elapsed ();
+
+    g_assert_cmphex (crc, ==, crc_reference);
+    g_test_maximized_result (THROUGHPUT_ROUNDS / elapsed, "dm_crc16: %.1f MiB/s", THROUGHPUT_ROUNDS / elapsed);
+    g_test_message ("bitwise CRC: %.1f MiB/s, dm_crc16 is %.1fx faster",
+                    THROUGHPUT_ROUNDS / reference, reference / elapsed);
+
+    g_free (buf);
+}
@@ -20,6 +20,8 @@
 
 void test_crc16_2 (void *f, void *data);
 void test_crc16_1 (void *f, void *data);
+void test_crc16_random (void *f, void *data);
+void test_crc16_throughput (void *f, void *data);
 
 #endif  /* TEST_QCDM_CRC_H */
 
@@ -122,3 +122,78 @@ test_escape_unescape (void *f, void *data)
     g_assert (memcmp (unescaped, data1, unlen) == 0);
 }
 
+
+/* Plain bytewise unescaping, for comparison with the memchr() based one */
+static gsize
+unescape_bytewise (const char *inbuf, gsize inbuf_len, char *outbuf)
+{
+    gboolean escaping = FALSE;
+    gsize i, outsize = 0;
+
+    for (i = 0; i < inbuf_len; i++) {
+        if (escaping) {
+            outbuf[outsize++] = inbuf[i] ^ 0x20;
+            escaping = FALSE;
+        } else if (inbuf[i] == 0x7d)
+            escaping = TRUE;
+        else
+            outbuf[outsize++] = inbuf[i];
+    }
+    return outsize;
+}
+
+#define THROUGHPUT_BUFFER_SIZE (1024 * 1024)
+#define THROUGHPUT_ROUNDS      16
+
+void
+test_escape_unescape_throughput (void *f, void *data)
+{
+    char *buf, *escaped, *unescaped;
+    gsize i, len = 0, unlen = 0;
+    gdouble escape_elapsed, unescape_elapsed, reference;
+    qcdmbool escaping = FALSE;
+
+    /* Benchmark, only run with -m perf */
+    if (!g_test_perf ()) {
+        g_test_skip ("run with -m perf");
+        return;
+    }
+
+    /* Random data, so about 1 in 128 bytes needs escaping */
+    buf = g_malloc (THROUGHPUT_BUFFER_SIZE);
+    for (i = 0; i < THROUGHPUT_BUFFER_SIZE; i++)
+        buf[i] = (char) g_test_rand_int_range (0, 256);
+    escaped = g_malloc (THROUGHPUT_BUFFER_SIZE * 2);
+    unescaped = g_malloc (THROUGHPUT_BUFFER_SIZE * 2);
+
+    g_test_timer_start ();
+    for (i = 0; i < THROUGHPUT_ROUNDS; i++)
+        len = dm_escape (buf, THROUGHPUT_BUFFER_SIZE, escaped, THROUGHPUT_BUFFER_SIZE * 2);
+    escape_elapsed = g_test_timer_elapsed ();
+    g_assert (len > THROUGHPUT_BUFFER_SIZE);
+
+    g_test_timer_start ();
+    for (i = 0; i < THROUGHPUT_ROUNDS; i++) {
+        escaping = FALSE;
+        unlen = dm_unescape (escaped, len, unescaped, THROUGHPUT_BUFFER_SIZE * 2, &escaping);
+    }
+    unescape_elapsed = g_test_timer_elapsed ();
+    g_assert (unlen == THROUGHPUT_BUFFER_SIZE);
+    g_assert (memcmp (unescaped, buf, unlen) == 0);
+
+    g_test_timer_start ();
+    for (i = 0; i < THROUGHPUT_ROUNDS; i++)
+        unlen = unescape_bytewise (escaped, len, unescaped);
+    reference = g_test_timer_elapsed ();
+    g_assert (unlen == THROUGHPUT_BUFFER_SIZE);
+
+    g_test_maximized_result (THROUGHPUT_ROUNDS / unescape_elapsed, "dm_unescape: %.1f MiB/s",
+                             THROUGHPUT_ROUNDS / unescape_elapsed);
+    g_test_message ("dm_escape: %.1f MiB/s", THROUGHPUT_ROUNDS / escape_elapsed);
+    g_test_message ("bytewise unescape: %.1f MiB/s, dm_unescape is %.1fx faster",
+                    THROUGHPUT_ROUNDS / reference, reference / unescape_elapsed);
+
+    g_free (buf);
+    g_free (escaped);
+    g_free (unescaped);
+}
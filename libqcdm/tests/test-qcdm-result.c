@@ -21,6 +21,7 @@
 #include "test-qcdm-result.h"
 #include "result.h"
 #include "result-private.h"
+#include "errors.h"
 
 #define TEST_TAG "test"
 
@@ -90,3 +91,50 @@ test_result_uint8_array (void *f, void *data)
 
     qcdm_result_unref (result);
 }
+
+void
+test_result_many (void *f, void *data)
+{
+    uint16_t array[300];
+    const uint16_t *tmp_array = NULL;
+    size_t tmp_len = 0;
+    const char *tmp_str = NULL;
+    QcdmResult *result;
+    char key[32];
+    guint32 tmp;
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (array); i++)
+        array[i] = i * 3;
+
+    /* More fields and data than fit in the space embedded in the result */
+    result = qcdm_result_new ();
+    for (i = 0; i < 100; i++) {
+        g_snprintf (key, sizeof (key), "item-%u", i);
+        qcdm_result_add_u32 (result, key, i);
+    }
+    qcdm_result_add_u16_array (result, TEST_TAG, array, G_N_ELEMENTS (array));
+    qcdm_result_add_string (result, "string", "foo");
+
+    /* Adding a key again replaces its value */
+    qcdm_result_add_string (result, "string", "bar");
+    qcdm_result_add_u32 (result, "item-42", 4242);
+
+    for (i = 0; i < 100; i++) {
+        g_snprintf (key, sizeof (key), "item-%u", i);
+        tmp = 0;
+        g_assert_cmpint (qcdm_result_get_u32 (result, key, &tmp), ==, 0);
+        g_assert_cmpuint (tmp, ==, i == 42 ? 4242 : i);
+    }
+
+    g_assert_cmpint (qcdm_result_get_u16_array (result, TEST_TAG, &tmp_array, &tmp_len), ==, 0);
+    g_assert_cmpuint (tmp_len, ==, G_N_ELEMENTS (array));
+    g_assert_cmpint (memcmp (tmp_array, array, sizeof (array)), ==, 0);
+
+    g_assert_cmpint (qcdm_result_get_string (result, "string", &tmp_str), ==, 0);
+    g_assert_cmpstr (tmp_str, ==, "bar");
+
+    g_assert_cmpint (qcdm_result_get_u32 (result, "item-100", &tmp), ==, -QCDM_ERROR_VALUE_NOT_FOUND);
+
+    qcdm_result_unref (result);
+}
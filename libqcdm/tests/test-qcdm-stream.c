@@ -0,0 +1,213 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * Copyright (C) 2026 ModemManager contributors
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of version 2 of the GNU General Public
+ * License as published by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <endian.h>
+
+#include "test-qcdm-stream.h"
+#include "stream.h"
+#include "utils.h"
+
+/* Payloads including characters that need escaping */
+static const char payload1[] = { 0x10, 0x00, 0x7e, 0x00, 0x7d, 0x5e, 0x01, 0x02 };
+static const char payload2[] = { 0x4b, 0x0f, 0x00, 0x00 };
+
+static gsize
+build_stream (char *buf, gsize buf_len)
+{
+    char tmp[64];
+    gsize len = 0;
+
+    /* Opening flag, as sent by some devices */
+    buf[len++] = DIAG_CONTROL_CHAR;
+
+    memcpy (tmp, payload1, sizeof (payload1));
+    len += dm_encapsulate_buffer (tmp, sizeof (payload1), sizeof (tmp), &buf[len], buf_len - len);
+    memcpy (tmp, payload2, sizeof (payload2));
+    len += dm_encapsulate_buffer (tmp, sizeof (payload2), sizeof (tmp), &buf[len], buf_len - len);
+    return len;
+}
+
+static void
+collect_frame (const char *frame, size_t len, void *user_data)
+{
+    GPtrArray *frames = user_data;
+
+    g_ptr_array_add (frames, g_bytes_new (frame, len));
+}
+
+static void
+assert_frame (GPtrArray *frames, guint i, const char *expected, gsize expected_len)
+{
+    gconstpointer frame;
+    gsize len;
+
+    g_assert_cmpuint (frames->len, >, i);
+    frame = g_bytes_get_data (g_ptr_array_index (frames, i), &len);
+    g_assert_cmpmem (frame, len, expected, expected_len);
+}
+
+void
+test_stream_frames (void *f, void *data)
+{
+    QcdmStream *stream;
+    GPtrArray *frames;
+    char buf[128];
+    gsize len;
+
+    len = build_stream (buf, sizeof (buf));
+
+    frames = g_ptr_array_new_with_free_func ((GDestroyNotify) g_bytes_unref);
+    stream = qcdm_stream_new ();
+    g_assert_cmpuint (qcdm_stream_feed (stream, buf, len, collect_frame, frames), ==, 2);
+
+    assert_frame (frames, 0, payload1, sizeof (payload1));
+    assert_frame (frames, 1, payload2, sizeof (payload2));
+    g_assert_cmpuint (qcdm_stream_get_frames (stream), ==, 2);
+    g_assert_cmpuint (qcdm_stream_get_crc_errors (stream), ==, 0);
+    g_assert_cmpuint (qcdm_stream_get_dropped (stream), ==, 0);
+
+    qcdm_stream_free (stream);
+    g_ptr_array_unref (frames);
+}
+
+void
+test_stream_split (void *f, void *data)
+{
+    char buf[128];
+    gsize len, split;
+
+    len = build_stream (buf, sizeof (buf));
+
+    /* Frames split at every possible point, including between an escape
+     * character and the escaped byte, must be reassembled */
+    for (split = 1; split < len; split++) {
+        QcdmStream *stream;
+        GPtrArray *frames;
+        gsize n;
+
+        frames = g_ptr_array_new_with_free_func ((GDestroyNotify) g_bytes_unref);
+        stream = qcdm_stream_new ();
+        n = qcdm_stream_feed (stream, buf, split, collect_frame, frames);
+        n += qcdm_stream_feed (stream, &buf[split], len - split, collect_frame, frames);
+        g_assert_cmpuint (n, ==, 2);
+        assert_frame (frames, 0, payload1, sizeof (payload1));
+        assert_frame (frames, 1, payload2, sizeof (payload2));
+        qcdm_stream_free (stream);
+        g_ptr_array_unref (frames);
+    }
+}
+
+void
+test_stream_errors (void *f, void *data)
+{
+    QcdmStream *stream;
+    GPtrArray *frames;
+    char buf[128];
+    gsize len;
+    char *big;
+
+    frames = g_ptr_array_new_with_free_func ((GDestroyNotify) g_bytes_unref);
+    stream = qcdm_stream_new ();
+
+    /* Corrupted CRC in the first frame, second frame still reported */
+    len = build_stream (buf, sizeof (buf));
+    buf[2] ^= 0x01;
+    g_assert_cmpuint (qcdm_stream_feed (stream, buf, len, collect_frame, frames), ==, 1);
+    assert_frame (frames, 0, payload2, sizeof (payload2));
+    g_assert_cmpuint (qcdm_stream_get_crc_errors (stream), ==, 1);
+
+    /* Too short to hold data and CRC */
+    buf[0] = 0x01;
+    buf[1] = 0x02;
+    buf[2] = DIAG_CONTROL_CHAR;
+    g_assert_cmpuint (qcdm_stream_feed (stream, buf, 3, collect_frame, frames), ==, 0);
+    g_assert_cmpuint (qcdm_stream_get_dropped (stream), ==, 1);
+
+    /* Longer than the maximum frame size, and the stream recovers after it */
+    big = g_malloc (QCDM_STREAM_MAX_FRAME_LEN + 16);
+    memset (big, 0x01, QCDM_STREAM_MAX_FRAME_LEN + 16);
+    big[QCDM_STREAM_MAX_FRAME_LEN + 15] = DIAG_CONTROL_CHAR;
+    g_assert_cmpuint (qcdm_stream_feed (stream, big, QCDM_STREAM_MAX_FRAME_LEN + 16, collect_frame, frames), ==, 0);
+    g_assert_cmpuint (qcdm_stream_get_dropped (stream), ==, 2);
+    g_free (big);
+
+    len = build_stream (buf, sizeof (buf));
+    g_assert_cmpuint (qcdm_stream_feed (stream, buf, len, collect_frame, frames), ==, 2);
+    g_assert_cmpuint (qcdm_stream_get_frames (stream), ==, 3);
+
+    qcdm_stream_free (stream);
+    g_ptr_array_unref (frames);
+}
+
+void
+test_log_file_wrap (void *f, void *data)
+{
+    GError *error = NULL;
+    QcdmLogFile *file;
+    char too_long[200] = { 0 };
+    gchar *dir;
+    gchar *path;
+    gchar *contents;
+    gsize contents_len;
+    guint64 u64;
+    guint32 u32;
+    guint i;
+
+    dir = g_dir_make_tmp ("qcdm-log-XXXXXX", &error);
+    g_assert_no_error (error);
+    path = g_build_filename (dir, "capture.qcdm", NULL);
+
+    /* 48-byte header and room for 4 records of 16 + 8 bytes */
+    file = qcdm_log_file_open (path, 48 + 4 * 24);
+    g_assert (file);
+
+    g_assert (!qcdm_log_file_append (file, too_long, sizeof (too_long), 0));
+    for (i = 0; i < 6; i++)
+        g_assert (qcdm_log_file_append (file, payload1, sizeof (payload1), i));
+    g_assert_cmpuint (qcdm_log_file_get_records (file), ==, 6);
+    g_assert_cmpuint (qcdm_log_file_get_wraps (file), ==, 1);
+    qcdm_log_file_close (file);
+
+    g_file_get_contents (path, &contents, &contents_len, &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (contents_len, ==, 48 + 4 * 24);
+    g_assert (memcmp (contents, QCDM_LOG_FILE_MAGIC, 8) == 0);
+
+    /* Write offset after the 2 records written since wrapping */
+    memcpy (&u64, &contents[24], 8);
+    g_assert_cmpuint (le64toh (u64), ==, 2 * 24);
+    memcpy (&u64, &contents[32], 8);
+    g_assert_cmpuint (le64toh (u64), ==, 1);
+    memcpy (&u64, &contents[40], 8);
+    g_assert_cmpuint (le64toh (u64), ==, 6);
+
+    /* Oldest record left is the one with timestamp 2 */
+    memcpy (&u32, &contents[48 + 2 * 24], 4);
+    g_assert_cmpuint (le32toh (u32), ==, sizeof (payload1));
+    memcpy (&u64, &contents[48 + 2 * 24 + 8], 8);
+    g_assert_cmpuint (le64toh (u64), ==, 2);
+    g_assert_cmpmem (&contents[48 + 2 * 24 + 16], sizeof (payload1), payload1, sizeof (payload1));
+
+    g_free (contents);
+    g_unlink (path);
+    g_rmdir (dir);
+    g_free (path);
+    g_free (dir);
+}
@@ -23,6 +23,7 @@
 #include "test-qcdm-com.h"
 #include "test-qcdm-result.h"
 #include "test-qcdm-utils.h"
+#include "test-qcdm-stream.h"
 
 typedef struct {
     gpointer com_data;
@@ -80,9 +81,12 @@ int main (int argc, char **argv)
 
     g_test_suite_add (suite, TESTCASE (test_crc16_1, NULL));
     g_test_suite_add (suite, TESTCASE (test_crc16_2, NULL));
+    g_test_suite_add (suite, TESTCASE (test_crc16_random, NULL));
+    g_test_suite_add (suite, TESTCASE (test_crc16_throughput, NULL));
     g_test_suite_add (suite, TESTCASE (test_escape1, NULL));
     g_test_suite_add (suite, TESTCASE (test_escape2, NULL));
     g_test_suite_add (suite, TESTCASE (test_escape_unescape, NULL));
+    g_test_suite_add (suite, TESTCASE (test_escape_unescape_throughput, NULL));
     g_test_suite_add (suite, TESTCASE (test_utils_decapsulate_buffer, NULL));
     g_test_suite_add (suite, TESTCASE (test_utils_encapsulate_buffer, NULL));
     g_test_suite_add (suite, TESTCASE (test_utils_decapsulate_sierra_cns, NULL));
@@ -90,6 +94,11 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_result_uint32, NULL));
     g_test_suite_add (suite, TESTCASE (test_result_uint8, NULL));
     g_test_suite_add (suite, TESTCASE (test_result_uint8_array, NULL));
+    g_test_suite_add (suite, TESTCASE (test_result_many, NULL));
+    g_test_suite_add (suite, TESTCASE (test_stream_frames, NULL));
+    g_test_suite_add (suite, TESTCASE (test_stream_split, NULL));
+    g_test_suite_add (suite, TESTCASE (test_stream_errors, NULL));
+    g_test_suite_add (suite, TESTCASE (test_log_file_wrap, NULL));
 
     /* Live tests */
     if (port) {
@@ -29,7 +29,10 @@
 #define MM_LOG_NO_OBJECT
 #include "mm-log.h"
 #include "mm-base-manager.h"
+#include "mm-plugin-manager.h"
 #include "mm-context.h"
+#include "mm-port-serial.h"
+#include "mm-main-loop-profiler.h"
 
 #if defined WITH_SUSPEND_RESUME
 # include "mm-sleep-monitor.h"
@@ -38,9 +41,19 @@
 /* Maximum time to wait for all modems to get disabled and removed */
 #define MAX_SHUTDOWN_TIME_SECS 20
 
+/* Number of callbacks listed in the main loop profile report */
+#define MAIN_LOOP_PROFILE_REPORT_TOP 15
+
 static GMainLoop *loop;
 static MMBaseManager *manager;
 
+static gboolean
+main_loop_profile_report_cb (gpointer user_data)
+{
+    mm_main_loop_profiler_report (MAIN_LOOP_PROFILE_REPORT_TOP);
+    return G_SOURCE_CONTINUE;
+}
+
 static gboolean
 quit_cb (gpointer user_data)
 {
@@ -182,6 +195,28 @@ register_dbus_errors (void)
     g_dbus_error_register_error   (G_IO_ERROR,    G_IO_ERROR_CANCELLED,    MM_CORE_ERROR_DBUS_PREFIX ".Cancelled");
 }
 
+#if !defined WITH_BUILTIN_PLUGINS
+
+static gboolean
+write_plugin_manifest (const gchar *path)
+{
+    g_autoptr(MMFilter)        filter = NULL;
+    g_autoptr(MMPluginManager) plugin_manager = NULL;
+    g_autoptr(GError)          error = NULL;
+
+    /* No filter rules, plugin allowlists are not needed */
+    filter = mm_filter_new (MM_FILTER_RULE_NONE, &error);
+    if (filter)
+        plugin_manager = mm_plugin_manager_new (filter, mm_context_get_test_plugin_dir (), &error);
+    if (!plugin_manager || !mm_plugin_manager_write_manifest (plugin_manager, path, &error)) {
+        g_printerr ("error: could not write plugin manifest: %s\n", error->message);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+#endif
+
 static void
 shutdown_done (MMSleepContext *sleep_ctx,
                GError         *error,
@@ -219,15 +254,33 @@ main (int argc, char *argv[])
     g_unix_signal_add (SIGTERM, quit_cb, NULL);
     g_unix_signal_add (SIGINT, quit_cb, NULL);
 
+    if (mm_context_get_profile_main_loop ()) {
+        mm_dbg ("Main loop profiling enabled, send SIGUSR1 to get a report");
+        mm_main_loop_profiler_enable (mm_context_get_profile_main_loop ());
+        g_unix_signal_add (SIGUSR1, main_loop_profile_report_cb, NULL);
+    }
+
     /* Early register all known errors */
     register_dbus_errors ();
 
+#if !defined WITH_BUILTIN_PLUGINS
+    /* Only write the plugin manifest */
+    if (mm_context_get_test_write_plugin_manifest ())
+        exit (write_plugin_manifest (mm_context_get_test_write_plugin_manifest ()) ? 0 : 1);
+#endif
+
     mm_msg ("ModemManager (version " MM_DIST_VERSION ") starting in %s bus...",
             mm_context_get_test_session () ? "session" : "system");
 
     /* Detect runtime charset conversion support */
     mm_modem_charsets_init ();
 
+    /* Not worth the memory when modems are meant to be slim */
+    if (mm_context_get_slim_modems ())
+        mm_dbg ("Serial port command statistics disabled");
+    else
+        mm_port_serial_enable_command_stats ();
+
     /* Acquire name, don't allow replacement */
     name_id = g_bus_own_name (mm_context_get_test_session () ? G_BUS_TYPE_SESSION : G_BUS_TYPE_SYSTEM,
                               MM_DBUS_SERVICE,
@@ -300,6 +353,9 @@ main (int argc, char *argv[])
 
     g_bus_unown_name (name_id);
 
+    if (mm_main_loop_profiler_is_enabled ())
+        mm_main_loop_profiler_report (MAIN_LOOP_PROFILE_REPORT_TOP);
+
     mm_msg ("ModemManager is shut down");
 
     mm_log_shutdown ();
@@ -23,6 +23,7 @@
 #include <unistd.h>
 #include <string.h>
 #include <ctype.h>
+#include <net/if.h>
 
 #include <ModemManager.h>
 #define _LIBMM_INSIDE_MM
@@ -42,6 +43,8 @@
 #include "mm-dispatcher-connection.h"
 #include "mm-auth-provider.h"
 #include "mm-bind.h"
+#include "mm-context.h"
+#include "mm-netlink.h"
 
 /* We require up to 20s to get a proper IP when using PPP */
 #define BEARER_IP_TIMEOUT_DEFAULT 20
@@ -50,6 +53,9 @@
 
 #define BEARER_STATS_UPDATE_TIMEOUT 30
 
+/* Number of stats samples kept in the history */
+#define BEARER_STATS_HISTORY_SIZE 120
+
 /* Initial connectivity check after 30s, then each 5s */
 #define BEARER_CONNECTION_MONITOR_INITIAL_TIMEOUT 30
 #define BEARER_CONNECTION_MONITOR_TIMEOUT          5
@@ -139,6 +145,19 @@ struct _MMBaseBearerPrivate {
     GTimer *duration_timer;
     /* Flag to specify whether reloading stats is supported or not */
     gboolean reload_stats_supported;
+    /* Kernel link stats watch, when loading stats from the net interface */
+    guint    link_stats_watch_id;
+    gboolean link_stats_enabled;
+    gboolean link_stats_initialized;
+    gint64   link_stats_published_timestamp;
+    guint64  link_stats_rx_bytes_last;
+    guint64  link_stats_tx_bytes_last;
+    guint64  link_stats_rx_bytes;
+    guint64  link_stats_tx_bytes;
+    /* Ring of the latest stats samples of the ongoing connection */
+    MMBearerStatsSample stats_history[BEARER_STATS_HISTORY_SIZE];
+    guint               stats_history_first;
+    guint               stats_history_n;
 };
 
 /*****************************************************************************/
@@ -299,10 +318,12 @@ bearer_reset_ongoing_interface_stats (MMBaseBearer *self)
     mm_bearer_stats_set_start_date (self->priv->stats, 0);
     mm_bearer_stats_set_uplink_speed (self->priv->stats, 0);
     mm_bearer_stats_set_downlink_speed (self->priv->stats, 0);
+    mm_bearer_stats_set_rx_rate (self->priv->stats, 0);
+    mm_bearer_stats_set_tx_rate (self->priv->stats, 0);
     bearer_update_interface_stats (self);
 }
 
-static void
+static gboolean
 bearer_set_ongoing_interface_stats (MMBaseBearer *self,
                                     guint         duration,
                                     guint64       rx_bytes,
@@ -349,13 +370,224 @@ bearer_set_ongoing_interface_stats (MMBaseBearer *self,
         }
     }
 
-    if (n_updates)
+    if (!n_updates)
+        return FALSE;
+
+    bearer_update_interface_stats (self);
+    return TRUE;
+}
+
+static void
+bearer_stats_history_reset (MMBaseBearer *self)
+{
+    self->priv->stats_history_first = 0;
+    self->priv->stats_history_n = 0;
+}
+
+static void
+bearer_stats_history_add (MMBaseBearer *self)
+{
+    MMBearerStatsSample *sample;
+    MMBearerStatsSample *previous = NULL;
+    guint                i;
+
+    if (self->priv->stats_history_n > 0) {
+        i = (self->priv->stats_history_first + self->priv->stats_history_n - 1) % BEARER_STATS_HISTORY_SIZE;
+        previous = &self->priv->stats_history[i];
+    }
+
+    /* When full, overwrite the oldest sample */
+    if (self->priv->stats_history_n < BEARER_STATS_HISTORY_SIZE) {
+        i = (self->priv->stats_history_first + self->priv->stats_history_n) % BEARER_STATS_HISTORY_SIZE;
+        self->priv->stats_history_n++;
+    } else {
+        i = self->priv->stats_history_first;
+        self->priv->stats_history_first = (self->priv->stats_history_first + 1) % BEARER_STATS_HISTORY_SIZE;
+    }
+
+    sample = &self->priv->stats_history[i];
+    sample->timestamp = (guint64) (g_get_real_time () / 1000);
+    sample->rx_bytes = mm_bearer_stats_get_rx_bytes (self->priv->stats);
+    sample->tx_bytes = mm_bearer_stats_get_tx_bytes (self->priv->stats);
+    sample->rx_rate = 0;
+    sample->tx_rate = 0;
+    if (previous && sample->timestamp > previous->timestamp) {
+        guint64 elapsed_ms;
+
+        elapsed_ms = sample->timestamp - previous->timestamp;
+        if (sample->rx_bytes > previous->rx_bytes)
+            sample->rx_rate = ((sample->rx_bytes - previous->rx_bytes) * 8 * 1000) / elapsed_ms;
+        if (sample->tx_bytes > previous->tx_bytes)
+            sample->tx_rate = ((sample->tx_bytes - previous->tx_bytes) * 8 * 1000) / elapsed_ms;
+    }
+    if (self->priv->modem && MM_IS_IFACE_MODEM (self->priv->modem)) {
+        sample->signal_quality = mm_iface_modem_get_signal_quality (MM_IFACE_MODEM (self->priv->modem));
+        sample->access_technologies = mm_iface_modem_get_access_technologies (MM_IFACE_MODEM (self->priv->modem));
+    } else {
+        sample->signal_quality = 0;
+        sample->access_technologies = MM_MODEM_ACCESS_TECHNOLOGY_UNKNOWN;
+    }
+}
+
+static GVariant *
+bearer_stats_history_build_result (MMBaseBearer *self)
+{
+    GVariantBuilder builder;
+    guint           n;
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a(tttttuu)"));
+    for (n = 0; n < self->priv->stats_history_n; n++) {
+        const MMBearerStatsSample *sample;
+
+        sample = &self->priv->stats_history[(self->priv->stats_history_first + n) % BEARER_STATS_HISTORY_SIZE];
+        g_variant_builder_add (&builder,
+                               "(tttttuu)",
+                               sample->timestamp,
+                               sample->rx_bytes,
+                               sample->tx_bytes,
+                               sample->rx_rate,
+                               sample->tx_rate,
+                               sample->signal_quality,
+                               (guint32) sample->access_technologies);
+    }
+    return g_variant_builder_end (&builder);
+}
+
+static guint64
+link_stats_counter_delta (guint64 current,
+                          guint64 last)
+{
+    /* If the counter went backwards the link was reset, so assume it
+     * restarted counting from zero */
+    return (current >= last) ? (current - last) : current;
+}
+
+static void
+link_stats_cb (MMNetlink                *netlink,
+               guint                     ifindex,
+               const MMNetlinkLinkStats *link_stats,
+               MMBaseBearer             *self)
+{
+    if (self->priv->status != MM_BEARER_STATUS_CONNECTED || !self->priv->duration_timer)
+        return;
+
+    /* The kernel counters aren't reset on every connection when the same
+     * net interface is reused, so the first sample is just the baseline */
+    if (!self->priv->link_stats_initialized) {
+        self->priv->link_stats_initialized = TRUE;
+        self->priv->link_stats_published_timestamp = g_get_monotonic_time ();
+        self->priv->link_stats_rx_bytes_last = link_stats->rx_bytes;
+        self->priv->link_stats_tx_bytes_last = link_stats->tx_bytes;
+        return;
+    }
+
+    /* Only accumulated here; the Stats property is updated from
+     * stats_update_cb(), so that D-Bus isn't flooded at the netlink rate */
+    self->priv->link_stats_rx_bytes += link_stats_counter_delta (link_stats->rx_bytes, self->priv->link_stats_rx_bytes_last);
+    self->priv->link_stats_tx_bytes += link_stats_counter_delta (link_stats->tx_bytes, self->priv->link_stats_tx_bytes_last);
+    self->priv->link_stats_rx_bytes_last = link_stats->rx_bytes;
+    self->priv->link_stats_tx_bytes_last = link_stats->tx_bytes;
+}
+
+static void
+link_stats_publish (MMBaseBearer *self)
+{
+    gint64  now;
+    gint64  elapsed;
+    guint64 rx_delta;
+    guint64 tx_delta;
+    guint64 rx_rate;
+    guint64 tx_rate;
+
+    if (!self->priv->link_stats_initialized)
+        return;
+
+    now = g_get_monotonic_time ();
+    elapsed = now - self->priv->link_stats_published_timestamp;
+    if (elapsed <= 0)
+        return;
+
+    rx_delta = self->priv->link_stats_rx_bytes - mm_bearer_stats_get_rx_bytes (self->priv->stats);
+    tx_delta = self->priv->link_stats_tx_bytes - mm_bearer_stats_get_tx_bytes (self->priv->stats);
+
+    /* Rates in bits per second, averaged since the last update */
+    rx_rate = (rx_delta * 8 * G_USEC_PER_SEC) / (guint64) elapsed;
+    tx_rate = (tx_delta * 8 * G_USEC_PER_SEC) / (guint64) elapsed;
+    self->priv->link_stats_published_timestamp = now;
+
+    /* Nothing new to publish */
+    if (!rx_delta && !tx_delta &&
+        rx_rate == mm_bearer_stats_get_rx_rate (self->priv->stats) &&
+        tx_rate == mm_bearer_stats_get_tx_rate (self->priv->stats))
+        return;
+
+    mm_bearer_stats_set_rx_rate (self->priv->stats, rx_rate);
+    mm_bearer_stats_set_tx_rate (self->priv->stats, tx_rate);
+    if (!bearer_set_ongoing_interface_stats (self,
+                                             (guint32) g_timer_elapsed (self->priv->duration_timer, NULL),
+                                             self->priv->link_stats_rx_bytes,
+                                             self->priv->link_stats_tx_bytes))
         bearer_update_interface_stats (self);
+
+    bearer_stats_history_add (self);
+}
+
+static void
+link_stats_stop (MMBaseBearer *self)
+{
+    if (self->priv->link_stats_watch_id) {
+        mm_netlink_link_stats_watch_remove (mm_netlink_get (), self->priv->link_stats_watch_id);
+        self->priv->link_stats_watch_id = 0;
+    }
+}
+
+static void
+link_stats_start (MMBaseBearer *self)
+{
+    const gchar *interface;
+    guint        interval;
+    guint        ifindex;
+
+    g_assert (!self->priv->link_stats_watch_id);
+
+    self->priv->link_stats_enabled = FALSE;
+    self->priv->link_stats_initialized = FALSE;
+    self->priv->link_stats_rx_bytes = 0;
+    self->priv->link_stats_tx_bytes = 0;
+
+    interval = mm_context_get_bearer_stats_interval ();
+    if (!interval)
+        return;
+
+    interface = mm_gdbus_bearer_get_interface (MM_GDBUS_BEARER (self));
+    if (!interface)
+        return;
+
+    ifindex = if_nametoindex (interface);
+    if (!ifindex) {
+        mm_obj_dbg (self, "couldn't get index of interface %s: falling back to modem stats", interface);
+        return;
+    }
+
+    self->priv->link_stats_watch_id = mm_netlink_link_stats_watch_add (mm_netlink_get (), /* singleton */
+                                                                       ifindex,
+                                                                       interval,
+                                                                       (MMNetlinkLinkStatsFunc) link_stats_cb,
+                                                                       self);
+    if (!self->priv->link_stats_watch_id) {
+        mm_obj_dbg (self, "couldn't monitor stats of interface %s: falling back to modem stats", interface);
+        return;
+    }
+
+    mm_obj_dbg (self, "loading stats from interface %s every %ums", interface, interval);
+    self->priv->link_stats_enabled = TRUE;
 }
 
 static void
 bearer_stats_stop (MMBaseBearer *self)
 {
+    link_stats_stop (self);
+
     if (self->priv->duration_timer) {
         bearer_set_ongoing_interface_stats (self,
                                             (guint64) g_timer_elapsed (self->priv->duration_timer, NULL),
@@ -385,11 +617,16 @@ reload_stats_ready (MMBaseBearer *self,
         return;
     }
 
+    /* Ignore the result if we got disconnected in the meantime */
+    if (!self->priv->duration_timer)
+        return;
+
     /* We only update stats if they were retrieved properly */
     bearer_set_ongoing_interface_stats (self,
                                         (guint32) g_timer_elapsed (self->priv->duration_timer, NULL),
                                         rx_bytes,
                                         tx_bytes);
+    bearer_stats_history_add (self);
 }
 
 static gboolean
@@ -399,8 +636,9 @@ stats_update_cb (MMBaseBearer *self)
     if (self->priv->status != MM_BEARER_STATUS_CONNECTED)
         return G_SOURCE_CONTINUE;
 
-    /* If the implementation knows how to update stat values, run it */
-    if (self->priv->reload_stats_supported) {
+    /* If the implementation knows how to update stat values, run it, unless
+     * the kernel interface counters are being used instead */
+    if (self->priv->reload_stats_supported && !self->priv->link_stats_watch_id) {
         MM_BASE_BEARER_GET_CLASS (self)->reload_stats (
             self,
             (GAsyncReadyCallback)reload_stats_ready,
@@ -408,11 +646,19 @@ stats_update_cb (MMBaseBearer *self)
         return G_SOURCE_CONTINUE;
     }
 
+    /* Kernel link stats are accumulated as they arrive, and only published
+     * here */
+    if (self->priv->link_stats_watch_id) {
+        link_stats_publish (self);
+        return G_SOURCE_CONTINUE;
+    }
+
     /* Otherwise, just update duration and we're done */
     bearer_set_ongoing_interface_stats (self,
                                         (guint32) g_timer_elapsed (self->priv->duration_timer, NULL),
                                         0,
                                         0);
+    bearer_stats_history_add (self);
     return G_SOURCE_CONTINUE;
 }
 
@@ -425,6 +671,9 @@ bearer_stats_start (MMBaseBearer *self,
     g_assert (!self->priv->duration_timer);
     self->priv->duration_timer = g_timer_new ();
 
+    /* The history only covers the ongoing connection */
+    bearer_stats_history_reset (self);
+
     /* Schedule */
     g_assert (!self->priv->stats_update_id);
     self->priv->stats_update_id = g_timeout_add_seconds (BEARER_STATS_UPDATE_TIMEOUT,
@@ -436,6 +685,9 @@ bearer_stats_start (MMBaseBearer *self,
     mm_bearer_stats_set_downlink_speed (self->priv->stats, downlink_speed);
     bearer_update_interface_stats (self);
 
+    /* Prefer the kernel interface counters, if enabled */
+    link_stats_start (self);
+
     /* Load initial values */
     stats_update_cb (self);
 }
@@ -548,7 +800,7 @@ bearer_update_status (MMBaseBearer *self,
                                 "connection #%u finished: duration %us",
                                 mm_bearer_stats_get_attempts (self->priv->stats),
                                 mm_bearer_stats_get_duration (self->priv->stats));
-        if (self->priv->reload_stats_supported)
+        if (self->priv->reload_stats_supported || self->priv->link_stats_enabled)
             g_string_append_printf (report,
                                     ", tx: %" G_GUINT64_FORMAT " bytes, rx: %" G_GUINT64_FORMAT " bytes",
                                     mm_bearer_stats_get_tx_bytes (self->priv->stats),
@@ -1379,6 +1631,20 @@ handle_disconnect (MMBaseBearer *self,
     return TRUE;
 }
 
+/*****************************************************************************/
+/* GET STATS HISTORY */
+
+static gboolean
+handle_get_stats_history (MMBaseBearer          *self,
+                          GDBusMethodInvocation *invocation)
+{
+    /* Read-only, same as the Stats property, so no authorization needed */
+    mm_gdbus_bearer_complete_get_stats_history (MM_GDBUS_BEARER (self),
+                                                invocation,
+                                                bearer_stats_history_build_result (self));
+    return TRUE;
+}
+
 /*****************************************************************************/
 
 static void
@@ -1395,6 +1661,10 @@ base_bearer_dbus_export (MMBaseBearer *self)
                       "handle-disconnect",
                       G_CALLBACK (handle_disconnect),
                       NULL);
+    g_signal_connect (self,
+                      "handle-get-stats-history",
+                      G_CALLBACK (handle_get_stats_history),
+                      NULL);
 
     if (!g_dbus_interface_skeleton_export (G_DBUS_INTERFACE_SKELETON (self),
                                            self->priv->connection,
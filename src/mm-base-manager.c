@@ -59,7 +59,12 @@
 #include "mm-filter.h"
 #include "mm-log-object.h"
 #include "mm-base-modem.h"
+#include "mm-broadband-modem.h"
 #include "mm-iface-modem.h"
+#include "mm-base-sim.h"
+#include "mm-base-bearer.h"
+#include "mm-bearer-list.h"
+#include "mm-port-serial.h"
 
 #include "mm-dispatcher-modem-setup.h"
 
@@ -1358,6 +1363,273 @@ handle_set_logging (MmGdbusOrgFreedesktopModemManager1 *manager,
     return TRUE;
 }
 
+/*****************************************************************************/
+/* Snapshot */
+
+#define SNAPSHOT_VERSION 1
+
+/* Adds all properties of the given interface skeletons, exported in the given
+ * object path, as read from the values cached in the skeletons themselves */
+static void
+snapshot_add_object (GVariantBuilder *objects,
+                     GHashTable      *added,
+                     const gchar     *path,
+                     GList           *interfaces)
+{
+    GVariantBuilder  builder;
+    GList           *l;
+
+    if (!path || g_hash_table_contains (added, path))
+        return;
+    g_hash_table_add (added, g_strdup (path));
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sa{sv}}"));
+    for (l = interfaces; l; l = g_list_next (l)) {
+        GDBusInterfaceSkeleton *skeleton;
+
+        skeleton = G_DBUS_INTERFACE_SKELETON (l->data);
+        g_variant_builder_add (&builder, "{s@a{sv}}",
+                               g_dbus_interface_skeleton_get_info (skeleton)->name,
+                               g_dbus_interface_skeleton_get_properties (skeleton));
+    }
+    g_variant_builder_add (objects, "{o@a{sa{sv}}}", path, g_variant_builder_end (&builder));
+}
+
+static void
+snapshot_add_interface_object (GVariantBuilder *objects,
+                               GHashTable      *added,
+                               gpointer         skeleton)
+{
+    GList list = { 0 };
+
+    list.data = skeleton;
+    snapshot_add_object (objects,
+                         added,
+                         g_dbus_interface_skeleton_get_object_path (G_DBUS_INTERFACE_SKELETON (skeleton)),
+                         &list);
+}
+
+typedef struct {
+    GVariantBuilder *objects;
+    GHashTable      *added;
+} SnapshotBearerContext;
+
+static void
+snapshot_add_bearer (MMBaseBearer          *bearer,
+                     SnapshotBearerContext *ctx)
+{
+    snapshot_add_interface_object (ctx->objects, ctx->added, bearer);
+}
+
+static void
+snapshot_add_modem (MMBaseManager   *self,
+                    GVariantBuilder *objects,
+                    GHashTable      *added,
+                    MMBaseModem     *modem)
+{
+    GList                     *interfaces;
+    g_autoptr(MMBaseSim)       sim = NULL;
+    g_autoptr(GPtrArray)       sim_slots = NULL;
+    g_autoptr(MMBearerList)    bearer_list = NULL;
+    SnapshotBearerContext      bearer_ctx;
+    guint                      i;
+
+    if (!g_dbus_object_manager_server_is_exported (self->priv->object_manager,
+                                                   G_DBUS_OBJECT_SKELETON (modem)))
+        return;
+
+    interfaces = g_dbus_object_get_interfaces (G_DBUS_OBJECT (modem));
+    snapshot_add_object (objects, added, g_dbus_object_get_object_path (G_DBUS_OBJECT (modem)), interfaces);
+    g_list_free_full (interfaces, g_object_unref);
+
+    if (!MM_IS_IFACE_MODEM (modem))
+        return;
+
+    g_object_get (modem,
+                  MM_IFACE_MODEM_SIM,         &sim,
+                  MM_IFACE_MODEM_SIM_SLOTS,   &sim_slots,
+                  MM_IFACE_MODEM_BEARER_LIST, &bearer_list,
+                  NULL);
+
+    if (sim)
+        snapshot_add_interface_object (objects, added, sim);
+    for (i = 0; sim_slots && i < sim_slots->len; i++) {
+        if (g_ptr_array_index (sim_slots, i))
+            snapshot_add_interface_object (objects, added, g_ptr_array_index (sim_slots, i));
+    }
+
+    if (bearer_list) {
+        bearer_ctx.objects = objects;
+        bearer_ctx.added = added;
+        mm_bearer_list_foreach (bearer_list, (MMBearerListForeachFunc)snapshot_add_bearer, &bearer_ctx);
+    }
+}
+
+static gboolean
+handle_get_snapshot (MmGdbusOrgFreedesktopModemManager1 *manager,
+                     GDBusMethodInvocation              *invocation)
+{
+    MMBaseManager        *self;
+    GVariantBuilder       objects;
+    GHashTableIter        iter;
+    gpointer              value;
+    g_autoptr(GHashTable) added = NULL;
+
+    self = MM_BASE_MANAGER (manager);
+    added = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+    g_variant_builder_init (&objects, G_VARIANT_TYPE ("a{oa{sa{sv}}}"));
+    g_hash_table_iter_init (&iter, self->priv->devices);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+        MMBaseModem *modem;
+
+        modem = mm_device_peek_modem (MM_DEVICE (value));
+        if (modem)
+            snapshot_add_modem (self, &objects, added, modem);
+    }
+
+    mm_gdbus_org_freedesktop_modem_manager1_complete_get_snapshot (
+        manager,
+        invocation,
+        g_variant_new ("(u@a{oa{sa{sv}}})", SNAPSHOT_VERSION, g_variant_builder_end (&objects)));
+    return TRUE;
+}
+
+/*****************************************************************************/
+/* Command statistics */
+
+typedef struct {
+    GVariantBuilder *builder;
+    const gchar     *modem_path;
+    const gchar     *port_name;
+} CommandStatsContext;
+
+static void
+command_stats_add (const gchar                    *command,
+                   const MMPortSerialCommandStats *stats,
+                   CommandStatsContext            *ctx)
+{
+    GVariantBuilder entry;
+
+    g_variant_builder_init (&entry, G_VARIANT_TYPE ("a{sv}"));
+    g_variant_builder_add (&entry, "{sv}", "modem",        g_variant_new_object_path (ctx->modem_path));
+    g_variant_builder_add (&entry, "{sv}", "port",         g_variant_new_string (ctx->port_name));
+    g_variant_builder_add (&entry, "{sv}", "command",      g_variant_new_string (command));
+    g_variant_builder_add (&entry, "{sv}", "count",        g_variant_new_uint64 (stats->latency.count));
+    g_variant_builder_add (&entry, "{sv}", "errors",       g_variant_new_uint64 (stats->errors));
+    g_variant_builder_add (&entry, "{sv}", "timeouts",     g_variant_new_uint64 (stats->timeouts));
+    g_variant_builder_add (&entry, "{sv}", "retries",      g_variant_new_uint64 (stats->retries));
+    g_variant_builder_add (&entry, "{sv}", "latency-min",  g_variant_new_uint64 (stats->latency.min));
+    g_variant_builder_add (&entry, "{sv}", "latency-mean", g_variant_new_uint64 (mm_histogram_get_mean (&stats->latency)));
+    g_variant_builder_add (&entry, "{sv}", "latency-p50",  g_variant_new_uint64 (mm_histogram_get_percentile (&stats->latency, 50)));
+    g_variant_builder_add (&entry, "{sv}", "latency-p90",  g_variant_new_uint64 (mm_histogram_get_percentile (&stats->latency, 90)));
+    g_variant_builder_add (&entry, "{sv}", "latency-p99",  g_variant_new_uint64 (mm_histogram_get_percentile (&stats->latency, 99)));
+    g_variant_builder_add (&entry, "{sv}", "latency-max",  g_variant_new_uint64 (stats->latency.max));
+    g_variant_builder_add_value (ctx->builder, g_variant_builder_end (&entry));
+}
+
+static gboolean
+handle_get_command_stats (MmGdbusOrgFreedesktopModemManager1 *manager,
+                          GDBusMethodInvocation              *invocation)
+{
+    MMBaseManager   *self;
+    GVariantBuilder  builder;
+    GHashTableIter   iter;
+    gpointer         value;
+
+    self = MM_BASE_MANAGER (manager);
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("aa{sv}"));
+    g_hash_table_iter_init (&iter, self->priv->devices);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+        MMBaseModem         *modem;
+        CommandStatsContext  ctx;
+        GList               *ports;
+        GList               *l;
+
+        modem = mm_device_peek_modem (MM_DEVICE (value));
+        if (!modem)
+            continue;
+
+        /* Only modems exported in the bus, so that they can be referred to */
+        ctx.builder = &builder;
+        ctx.modem_path = g_dbus_object_get_object_path (G_DBUS_OBJECT (modem));
+        if (!ctx.modem_path)
+            continue;
+
+        ports = mm_base_modem_find_ports (modem, MM_PORT_SUBSYS_UNKNOWN, MM_PORT_TYPE_UNKNOWN);
+        for (l = ports; l; l = g_list_next (l)) {
+            if (!MM_IS_PORT_SERIAL (l->data))
+                continue;
+            ctx.port_name = mm_port_get_device (MM_PORT (l->data));
+            mm_port_serial_command_stats_foreach (MM_PORT_SERIAL (l->data),
+                                                  (MMPortSerialCommandStatsForeachFunc) command_stats_add,
+                                                  &ctx);
+        }
+        g_list_free_full (ports, g_object_unref);
+    }
+
+    mm_gdbus_org_freedesktop_modem_manager1_complete_get_command_stats (
+        manager,
+        invocation,
+        g_variant_builder_end (&builder));
+    return TRUE;
+}
+
+/*****************************************************************************/
+/* Memory usage */
+
+static gboolean
+handle_get_memory_usage (MmGdbusOrgFreedesktopModemManager1 *manager,
+                         GDBusMethodInvocation              *invocation)
+{
+    MMBaseManager   *self;
+    GVariantBuilder  builder;
+    GHashTableIter   iter;
+    gpointer         value;
+
+    self = MM_BASE_MANAGER (manager);
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("aa{sv}"));
+    if (!mm_memory_usage_supported ())
+        goto out;
+
+    g_hash_table_iter_init (&iter, self->priv->devices);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+        MMBaseModem         *modem;
+        const MMMemoryUsage *usage;
+        const gchar         *modem_path;
+        GVariantBuilder      entry;
+        guint                i;
+
+        modem = mm_device_peek_modem (MM_DEVICE (value));
+        if (!modem || !MM_IS_BROADBAND_MODEM (modem))
+            continue;
+
+        /* Only modems exported in the bus, so that they can be referred to */
+        modem_path = g_dbus_object_get_object_path (G_DBUS_OBJECT (modem));
+        if (!modem_path)
+            continue;
+
+        usage = mm_broadband_modem_peek_memory_usage (MM_BROADBAND_MODEM (modem));
+        g_variant_builder_init (&entry, G_VARIANT_TYPE ("a{sv}"));
+        g_variant_builder_add (&entry, "{sv}", "modem", g_variant_new_object_path (modem_path));
+        g_variant_builder_add (&entry, "{sv}", "total", g_variant_new_uint64 ((guint64) mm_memory_usage_get_total (usage)));
+        for (i = 0; i < MM_MEMORY_SUBSYSTEM_LAST; i++)
+            g_variant_builder_add (&entry, "{sv}",
+                                   mm_memory_subsystem_get_string (i),
+                                   g_variant_new_uint64 ((guint64) usage->bytes[i]));
+        g_variant_builder_add_value (&builder, g_variant_builder_end (&entry));
+    }
+
+out:
+    mm_gdbus_org_freedesktop_modem_manager1_complete_get_memory_usage (
+        manager,
+        invocation,
+        g_variant_builder_end (&builder));
+    return TRUE;
+}
+
 /*****************************************************************************/
 /* Manual scan */
 
@@ -2113,6 +2385,9 @@ mm_base_manager_init (MMBaseManager *self)
                       "signal::handle-scan-devices",        G_CALLBACK (handle_scan_devices),        NULL,
                       "signal::handle-report-kernel-event", G_CALLBACK (handle_report_kernel_event), NULL,
                       "signal::handle-inhibit-device",      G_CALLBACK (handle_inhibit_device),      NULL,
+                      "signal::handle-get-snapshot",        G_CALLBACK (handle_get_snapshot),        NULL,
+                      "signal::handle-get-command-stats",   G_CALLBACK (handle_get_command_stats),   NULL,
+                      "signal::handle-get-memory-usage",    G_CALLBACK (handle_get_memory_usage),    NULL,
                       NULL);
 }
 
@@ -1686,54 +1686,240 @@ mm_base_sim_is_emergency_number (MMBaseSim   *self,
     }
 
 /*****************************************************************************/
-/* Emergency numbers */
+/* SIM file cache */
 
-static GStrv
-parse_emergency_numbers (const gchar  *response,
-                         GError      **error)
+/* Maximum number of different cards kept in the cache */
+#define FILE_CACHE_MAX_CARDS 32
+
+/* card id -> (file id -> GBytes) */
+static GHashTable *file_cache;
+
+static gchar *
+file_cache_build_card_id (MMBaseSim *self)
 {
-    guint  sw1 = 0;
-    guint  sw2 = 0;
-    gchar *hex = 0;
-    GStrv  ret;
+    const gchar *iccid;
+    const gchar *imsi;
 
-    if (!mm_3gpp_parse_crsm_response (response, &sw1, &sw2, &hex, error))
+    /* The IMSI is also part of the key, as it may be switched without
+     * changing the ICCID (e.g. multi-IMSI cards) */
+    iccid = mm_gdbus_sim_get_sim_identifier (MM_GDBUS_SIM (self));
+    imsi = mm_gdbus_sim_get_imsi (MM_GDBUS_SIM (self));
+    if (!iccid || !imsi)
         return NULL;
+    return g_strdup_printf ("%s/%s", iccid, imsi);
+}
 
-    if ((sw1 == 0x90 && sw2 == 0x00) ||
-        (sw1 == 0x91) ||
-        (sw1 == 0x92) ||
-        (sw1 == 0x9f)) {
-        ret = mm_3gpp_parse_emergency_numbers (hex, error);
-        g_free (hex);
-        return ret;
+GBytes *
+mm_base_sim_lookup_file (MMBaseSim *self,
+                         guint16    file_id)
+{
+    g_autofree gchar *card_id = NULL;
+    GHashTable       *files;
+    GBytes           *contents;
+
+    if (!file_cache)
+        return NULL;
+
+    card_id = file_cache_build_card_id (self);
+    if (!card_id)
+        return NULL;
+
+    files = g_hash_table_lookup (file_cache, card_id);
+    if (!files)
+        return NULL;
+
+    contents = g_hash_table_lookup (files, GUINT_TO_POINTER (file_id));
+    if (!contents)
+        return NULL;
+
+    mm_obj_dbg (self, "SIM file 0x%04x loaded from cache", file_id);
+    return g_bytes_ref (contents);
+}
+
+void
+mm_base_sim_store_file (MMBaseSim    *self,
+                        guint16       file_id,
+                        const guint8 *data,
+                        gsize         data_len)
+{
+    g_autofree gchar *card_id = NULL;
+    GHashTable       *files;
+
+    card_id = file_cache_build_card_id (self);
+    if (!card_id)
+        return;
+
+    if (G_UNLIKELY (!file_cache))
+        file_cache = g_hash_table_new_full (g_str_hash,
+                                            g_str_equal,
+                                            g_free,
+                                            (GDestroyNotify) g_hash_table_unref);
+
+    files = g_hash_table_lookup (file_cache, card_id);
+    if (!files) {
+        /* Just start over if there are too many different cards */
+        if (g_hash_table_size (file_cache) >= FILE_CACHE_MAX_CARDS)
+            g_hash_table_remove_all (file_cache);
+        files = g_hash_table_new_full (g_direct_hash,
+                                       g_direct_equal,
+                                       NULL,
+                                       (GDestroyNotify) g_bytes_unref);
+        g_hash_table_insert (file_cache, g_steal_pointer (&card_id), files);
+    }
+
+    g_hash_table_replace (files, GUINT_TO_POINTER (file_id), g_bytes_new (data, data_len));
+}
+
+void
+mm_base_sim_forget_files (MMBaseSim *self)
+{
+    g_autofree gchar *card_id = NULL;
+
+    if (!file_cache)
+        return;
+
+    card_id = file_cache_build_card_id (self);
+    if (card_id && g_hash_table_remove (file_cache, card_id))
+        mm_obj_dbg (self, "cached SIM files removed");
+}
+
+/*****************************************************************************/
+/* READ BINARY of transparent elementary files with +CRSM, using the file cache */
+
+#define FILE_ID_ECC   0x6FB7
+#define FILE_ID_AD    0x6FAD
+#define FILE_ID_SPN   0x6F46
+#define FILE_ID_GID1  0x6F3E
+#define FILE_ID_GID2  0x6F3F
+
+static GBytes *
+read_binary_finish (MMBaseSim     *self,
+                    GAsyncResult  *res,
+                    GError       **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+read_binary_command_ready (MMBaseModem  *modem,
+                           GAsyncResult *res,
+                           GTask        *task)
+{
+    MMBaseSim          *self;
+    const gchar        *response;
+    GError             *error = NULL;
+    guint               sw1 = 0;
+    guint               sw2 = 0;
+    g_autofree gchar   *hex = NULL;
+    g_autofree guint8  *bin = NULL;
+    gsize               binlen = 0;
+
+    self = g_task_get_source_object (task);
+
+    response = mm_base_modem_at_command_finish (modem, res, &error);
+    if (!response || !mm_3gpp_parse_crsm_response (response, &sw1, &sw2, &hex, &error)) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    if (!((sw1 == 0x90 && sw2 == 0x00) ||
+          (sw1 == 0x91) ||
+          (sw1 == 0x92) ||
+          (sw1 == 0x9f))) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                 "SIM failed to handle CRSM request (sw1 %d sw2 %d)", sw1, sw2);
+        g_object_unref (task);
+        return;
+    }
+
+    /* Convert hex string to binary */
+    bin = mm_utils_hexstr2bin (hex, -1, &binlen, &error);
+    if (!bin) {
+        g_prefix_error (&error, "SIM returned malformed response '%s': ", hex);
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    mm_base_sim_store_file (self, GPOINTER_TO_UINT (g_task_get_task_data (task)), bin, binlen);
+    g_task_return_pointer (task,
+                           g_bytes_new_take (g_steal_pointer (&bin), binlen),
+                           (GDestroyNotify) g_bytes_unref);
+    g_object_unref (task);
+}
+
+static void
+read_binary (MMBaseSim           *self,
+             guint16              file_id,
+             guint                length,
+             guint                timeout,
+             GAsyncReadyCallback  callback,
+             gpointer             user_data)
+{
+    GTask            *task;
+    GBytes           *contents;
+    g_autofree gchar *cmd = NULL;
+
+    task = g_task_new (self, NULL, callback, user_data);
+
+    contents = mm_base_sim_lookup_file (self, file_id);
+    if (contents) {
+        g_task_return_pointer (task, contents, (GDestroyNotify) g_bytes_unref);
+        g_object_unref (task);
+        return;
     }
 
-    g_free (hex);
-    g_set_error (error,
-                 MM_CORE_ERROR,
-                 MM_CORE_ERROR_FAILED,
-                 "SIM failed to handle CRSM request (sw1 %d sw2 %d)",
-                 sw1, sw2);
-    return NULL;
+    g_task_set_task_data (task, GUINT_TO_POINTER (file_id), NULL);
+    cmd = g_strdup_printf ("+CRSM=176,%u,0,0,%u", file_id, length);
+    mm_base_modem_at_command (self->priv->modem,
+                              cmd,
+                              timeout,
+                              FALSE,
+                              (GAsyncReadyCallback)read_binary_command_ready,
+                              task);
 }
 
+#define BYTES_REPLY_READY_FN(NAME)                                      \
+    static void                                                         \
+    NAME##_read_ready (MMBaseSim    *self,                              \
+                       GAsyncResult *res,                               \
+                       GTask        *task)                              \
+    {                                                                   \
+        GError *error = NULL;                                           \
+        GBytes *contents;                                               \
+                                                                        \
+        contents = read_binary_finish (self, res, &error);              \
+        if (!contents)                                                  \
+            g_task_return_error (task, error);                          \
+        else                                                            \
+            g_task_return_pointer (task, contents, (GDestroyNotify) g_bytes_unref); \
+                                                                        \
+        g_object_unref (task);                                          \
+    }
+
+/*****************************************************************************/
+/* Emergency numbers */
+
 static GStrv
 load_emergency_numbers_finish (MMBaseSim     *self,
                                GAsyncResult  *res,
                                GError       **error)
 {
-    gchar *result;
-    GStrv  emergency_numbers;
-    guint  i;
+    g_autoptr(GBytes)  contents = NULL;
+    g_autofree gchar  *hex = NULL;
+    const guint8      *data;
+    gsize              data_len;
+    GStrv              emergency_numbers;
+    guint              i;
 
-    result = g_task_propagate_pointer (G_TASK (res), error);
-    if (!result)
+    contents = g_task_propagate_pointer (G_TASK (res), error);
+    if (!contents)
         return NULL;
 
-    emergency_numbers = parse_emergency_numbers (result, error);
-    g_free (result);
-
+    data = g_bytes_get_data (contents, &data_len);
+    hex = mm_utils_bin2hexstr (data, data_len);
+    emergency_numbers = mm_3gpp_parse_emergency_numbers (hex, error);
     if (!emergency_numbers)
         return NULL;
 
@@ -1743,7 +1929,7 @@ load_emergency_numbers_finish (MMBaseSim     *self,
     return emergency_numbers;
 }
 
-STR_REPLY_READY_FN (load_emergency_numbers)
+BYTES_REPLY_READY_FN (load_emergency_numbers)
 
 static void
 load_emergency_numbers (MMBaseSim           *self,
@@ -1753,13 +1939,12 @@ load_emergency_numbers (MMBaseSim           *self,
     mm_obj_dbg (self, "loading emergency numbers...");
 
     /* READ BINARY of EF_ECC (Emergency Call Codes) ETSI TS 51.011 section 10.3.27 */
-    mm_base_modem_at_command (
-        self->priv->modem,
-        "+CRSM=176,28599,0,0,15",
-        20,
-        FALSE,
-        (GAsyncReadyCallback)load_emergency_numbers_command_ready,
-        g_task_new (self, NULL, callback, user_data));
+    read_binary (self,
+                 FILE_ID_ECC,
+                 15,
+                 20,
+                 (GAsyncReadyCallback)load_emergency_numbers_read_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 /*****************************************************************************/
@@ -2046,63 +2231,25 @@ load_imsi (MMBaseSim *self,
 /*****************************************************************************/
 /* Operator ID */
 
-static guint
-parse_mnc_length (const gchar *response,
-                  GError **error)
-{
-    guint             sw1 = 0;
-    guint             sw2 = 0;
-    g_autofree gchar *hex = NULL;
-
-    if (!mm_3gpp_parse_crsm_response (response,
-                                      &sw1,
-                                      &sw2,
-                                      &hex,
-                                      error))
-        return 0;
-
-    if ((sw1 == 0x90 && sw2 == 0x00) ||
-        (sw1 == 0x91) ||
-        (sw1 == 0x92) ||
-        (sw1 == 0x9f)) {
-        gsize              buflen = 0;
-        g_autofree guint8 *bin = NULL;
-
-        /* Convert hex string to binary */
-        bin = mm_utils_hexstr2bin (hex, -1, &buflen, error);
-        if (!bin) {
-            g_prefix_error (error, "SIM returned malformed response '%s': ", hex);
-            return 0;
-        }
-
-        return mm_sim_validate_mnc_length (bin, buflen, error);
-    }
-
-    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                 "SIM failed to handle CRSM request (sw1 %d sw2 %d)", sw1, sw2);
-    return 0;
-}
-
 static gchar *
 load_operator_identifier_finish (MMBaseSim *self,
                                  GAsyncResult *res,
                                  GError **error)
 {
-    GError *inner_error = NULL;
-    const gchar *imsi;
-    gchar *result;
-    guint mnc_length;
+    g_autoptr(GBytes)  contents = NULL;
+    const guint8      *data;
+    gsize              data_len;
+    const gchar       *imsi;
+    guint              mnc_length;
 
-    result = g_task_propagate_pointer (G_TASK (res), error);
-    if (!result)
+    contents = g_task_propagate_pointer (G_TASK (res), error);
+    if (!contents)
         return NULL;
 
-    mnc_length = parse_mnc_length (result, &inner_error);
-    g_free (result);
-    if (inner_error) {
-        g_propagate_error (error, inner_error);
+    data = g_bytes_get_data (contents, &data_len);
+    mnc_length = mm_sim_validate_mnc_length (data, data_len, error);
+    if (!mnc_length)
         return NULL;
-    }
 
     imsi = mm_gdbus_sim_get_imsi (MM_GDBUS_SIM (self));
     if (!imsi) {
@@ -2117,7 +2264,7 @@ load_operator_identifier_finish (MMBaseSim *self,
     return g_strndup (imsi, 3 + mnc_length);
 }
 
-STR_REPLY_READY_FN (load_operator_identifier)
+BYTES_REPLY_READY_FN (load_operator_identifier)
 
 static void
 load_operator_identifier (MMBaseSim *self,
@@ -2129,73 +2276,35 @@ load_operator_identifier (MMBaseSim *self,
     /* READ BINARY of EFad (Administrative Data) ETSI 51.011 section 10.3.18
      * SIMCOM A760xE-H modems can answer in 10s or more, so use rather big timeout
      */
-    mm_base_modem_at_command (
-        self->priv->modem,
-        "+CRSM=176,28589,0,0,4",
-        20,
-        FALSE,
-        (GAsyncReadyCallback)load_operator_identifier_command_ready,
-        g_task_new (self, NULL, callback, user_data));
+    read_binary (self,
+                 FILE_ID_AD,
+                 4,
+                 20,
+                 (GAsyncReadyCallback)load_operator_identifier_read_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 /*****************************************************************************/
 /* Operator Name (Service Provider Name) */
 
-static gchar *
-parse_spn (const gchar *response,
-           GError **error)
-{
-    guint             sw1 = 0;
-    guint             sw2 = 0;
-    g_autofree gchar *hex = NULL;
-
-    if (!mm_3gpp_parse_crsm_response (response,
-                                      &sw1,
-                                      &sw2,
-                                      &hex,
-                                      error))
-        return NULL;
-
-    if ((sw1 == 0x90 && sw2 == 0x00) ||
-        (sw1 == 0x91) ||
-        (sw1 == 0x92) ||
-        (sw1 == 0x9f)) {
-        g_autofree guint8     *bin = NULL;
-        gsize                  binlen = 0;
-
-        /* Convert hex string to binary */
-        bin = mm_utils_hexstr2bin (hex, -1, &binlen, error);
-        if (!bin) {
-            g_prefix_error (error, "SIM returned malformed response '%s': ", hex);
-            return NULL;
-        }
-
-        return mm_sim_convert_spn_to_utf8 (bin, binlen, error);
-    }
-
-    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                 "SIM failed to handle CRSM request (sw1 %d sw2 %d)", sw1, sw2);
-    return NULL;
-}
-
 static gchar *
 load_operator_name_finish (MMBaseSim *self,
                            GAsyncResult *res,
                            GError **error)
 {
-    gchar *result;
-    gchar *spn;
+    g_autoptr(GBytes)  contents = NULL;
+    const guint8      *data;
+    gsize              data_len;
 
-    result = g_task_propagate_pointer (G_TASK (res), error);
-    if (!result)
+    contents = g_task_propagate_pointer (G_TASK (res), error);
+    if (!contents)
         return NULL;
 
-    spn = parse_spn (result, error);
-    g_free (result);
-    return spn;
+    data = g_bytes_get_data (contents, &data_len);
+    return mm_sim_convert_spn_to_utf8 (data, data_len, error);
 }
 
-STR_REPLY_READY_FN (load_operator_name)
+BYTES_REPLY_READY_FN (load_operator_name)
 
 static void
 load_operator_name (MMBaseSim *self,
@@ -2205,68 +2314,37 @@ load_operator_name (MMBaseSim *self,
     mm_obj_dbg (self, "loading operator name...");
 
     /* READ BINARY of EFspn (Service Provider Name) ETSI 51.011 section 10.3.11 */
-    mm_base_modem_at_command (
-        self->priv->modem,
-        "+CRSM=176,28486,0,0,17",
-        10,
-        FALSE,
-        (GAsyncReadyCallback)load_operator_name_command_ready,
-        g_task_new (self, NULL, callback, user_data));
+    read_binary (self,
+                 FILE_ID_SPN,
+                 17,
+                 10,
+                 (GAsyncReadyCallback)load_operator_name_read_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 /*****************************************************************************/
 /* GID1 and GID2 */
 
-static GByteArray *
-parse_gid (const gchar  *response,
-           GError      **error)
-{
-    guint             sw1 = 0;
-    guint             sw2 = 0;
-    g_autofree gchar *hex = NULL;
-
-    if (!mm_3gpp_parse_crsm_response (response, &sw1, &sw2, &hex, error))
-        return NULL;
-
-    if ((sw1 == 0x90 && sw2 == 0x00) ||
-        (sw1 == 0x91) ||
-        (sw1 == 0x92) ||
-        (sw1 == 0x9f)) {
-        guint8 *bin = NULL;
-        gsize   binlen = 0;
-
-        /* Convert hex string to binary */
-        bin = mm_utils_hexstr2bin (hex, -1, &binlen, error);
-        if (!bin) {
-            g_prefix_error (error, "SIM returned malformed response '%s': ", hex);
-            return NULL;
-        }
-
-        /* return as bytearray */
-        return g_byte_array_new_take (bin, binlen);
-    }
-
-    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                 "SIM failed to handle CRSM request (sw1 %d sw2 %d)", sw1, sw2);
-    return NULL;
-}
-
 static GByteArray *
 common_load_gid_finish (MMBaseSim     *self,
                         GAsyncResult  *res,
                         GError       **error)
 {
-    g_autofree gchar *result = NULL;
+    g_autoptr(GBytes)  contents = NULL;
+    const guint8      *data;
+    gsize              data_len;
 
-    result = g_task_propagate_pointer (G_TASK (res), error);
-    if (!result)
+    contents = g_task_propagate_pointer (G_TASK (res), error);
+    if (!contents)
         return NULL;
 
-    return parse_gid (result, error);
+    /* return as bytearray */
+    data = g_bytes_get_data (contents, &data_len);
+    return g_byte_array_append (g_byte_array_sized_new (data_len), data, data_len);
 }
 
-STR_REPLY_READY_FN (load_gid1)
-STR_REPLY_READY_FN (load_gid2)
+BYTES_REPLY_READY_FN (load_gid1)
+BYTES_REPLY_READY_FN (load_gid2)
 
 static void
 load_gid1 (MMBaseSim           *self,
@@ -2274,13 +2352,12 @@ load_gid1 (MMBaseSim           *self,
            gpointer             user_data)
 {
     /* READ BINARY of EFgid1 */
-    mm_base_modem_at_command (
-        self->priv->modem,
-        "+CRSM=176,28478,0,0,0",
-        10,
-        FALSE,
-        (GAsyncReadyCallback)load_gid1_command_ready,
-        g_task_new (self, NULL, callback, user_data));
+    read_binary (self,
+                 FILE_ID_GID1,
+                 0,
+                 10,
+                 (GAsyncReadyCallback)load_gid1_read_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 static void
@@ -2289,13 +2366,12 @@ load_gid2 (MMBaseSim           *self,
            gpointer             user_data)
 {
     /* READ BINARY of EFgid2 */
-    mm_base_modem_at_command (
-        self->priv->modem,
-        "+CRSM=176,28479,0,0,0",
-        10,
-        FALSE,
-        (GAsyncReadyCallback)load_gid2_command_ready,
-        g_task_new (self, NULL, callback, user_data));
+    read_binary (self,
+                 FILE_ID_GID2,
+                 0,
+                 10,
+                 (GAsyncReadyCallback)load_gid2_read_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 /*****************************************************************************/
@@ -2343,6 +2419,7 @@ typedef enum {
     INITIALIZATION_STEP_ESIM_STATUS,
     INITIALIZATION_STEP_SIM_IDENTIFIER,
     INITIALIZATION_STEP_IMSI,
+    INITIALIZATION_STEP_PREFETCH_FILES,
     INITIALIZATION_STEP_OPERATOR_ID,
     INITIALIZATION_STEP_OPERATOR_NAME,
     INITIALIZATION_STEP_EMERGENCY_NUMBERS,
@@ -2597,6 +2674,24 @@ init_load_sim_identifier_ready (MMBaseSim *self,
 ENUM_REPLY_READY_FN (esim_status, "esim status", MMSimEsimStatus, mm_sim_esim_status_get_string)
 ENUM_REPLY_READY_FN (sim_type,    "sim type",    MMSimType,       mm_sim_type_get_string)
 
+static void
+init_prefetch_files_ready (MMBaseSim    *self,
+                           GAsyncResult *res,
+                           GTask        *task)
+{
+    InitAsyncContext  *ctx;
+    g_autoptr(GError)  error = NULL;
+
+    /* Not fatal, files will be read one by one when needed */
+    if (!MM_BASE_SIM_GET_CLASS (self)->prefetch_files_finish (self, res, &error))
+        mm_obj_dbg (self, "couldn't prefetch SIM files: %s", error->message);
+
+    /* Go on to next step */
+    ctx = g_task_get_task_data (task);
+    ctx->step++;
+    interface_initialization_step (task);
+}
+
 static void
 init_wait_sim_ready (MMBaseSim    *self,
                      GAsyncResult *res,
@@ -2710,6 +2805,20 @@ interface_initialization_step (GTask *task)
         ctx->step++;
         /* Fall through */
 
+    case INITIALIZATION_STEP_PREFETCH_FILES:
+        if (IS_ESIM_WITHOUT_PROFILES (self))
+            mm_obj_dbg (self, "not prefetching SIM files in eSIM without profiles");
+        else if (MM_BASE_SIM_GET_CLASS (self)->prefetch_files &&
+                 MM_BASE_SIM_GET_CLASS (self)->prefetch_files_finish) {
+            MM_BASE_SIM_GET_CLASS (self)->prefetch_files (
+                self,
+                (GAsyncReadyCallback)init_prefetch_files_ready,
+                task);
+            return;
+        }
+        ctx->step++;
+        /* Fall through */
+
     case INITIALIZATION_STEP_OPERATOR_ID:
         /* Don't load operator ID if the SIM is known to be an eSIM without
          * profiles; otherwise (if physical SIM, or if eSIM with profile, or if
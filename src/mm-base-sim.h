@@ -156,6 +156,15 @@ struct _MMBaseSimClass {
                                                     GAsyncResult         *res,
                                                     GError              **error);
 
+    /* Read in one go all the SIM files required by the load operations that
+     * run after the IMSI is known, storing them in the file cache (async) */
+    void     (* prefetch_files)        (MMBaseSim            *self,
+                                        GAsyncReadyCallback   callback,
+                                        gpointer              user_data);
+    gboolean (* prefetch_files_finish) (MMBaseSim            *self,
+                                        GAsyncResult         *res,
+                                        GError              **error);
+
     /* Change PIN (async) */
     void     (* change_pin)        (MMBaseSim *self,
                                     const gchar *old_pin,
@@ -274,4 +283,15 @@ gboolean     mm_base_sim_is_emergency_number (MMBaseSim   *self,
 
 gboolean     mm_base_sim_is_esim_without_profiles (MMBaseSim *self);
 
+/* Contents of the elementary files read from the card, kept during the whole
+ * daemon lifetime and keyed by the ICCID and IMSI of the card; only available
+ * once both have been loaded. */
+GBytes      *mm_base_sim_lookup_file  (MMBaseSim    *self,
+                                       guint16       file_id);
+void         mm_base_sim_store_file   (MMBaseSim    *self,
+                                       guint16       file_id,
+                                       const guint8 *data,
+                                       gsize         data_len);
+void         mm_base_sim_forget_files (MMBaseSim    *self);
+
 #endif /* MM_BASE_SIM_H */
@@ -72,6 +72,9 @@ struct _MMBroadbandBearerPrivate {
     /*-- 3GPP specific --*/
     /* CID of the PDP context */
     gint profile_id;
+
+    /* Ongoing connection status wait, if any */
+    GTask *wait_status_task;
 };
 
 /*****************************************************************************/
@@ -1733,6 +1736,228 @@ load_connection_status (MMBaseBearer        *self,
                                    task);
 }
 
+/*****************************************************************************/
+/* Wait for the connection status reached after a connection or disconnection
+ * request; see mm_broadband_bearer_wait_connection_status() */
+
+/* The first status poll is run shortly after the wait starts and the interval
+ * is doubled after every poll, up to the 1s used between vendor polls
+ * before. */
+#define WAIT_STATUS_POLL_INITIAL_INTERVAL_MS 250
+#define WAIT_STATUS_POLL_MAX_INTERVAL_MS     1000
+
+typedef struct {
+    MMBearerConnectionStatus             status;
+    MMBroadbandBearerStatusPollFn        poll;
+    MMBroadbandBearerStatusPollFinishFn  poll_finish;
+    gpointer                             poll_data;
+    guint                                poll_interval_ms;
+    guint                                poll_id;
+    guint                                timeout_id;
+    guint                                n_polls;
+} WaitConnectionStatusContext;
+
+static void
+wait_connection_status_context_free (WaitConnectionStatusContext *ctx)
+{
+    g_assert (!ctx->poll_id);
+    g_assert (!ctx->timeout_id);
+    g_slice_free (WaitConnectionStatusContext, ctx);
+}
+
+gboolean
+mm_broadband_bearer_wait_connection_status_finish (MMBroadbandBearer  *self,
+                                                   GAsyncResult       *res,
+                                                   GError            **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+wait_connection_status_complete (MMBroadbandBearer *self,
+                                 GError            *error)
+{
+    GTask                       *task;
+    WaitConnectionStatusContext *ctx;
+
+    task = g_steal_pointer (&self->priv->wait_status_task);
+    g_assert (task);
+    ctx = g_task_get_task_data (task);
+
+    if (ctx->poll_id) {
+        g_source_remove (ctx->poll_id);
+        ctx->poll_id = 0;
+    }
+    if (ctx->timeout_id) {
+        g_source_remove (ctx->timeout_id);
+        ctx->timeout_id = 0;
+    }
+
+    if (error)
+        g_task_return_error (task, error);
+    else {
+        mm_obj_dbg (self, "connection status '%s' reached (%u polls run)",
+                    mm_bearer_connection_status_get_string (ctx->status), ctx->n_polls);
+        g_task_return_boolean (task, TRUE);
+    }
+    g_object_unref (task);
+}
+
+static gboolean wait_connection_status_poll_cb (GTask *task);
+
+static void
+wait_connection_status_schedule_poll (GTask *task)
+{
+    WaitConnectionStatusContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+    g_assert (!ctx->poll_id);
+    ctx->poll_id = g_timeout_add (ctx->poll_interval_ms, (GSourceFunc) wait_connection_status_poll_cb, task);
+    ctx->poll_interval_ms = MIN (ctx->poll_interval_ms * 2, WAIT_STATUS_POLL_MAX_INTERVAL_MS);
+}
+
+static void
+wait_connection_status_poll_ready (MMBroadbandBearer *self,
+                                   GAsyncResult      *res,
+                                   GTask             *task)
+{
+    WaitConnectionStatusContext *ctx;
+    MMBearerConnectionStatus     status;
+    GError                      *error = NULL;
+
+    /* If the wait was already completed (e.g. by an unsolicited message) the
+     * vendor poll data may no longer be valid, so the result is ignored */
+    if (self->priv->wait_status_task != task) {
+        mm_obj_dbg (self, "connection status wait already finished, ignoring poll result");
+        g_object_unref (task);
+        return;
+    }
+
+    ctx = g_task_get_task_data (task);
+
+    status = ctx->poll_finish (self, res, ctx->poll_data, &error);
+    if (error)
+        wait_connection_status_complete (self, error);
+    else if (status == ctx->status)
+        wait_connection_status_complete (self, NULL);
+    else
+        wait_connection_status_schedule_poll (task);
+
+    g_object_unref (task);
+}
+
+static gboolean
+wait_connection_status_poll_cb (GTask *task)
+{
+    MMBroadbandBearer           *self;
+    WaitConnectionStatusContext *ctx;
+
+    self = g_task_get_source_object (task);
+    ctx  = g_task_get_task_data (task);
+
+    ctx->poll_id = 0;
+
+    if (g_cancellable_is_cancelled (g_task_get_cancellable (task))) {
+        wait_connection_status_complete (self,
+                                         g_error_new_literal (G_IO_ERROR, G_IO_ERROR_CANCELLED,
+                                                              "Connection status wait has been cancelled"));
+        return G_SOURCE_REMOVE;
+    }
+
+    /* Without a poll method, just keep on checking for cancellation while
+     * waiting for the unsolicited message */
+    if (!ctx->poll) {
+        wait_connection_status_schedule_poll (task);
+        return G_SOURCE_REMOVE;
+    }
+
+    ctx->n_polls++;
+    ctx->poll (self,
+               ctx->poll_data,
+               (GAsyncReadyCallback) wait_connection_status_poll_ready,
+               g_object_ref (task));
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean
+wait_connection_status_timeout_cb (GTask *task)
+{
+    MMBroadbandBearer           *self;
+    WaitConnectionStatusContext *ctx;
+
+    self = g_task_get_source_object (task);
+    ctx  = g_task_get_task_data (task);
+
+    ctx->timeout_id = 0;
+    wait_connection_status_complete (self,
+                                     g_error_new_literal (MM_MOBILE_EQUIPMENT_ERROR,
+                                                          MM_MOBILE_EQUIPMENT_ERROR_NETWORK_TIMEOUT,
+                                                          (ctx->status == MM_BEARER_CONNECTION_STATUS_CONNECTED ?
+                                                           "Connection attempt timed out" :
+                                                           "Disconnection attempt timed out")));
+    return G_SOURCE_REMOVE;
+}
+
+gboolean
+mm_broadband_bearer_wait_connection_status_report (MMBroadbandBearer        *self,
+                                                   MMBearerConnectionStatus  status,
+                                                   const GError             *error)
+{
+    WaitConnectionStatusContext *ctx;
+
+    if (!self->priv->wait_status_task)
+        return FALSE;
+
+    ctx = g_task_get_task_data (self->priv->wait_status_task);
+    if (status == ctx->status)
+        wait_connection_status_complete (self, NULL);
+    else if (error)
+        wait_connection_status_complete (self, g_error_copy (error));
+    else
+        mm_obj_dbg (self, "ignoring connection status '%s' while waiting for '%s'",
+                    mm_bearer_connection_status_get_string (status),
+                    mm_bearer_connection_status_get_string (ctx->status));
+    return TRUE;
+}
+
+void
+mm_broadband_bearer_wait_connection_status (MMBroadbandBearer                   *self,
+                                            MMBearerConnectionStatus             status,
+                                            guint                                timeout,
+                                            MMBroadbandBearerStatusPollFn        poll,
+                                            MMBroadbandBearerStatusPollFinishFn  poll_finish,
+                                            gpointer                             poll_data,
+                                            GCancellable                        *cancellable,
+                                            GAsyncReadyCallback                  callback,
+                                            gpointer                             user_data)
+{
+    GTask                       *task;
+    WaitConnectionStatusContext *ctx;
+
+    g_assert (status == MM_BEARER_CONNECTION_STATUS_CONNECTED ||
+              status == MM_BEARER_CONNECTION_STATUS_DISCONNECTED);
+    g_assert (!poll || poll_finish);
+    g_assert (!self->priv->wait_status_task);
+
+    task = g_task_new (self, cancellable, callback, user_data);
+    /* Once the status is reached the caller decides how to handle a
+     * cancellation, as it may need to undo the connection */
+    g_task_set_check_cancellable (task, FALSE);
+
+    ctx = g_slice_new0 (WaitConnectionStatusContext);
+    ctx->status = status;
+    ctx->poll = poll;
+    ctx->poll_finish = poll_finish;
+    ctx->poll_data = poll_data;
+    ctx->poll_interval_ms = WAIT_STATUS_POLL_INITIAL_INTERVAL_MS;
+    g_task_set_task_data (task, ctx, (GDestroyNotify) wait_connection_status_context_free);
+
+    /* The bearer keeps the task reference until completion */
+    self->priv->wait_status_task = task;
+    ctx->timeout_id = g_timeout_add_seconds (timeout, (GSourceFunc) wait_connection_status_timeout_cb, task);
+    wait_connection_status_schedule_poll (task);
+}
+
 /*****************************************************************************/
 
 static void
@@ -129,6 +129,18 @@ struct _MMBroadbandBearerClass {
                                          GError **error);
 };
 
+/* Connection status poll, run while waiting for a connection status. An error
+ * aborts the wait; any status other than the expected one retries the poll
+ * later on. */
+typedef void                     (* MMBroadbandBearerStatusPollFn)       (MMBroadbandBearer    *self,
+                                                                          gpointer              poll_data,
+                                                                          GAsyncReadyCallback   callback,
+                                                                          gpointer              user_data);
+typedef MMBearerConnectionStatus (* MMBroadbandBearerStatusPollFinishFn) (MMBroadbandBearer    *self,
+                                                                          GAsyncResult         *res,
+                                                                          gpointer              poll_data,
+                                                                          GError              **error);
+
 GType mm_broadband_bearer_get_type (void);
 G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMBroadbandBearer, g_object_unref)
 
@@ -141,4 +153,29 @@ void          mm_broadband_bearer_new        (MMBroadbandModem *modem,
 MMBaseBearer *mm_broadband_bearer_new_finish (GAsyncResult *res,
                                               GError **error);
 
+/* Wait until the connection status is reported (e.g. by a vendor unsolicited
+ * message) through mm_broadband_bearer_wait_connection_status_report(), or
+ * until the optional poll method reads it, for at most the given timeout in
+ * seconds. Polling starts at sub-second intervals with exponential backoff.
+ * Only one wait may be ongoing per bearer. */
+void     mm_broadband_bearer_wait_connection_status        (MMBroadbandBearer                    *self,
+                                                            MMBearerConnectionStatus              status,
+                                                            guint                                 timeout,
+                                                            MMBroadbandBearerStatusPollFn         poll,
+                                                            MMBroadbandBearerStatusPollFinishFn   poll_finish,
+                                                            gpointer                              poll_data,
+                                                            GCancellable                         *cancellable,
+                                                            GAsyncReadyCallback                   callback,
+                                                            gpointer                              user_data);
+gboolean mm_broadband_bearer_wait_connection_status_finish (MMBroadbandBearer                    *self,
+                                                            GAsyncResult                         *res,
+                                                            GError                              **error);
+
+/* Returns TRUE if a wait is ongoing and the status was processed by it. The
+ * expected status completes the wait; any other status fails it if an error
+ * is given, and is ignored otherwise. */
+gboolean mm_broadband_bearer_wait_connection_status_report (MMBroadbandBearer                    *self,
+                                                            MMBearerConnectionStatus              status,
+                                                            const GError                         *error);
+
 #endif /* MM_BROADBAND_BEARER_H */
@@ -2502,6 +2502,7 @@ typedef struct {
     GetCellInfoStep step;
     GList           *rfim_info_list;
     GList           *cell_info_list;
+    MMCellTable     *table;
     GError          *saved_error;
 } GetCellInfoContext;
 
@@ -2530,6 +2531,29 @@ cell_info_list_free (GList *list)
     g_list_free_full (list, (GDestroyNotify)g_object_unref);
 }
 
+static gboolean
+modem_load_cell_info_finish (MMIfaceModem  *self,
+                             GAsyncResult  *res,
+                             GError       **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+/* Loaded cells are either given to the ongoing update of the cell table, or
+ * collected in a list for the GetCellInfo result */
+static void
+cell_info_collect (GetCellInfoContext  *ctx,
+                   GList              **list,
+                   MMCellInfo          *info)
+{
+    if (ctx->table) {
+        mm_cell_table_update_add (ctx->table, info);
+        g_object_unref (info);
+        return;
+    }
+    *list = g_list_append (*list, info);
+}
+
 static void
 base_stations_info_query_ready (MbimDevice   *device,
                                 GAsyncResult *res,
@@ -2677,7 +2701,7 @@ base_stations_info_query_ready (MbimDevice   *device,
         CELL_INFO_SET_HEXSTR (gsm_serving_cell->base_station_id,    0xFFFFFFFF, "", gsm_set_base_station_id, MM_CELL_INFO_GSM);
         CELL_INFO_SET_UINT   (gsm_serving_cell->rx_level,           0xFFFFFFFF,     gsm_set_rx_level,        MM_CELL_INFO_GSM);
 
-        list = g_list_append (list, g_steal_pointer (&info));
+        cell_info_collect (ctx, &list, g_steal_pointer (&info));
     }
 
     if (gsm_neighboring_cells_count && gsm_neighboring_cells) {
@@ -2694,7 +2718,7 @@ base_stations_info_query_ready (MbimDevice   *device,
             CELL_INFO_SET_HEXSTR (gsm_neighboring_cells[i]->base_station_id,    0xFFFFFFFF, "", gsm_set_base_station_id, MM_CELL_INFO_GSM);
             CELL_INFO_SET_UINT   (gsm_neighboring_cells[i]->rx_level,           0xFFFFFFFF,     gsm_set_rx_level,        MM_CELL_INFO_GSM);
 
-            list = g_list_append (list, g_steal_pointer (&info));
+            cell_info_collect (ctx, &list, g_steal_pointer (&info));
         }
     }
 
@@ -2714,7 +2738,7 @@ base_stations_info_query_ready (MbimDevice   *device,
         CELL_INFO_SET_INT_DOUBLE (umts_serving_cell->ecno,                    1,              umts_set_ecio,             MM_CELL_INFO_UMTS);
         CELL_INFO_SET_UINT       (umts_serving_cell->path_loss,               0xFFFFFFFF,     umts_set_path_loss,        MM_CELL_INFO_UMTS);
 
-        list = g_list_append (list, g_steal_pointer (&info));
+        cell_info_collect (ctx, &list, g_steal_pointer (&info));
     }
 
     if (umts_neighboring_cells_count && umts_neighboring_cells) {
@@ -2733,7 +2757,7 @@ base_stations_info_query_ready (MbimDevice   *device,
             CELL_INFO_SET_INT_DOUBLE (umts_neighboring_cells[i]->ecno,                    1,              umts_set_ecio,        MM_CELL_INFO_UMTS);
             CELL_INFO_SET_UINT       (umts_neighboring_cells[i]->path_loss,               0xFFFFFFFF,     umts_set_path_loss,   MM_CELL_INFO_UMTS);
 
-            list = g_list_append (list, g_steal_pointer (&info));
+            cell_info_collect (ctx, &list, g_steal_pointer (&info));
         }
     }
 
@@ -2750,7 +2774,7 @@ base_stations_info_query_ready (MbimDevice   *device,
         CELL_INFO_SET_INT_DOUBLE (tdscdma_serving_cell->rscp,               0xFFFFFFFF,     tdscdma_set_rscp,              MM_CELL_INFO_TDSCDMA);
         CELL_INFO_SET_UINT       (tdscdma_serving_cell->path_loss,          0xFFFFFFFF,     tdscdma_set_path_loss,         MM_CELL_INFO_TDSCDMA);
 
-        list = g_list_append (list, g_steal_pointer (&info));
+        cell_info_collect (ctx, &list, g_steal_pointer (&info));
     }
 
     if (tdscdma_neighboring_cells_count && tdscdma_neighboring_cells) {
@@ -2769,7 +2793,7 @@ base_stations_info_query_ready (MbimDevice   *device,
             CELL_INFO_SET_INT_DOUBLE (tdscdma_neighboring_cells[i]->rscp,               0xFFFFFFFF,     tdscdma_set_rscp,              MM_CELL_INFO_TDSCDMA);
             CELL_INFO_SET_UINT       (tdscdma_neighboring_cells[i]->path_loss,          0xFFFFFFFF,     tdscdma_set_path_loss,         MM_CELL_INFO_TDSCDMA);
 
-            list = g_list_append (list, g_steal_pointer (&info));
+            cell_info_collect (ctx, &list, g_steal_pointer (&info));
         }
     }
 
@@ -2804,7 +2828,7 @@ base_stations_info_query_ready (MbimDevice   *device,
                 mm_rf_info_free (data);
             }
         }
-        list = g_list_append (list, g_steal_pointer (&info));
+        cell_info_collect (ctx, &list, g_steal_pointer (&info));
     }
 
     if (lte_neighboring_cells_count && lte_neighboring_cells) {
@@ -2822,7 +2846,7 @@ base_stations_info_query_ready (MbimDevice   *device,
             CELL_INFO_SET_INT_DOUBLE (lte_neighboring_cells[i]->rsrp,             0xFFFFFFFF,     lte_set_rsrp,        MM_CELL_INFO_LTE);
             CELL_INFO_SET_INT_DOUBLE (lte_neighboring_cells[i]->rsrq,             0xFFFFFFFF,     lte_set_rsrq,        MM_CELL_INFO_LTE);
 
-            list = g_list_append (list, g_steal_pointer (&info));
+            cell_info_collect (ctx, &list, g_steal_pointer (&info));
         }
     }
 
@@ -2839,7 +2863,7 @@ base_stations_info_query_ready (MbimDevice   *device,
             CELL_INFO_SET_HEXSTR     (cdma_cells[i]->ref_pn,           0xFFFFFFFF, "", cdma_set_ref_pn,          MM_CELL_INFO_CDMA);
             CELL_INFO_SET_UINT       (cdma_cells[i]->pilot_strength,   0xFFFFFFFF,     cdma_set_pilot_strength,  MM_CELL_INFO_CDMA);
 
-            list = g_list_append (list, g_steal_pointer (&info));
+            cell_info_collect (ctx, &list, g_steal_pointer (&info));
         }
     }
 
@@ -2879,7 +2903,7 @@ base_stations_info_query_ready (MbimDevice   *device,
                     mm_rf_info_free (data);
                 }
             }
-            list = g_list_append (list, g_steal_pointer (&info));
+            cell_info_collect (ctx, &list, g_steal_pointer (&info));
         }
     }
 
@@ -2898,7 +2922,7 @@ base_stations_info_query_ready (MbimDevice   *device,
             CELL_INFO_SET_UINT_DOUBLE_SCALED (nr_neighboring_cells[i]->rsrq,             0xFFFFFFFF, -43,  nr5g_set_rsrq,        MM_CELL_INFO_NR5G);
             CELL_INFO_SET_UINT_DOUBLE_SCALED (nr_neighboring_cells[i]->sinr,             0xFFFFFFFF, -23,  nr5g_set_sinr,        MM_CELL_INFO_NR5G);
 
-            list = g_list_append (list, g_steal_pointer (&info));
+            cell_info_collect (ctx, &list, g_steal_pointer (&info));
         }
     }
 
@@ -3006,6 +3030,8 @@ get_cell_info_step (MbimDevice *device,
     case GET_CELL_INFO_STEP_LAST:
         if (ctx->saved_error)
             g_task_return_error (task, g_steal_pointer (&ctx->saved_error));
+        else if (ctx->table)
+            g_task_return_boolean (task, TRUE);
         else if (ctx->cell_info_list)
             g_task_return_pointer (task, ctx->cell_info_list, (GDestroyNotify)cell_info_list_free);
         else
@@ -3022,11 +3048,11 @@ get_cell_info_step (MbimDevice *device,
 
 
 static void
-modem_get_cell_info (MMIfaceModem        *_self,
-                     GAsyncReadyCallback callback,
-                     gpointer            user_data)
+run_get_cell_info (MMBroadbandModemMbim *self,
+                   MMCellTable          *table,
+                   GAsyncReadyCallback   callback,
+                   gpointer              user_data)
 {
-    MMBroadbandModemMbim *self = MM_BROADBAND_MODEM_MBIM (_self);
     MbimDevice           *device;
     GTask                *task;
     GetCellInfoContext   *ctx;
@@ -3037,10 +3063,28 @@ modem_get_cell_info (MMIfaceModem        *_self,
     task = g_task_new (self, NULL, callback, user_data);
     ctx = g_new0 (GetCellInfoContext, 1);
     ctx->step = GET_CELL_INFO_STEP_FIRST;
+    ctx->table = table;
     g_task_set_task_data (task, ctx, (GDestroyNotify)get_cell_info_context_free);
     get_cell_info_step (device, task);
 }
 
+static void
+modem_get_cell_info (MMIfaceModem        *self,
+                     GAsyncReadyCallback callback,
+                     gpointer            user_data)
+{
+    run_get_cell_info (MM_BROADBAND_MODEM_MBIM (self), NULL, callback, user_data);
+}
+
+static void
+modem_load_cell_info (MMIfaceModem        *self,
+                      MMCellTable         *table,
+                      GAsyncReadyCallback  callback,
+                      gpointer             user_data)
+{
+    run_get_cell_info (MM_BROADBAND_MODEM_MBIM (self), table, callback, user_data);
+}
+
 /*****************************************************************************/
 /* Create Bearer (Modem interface) */
 
@@ -5887,8 +5931,11 @@ basic_connect_notification (MMBroadbandModemMbim *self,
             basic_connect_notification_signal_state (self, device, notification);
         break;
     case MBIM_CID_BASIC_CONNECT_REGISTER_STATE:
-        if (self->priv->setup_flags & PROCESS_NOTIFICATION_FLAG_REGISTRATION_UPDATES)
+        if (self->priv->setup_flags & PROCESS_NOTIFICATION_FLAG_REGISTRATION_UPDATES) {
             basic_connect_notification_register_state (self, device, notification);
+            /* The serving cell may have changed, so refresh cell info */
+            mm_iface_modem_refresh_cell_info (MM_IFACE_MODEM (self));
+        }
         break;
     case MBIM_CID_BASIC_CONNECT_CONNECT:
         if (self->priv->setup_flags & PROCESS_NOTIFICATION_FLAG_CONNECT)
@@ -10558,6 +10605,8 @@ iface_modem_init (MMIfaceModemInterface *iface)
     iface->load_signal_quality_finish = modem_load_signal_quality_finish;
     iface->get_cell_info = modem_get_cell_info;
     iface->get_cell_info_finish = modem_get_cell_info_finish;
+    iface->load_cell_info = modem_load_cell_info;
+    iface->load_cell_info_finish = modem_load_cell_info_finish;
 
     /* Unneeded things */
     iface->modem_after_power_up = NULL;
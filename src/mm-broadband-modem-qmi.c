@@ -896,7 +896,7 @@ modem_load_unlock_required_finish (MMIfaceModem  *self,
 static void load_unlock_required_context_step (GTask *task);
 
 static void
-unlock_required_uim_get_card_status_ready (QmiClientUim *client,
+unlock_required_uim_get_card_status_ready (MMSharedQmi  *_self,
                                            GAsyncResult *res,
                                            GTask        *task)
 {
@@ -906,11 +906,11 @@ unlock_required_uim_get_card_status_ready (QmiClientUim *client,
     GError *error = NULL;
     MMModemLock lock = MM_MODEM_LOCK_UNKNOWN;
 
-    self = g_task_get_source_object (task);
+    self = MM_BROADBAND_MODEM_QMI (_self);
     ctx = g_task_get_task_data (task);
 
-    output = qmi_client_uim_get_card_status_finish (client, res, &error);
-    if (!output || !qmi_message_uim_get_card_status_output_get_result (output, &error)) {
+    output = mm_shared_qmi_uim_get_card_status_finish (_self, res, &error);
+    if (!output) {
         g_prefix_error (&error, "QMI operation failed: ");
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -1096,23 +1096,11 @@ load_unlock_required_context_step (GTask *task)
 
     case LOAD_UNLOCK_REQUIRED_STEP_UIM:
         /* Failure to get UIM client at this point is hard as well */
-        client = mm_shared_qmi_peek_client (MM_SHARED_QMI (self),
-                                            QMI_SERVICE_UIM,
-                                            MM_PORT_QMI_FLAG_DEFAULT,
-                                            &error);
-        if (!client) {
-            g_task_return_error (task, error);
-            g_object_unref (task);
-            return;
-        }
-
         mm_obj_dbg (self, "loading unlock required (UIM)...");
-        qmi_client_uim_get_card_status (QMI_CLIENT_UIM (client),
-                                        NULL,
-                                        5,
-                                        g_task_get_cancellable (task),
-                                        (GAsyncReadyCallback) unlock_required_uim_get_card_status_ready,
-                                        task);
+        mm_shared_qmi_uim_get_card_status (MM_SHARED_QMI (self),
+                                           g_task_get_cancellable (task),
+                                           (GAsyncReadyCallback) unlock_required_uim_get_card_status_ready,
+                                           task);
         return;
 
     default:
@@ -1152,7 +1140,7 @@ modem_load_unlock_retries_finish (MMIfaceModem  *self,
 }
 
 static void
-unlock_retries_uim_get_card_status_ready (QmiClientUim *client,
+unlock_retries_uim_get_card_status_ready (MMSharedQmi  *_self,
                                           GAsyncResult *res,
                                           GTask        *task)
 {
@@ -1167,10 +1155,10 @@ unlock_retries_uim_get_card_status_ready (QmiClientUim *client,
     MMUnlockRetries *retries;
     MMModemLock lock = MM_MODEM_LOCK_UNKNOWN;
 
-    self = g_task_get_source_object (task);
+    self = MM_BROADBAND_MODEM_QMI (_self);
 
-    output = qmi_client_uim_get_card_status_finish (client, res, &error);
-    if (!output || !qmi_message_uim_get_card_status_output_get_result (output, &error)) {
+    output = mm_shared_qmi_uim_get_card_status_finish (_self, res, &error);
+    if (!output) {
         g_prefix_error (&error, "QMI operation failed: ");
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -1184,6 +1172,7 @@ unlock_retries_uim_get_card_status_ready (QmiClientUim *client,
                                                   NULL, &pin2_retries, &puk2_retries,
                                                   &pers_retries,
                                                   &error)) {
+        qmi_message_uim_get_card_status_output_unref (output);
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
@@ -1207,25 +1196,10 @@ static void
 uim_load_unlock_retries (MMBroadbandModemQmi *self,
                          GTask               *task)
 {
-    QmiClient *client;
-    GError *error = NULL;
-
-    client = mm_shared_qmi_peek_client (MM_SHARED_QMI (self),
-                                        QMI_SERVICE_UIM,
-                                        MM_PORT_QMI_FLAG_DEFAULT,
-                                        &error);
-    if (!client) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
-        return;
-    }
-
-    qmi_client_uim_get_card_status (QMI_CLIENT_UIM (client),
-                                    NULL,
-                                    5,
-                                    NULL,
-                                    (GAsyncReadyCallback) unlock_retries_uim_get_card_status_ready,
-                                    task);
+    mm_shared_qmi_uim_get_card_status (MM_SHARED_QMI (self),
+                                       NULL,
+                                       (GAsyncReadyCallback) unlock_retries_uim_get_card_status_ready,
+                                       task);
 }
 
 static void
@@ -1764,6 +1738,32 @@ cell_info_list_free (GList *cell_info_list)
     g_list_free_full (cell_info_list, g_object_unref);
 }
 
+static gboolean
+load_cell_info_finish (MMIfaceModem  *self,
+                       GAsyncResult  *res,
+                       GError       **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+/* Loaded cells are either given to the ongoing update of the cell table set
+ * as task data, or collected in a list for the GetCellInfo result */
+static void
+cell_info_collect (GTask    *task,
+                   GList   **list,
+                   gpointer  info)
+{
+    MMCellTable *table;
+
+    table = g_task_get_task_data (task);
+    if (table) {
+        mm_cell_table_update_add (table, MM_CELL_INFO (info));
+        g_object_unref (info);
+        return;
+    }
+    *list = g_list_append (*list, info);
+}
+
 /* Stolen from qmicli-nas.c as mm_bcd_to_string() doesn't correctly handle
  * special filler byte (0xF) for 2-digit MNCs.
  * ref: Table 10.5.3/3GPP TS 24.008 */
@@ -1876,7 +1876,7 @@ get_cell_info_ready (QmiClientNas *client,
             mm_cell_info_gsm_set_timing_advance (gsm_info, timing_advance);
             mm_cell_info_gsm_set_rx_level (gsm_info, rxlev);
 
-            list = g_list_append (list, g_steal_pointer (&gsm_info));
+            cell_info_collect (task, &list, g_steal_pointer (&gsm_info));
         }
 
         for (i = 0; i < cell_array->len; i++) {
@@ -1902,7 +1902,7 @@ get_cell_info_ready (QmiClientNas *client,
             mm_cell_info_gsm_set_timing_advance (gsm_info, timing_advance);
             mm_cell_info_gsm_set_rx_level (gsm_info, element->rx_level);
 
-            list = g_list_append (list, g_steal_pointer (&gsm_info));
+            cell_info_collect (task, &list, g_steal_pointer (&gsm_info));
         }
     }
 
@@ -1960,7 +1960,7 @@ get_cell_info_ready (QmiClientNas *client,
                 }
             }
 
-            list = g_list_append (list, g_steal_pointer (&lte_info));
+            cell_info_collect (task, &list, g_steal_pointer (&lte_info));
         }
     }
 
@@ -1992,7 +1992,7 @@ get_cell_info_ready (QmiClientNas *client,
                 mm_cell_info_lte_set_rsrp (lte_info, (0.1) * ((gdouble)cell->rsrp));
                 mm_cell_info_lte_set_rsrq (lte_info, (0.1) * ((gdouble)cell->rsrq));
 
-                list = g_list_append (list, g_steal_pointer (&lte_info));
+                cell_info_collect (task, &list, g_steal_pointer (&lte_info));
             }
         }
     }
@@ -2036,18 +2036,22 @@ get_cell_info_ready (QmiClientNas *client,
             mm_cell_info_nr5g_set_nrarfcn (nr5g_info, nr5g_arfcn);
         }
 
-        list = g_list_append (list, g_steal_pointer (&nr5g_info));
+        cell_info_collect (task, &list, g_steal_pointer (&nr5g_info));
     }
 
-    g_task_return_pointer (task, list, (GDestroyNotify)cell_info_list_free);
+    if (g_task_get_task_data (task))
+        g_task_return_boolean (task, TRUE);
+    else
+        g_task_return_pointer (task, list, (GDestroyNotify)cell_info_list_free);
     g_object_unref (task);
     qmi_message_nas_get_cell_location_info_output_unref (output);
 }
 
 static void
-get_cell_info (MMIfaceModem        *self,
-               GAsyncReadyCallback  callback,
-               gpointer             user_data)
+run_get_cell_info (MMIfaceModem        *self,
+                   MMCellTable         *table,
+                   GAsyncReadyCallback  callback,
+                   gpointer             user_data)
 {
     QmiClient *client = NULL;
     GTask *task;
@@ -2056,6 +2060,7 @@ get_cell_info (MMIfaceModem        *self,
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
+    g_task_set_task_data (task, table, NULL);
 
     mm_obj_dbg (self, "getting cell info...");
     qmi_client_nas_get_cell_location_info (QMI_CLIENT_NAS (client),
@@ -2066,6 +2071,23 @@ get_cell_info (MMIfaceModem        *self,
                                            task);
 }
 
+static void
+get_cell_info (MMIfaceModem        *self,
+               GAsyncReadyCallback  callback,
+               gpointer             user_data)
+{
+    run_get_cell_info (self, NULL, callback, user_data);
+}
+
+static void
+load_cell_info (MMIfaceModem        *self,
+                MMCellTable         *table,
+                GAsyncReadyCallback  callback,
+                gpointer             user_data)
+{
+    run_get_cell_info (self, table, callback, user_data);
+}
+
 /*****************************************************************************/
 /* Powering up/down/off the modem (Modem interface) */
 
@@ -2801,7 +2823,7 @@ modem_3gpp_load_enabled_facility_locks_finish (MMIfaceModem3gpp *self,
 }
 
 static void
-get_sim_lock_status_via_get_card_status_ready (QmiClientUim *client,
+get_sim_lock_status_via_get_card_status_ready (MMSharedQmi  *_self,
                                                GAsyncResult *res,
                                                GTask *task)
 {
@@ -2813,16 +2835,14 @@ get_sim_lock_status_via_get_card_status_ready (QmiClientUim *client,
     QmiUimPinState pin1_state;
     QmiUimPinState pin2_state;
 
-    self = g_task_get_source_object (task);
+    self = MM_BROADBAND_MODEM_QMI (_self);
     ctx = g_task_get_task_data (task);
 
-    output = qmi_client_uim_get_card_status_finish (client, res, &error);
-    if (!output || !qmi_message_uim_get_card_status_output_get_result (output, &error)) {
+    output = mm_shared_qmi_uim_get_card_status_finish (_self, res, &error);
+    if (!output) {
         g_prefix_error (&error, "QMI operation failed: ");
         g_task_return_error (task, error);
         g_object_unref (task);
-        if (output)
-            qmi_message_uim_get_card_status_output_unref (output);
         return;
     }
 
@@ -2895,12 +2915,10 @@ get_pin_lock_status_via_get_configuration_ready (QmiClientUim *client,
     qmi_message_uim_get_configuration_output_unref (output);
 
     mm_obj_dbg (self, "Getting UIM card status to read pin lock state...");
-    qmi_client_uim_get_card_status (QMI_CLIENT_UIM (ctx->client),
-                                    NULL,
-                                    5,
-                                    NULL,
-                                    (GAsyncReadyCallback) get_sim_lock_status_via_get_card_status_ready,
-                                    task);
+    mm_shared_qmi_uim_get_card_status (MM_SHARED_QMI (self),
+                                       NULL,
+                                       (GAsyncReadyCallback) get_sim_lock_status_via_get_card_status_ready,
+                                       task);
 }
 
 static void
@@ -3256,6 +3274,9 @@ disable_facility_lock_ready (QmiClientUim *client,
     QmiMessageUimDepersonalizationOutput *output;
     GError *error = NULL;
 
+    /* Personalization lock state is reported in the card status */
+    mm_shared_qmi_uim_card_status_invalidate (MM_SHARED_QMI (g_task_get_source_object (task)));
+
     output = qmi_client_uim_depersonalization_finish (client, res, &error);
     if (!output ||
         !qmi_message_uim_depersonalization_output_get_result (output, &error)) {
@@ -5405,6 +5426,9 @@ system_info_indication_cb (QmiClientNas *client,
 {
     if (mm_iface_modem_is_3gpp (MM_IFACE_MODEM (self)))
         common_process_system_info_3gpp (self, NULL, output);
+
+    /* The system info includes the serving cell, so refresh cell info */
+    mm_iface_modem_refresh_cell_info (MM_IFACE_MODEM (self));
 }
 
 static void
@@ -5426,6 +5450,9 @@ serving_system_indication_cb (QmiClientNas *client,
         common_process_serving_system_3gpp (self, NULL, output);
     else if (mm_iface_modem_is_cdma (MM_IFACE_MODEM (self)))
         common_process_serving_system_cdma (self, NULL, output);
+
+    /* The serving system includes the serving cell, so refresh cell info */
+    mm_iface_modem_refresh_cell_info (MM_IFACE_MODEM (self));
 }
 
 /* network reject indications enabled in both with/without newest QMI commands */
@@ -10964,19 +10991,19 @@ add_new_read_cbm_part (MMIfaceModemCellBroadcast *self,
                        gboolean                   transfer_route,
                        GArray                    *data)
 {
-    MMCbmPart *part = NULL;
     g_autoptr(GError) error = NULL;
 
     switch (format) {
         /* Cell Broadcasts need to be broadcast messages */
     case QMI_WMS_MESSAGE_FORMAT_GSM_WCDMA_BROADCAST:
-        part = mm_cbm_part_new_from_binary_pdu ((guint8 *)data->data,
-                                                data->len,
-                                                self,
-                                                &error);
-        if (error) {
+        if (!mm_iface_modem_cell_broadcast_take_pdu (self,
+                                                     G_OBJECT (self),
+                                                     (const guint8 *)data->data,
+                                                     data->len,
+                                                     mm_cbm_state_from_qmi_message_tag (tag),
+                                                     &error)) {
             /* Don't treat the error as critical */
-            mm_obj_dbg (self, "error parsing PDU: %s", error->message);
+            mm_obj_dbg (self, "error adding CBM: %s", error->message);
         }
         break;
     case QMI_WMS_MESSAGE_FORMAT_MWI:
@@ -10986,18 +11013,6 @@ add_new_read_cbm_part (MMIfaceModemCellBroadcast *self,
         mm_obj_dbg (self, "unhandled message format '%u'", format);
         break;
     }
-
-    if (part) {
-        mm_obj_dbg (self, "correctly parsed PDU");
-        if (!mm_iface_modem_cell_broadcast_take_part (self,
-                                                      G_OBJECT (self),
-                                                      part,
-                                                      mm_cbm_state_from_qmi_message_tag (tag),
-                                                      &error)) {
-            /* Don't treat the error as critical */
-            mm_obj_dbg (self, "error adding CBM: %s", error->message);
-        }
-    }
 }
 
 static void
@@ -15088,6 +15103,8 @@ iface_modem_init (MMIfaceModemInterface *iface)
     iface->load_signal_quality_finish = load_signal_quality_finish;
     iface->get_cell_info = get_cell_info;
     iface->get_cell_info_finish = get_cell_info_finish;
+    iface->load_cell_info = load_cell_info;
+    iface->load_cell_info_finish = load_cell_info_finish;
     iface->load_current_bands = mm_shared_qmi_load_current_bands;
     iface->load_current_bands_finish = mm_shared_qmi_load_current_bands_finish;
     iface->set_current_bands = mm_shared_qmi_set_current_bands;
@@ -67,6 +67,8 @@
 #include "libqcdm/src/log-items.h"
 #include "mm-helper-enums-types.h"
 #include "mm-bind.h"
+#include "mm-context.h"
+#include "mm-memory-usage.h"
 
 static void iface_modem_init                      (MMIfaceModemInterface                   *iface);
 static void iface_modem_3gpp_init                 (MMIfaceModem3gppInterface               *iface);
@@ -307,6 +309,9 @@ struct _MMBroadbandModemPrivate {
     MMCbmList *modem_cell_broadcast_cbm_list;
 
     gboolean  modem_firmware_ignore_carrier;
+
+    /* Memory used by each subsystem during initialization */
+    MMMemoryUsage memory_usage;
 };
 
 /*****************************************************************************/
@@ -7514,8 +7519,10 @@ sms_part_ready (MMBroadbandModem *self,
 {
     SmsPartContext *ctx;
     MMSmsPart      *part;
-    MM3gppPduInfo  *info;
     const gchar    *response;
+    const gchar    *pdu;
+    gsize           pdu_len;
+    gint            status;
     GError         *error = NULL;
 
     /* Always always always unlock mem1 storage. Warned you've been. */
@@ -7533,15 +7540,14 @@ sms_part_ready (MMBroadbandModem *self,
 
     ctx = g_task_get_task_data (task);
 
-    info = mm_3gpp_parse_cmgr_read_response (response, ctx->idx, &error);
-    if (!info) {
+    if (!mm_3gpp_parse_cmgr_read_response_pdu (response, &status, &pdu, &pdu_len, &error)) {
         mm_obj_warn (self, "couldn't parse SMS part: '%s'", error->message);
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
     }
 
-    part = mm_sms_part_3gpp_new_from_pdu (info->index, info->pdu, self, &error);
+    part = mm_sms_part_3gpp_new_from_hex_pdu (ctx->idx, pdu, pdu_len, self, &error);
     if (!part) {
         /* Don't treat the error as critical */
         mm_obj_dbg (self, "error parsing PDU (%d): %s", ctx->idx, error->message);
@@ -7561,7 +7567,6 @@ sms_part_ready (MMBroadbandModem *self,
     }
 
     /* All done */
-    mm_3gpp_pdu_info_free (info);
     g_task_return_boolean (task, TRUE);
     g_object_unref (task);
 }
@@ -8096,16 +8101,52 @@ sms_state_from_index (guint index)
     }
 }
 
+typedef struct {
+    MMBroadbandModem *self;
+    ListPartsContext *ctx;
+} SmsPduPartListContext;
+
+static void
+sms_pdu_part_list_foreach (gint                   index,
+                           gint                   status,
+                           const gchar           *pdu,
+                           gsize                  pdu_len,
+                           SmsPduPartListContext *list_ctx)
+{
+    MMBroadbandModem *self = list_ctx->self;
+    MMSmsPart        *part;
+    GError           *error = NULL;
+
+    /* Decode directly from the response buffer */
+    part = mm_sms_part_3gpp_new_from_hex_pdu (index, pdu, pdu_len, self, &error);
+    if (!part) {
+        /* Don't treat the error as critical */
+        mm_obj_dbg (self, "error parsing PDU (%d): %s", index, error->message);
+        g_clear_error (&error);
+        return;
+    }
+
+    mm_obj_dbg (self, "correctly parsed PDU (%d)", index);
+    if (!mm_iface_modem_messaging_take_part (MM_IFACE_MODEM_MESSAGING (self),
+                                             mm_broadband_modem_create_sms (MM_BROADBAND_MODEM (self)),
+                                             part,
+                                             sms_state_from_index (status),
+                                             list_ctx->ctx->list_storage,
+                                             &error)) {
+        /* Don't treat the error as critical */
+        mm_obj_dbg (self, "error adding SMS (%d): %s", index, error->message);
+        g_clear_error (&error);
+    }
+}
+
 static void
 sms_pdu_part_list_ready (MMBroadbandModem *self,
                          GAsyncResult *res,
                          GTask *task)
 {
-    ListPartsContext *ctx;
+    SmsPduPartListContext list_ctx;
     const gchar *response;
     GError *error = NULL;
-    GList *info_list;
-    GList *l;
 
     /* Always always always unlock mem1 storage. Warned you've been. */
     mm_iface_modem_messaging_unlock_storages (MM_IFACE_MODEM_MESSAGING (self), TRUE, FALSE);
@@ -8117,41 +8158,19 @@ sms_pdu_part_list_ready (MMBroadbandModem *self,
         return;
     }
 
-    info_list = mm_3gpp_parse_pdu_cmgl_response (response, &error);
-    if (error) {
+    list_ctx.self = self;
+    list_ctx.ctx = g_task_get_task_data (task);
+
+    /* Parts found before a malformed entry are still processed */
+    if (!mm_3gpp_parse_pdu_cmgl_response_foreach (response,
+                                                  (MM3gppPduForeachFn) sms_pdu_part_list_foreach,
+                                                  &list_ctx,
+                                                  &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
     }
 
-    ctx = g_task_get_task_data (task);
-
-    for (l = info_list; l; l = g_list_next (l)) {
-        MM3gppPduInfo *info = l->data;
-        MMSmsPart *part;
-
-        part = mm_sms_part_3gpp_new_from_pdu (info->index, info->pdu, self, &error);
-        if (!part) {
-            /* Don't treat the error as critical */
-            mm_obj_dbg (self, "error parsing PDU (%d): %s", info->index, error->message);
-            g_clear_error (&error);
-        } else {
-            mm_obj_dbg (self, "correctly parsed PDU (%d)", info->index);
-            if (!mm_iface_modem_messaging_take_part (MM_IFACE_MODEM_MESSAGING (self),
-                                                     mm_broadband_modem_create_sms (MM_BROADBAND_MODEM (self)),
-                                                     part,
-                                                     sms_state_from_index (info->status),
-                                                     ctx->list_storage,
-                                                     &error)) {
-                /* Don't treat the error as critical */
-                mm_obj_dbg (self, "error adding SMS (%d): %s", info->index, error->message);
-                g_clear_error (&error);
-            }
-        }
-    }
-
-    mm_3gpp_pdu_info_list_free (info_list);
-
     /* We consider all done */
     g_task_return_boolean (task, TRUE);
     g_object_unref (task);
@@ -10615,9 +10634,10 @@ cbc_cbm_received (MMPortSerialAt *port,
                   MMBroadbandModem *self)
 {
     g_autoptr(GError) error = NULL;
-    MMCbmPart *part;
+    g_autofree gchar *pdu = NULL;
+    g_autofree guint8 *bin = NULL;
+    gsize bin_len = 0;
     guint length;
-    gchar *pdu;
 
     mm_obj_dbg (self, "got new cell broadcast message indication");
 
@@ -10628,20 +10648,21 @@ cbc_cbm_received (MMPortSerialAt *port,
     if (!pdu)
         return;
 
-    part = mm_cbm_part_new_from_pdu (pdu, self, &error);
-    if (!part) {
+    bin = mm_utils_hexstr2bin (pdu, -1, &bin_len, &error);
+    if (!bin) {
         /* Don't treat the error as critical */
-        mm_obj_dbg (self, "error parsing PDU: %s", error->message);
-    } else {
-        mm_obj_dbg (self, "correctly parsed PDU");
-        if (!mm_iface_modem_cell_broadcast_take_part (MM_IFACE_MODEM_CELL_BROADCAST (self),
-                                                      G_OBJECT (self),
-                                                      part,
-                                                      MM_CBM_STATE_RECEIVED,
-                                                      &error)) {
-            /* Don't treat the error as critical */
-            mm_obj_dbg (self, "error adding CBM: %s", error->message);
-        }
+        mm_obj_dbg (self, "error converting PDU from hex to binary: %s", error->message);
+        return;
+    }
+
+    if (!mm_iface_modem_cell_broadcast_take_pdu (MM_IFACE_MODEM_CELL_BROADCAST (self),
+                                                 G_OBJECT (self),
+                                                 bin,
+                                                 bin_len,
+                                                 MM_CBM_STATE_RECEIVED,
+                                                 &error)) {
+        /* Don't treat the error as critical */
+        mm_obj_dbg (self, "error adding CBM: %s", error->message);
     }
 }
 
@@ -12515,6 +12536,33 @@ disable (MMBaseModem         *self,
                     user_data);
 }
 
+/*****************************************************************************/
+/* Memory usage */
+
+const MMMemoryUsage *
+mm_broadband_modem_peek_memory_usage (MMBroadbandModem *self)
+{
+    g_return_val_if_fail (MM_IS_BROADBAND_MODEM (self), NULL);
+
+    return &self->priv->memory_usage;
+}
+
+static void
+report_memory_usage (MMBroadbandModem *self,
+                     const gchar      *sequence)
+{
+    g_autofree gchar *str = NULL;
+
+    if (!mm_memory_usage_supported ())
+        return;
+
+    str = mm_memory_usage_build_string (&self->priv->memory_usage);
+    mm_obj_info (self, "memory used after %s: %.1f KiB (%s)",
+                 sequence,
+                 (gdouble) mm_memory_usage_get_total (&self->priv->memory_usage) / 1024.0,
+                 str);
+}
+
 /*****************************************************************************/
 
 typedef enum {
@@ -12542,6 +12590,7 @@ typedef struct {
     EnablingStep  step;
     MMModemState  previous_state;
     GError       *saved_error;
+    gint64        memory_sample;
 } EnablingContext;
 
 static void
@@ -12568,6 +12617,9 @@ enabling_complete (GTask *task)
     self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
 
+    /* Includes the lists created when enabling (e.g. SMS and CBM) */
+    mm_memory_usage_account (&self->priv->memory_usage, MM_MEMORY_SUBSYSTEM_ENABLING, ctx->memory_sample);
+
     /* Enable failed? */
     if (ctx->saved_error) {
         if (ctx->previous_state != MM_MODEM_STATE_ENABLED) {
@@ -12582,6 +12634,7 @@ enabling_complete (GTask *task)
     }
 
     /* Enable succeeded */
+    report_memory_usage (self, "enabling");
     mm_iface_modem_update_state (MM_IFACE_MODEM (self),
                                  MM_MODEM_STATE_ENABLED,
                                  MM_MODEM_STATE_CHANGE_REASON_USER_REQUESTED);
@@ -12920,10 +12973,17 @@ enabling_step (GTask *task)
 static void
 enabling_start (GTask *task)
 {
-    EnablingContext *ctx;
+    MMBroadbandModem *self;
+    EnablingContext  *ctx;
+
+    self = g_task_get_source_object (task);
+
+    /* What a previous enabling allocated was released when disabling */
+    mm_memory_usage_reset (&self->priv->memory_usage, MM_MEMORY_SUBSYSTEM_ENABLING);
 
     ctx = g_slice_new0 (EnablingContext);
     ctx->step = ENABLING_STEP_FIRST;
+    ctx->memory_sample = mm_memory_usage_sample ();
     g_task_set_task_data (task, ctx, (GDestroyNotify)enabling_context_free);
 
     enabling_step (task);
@@ -13320,10 +13380,92 @@ typedef struct {
     MMBroadbandModem *self;
     InitializeStep step;
     gpointer ports_ctx;
+    /* Heap usage when the last step was launched or completed */
+    gint64 memory_sample;
+    /* Interface initializations running concurrently */
+    guint n_pending;
+    gboolean fatal_failure;
+    /* Times in us, to find the critical path of the sequence */
+    gint64 start_time;
+    gint64 step_launched[INITIALIZE_STEP_LAST];
+    gint64 step_duration[INITIALIZE_STEP_LAST];
 } InitializeContext;
 
+/* Ranges of steps initializing interfaces that don't depend on each other,
+ * which are run concurrently. The commands they send are still serialized
+ * by each port. */
+static const struct {
+    InitializeStep first;
+    InitializeStep last; /* not included */
+} initialize_groups[] = {
+    { INITIALIZE_STEP_IFACE_3GPP_PROFILE_MANAGER, INITIALIZE_STEP_FALLBACK_LIMITED },
+    { INITIALIZE_STEP_IFACE_LOCATION,             INITIALIZE_STEP_IFACE_SIMPLE     },
+};
+
+static const gchar *initialize_step_names[INITIALIZE_STEP_LAST] = {
+    [INITIALIZE_STEP_STARTED]                    = "started",
+    [INITIALIZE_STEP_IFACE_MODEM]                = "modem",
+    [INITIALIZE_STEP_IFACE_3GPP]                 = "3gpp",
+    [INITIALIZE_STEP_IFACE_3GPP_PROFILE_MANAGER] = "3gpp-profile-manager",
+    [INITIALIZE_STEP_IFACE_3GPP_USSD]            = "3gpp-ussd",
+    [INITIALIZE_STEP_IFACE_CDMA]                 = "cdma",
+    [INITIALIZE_STEP_IFACE_MESSAGING]            = "messaging",
+    [INITIALIZE_STEP_IFACE_TIME]                 = "time",
+    [INITIALIZE_STEP_IFACE_SIGNAL]               = "signal",
+    [INITIALIZE_STEP_IFACE_OMA]                  = "oma",
+    [INITIALIZE_STEP_IFACE_SAR]                  = "sar",
+    [INITIALIZE_STEP_IFACE_CELL_BROADCAST]       = "cell-broadcast",
+    [INITIALIZE_STEP_IFACE_LOCATION]             = "location",
+    [INITIALIZE_STEP_IFACE_VOICE]                = "voice",
+    [INITIALIZE_STEP_IFACE_FIRMWARE]             = "firmware",
+};
+
 static void initialize_step (GTask *task);
 
+static void
+initialize_step_launched (InitializeContext *ctx,
+                          InitializeStep     step)
+{
+    ctx->step_launched[step] = g_get_monotonic_time ();
+}
+
+static void
+initialize_step_completed (InitializeContext *ctx,
+                           InitializeStep     step,
+                           MMMemorySubsystem  subsystem)
+{
+    ctx->step_duration[step] = g_get_monotonic_time () - ctx->step_launched[step];
+
+    /* With steps running concurrently, what's allocated since the last one
+     * completed is accounted to the one completing now */
+    mm_memory_usage_account (&ctx->self->priv->memory_usage, subsystem, ctx->memory_sample);
+    ctx->memory_sample = mm_memory_usage_sample ();
+}
+
+/* Called once an interface initialization is done, either moving on to the
+ * next step or waiting for the ones running concurrently to finish */
+static void
+initialize_step_done (GTask    *task,
+                      gboolean  fatal)
+{
+    InitializeContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+    if (fatal)
+        ctx->fatal_failure = TRUE;
+
+    if (ctx->n_pending > 0) {
+        if (--ctx->n_pending > 0)
+            return;
+    } else
+        ctx->step++;
+
+    /* Just jump to the last step on fatal errors */
+    if (ctx->fatal_failure)
+        ctx->step = INITIALIZE_STEP_LAST;
+    initialize_step (task);
+}
+
 static void
 initialize_context_free (InitializeContext *ctx)
 {
@@ -13358,6 +13500,7 @@ initialization_started_ready (MMBroadbandModem *self,
     gpointer ports_ctx;
 
     ctx = g_task_get_task_data (task);
+    initialize_step_completed (ctx, INITIALIZE_STEP_STARTED, MM_MEMORY_SUBSYSTEM_CORE);
 
     /* May return NULL without error */
     ports_ctx = MM_BROADBAND_MODEM_GET_CLASS (self)->initialization_started_finish (self, result, &error);
@@ -13391,6 +13534,7 @@ iface_modem_initialize_ready (MMBroadbandModem *self,
     GError *error = NULL;
 
     ctx = g_task_get_task_data (task);
+    initialize_step_completed (ctx, INITIALIZE_STEP_IFACE_MODEM, MM_MEMORY_SUBSYSTEM_MODEM);
 
     /* If the modem interface fails to get initialized, we will move the modem
      * to a FAILED state. Note that in this case we still export the interface. */
@@ -13435,7 +13579,7 @@ iface_modem_initialize_ready (MMBroadbandModem *self,
 }
 
 #undef INTERFACE_INIT_READY_FN
-#define INTERFACE_INIT_READY_FN(NAME,TYPE,FATAL_ERRORS)                 \
+#define INTERFACE_INIT_READY_FN(NAME,TYPE,FATAL_ERRORS,ID)              \
     static void                                                         \
     NAME##_initialize_ready (MMBroadbandModem *self,                    \
                              GAsyncResult *result,                      \
@@ -13445,6 +13589,9 @@ iface_modem_initialize_ready (MMBroadbandModem *self,
         GError *error = NULL;                                           \
                                                                         \
         ctx = g_task_get_task_data (task);                              \
+        initialize_step_completed (ctx,                                 \
+                                   INITIALIZE_STEP_IFACE_##ID,          \
+                                   MM_MEMORY_SUBSYSTEM_##ID);           \
                                                                         \
         if (!mm_##NAME##_initialize_finish (TYPE (self), result, &error)) { \
             if (FATAL_ERRORS) {                                         \
@@ -13456,9 +13603,7 @@ iface_modem_initialize_ready (MMBroadbandModem *self,
                 mm_iface_modem_update_failed_state (MM_IFACE_MODEM (self), \
                                                     MM_MODEM_STATE_FAILED_REASON_UNKNOWN); \
                                                                         \
-                /* Just jump to the last step */                        \
-                ctx->step = INITIALIZE_STEP_LAST;                       \
-                initialize_step (task);                                 \
+                initialize_step_done (task, TRUE);                      \
                 return;                                                 \
             }                                                           \
                                                                         \
@@ -13472,24 +13617,220 @@ iface_modem_initialize_ready (MMBroadbandModem *self,
             mm_##NAME##_bind_simple_status (TYPE (self), self->priv->modem_simple_status); \
         }                                                               \
                                                                         \
-        /* Go on to next step */                                        \
-        ctx->step++;                                                    \
-        initialize_step (task);                                         \
-    }
-
-INTERFACE_INIT_READY_FN (iface_modem_3gpp,                 MM_IFACE_MODEM_3GPP,                 TRUE)
-INTERFACE_INIT_READY_FN (iface_modem_3gpp_profile_manager, MM_IFACE_MODEM_3GPP_PROFILE_MANAGER, FALSE)
-INTERFACE_INIT_READY_FN (iface_modem_3gpp_ussd,            MM_IFACE_MODEM_3GPP_USSD,            FALSE)
-INTERFACE_INIT_READY_FN (iface_modem_cdma,                 MM_IFACE_MODEM_CDMA,                 TRUE)
-INTERFACE_INIT_READY_FN (iface_modem_location,             MM_IFACE_MODEM_LOCATION,             FALSE)
-INTERFACE_INIT_READY_FN (iface_modem_messaging,            MM_IFACE_MODEM_MESSAGING,            FALSE)
-INTERFACE_INIT_READY_FN (iface_modem_voice,                MM_IFACE_MODEM_VOICE,                FALSE)
-INTERFACE_INIT_READY_FN (iface_modem_time,                 MM_IFACE_MODEM_TIME,                 FALSE)
-INTERFACE_INIT_READY_FN (iface_modem_signal,               MM_IFACE_MODEM_SIGNAL,               FALSE)
-INTERFACE_INIT_READY_FN (iface_modem_oma,                  MM_IFACE_MODEM_OMA,                  FALSE)
-INTERFACE_INIT_READY_FN (iface_modem_firmware,             MM_IFACE_MODEM_FIRMWARE,             FALSE)
-INTERFACE_INIT_READY_FN (iface_modem_sar,                  MM_IFACE_MODEM_SAR,                  FALSE)
-INTERFACE_INIT_READY_FN (iface_modem_cell_broadcast,       MM_IFACE_MODEM_CELL_BROADCAST,       FALSE)
+        initialize_step_done (task, FALSE);                             \
+    }
+
+INTERFACE_INIT_READY_FN (iface_modem_3gpp,                 MM_IFACE_MODEM_3GPP,                 TRUE,  3GPP)
+INTERFACE_INIT_READY_FN (iface_modem_3gpp_profile_manager, MM_IFACE_MODEM_3GPP_PROFILE_MANAGER, FALSE, 3GPP_PROFILE_MANAGER)
+INTERFACE_INIT_READY_FN (iface_modem_3gpp_ussd,            MM_IFACE_MODEM_3GPP_USSD,            FALSE, 3GPP_USSD)
+INTERFACE_INIT_READY_FN (iface_modem_cdma,                 MM_IFACE_MODEM_CDMA,                 TRUE,  CDMA)
+INTERFACE_INIT_READY_FN (iface_modem_location,             MM_IFACE_MODEM_LOCATION,             FALSE, LOCATION)
+INTERFACE_INIT_READY_FN (iface_modem_messaging,            MM_IFACE_MODEM_MESSAGING,            FALSE, MESSAGING)
+INTERFACE_INIT_READY_FN (iface_modem_voice,                MM_IFACE_MODEM_VOICE,                FALSE, VOICE)
+INTERFACE_INIT_READY_FN (iface_modem_time,                 MM_IFACE_MODEM_TIME,                 FALSE, TIME)
+INTERFACE_INIT_READY_FN (iface_modem_signal,               MM_IFACE_MODEM_SIGNAL,               FALSE, SIGNAL)
+INTERFACE_INIT_READY_FN (iface_modem_oma,                  MM_IFACE_MODEM_OMA,                  FALSE, OMA)
+INTERFACE_INIT_READY_FN (iface_modem_firmware,             MM_IFACE_MODEM_FIRMWARE,             FALSE, FIRMWARE)
+INTERFACE_INIT_READY_FN (iface_modem_sar,                  MM_IFACE_MODEM_SAR,                  FALSE, SAR)
+INTERFACE_INIT_READY_FN (iface_modem_cell_broadcast,       MM_IFACE_MODEM_CELL_BROADCAST,       FALSE, CELL_BROADCAST)
+
+static void
+initialize_report_critical_path (InitializeContext *ctx)
+{
+    g_autoptr(GString) str = NULL;
+    gint64             total = 0;
+    guint              step;
+
+    /* The critical path goes through every step run on its own and through
+     * the longest step of each group run concurrently */
+    str = g_string_new (NULL);
+    for (step = INITIALIZE_STEP_FIRST; step < INITIALIZE_STEP_LAST; step++) {
+        guint longest = step;
+        guint last = step + 1;
+        guint i;
+
+        for (i = 0; i < G_N_ELEMENTS (initialize_groups); i++) {
+            if (initialize_groups[i].first == step)
+                last = initialize_groups[i].last;
+        }
+        for (i = step; i < last; i++) {
+            total += ctx->step_duration[i];
+            if (ctx->step_duration[i] > ctx->step_duration[longest])
+                longest = i;
+        }
+        if (ctx->step_duration[longest] > 0 && initialize_step_names[longest])
+            g_string_append_printf (str, "%s%s (%" G_GINT64_FORMAT " ms)",
+                                    str->len ? " -> " : "",
+                                    initialize_step_names[longest],
+                                    ctx->step_duration[longest] / 1000);
+        step = last - 1;
+    }
+
+    mm_obj_dbg (ctx->self, "initialization took %" G_GINT64_FORMAT " ms (%" G_GINT64_FORMAT " ms if run sequentially), critical path: %s",
+                (g_get_monotonic_time () - ctx->start_time) / 1000, total / 1000, str->str);
+}
+
+/* Launches the initialization of the given interface, returns FALSE if it
+ * doesn't apply to this modem */
+static gboolean
+initialize_iface_launch (GTask          *task,
+                         InitializeStep  step)
+{
+    InitializeContext *ctx;
+    MMBroadbandModem  *self;
+    GCancellable      *cancellable;
+
+    ctx = g_task_get_task_data (task);
+    self = ctx->self;
+    cancellable = g_task_get_cancellable (task);
+
+    switch (step) {
+    case INITIALIZE_STEP_IFACE_3GPP_PROFILE_MANAGER:
+        if (!mm_iface_modem_is_3gpp (MM_IFACE_MODEM (self)))
+            return FALSE;
+        /* Initialize the 3GPP Profile Manager interface */
+        mm_iface_modem_3gpp_profile_manager_initialize (MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (self),
+                                                        (GAsyncReadyCallback)iface_modem_3gpp_profile_manager_initialize_ready,
+                                                        task);
+        return TRUE;
+
+    case INITIALIZE_STEP_IFACE_3GPP_USSD:
+        if (!mm_iface_modem_is_3gpp (MM_IFACE_MODEM (self)))
+            return FALSE;
+        /* Initialize the 3GPP/USSD interface */
+        mm_iface_modem_3gpp_ussd_initialize (MM_IFACE_MODEM_3GPP_USSD (self),
+                                             (GAsyncReadyCallback)iface_modem_3gpp_ussd_initialize_ready,
+                                             task);
+        return TRUE;
+
+    case INITIALIZE_STEP_IFACE_CDMA:
+        if (!mm_iface_modem_is_cdma (MM_IFACE_MODEM (self)))
+            return FALSE;
+        /* Initialize the CDMA interface */
+        mm_iface_modem_cdma_initialize (MM_IFACE_MODEM_CDMA (self),
+                                        cancellable,
+                                        (GAsyncReadyCallback)iface_modem_cdma_initialize_ready,
+                                        task);
+        return TRUE;
+
+    case INITIALIZE_STEP_IFACE_MESSAGING:
+        /* Initialize the Messaging interface */
+        mm_iface_modem_messaging_initialize (MM_IFACE_MODEM_MESSAGING (self),
+                                             cancellable,
+                                             (GAsyncReadyCallback)iface_modem_messaging_initialize_ready,
+                                             task);
+        return TRUE;
+
+    case INITIALIZE_STEP_IFACE_TIME:
+        /* Initialize the Time interface */
+        mm_iface_modem_time_initialize (MM_IFACE_MODEM_TIME (self),
+                                        cancellable,
+                                        (GAsyncReadyCallback)iface_modem_time_initialize_ready,
+                                        task);
+        return TRUE;
+
+    case INITIALIZE_STEP_IFACE_SIGNAL:
+        /* Initialize the Signal interface */
+        mm_iface_modem_signal_initialize (MM_IFACE_MODEM_SIGNAL (self),
+                                          cancellable,
+                                          (GAsyncReadyCallback)iface_modem_signal_initialize_ready,
+                                          task);
+        return TRUE;
+
+    case INITIALIZE_STEP_IFACE_OMA:
+        if (mm_context_get_slim_modems ())
+            return FALSE;
+        /* Initialize the Oma interface */
+        mm_iface_modem_oma_initialize (MM_IFACE_MODEM_OMA (self),
+                                       cancellable,
+                                       (GAsyncReadyCallback)iface_modem_oma_initialize_ready,
+                                       task);
+        return TRUE;
+
+    case INITIALIZE_STEP_IFACE_SAR:
+        if (mm_context_get_slim_modems ())
+            return FALSE;
+        /* Initialize the SAR interface */
+        mm_iface_modem_sar_initialize (MM_IFACE_MODEM_SAR (self),
+                                       cancellable,
+                                       (GAsyncReadyCallback)iface_modem_sar_initialize_ready,
+                                       task);
+        return TRUE;
+
+    case INITIALIZE_STEP_IFACE_CELL_BROADCAST:
+        /* Initialize the CellBroadcast interface */
+        mm_iface_modem_cell_broadcast_initialize (MM_IFACE_MODEM_CELL_BROADCAST (self),
+                                                  cancellable,
+                                                  (GAsyncReadyCallback)iface_modem_cell_broadcast_initialize_ready,
+                                                  task);
+        return TRUE;
+
+    case INITIALIZE_STEP_IFACE_LOCATION:
+        /* Initialize the Location interface */
+        mm_iface_modem_location_initialize (MM_IFACE_MODEM_LOCATION (self),
+                                            cancellable,
+                                            (GAsyncReadyCallback)iface_modem_location_initialize_ready,
+                                            task);
+        return TRUE;
+
+    case INITIALIZE_STEP_IFACE_VOICE:
+        if (mm_context_get_slim_modems ())
+            return FALSE;
+        /* Initialize the Voice interface */
+        mm_iface_modem_voice_initialize (MM_IFACE_MODEM_VOICE (self),
+                                         cancellable,
+                                         (GAsyncReadyCallback)iface_modem_voice_initialize_ready,
+                                         task);
+        return TRUE;
+
+    case INITIALIZE_STEP_IFACE_FIRMWARE:
+        if (mm_context_get_slim_modems ())
+            return FALSE;
+        /* Initialize the Firmware interface */
+        mm_iface_modem_firmware_initialize (MM_IFACE_MODEM_FIRMWARE (self),
+                                            cancellable,
+                                            (GAsyncReadyCallback)iface_modem_firmware_initialize_ready,
+                                            task);
+        return TRUE;
+
+    case INITIALIZE_STEP_FIRST:
+    case INITIALIZE_STEP_SETUP_PORTS:
+    case INITIALIZE_STEP_STARTED:
+    case INITIALIZE_STEP_SETUP_SIMPLE_STATUS:
+    case INITIALIZE_STEP_IFACE_MODEM:
+    case INITIALIZE_STEP_IFACE_3GPP:
+    case INITIALIZE_STEP_JUMP_TO_LIMITED:
+    case INITIALIZE_STEP_FALLBACK_LIMITED:
+    case INITIALIZE_STEP_IFACE_SIMPLE:
+    case INITIALIZE_STEP_LAST:
+    default:
+        break;
+    }
+
+    g_assert_not_reached ();
+}
+
+static void
+initialize_launch_group (GTask *task,
+                         guint  group)
+{
+    InitializeContext *ctx;
+    InitializeStep     step;
+
+    ctx = g_task_get_task_data (task);
+    g_assert (ctx->n_pending == 0);
+
+    /* Hold the group until all steps are launched, in case any of them
+     * completes right away */
+    ctx->n_pending = 1;
+    ctx->step = initialize_groups[group].last;
+    for (step = initialize_groups[group].first; step < initialize_groups[group].last; step++) {
+        initialize_step_launched (ctx, step);
+        if (initialize_iface_launch (task, step))
+            ctx->n_pending++;
+    }
+    initialize_step_done (task, FALSE);
+}
 
 static void
 initialize_step (GTask *task)
@@ -13504,8 +13845,14 @@ initialize_step (GTask *task)
 
     ctx = g_task_get_task_data (task);
 
+    /* Anything allocated until the ready callback of the step launched now
+     * is accounted to that step */
+    ctx->memory_sample = mm_memory_usage_sample ();
+
     switch (ctx->step) {
     case INITIALIZE_STEP_FIRST:
+        if (mm_context_get_slim_modems ())
+            mm_obj_dbg (ctx->self, "slim mode: OMA, SAR, voice and firmware interfaces won't be exposed");
         ctx->step++;
        /* fall through */
 
@@ -13518,6 +13865,7 @@ initialize_step (GTask *task)
     case INITIALIZE_STEP_STARTED:
         if (MM_BROADBAND_MODEM_GET_CLASS (ctx->self)->initialization_started &&
             MM_BROADBAND_MODEM_GET_CLASS (ctx->self)->initialization_started_finish) {
+            initialize_step_launched (ctx, INITIALIZE_STEP_STARTED);
             MM_BROADBAND_MODEM_GET_CLASS (ctx->self)->initialization_started (ctx->self,
                                                                               (GAsyncReadyCallback)initialization_started_ready,
                                                                               task);
@@ -13537,6 +13885,7 @@ initialize_step (GTask *task)
 
     case INITIALIZE_STEP_IFACE_MODEM:
         /* Initialize the Modem interface */
+        initialize_step_launched (ctx, INITIALIZE_STEP_IFACE_MODEM);
         mm_iface_modem_initialize (MM_IFACE_MODEM (ctx->self),
                                    g_task_get_cancellable (task),
                                    (GAsyncReadyCallback)iface_modem_initialize_ready,
@@ -13546,6 +13895,7 @@ initialize_step (GTask *task)
     case INITIALIZE_STEP_IFACE_3GPP:
         if (mm_iface_modem_is_3gpp (MM_IFACE_MODEM (ctx->self))) {
             /* Initialize the 3GPP interface */
+            initialize_step_launched (ctx, INITIALIZE_STEP_IFACE_3GPP);
             mm_iface_modem_3gpp_initialize (MM_IFACE_MODEM_3GPP (ctx->self),
                                             g_task_get_cancellable (task),
                                             (GAsyncReadyCallback)iface_modem_3gpp_initialize_ready,
@@ -13569,85 +13919,9 @@ initialize_step (GTask *task)
        /* fall through */
 
     case INITIALIZE_STEP_IFACE_3GPP_PROFILE_MANAGER:
-        if (mm_iface_modem_is_3gpp (MM_IFACE_MODEM (ctx->self))) {
-            /* Initialize the 3GPP Profile Manager interface */
-            mm_iface_modem_3gpp_profile_manager_initialize (MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (ctx->self),
-                                                            (GAsyncReadyCallback)iface_modem_3gpp_profile_manager_initialize_ready,
-                                                            task);
-            return;
-        }
-        ctx->step++;
-       /* fall through */
-
-    case INITIALIZE_STEP_IFACE_3GPP_USSD:
-        if (mm_iface_modem_is_3gpp (MM_IFACE_MODEM (ctx->self))) {
-            /* Initialize the 3GPP/USSD interface */
-            mm_iface_modem_3gpp_ussd_initialize (MM_IFACE_MODEM_3GPP_USSD (ctx->self),
-                                                 (GAsyncReadyCallback)iface_modem_3gpp_ussd_initialize_ready,
-                                                 task);
-            return;
-        }
-        ctx->step++;
-       /* fall through */
-
-    case INITIALIZE_STEP_IFACE_CDMA:
-        if (mm_iface_modem_is_cdma (MM_IFACE_MODEM (ctx->self))) {
-            /* Initialize the CDMA interface */
-            mm_iface_modem_cdma_initialize (MM_IFACE_MODEM_CDMA (ctx->self),
-                                            g_task_get_cancellable (task),
-                                            (GAsyncReadyCallback)iface_modem_cdma_initialize_ready,
-                                            task);
-            return;
-        }
-        ctx->step++;
-       /* fall through */
-
-    case INITIALIZE_STEP_IFACE_MESSAGING:
-        /* Initialize the Messaging interface */
-        mm_iface_modem_messaging_initialize (MM_IFACE_MODEM_MESSAGING (ctx->self),
-                                             g_task_get_cancellable (task),
-                                             (GAsyncReadyCallback)iface_modem_messaging_initialize_ready,
-                                             task);
-        return;
-
-    case INITIALIZE_STEP_IFACE_TIME:
-        /* Initialize the Time interface */
-        mm_iface_modem_time_initialize (MM_IFACE_MODEM_TIME (ctx->self),
-                                        g_task_get_cancellable (task),
-                                        (GAsyncReadyCallback)iface_modem_time_initialize_ready,
-                                        task);
-        return;
-
-    case INITIALIZE_STEP_IFACE_SIGNAL:
-        /* Initialize the Signal interface */
-        mm_iface_modem_signal_initialize (MM_IFACE_MODEM_SIGNAL (ctx->self),
-                                          g_task_get_cancellable (task),
-                                          (GAsyncReadyCallback)iface_modem_signal_initialize_ready,
-                                          task);
-        return;
-
-    case INITIALIZE_STEP_IFACE_OMA:
-        /* Initialize the Oma interface */
-        mm_iface_modem_oma_initialize (MM_IFACE_MODEM_OMA (ctx->self),
-                                       g_task_get_cancellable (task),
-                                       (GAsyncReadyCallback)iface_modem_oma_initialize_ready,
-                                       task);
-        return;
-
-    case INITIALIZE_STEP_IFACE_SAR:
-        /* Initialize the SAR interface */
-        mm_iface_modem_sar_initialize (MM_IFACE_MODEM_SAR (ctx->self),
-                                       g_task_get_cancellable (task),
-                                       (GAsyncReadyCallback)iface_modem_sar_initialize_ready,
-                                       task);
-        return;
-
-    case INITIALIZE_STEP_IFACE_CELL_BROADCAST:
-        /* Initialize the CellBroadcast interface */
-        mm_iface_modem_cell_broadcast_initialize (MM_IFACE_MODEM_CELL_BROADCAST (ctx->self),
-                                                  g_task_get_cancellable (task),
-                                                  (GAsyncReadyCallback)iface_modem_cell_broadcast_initialize_ready,
-                                                  task);
+        /* Initialize all the remaining interfaces not allowed in locked or
+         * failed state at once */
+        initialize_launch_group (task, 0);
         return;
 
     case INITIALIZE_STEP_FALLBACK_LIMITED:
@@ -13657,36 +13931,23 @@ initialize_step (GTask *task)
        /* fall through */
 
     case INITIALIZE_STEP_IFACE_LOCATION:
-        /* Initialize the Location interface */
-        mm_iface_modem_location_initialize (MM_IFACE_MODEM_LOCATION (ctx->self),
-                                            g_task_get_cancellable (task),
-                                            (GAsyncReadyCallback)iface_modem_location_initialize_ready,
-                                            task);
-        return;
-
-    case INITIALIZE_STEP_IFACE_VOICE:
-        /* Initialize the Voice interface */
-        mm_iface_modem_voice_initialize (MM_IFACE_MODEM_VOICE (ctx->self),
-                                         g_task_get_cancellable (task),
-                                         (GAsyncReadyCallback)iface_modem_voice_initialize_ready,
-                                         task);
-        return;
-
-    case INITIALIZE_STEP_IFACE_FIRMWARE:
-        /* Initialize the Firmware interface */
-        mm_iface_modem_firmware_initialize (MM_IFACE_MODEM_FIRMWARE (ctx->self),
-                                            g_task_get_cancellable (task),
-                                            (GAsyncReadyCallback)iface_modem_firmware_initialize_ready,
-                                            task);
+        /* Initialize the Location, Voice and Firmware interfaces at once */
+        initialize_launch_group (task, 1);
         return;
 
     case INITIALIZE_STEP_IFACE_SIMPLE:
-        if (ctx->self->priv->modem_state != MM_MODEM_STATE_FAILED)
+        if (ctx->self->priv->modem_state != MM_MODEM_STATE_FAILED) {
+            ctx->memory_sample = mm_memory_usage_sample ();
             mm_iface_modem_simple_initialize (MM_IFACE_MODEM_SIMPLE (ctx->self));
+            mm_memory_usage_account (&ctx->self->priv->memory_usage, MM_MEMORY_SUBSYSTEM_SIMPLE, ctx->memory_sample);
+        }
         ctx->step++;
        /* fall through */
 
     case INITIALIZE_STEP_LAST:
+        report_memory_usage (ctx->self, "initialization");
+        initialize_report_critical_path (ctx);
+
         if (ctx->self->priv->modem_state == MM_MODEM_STATE_FAILED) {
             GError *error = NULL;
 
@@ -13781,6 +14042,8 @@ initialize (MMBaseModem *self,
         ctx = g_new0 (InitializeContext, 1);
         ctx->self = MM_BROADBAND_MODEM (g_object_ref (self));
         ctx->step = INITIALIZE_STEP_FIRST;
+        ctx->memory_sample = -1;
+        ctx->start_time = g_get_monotonic_time ();
 
         g_task_set_task_data (task, ctx, (GDestroyNotify)initialize_context_free);
 
@@ -28,6 +28,7 @@
 #include "mm-charsets.h"
 #include "mm-base-modem.h"
 #include "mm-base-sms.h"
+#include "mm-memory-usage.h"
 
 #define MM_TYPE_BROADBAND_MODEM            (mm_broadband_modem_get_type ())
 #define MM_BROADBAND_MODEM(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), MM_TYPE_BROADBAND_MODEM, MMBroadbandModem))
@@ -141,4 +142,7 @@ gint mm_broadband_modem_get_initial_eps_bearer_cid (MMBroadbandModem *self);
 /* Helper to create a new modem-specific SMS object */
 MMBaseSms *mm_broadband_modem_create_sms (MMBroadbandModem *self);
 
+/* Memory accounted to each subsystem of the modem */
+const MMMemoryUsage *mm_broadband_modem_peek_memory_usage (MMBroadbandModem *self);
+
 #endif /* MM_BROADBAND_MODEM_H */
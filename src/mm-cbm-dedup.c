@@ -0,0 +1,144 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#include "mm-cbm-dedup.h"
+
+typedef struct {
+    guint16 serial;
+    guint16 channel;
+    guint8  part_num;
+    gint64  last_seen;
+} PageEntry;
+
+struct _MMCbmDedup {
+    /* PageEntry set, each entry being its own key */
+    GHashTable *pages;
+    /* retention window, in microseconds */
+    gint64      retention;
+    /* time of the last removal of expired entries */
+    gint64      last_expire;
+};
+
+static guint
+page_entry_hash (const PageEntry *entry)
+{
+    return ((guint) entry->serial << 16 | entry->channel) ^ ((guint) entry->part_num << 28);
+}
+
+static gboolean
+page_entry_equal (const PageEntry *a,
+                  const PageEntry *b)
+{
+    return (a->serial == b->serial &&
+            a->channel == b->channel &&
+            a->part_num == b->part_num);
+}
+
+static void
+page_entry_free (PageEntry *entry)
+{
+    g_slice_free (PageEntry, entry);
+}
+
+/*****************************************************************************/
+
+static void
+expire_entries (MMCbmDedup *self,
+                gint64      now)
+{
+    GHashTableIter  iter;
+    PageEntry      *entry;
+
+    g_hash_table_iter_init (&iter, self->pages);
+    while (g_hash_table_iter_next (&iter, (gpointer *)&entry, NULL)) {
+        if (now - entry->last_seen >= self->retention)
+            g_hash_table_iter_remove (&iter);
+    }
+    self->last_expire = now;
+}
+
+gboolean
+mm_cbm_dedup_check (MMCbmDedup *self,
+                    guint16     serial,
+                    guint16     channel,
+                    guint8      part_num,
+                    gint64      now)
+{
+    PageEntry  lookup;
+    PageEntry *entry;
+
+    if (!self->retention)
+        return FALSE;
+
+    /* Expired entries are removed at most once per retention window, so the
+     * cost is amortized over all the pages received in that time */
+    if (now - self->last_expire >= self->retention)
+        expire_entries (self, now);
+
+    lookup.serial = serial;
+    lookup.channel = channel;
+    lookup.part_num = part_num;
+
+    entry = g_hash_table_lookup (self->pages, &lookup);
+    if (entry && (now - entry->last_seen < self->retention)) {
+        entry->last_seen = now;
+        return TRUE;
+    }
+
+    if (!entry) {
+        entry = g_slice_new (PageEntry);
+        *entry = lookup;
+        g_hash_table_add (self->pages, entry);
+    }
+    entry->last_seen = now;
+    return FALSE;
+}
+
+/*****************************************************************************/
+
+guint
+mm_cbm_dedup_get_size (MMCbmDedup *self)
+{
+    return g_hash_table_size (self->pages);
+}
+
+void
+mm_cbm_dedup_clear (MMCbmDedup *self)
+{
+    g_hash_table_remove_all (self->pages);
+}
+
+MMCbmDedup *
+mm_cbm_dedup_new (guint retention_secs)
+{
+    MMCbmDedup *self;
+
+    self = g_slice_new0 (MMCbmDedup);
+    self->pages = g_hash_table_new_full ((GHashFunc)page_entry_hash,
+                                         (GEqualFunc)page_entry_equal,
+                                         (GDestroyNotify)page_entry_free,
+                                         NULL);
+    self->retention = (gint64) retention_secs * G_USEC_PER_SEC;
+    return self;
+}
+
+void
+mm_cbm_dedup_free (MMCbmDedup *self)
+{
+    g_hash_table_unref (self->pages);
+    g_slice_free (MMCbmDedup, self);
+}
@@ -0,0 +1,48 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#ifndef MM_CBM_DEDUP_H
+#define MM_CBM_DEDUP_H
+
+#include <glib.h>
+
+/* Index of the Cell Broadcast pages received recently, keyed by serial number
+ * (which includes the update number), message identifier and page number.
+ *
+ * Networks repeat the same broadcast periodically and, during emergencies,
+ * on several channels; the index allows dropping the repeated pages from the
+ * header alone, before the PDU is fully parsed. Entries expire once the
+ * retention window has elapsed since the page was last seen. */
+
+typedef struct _MMCbmDedup MMCbmDedup;
+
+/* A zero retention disables the index */
+MMCbmDedup *mm_cbm_dedup_new      (guint       retention_secs);
+void        mm_cbm_dedup_free     (MMCbmDedup *self);
+void        mm_cbm_dedup_clear    (MMCbmDedup *self);
+guint       mm_cbm_dedup_get_size (MMCbmDedup *self);
+
+/* Returns TRUE if the page was already seen within the retention window,
+ * otherwise records it and returns FALSE. Timestamps are given in
+ * microseconds, as returned by g_get_monotonic_time(). */
+gboolean    mm_cbm_dedup_check    (MMCbmDedup *self,
+                                   guint16     serial,
+                                   guint16     channel,
+                                   guint8      part_num,
+                                   gint64      now);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMCbmDedup, mm_cbm_dedup_free)
+
+#endif /* MM_CBM_DEDUP_H */
@@ -30,7 +30,9 @@
 
 #include "mm-iface-modem-messaging.h"
 #include "mm-cbm-list.h"
+#include "mm-cbm-dedup.h"
 #include "mm-base-cbm.h"
+#include "mm-context.h"
 #include "mm-log-object.h"
 #include "mm-bind.h"
 
@@ -63,8 +65,34 @@ struct _MMCbmListPrivate {
     MMBaseModem *modem;
     /* List of cbm objects */
     GList *list;
+    /* (serial, message id) -> cbm object, owned by the list */
+    GHashTable *index;
+    /* Pages received recently */
+    MMCbmDedup *dedup;
 };
 
+#define CBM_INDEX_KEY(serial, channel) GUINT_TO_POINTER (((guint) (serial) << 16) | (channel))
+
+static void
+index_add (MMCbmList *self,
+           MMBaseCbm *cbm)
+{
+    g_hash_table_insert (self->priv->index,
+                         CBM_INDEX_KEY (mm_base_cbm_get_serial (cbm), mm_base_cbm_get_channel (cbm)),
+                         cbm);
+}
+
+static void
+index_remove (MMCbmList *self,
+              MMBaseCbm *cbm)
+{
+    gpointer key;
+
+    key = CBM_INDEX_KEY (mm_base_cbm_get_serial (cbm), mm_base_cbm_get_channel (cbm));
+    if (g_hash_table_lookup (self->priv->index, key) == cbm)
+        g_hash_table_remove (self->priv->index, key);
+}
+
 /*****************************************************************************/
 
 guint
@@ -141,6 +169,7 @@ mm_cbm_list_delete_cbm (MMCbmList *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     self->priv->list = g_list_delete_link (self->priv->list, l);
+    index_remove (self, cbm);
 
     mm_base_cbm_unexport (cbm);
     g_object_unref (cbm);
@@ -157,6 +186,7 @@ mm_cbm_list_add_cbm (MMCbmList *self,
                      MMBaseCbm *cbm)
 {
     self->priv->list = g_list_prepend (self->priv->list, g_object_ref (cbm));
+    index_add (self, cbm);
     g_signal_emit (self, signals[SIGNAL_ADDED], 0,
                    mm_base_cbm_get_path (cbm),
                    FALSE);
@@ -164,19 +194,6 @@ mm_cbm_list_add_cbm (MMCbmList *self,
 
 /*****************************************************************************/
 
-typedef struct {
-    guint16 serial;
-    guint16 channel;
-} PartIdAndSerial;
-
-static guint
-cmp_cbm_by_serial_and_id (MMBaseCbm *cbm,
-                          PartIdAndSerial *ctx)
-{
-    return !(mm_base_cbm_get_serial (cbm) == ctx->serial &&
-             mm_base_cbm_get_channel (cbm) == ctx->channel);
-}
-
 static gboolean
 take_part (MMCbmList *self,
            GObject *bind_to,
@@ -184,22 +201,18 @@ take_part (MMCbmList *self,
            MMCbmState state,
            GError **error)
 {
-    GList *l;
     MMBaseCbm *cbm;
-    PartIdAndSerial cmp;
+    guint16 serial;
+    guint16 channel;
 
-    cmp = (PartIdAndSerial){
-        .serial = mm_cbm_part_get_serial (part),
-        .channel = mm_cbm_part_get_channel (part),
-    };
-    l = g_list_find_custom (self->priv->list,
-                            &cmp,
-                            (GCompareFunc)cmp_cbm_by_serial_and_id);
-    if (l) {
+    serial = mm_cbm_part_get_serial (part);
+    channel = mm_cbm_part_get_channel (part);
+    cbm = g_hash_table_lookup (self->priv->index, CBM_INDEX_KEY (serial, channel));
+    if (cbm) {
         /* Try to take the part */
         mm_obj_dbg (self, "found existing multipart CBM object with serial '%u' and id '%u': adding new part",
-                    cmp.serial, cmp.channel);
-        return mm_base_cbm_take_part (MM_BASE_CBM (l->data), part, error);
+                    serial, channel);
+        return mm_base_cbm_take_part (cbm, part, error);
     }
 
     /* Create new cbm */
@@ -212,9 +225,10 @@ take_part (MMCbmList *self,
         return FALSE;
 
     mm_obj_dbg (self, "creating new multipart CBM object: need to receive %u parts with serial '%u' and id '%u'",
-                mm_cbm_part_get_num_parts (part), cmp.serial, cmp.channel);
+                mm_cbm_part_get_num_parts (part), serial, channel);
 
     self->priv->list = g_list_prepend (self->priv->list, cbm);
+    index_add (self, cbm);
     g_signal_emit (self, signals[SIGNAL_ADDED], 0,
                    mm_base_cbm_get_path (cbm),
                    (state == MM_CBM_STATE_RECEIVED ||
@@ -223,36 +237,30 @@ take_part (MMCbmList *self,
     return TRUE;
 }
 
-typedef struct {
-    guint16 serial;
-    guint16 channel;
-    guint8  part_num;
-} PartIdSerialAndNum;
-
-static guint
-cmp_cbm_by_serial_id_and_part_num (MMBaseCbm          *cbm,
-                                   PartIdSerialAndNum *ctx)
-{
-    return !(mm_base_cbm_get_serial (cbm) == ctx->serial &&
-             mm_base_cbm_get_channel (cbm) == ctx->channel &&
-             mm_base_cbm_has_part_num (cbm, ctx->part_num));
-}
-
 gboolean
 mm_cbm_list_has_part (MMCbmList *self,
                       guint16    serial,
                       guint16    channel,
                       guint8     part_num)
 {
-    PartIdSerialAndNum ctx = {
-        .channel = channel,
-        .serial = serial,
-        .part_num = part_num
-    };
-
-    return !!g_list_find_custom (self->priv->list,
-                                 &ctx,
-                                 (GCompareFunc)cmp_cbm_by_serial_id_and_part_num);
+    MMBaseCbm *cbm;
+
+    cbm = g_hash_table_lookup (self->priv->index, CBM_INDEX_KEY (serial, channel));
+    return (cbm && mm_base_cbm_has_part_num (cbm, part_num));
+}
+
+gboolean
+mm_cbm_list_check_duplicate_page (MMCbmList *self,
+                                  guint16    serial,
+                                  guint16    channel,
+                                  guint8     part_num)
+{
+    /* Pages recently seen, even if the CBM they belonged to was already
+     * removed by the user */
+    if (mm_cbm_dedup_check (self->priv->dedup, serial, channel, part_num, g_get_monotonic_time ()))
+        return TRUE;
+
+    return mm_cbm_list_has_part (self, serial, channel, part_num);
 }
 
 gboolean
@@ -352,6 +360,8 @@ mm_cbm_list_init (MMCbmList *self)
     self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self,
                                               MM_TYPE_CBM_LIST,
                                               MMCbmListPrivate);
+    self->priv->index = g_hash_table_new (g_direct_hash, g_direct_equal);
+    self->priv->dedup = mm_cbm_dedup_new (mm_context_get_cbm_dedup_retention ());
 }
 
 static void
@@ -361,12 +371,23 @@ dispose (GObject *object)
 
     g_clear_object (&self->priv->modem);
     g_clear_object (&self->priv->bind_to);
+    g_clear_pointer (&self->priv->index, g_hash_table_unref);
     g_list_free_full (self->priv->list, g_object_unref);
     self->priv->list = NULL;
 
     G_OBJECT_CLASS (mm_cbm_list_parent_class)->dispose (object);
 }
 
+static void
+finalize (GObject *object)
+{
+    MMCbmList *self = MM_CBM_LIST (object);
+
+    mm_cbm_dedup_free (self->priv->dedup);
+
+    G_OBJECT_CLASS (mm_cbm_list_parent_class)->finalize (object);
+}
+
 static void
 log_object_iface_init (MMLogObjectInterface *iface)
 {
@@ -389,6 +410,7 @@ mm_cbm_list_class_init (MMCbmListClass *klass)
     object_class->get_property = get_property;
     object_class->set_property = set_property;
     object_class->dispose = dispose;
+    object_class->finalize = finalize;
 
     /* Properties */
     properties[PROP_MODEM] =
@@ -68,6 +68,14 @@ gboolean mm_cbm_list_has_part (MMCbmList *self,
                                guint16    message_id,
                                guint8     part_num);
 
+/* Returns TRUE if the page was already received, either in a CBM still in
+ * the list or within the deduplication retention window; otherwise the page
+ * is recorded as seen */
+gboolean mm_cbm_list_check_duplicate_page (MMCbmList *self,
+                                           guint16    serial,
+                                           guint16    message_id,
+                                           guint8     part_num);
+
 gboolean mm_cbm_list_take_part (MMCbmList *self,
                                 GObject *bind_to,
                                 MMCbmPart *part,
@@ -96,6 +96,24 @@ mm_cbm_part_coding_group_to_language (guint8 group)
 }
 
 
+gboolean
+mm_cbm_part_peek_header (const guint8 *pdu,
+                         gsize         pdu_len,
+                         guint16      *serial,
+                         guint16      *channel,
+                         guint8       *part_num)
+{
+    /* Serial number (2 bytes), message identifier (2 bytes), data coding
+     * scheme (1 byte) and page parameter (1 byte) */
+    if (pdu_len < 6)
+        return FALSE;
+
+    *serial = pdu[0] << 8 | pdu[1];
+    *channel = pdu[2] << 8 | pdu[3];
+    *part_num = (pdu[5] & 0xF0) >> 4;
+    return TRUE;
+}
+
 MMCbmPart *
 mm_cbm_part_new_from_pdu (const gchar  *hexpdu,
                           gpointer      log_object,
@@ -56,6 +56,14 @@ MMCbmPart *mm_cbm_part_new_from_binary_pdu (const guint8  *pdu,
                                             gpointer       log_object,
                                             GError       **error);
 
+/* Reads the identifiers of the page from the CBM header, without parsing
+ * the whole PDU */
+gboolean mm_cbm_part_peek_header (const guint8  *pdu,
+                                  gsize          pdu_len,
+                                  guint16       *serial,
+                                  guint16       *channel,
+                                  guint8        *part_num);
+
 MMCbmPart  *mm_cbm_part_new (void);
 void        mm_cbm_part_free (MMCbmPart *part);
 
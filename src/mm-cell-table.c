@@ -0,0 +1,226 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#include "mm-cell-table.h"
+
+/* Dictionary keys identifying a cell; whichever of these are reported for a
+ * given cell type are used to build the table key */
+static const gchar *identity_keys[] = {
+    "ci",
+    "physical-ci",
+    "psc",
+    "cell-parameter-id",
+    "base-station-id",
+    "ref-pn",
+    "arfcn",
+    "uarfcn",
+    "earfcn",
+    "nrarfcn",
+};
+
+typedef struct {
+    GVariant *dictionary;
+    guint     generation;
+} CellEntry;
+
+struct _MMCellTable {
+    /* cell key -> CellEntry */
+    GHashTable      *cells;
+    /* reused when building keys */
+    GString         *key;
+    /* increased on every update; entries not updated in the last
+     * generation are removed */
+    guint            generation;
+    /* state of the ongoing update */
+    gboolean         updating;
+    gboolean         updated;
+    GVariantBuilder  added_builder;
+    GVariantBuilder  changed_builder;
+};
+
+static void
+cell_entry_free (CellEntry *entry)
+{
+    g_variant_unref (entry->dictionary);
+    g_slice_free (CellEntry, entry);
+}
+
+/*****************************************************************************/
+
+static const gchar *
+build_key (MMCellTable *self,
+           MMCellInfo  *info,
+           GVariant    *dictionary)
+{
+    guint i;
+
+    g_string_printf (self->key, "%u", (guint) mm_cell_info_get_cell_type (info));
+    for (i = 0; i < G_N_ELEMENTS (identity_keys); i++) {
+        g_autoptr(GVariant) value = NULL;
+
+        value = g_variant_lookup_value (dictionary, identity_keys[i], NULL);
+        if (!value)
+            continue;
+        g_string_append_printf (self->key, "|%s=", identity_keys[i]);
+        g_variant_print_string (value, self->key, FALSE);
+    }
+    return self->key->str;
+}
+
+void
+mm_cell_table_update_begin (MMCellTable *self)
+{
+    g_assert (!self->updating);
+    self->updating = TRUE;
+    self->updated = FALSE;
+    self->generation++;
+    g_variant_builder_init (&self->added_builder,   G_VARIANT_TYPE ("aa{sv}"));
+    g_variant_builder_init (&self->changed_builder, G_VARIANT_TYPE ("aa{sv}"));
+}
+
+void
+mm_cell_table_update_add (MMCellTable *self,
+                          MMCellInfo  *info)
+{
+    g_autoptr(GVariant)  dictionary = NULL;
+    CellEntry           *entry;
+    const gchar         *key;
+
+    g_assert (self->updating);
+
+    dictionary = mm_cell_info_get_dictionary (info);
+    key = build_key (self, info, dictionary);
+
+    entry = g_hash_table_lookup (self->cells, key);
+    if (!entry) {
+        entry = g_slice_new (CellEntry);
+        entry->dictionary = g_variant_ref (dictionary);
+        entry->generation = self->generation;
+        g_hash_table_insert (self->cells, g_strdup (key), entry);
+        g_variant_builder_add_value (&self->added_builder, dictionary);
+        self->updated = TRUE;
+        return;
+    }
+
+    /* Same cell reported twice in the same sample; keep the first one */
+    if (entry->generation == self->generation)
+        return;
+
+    entry->generation = self->generation;
+    if (!g_variant_equal (entry->dictionary, dictionary)) {
+        g_variant_unref (entry->dictionary);
+        entry->dictionary = g_variant_ref (dictionary);
+        g_variant_builder_add_value (&self->changed_builder, dictionary);
+        self->updated = TRUE;
+    }
+}
+
+gboolean
+mm_cell_table_update_end (MMCellTable  *self,
+                          GVariant    **added,
+                          GVariant    **changed,
+                          GVariant    **removed)
+{
+    GVariantBuilder removed_builder;
+    GHashTableIter  iter;
+    CellEntry      *entry;
+
+    g_assert (self->updating);
+    self->updating = FALSE;
+
+    g_variant_builder_init (&removed_builder, G_VARIANT_TYPE ("aa{sv}"));
+    g_hash_table_iter_init (&iter, self->cells);
+    while (g_hash_table_iter_next (&iter, NULL, (gpointer *)&entry)) {
+        if (entry->generation == self->generation)
+            continue;
+        g_variant_builder_add_value (&removed_builder, entry->dictionary);
+        g_hash_table_iter_remove (&iter);
+        self->updated = TRUE;
+    }
+
+    *added   = g_variant_builder_end (&self->added_builder);
+    *changed = g_variant_builder_end (&self->changed_builder);
+    *removed = g_variant_builder_end (&removed_builder);
+    return self->updated;
+}
+
+void
+mm_cell_table_update_abort (MMCellTable *self)
+{
+    g_assert (self->updating);
+    self->updating = FALSE;
+    g_variant_builder_clear (&self->added_builder);
+    g_variant_builder_clear (&self->changed_builder);
+}
+
+gboolean
+mm_cell_table_is_updating (MMCellTable *self)
+{
+    return self->updating;
+}
+
+gboolean
+mm_cell_table_update (MMCellTable  *self,
+                      GList        *cells,
+                      GVariant    **added,
+                      GVariant    **changed,
+                      GVariant    **removed)
+{
+    GList *l;
+
+    mm_cell_table_update_begin (self);
+    for (l = cells; l; l = g_list_next (l))
+        mm_cell_table_update_add (self, MM_CELL_INFO (l->data));
+    return mm_cell_table_update_end (self, added, changed, removed);
+}
+
+/*****************************************************************************/
+
+guint
+mm_cell_table_get_n_cells (MMCellTable *self)
+{
+    return g_hash_table_size (self->cells);
+}
+
+void
+mm_cell_table_clear (MMCellTable *self)
+{
+    g_hash_table_remove_all (self->cells);
+}
+
+MMCellTable *
+mm_cell_table_new (void)
+{
+    MMCellTable *self;
+
+    self = g_slice_new0 (MMCellTable);
+    self->cells = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify)cell_entry_free);
+    self->key = g_string_new (NULL);
+    return self;
+}
+
+void
+mm_cell_table_free (MMCellTable *self)
+{
+    if (self->updating) {
+        g_variant_builder_clear (&self->added_builder);
+        g_variant_builder_clear (&self->changed_builder);
+    }
+    g_hash_table_unref (self->cells);
+    g_string_free (self->key, TRUE);
+    g_slice_free (MMCellTable, self);
+}
@@ -0,0 +1,65 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#ifndef MM_CELL_TABLE_H
+#define MM_CELL_TABLE_H
+
+#include <glib.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+/* Table of the cells last reported by a modem, keyed by cell type, cell
+ * identity (CI, PCI, PSC...) and frequency channel.
+ *
+ * Each update compares the new list of cells with the table contents, and
+ * reports which cells were added, which ones changed any of their values
+ * (e.g. signal measurements or serving flag) and which ones are no longer
+ * reported. Entries of cells that did not change are kept as they are, so
+ * consecutive samples only cost the comparison. */
+
+typedef struct _MMCellTable MMCellTable;
+
+MMCellTable *mm_cell_table_new  (void);
+void         mm_cell_table_free (MMCellTable *self);
+void         mm_cell_table_clear (MMCellTable *self);
+guint        mm_cell_table_get_n_cells (MMCellTable *self);
+
+/* The added, changed and removed outputs are floating "aa{sv}" variants with
+ * the cell info dictionaries; they are always given, and the method returns
+ * TRUE if any of them is not empty. */
+gboolean mm_cell_table_update (MMCellTable  *self,
+                               GList        *cells,
+                               GVariant    **added,
+                               GVariant    **changed,
+                               GVariant    **removed);
+
+/* Same update, with the cells given one by one as they are loaded, so that
+ * periodic samples don't need to build a list of cells first. */
+void     mm_cell_table_update_begin  (MMCellTable  *self);
+void     mm_cell_table_update_add    (MMCellTable  *self,
+                                      MMCellInfo   *info);
+gboolean mm_cell_table_update_end    (MMCellTable  *self,
+                                      GVariant    **added,
+                                      GVariant    **changed,
+                                      GVariant    **removed);
+/* Stops the ongoing update without removing the cells that were not given,
+ * e.g. when the load failed. */
+void     mm_cell_table_update_abort  (MMCellTable  *self);
+gboolean mm_cell_table_is_updating   (MMCellTable  *self);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMCellTable, mm_cell_table_free)
+
+#endif /* MM_CELL_TABLE_H */
@@ -838,10 +838,11 @@ charset_iconv_to_utf8 (const guint8           *data,
 }
 
 gchar *
-mm_modem_charset_bytearray_to_utf8 (GByteArray      *bytearray,
-                                    MMModemCharset   charset,
-                                    gboolean         translit,
-                                    GError         **error)
+mm_modem_charset_bytes_to_utf8 (const guint8    *data,
+                                gsize            len,
+                                MMModemCharset   charset,
+                                gboolean         translit,
+                                GError         **error)
 {
     const CharsetSettings *settings;
     g_autofree gchar      *utf8 = NULL;
@@ -856,8 +857,8 @@ mm_modem_charset_bytearray_to_utf8 (GByteArray      *bytearray,
 
     switch (charset) {
         case MM_MODEM_CHARSET_GSM:
-            utf8 = (gchar *) charset_gsm_unpacked_to_utf8 (bytearray->data,
-                                                           bytearray->len,
+            utf8 = (gchar *) charset_gsm_unpacked_to_utf8 (data,
+                                                           len,
                                                            translit,
                                                            error);
             break;
@@ -868,8 +869,8 @@ mm_modem_charset_bytearray_to_utf8 (GByteArray      *bytearray,
         case MM_MODEM_CHARSET_PCDN:
         case MM_MODEM_CHARSET_UCS2:
         case MM_MODEM_CHARSET_UTF16:
-            utf8 = charset_iconv_to_utf8 (bytearray->data,
-                                          bytearray->len,
+            utf8 = charset_iconv_to_utf8 (data,
+                                          len,
                                           settings,
                                           translit,
                                           error);
@@ -893,6 +894,15 @@ mm_modem_charset_bytearray_to_utf8 (GByteArray      *bytearray,
     return g_steal_pointer (&utf8);
 }
 
+gchar *
+mm_modem_charset_bytearray_to_utf8 (GByteArray      *bytearray,
+                                    MMModemCharset   charset,
+                                    gboolean         translit,
+                                    GError         **error)
+{
+    return mm_modem_charset_bytes_to_utf8 (bytearray->data, bytearray->len, charset, translit, error);
+}
+
 gchar *
 mm_modem_charset_str_to_utf8 (const gchar     *str,
                               gssize           len,
@@ -92,6 +92,14 @@ gchar *mm_modem_charset_bytearray_to_utf8 (GByteArray      *bytearray,
                                            gboolean         translit,
                                            GError         **error);
 
+/* Same as mm_modem_charset_bytearray_to_utf8(), but reading the input from a
+ * plain buffer, so that no intermediate byte array is needed. */
+gchar *mm_modem_charset_bytes_to_utf8 (const guint8    *data,
+                                       gsize            len,
+                                       MMModemCharset   charset,
+                                       gboolean         translit,
+                                       GError         **error);
+
 /*
  * Convert into an UTF-8 encoded string the input string, which is
  * encoded in the given charset. Those charsets that allow embedded NUL
@@ -35,12 +35,20 @@
 # define NO_AUTO_SCAN_DEFAULT     TRUE
 #endif
 
+#define CBM_DEDUP_RETENTION_DEFAULT 3600
+
 static gboolean      help_flag;
 static gboolean      version_flag;
 static gboolean      debug;
 static MMFilterRule  filter_policy = MM_FILTER_POLICY_STRICT;
 static gboolean      no_auto_scan = NO_AUTO_SCAN_DEFAULT;
 static const gchar  *initial_kernel_events;
+static gint          bearer_stats_interval;
+static const gchar  *dispatcher_helper_socket;
+static gboolean      no_modem_info_cache;
+static gint          cbm_dedup_retention = CBM_DEDUP_RETENTION_DEFAULT;
+static gboolean      slim_modems;
+static gint          profile_main_loop;
 
 static gboolean
 filter_policy_option_arg (const gchar  *option_name,
@@ -84,6 +92,36 @@ static const GOptionEntry entries[] = {
         "Path to initial kernel events file",
         "[PATH]"
     },
+    {
+        "bearer-stats-interval", 0, 0, G_OPTION_ARG_INT, &bearer_stats_interval,
+        "Interval, in ms, to load bearer stats from kernel network interface counters (0 to disable)",
+        "[MS]"
+    },
+    {
+        "dispatcher-helper-socket", 0, 0, G_OPTION_ARG_FILENAME, &dispatcher_helper_socket,
+        "Path to the unix socket of a long-lived dispatcher helper",
+        "[PATH]"
+    },
+    {
+        "no-modem-info-cache", 0, 0, G_OPTION_ARG_NONE, &no_modem_info_cache,
+        "Don't cache static modem information across daemon restarts",
+        NULL
+    },
+    {
+        "cbm-dedup-retention", 0, 0, G_OPTION_ARG_INT, &cbm_dedup_retention,
+        "Time, in seconds, during which repeated cell broadcast pages are ignored (0 to disable, default " G_STRINGIFY (CBM_DEDUP_RETENTION_DEFAULT) ")",
+        "[SECONDS]"
+    },
+    {
+        "slim-modems", 0, 0, G_OPTION_ARG_NONE, &slim_modems,
+        "Don't expose the rarely used OMA, SAR, Voice and Firmware interfaces, to reduce memory usage",
+        NULL
+    },
+    {
+        "profile-main-loop", 0, 0, G_OPTION_ARG_INT, &profile_main_loop,
+        "Profile the callbacks run in the main loop, reporting iterations longer than MS (0 to disable)",
+        "[MS]"
+    },
     {
         "debug", 0, 0, G_OPTION_ARG_NONE, &debug,
         "Run with extended debugging capabilities",
@@ -126,6 +164,42 @@ mm_context_get_filter_policy (void)
     return filter_policy;
 }
 
+guint
+mm_context_get_bearer_stats_interval (void)
+{
+    return (guint) bearer_stats_interval;
+}
+
+const gchar *
+mm_context_get_dispatcher_helper_socket (void)
+{
+    return dispatcher_helper_socket;
+}
+
+gboolean
+mm_context_get_no_modem_info_cache (void)
+{
+    return no_modem_info_cache;
+}
+
+guint
+mm_context_get_cbm_dedup_retention (void)
+{
+    return (guint) cbm_dedup_retention;
+}
+
+gboolean
+mm_context_get_slim_modems (void)
+{
+    return slim_modems;
+}
+
+guint
+mm_context_get_profile_main_loop (void)
+{
+    return (guint) profile_main_loop;
+}
+
 /*****************************************************************************/
 /* Log context */
 
@@ -231,6 +305,8 @@ static gboolean  test_enable;
 #endif
 #if !defined WITH_BUILTIN_PLUGINS
 static gchar    *test_plugin_dir;
+static gboolean  test_no_plugin_manifest;
+static gchar    *test_write_plugin_manifest;
 #endif
 #if defined WITH_UDEV
 static gboolean  test_no_udev;
@@ -267,6 +343,16 @@ static const GOptionEntry test_entries[] = {
         "Path to look for plugins",
         "[PATH]"
     },
+    {
+        "test-no-plugin-manifest", 0, 0, G_OPTION_ARG_NONE, &test_no_plugin_manifest,
+        "Load all plugins on startup, ignoring the plugin manifest",
+        NULL
+    },
+    {
+        "test-write-plugin-manifest", 0, 0, G_OPTION_ARG_FILENAME, &test_write_plugin_manifest,
+        "Write the manifest of the plugins found in the plugin directory and exit",
+        "[PATH]"
+    },
 #endif
 #if defined WITH_UDEV
     {
@@ -348,6 +434,18 @@ mm_context_get_test_plugin_dir (void)
 {
     return test_plugin_dir ? test_plugin_dir : PLUGINDIR;
 }
+
+gboolean
+mm_context_get_test_no_plugin_manifest (void)
+{
+    return test_no_plugin_manifest;
+}
+
+const gchar *
+mm_context_get_test_write_plugin_manifest (void)
+{
+    return test_write_plugin_manifest;
+}
 #endif
 
 #if defined WITH_UDEV
@@ -465,6 +563,16 @@ mm_context_init (gint argc,
             log_show_ts = TRUE;
     }
 
+    if (bearer_stats_interval < 0) {
+        g_printerr ("error: --bearer-stats-interval must not be negative\n");
+        exit (1);
+    }
+
+    if (cbm_dedup_retention < 0) {
+        g_printerr ("error: --cbm-dedup-retention must not be negative\n");
+        exit (1);
+    }
+
     /* Initial kernel events processing may only be used if autoscan is disabled */
 #if defined WITH_UDEV || defined WITH_QRTR
     if (!no_auto_scan && initial_kernel_events) {
@@ -35,6 +35,24 @@ gboolean     mm_context_get_no_auto_scan          (void);
 /* Filter support */
 MMFilterRule mm_context_get_filter_policy (void);
 
+/* Bearer stats support */
+guint        mm_context_get_bearer_stats_interval (void);
+
+/* Dispatcher support */
+const gchar *mm_context_get_dispatcher_helper_socket (void);
+
+/* Modem info cache support */
+gboolean     mm_context_get_no_modem_info_cache (void);
+
+/* Cell broadcast support */
+guint        mm_context_get_cbm_dedup_retention (void);
+
+/* Memory footprint support */
+gboolean     mm_context_get_slim_modems (void);
+
+/* Main loop profiling support */
+guint        mm_context_get_profile_main_loop (void);
+
 /* Logging support */
 const gchar *mm_context_get_log_level               (void);
 const gchar *mm_context_get_log_file                (void);
@@ -50,6 +68,8 @@ gboolean     mm_context_get_test_enable            (void);
 #endif
 #if !defined WITH_BUILTIN_PLUGINS
 const gchar *mm_context_get_test_plugin_dir        (void);
+gboolean     mm_context_get_test_no_plugin_manifest    (void);
+const gchar *mm_context_get_test_write_plugin_manifest (void);
 #endif
 #if defined WITH_UDEV
 gboolean     mm_context_get_test_no_udev           (void);
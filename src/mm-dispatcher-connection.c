@@ -105,6 +105,15 @@ dispatcher_run_ready (MMDispatcher *self,
     ctx = g_task_get_task_data (task);
 
     if (!mm_dispatcher_run_finish (self, res, &error)) {
+        /* If superseded by a newer event, skip all the pending scripts */
+        if (g_error_matches (error, MM_CORE_ERROR, MM_CORE_ERROR_CANCELLED)) {
+            mm_obj_dbg (self, OPERATION_DESCRIPTION " operation from %s skipped: %s",
+                        g_file_peek_path (ctx->current), error->message);
+            g_clear_object (&ctx->current);
+            g_task_return_boolean (task, TRUE);
+            g_object_unref (task);
+            return;
+        }
         ctx->n_failures++;
         mm_obj_warn (self, "Cannot run " OPERATION_DESCRIPTION " operation from %s: %s",
                      g_file_peek_path (ctx->current), error->message);
@@ -155,8 +164,10 @@ connection_run_next (GTask *task)
     argv = (GStrv) g_ptr_array_free (aux, FALSE);
 
     /* run */
+    /* A newer event on the same bearer supersedes this one, if not yet run */
     mm_dispatcher_run (MM_DISPATCHER (self),
                        argv,
+                       ctx->bearer_dbus_path,
                        MAX_CONNECTION_EXEC_TIME_SECS,
                        g_task_get_cancellable (task),
                        (GAsyncReadyCallback) dispatcher_run_ready,
@@ -117,9 +117,10 @@ mm_dispatcher_fcc_unlock_run (MMDispatcherFccUnlock  *self,
         g_ptr_array_add (aux, NULL);
         argv = (GStrv) g_ptr_array_free (aux, FALSE);
 
-        /* run */
+        /* run, in parallel with other modems */
         mm_dispatcher_run (MM_DISPATCHER (self),
                            argv,
+                           modem_dbus_path,
                            MAX_FCC_UNLOCK_EXEC_TIME_SECS,
                            cancellable,
                            (GAsyncReadyCallback) dispatcher_run_ready,
@@ -119,9 +119,10 @@ mm_dispatcher_modem_setup_run (MMDispatcherModemSetup  *self,
         g_ptr_array_add (aux, NULL);
         argv = (GStrv) g_ptr_array_free (aux, FALSE);
 
-        /* run */
+        /* run, in parallel with other modems */
         mm_dispatcher_run (MM_DISPATCHER (self),
                            argv,
+                           device_path,
                            MAX_MODEM_SETUP_EXEC_TIME_SECS,
                            g_task_get_cancellable (task),
                            (GAsyncReadyCallback) dispatcher_run_ready,
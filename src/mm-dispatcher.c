@@ -16,10 +16,15 @@
 #include <config.h>
 #include <sys/stat.h>
 
+#include <gio/gunixsocketaddress.h>
+
 #include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
 #include "mm-errors-types.h"
 #include "mm-utils.h"
 #include "mm-log-object.h"
+#include "mm-context.h"
 #include "mm-dispatcher.h"
 
 static void log_object_iface_init (MMLogObjectInterface *iface);
@@ -35,9 +40,33 @@ enum {
 
 static GParamSpec *properties[PROP_LAST];
 
+/* Maximum time connecting or writing to the helper may take */
+#define MAX_HELPER_IO_TIME_SECS 2
+
 struct _MMDispatcherPrivate {
     gchar               *operation_description;
     GSubprocessLauncher *launcher;
+
+    /* Run queue */
+    GQueue     *pending;
+    GHashTable *running_keys;
+    guint       n_running;
+    gboolean    processing;
+
+    /* Long-lived helper */
+    GSocketConnection *helper_connection;
+    GDataInputStream  *helper_input;
+    GQueue            *helper_outgoing;
+    GQueue            *helper_awaiting;
+    gboolean           helper_connecting;
+    gboolean           helper_reading;
+    GCancellable      *helper_io_cancellable;
+    guint              helper_io_timeout_id;
+    /* Request being written; task is NULL if it timed out meanwhile */
+    gboolean           helper_writing_active;
+    GTask             *helper_writing;
+    gchar             *helper_request;
+    gsize              helper_request_len;
 };
 
 /*****************************************************************************/
@@ -124,17 +153,41 @@ validate_file (const gchar  *path,
 }
 
 /*****************************************************************************/
+/* Run queue
+ *
+ * Operations are queued and run with a bounded concurrency, so that a burst
+ * of events (e.g. mass reconnections after a network outage) does not end up
+ * spawning an unbounded number of processes. Operations for the same script
+ * and key (e.g. the same bearer) are run one after the other, so that the
+ * script sees the events in order, while different keys may run the same
+ * script in parallel. Operations without a key are serialized per script.
+ * A queued operation that has not started yet is superseded by a newer one
+ * requested for the same script and key, as only the latest event is
+ * relevant at that point.
+ */
+
+#define MAX_RUNNING 4
 
 typedef struct {
+    GStrv        argv;
+    gchar       *key;
+    gchar       *running_key;
+    guint        timeout_secs;
     GSubprocess *subprocess;
     guint        timeout_id;
+    gboolean     running;
+    gboolean     via_helper;
 } RunContext;
 
 static void
 run_context_free (RunContext *ctx)
 {
     g_assert (!ctx->timeout_id);
+    g_assert (!ctx->running);
     g_clear_object (&ctx->subprocess);
+    g_strfreev (ctx->argv);
+    g_free (ctx->key);
+    g_free (ctx->running_key);
     g_slice_free (RunContext, ctx);
 }
 
@@ -146,8 +199,11 @@ mm_dispatcher_run_finish (MMDispatcher  *self,
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
-static gboolean
-subprocess_wait_timed_out (GTask *task)
+static void queue_process (MMDispatcher *self);
+
+static void
+run_complete (GTask  *task,
+              GError *error)
 {
     MMDispatcher *self;
     RunContext   *ctx;
@@ -155,10 +211,383 @@ subprocess_wait_timed_out (GTask *task)
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
 
-    mm_obj_warn (self, "forcing exit on %s operation", self->priv->operation_description);
-    g_subprocess_force_exit (ctx->subprocess);
+    if (ctx->timeout_id) {
+        g_source_remove (ctx->timeout_id);
+        ctx->timeout_id = 0;
+    }
+
+    g_assert (ctx->running);
+    ctx->running = FALSE;
+    g_assert (self->priv->n_running > 0);
+    self->priv->n_running--;
+    g_assert (g_hash_table_contains (self->priv->running_keys, ctx->running_key));
+    g_hash_table_remove (self->priv->running_keys, ctx->running_key);
+
+    /* keep the dispatcher alive until the queue has been processed */
+    g_object_ref (self);
+    if (error)
+        g_task_return_error (task, error);
+    else
+        g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+
+    queue_process (self);
+    g_object_unref (self);
+}
+
+/*****************************************************************************/
+/* Helper support
+ *
+ * Instead of spawning a new process for every operation, the operations may
+ * be sent to a long-lived helper listening in a unix socket. The protocol is
+ * line based; each request is one line with the script path and its arguments
+ * escaped with g_strescape() and separated by one space, and the helper must
+ * reply to each request, in the same order, with one line containing the exit
+ * status of the script (0 on success). If the helper isn't available, the
+ * scripts are executed directly.
+ */
+
+static void helper_read_next (MMDispatcher *self);
+static void helper_process (MMDispatcher *self);
+static void run_spawn      (MMDispatcher *self,
+                            GTask        *task);
+
+static void
+helper_io_timeout_stop (MMDispatcher *self)
+{
+    if (self->priv->helper_io_timeout_id) {
+        g_source_remove (self->priv->helper_io_timeout_id);
+        self->priv->helper_io_timeout_id = 0;
+    }
+    g_clear_object (&self->priv->helper_io_cancellable);
+}
+
+static gboolean
+helper_io_timed_out (MMDispatcher *self)
+{
+    self->priv->helper_io_timeout_id = 0;
+    g_cancellable_cancel (self->priv->helper_io_cancellable);
+    return G_SOURCE_REMOVE;
+}
+
+/* Connecting and writing to the helper are bounded in time; reading the
+ * replies isn't, as those come once the scripts finish, and each operation
+ * has its own timeout anyway */
+static GCancellable *
+helper_io_timeout_start (MMDispatcher *self)
+{
+    g_assert (!self->priv->helper_io_cancellable);
+    self->priv->helper_io_cancellable = g_cancellable_new ();
+    self->priv->helper_io_timeout_id = g_timeout_add_seconds (MAX_HELPER_IO_TIME_SECS,
+                                                              (GSourceFunc) helper_io_timed_out,
+                                                              self);
+    return self->priv->helper_io_cancellable;
+}
+
+static void
+helper_fallback (MMDispatcher *self,
+                 GTask        *task)
+{
+    RunContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+    ctx->via_helper = FALSE;
+    run_spawn (self, task);
+}
+
+static void
+helper_fallback_all (MMDispatcher *self)
+{
+    GQueue *outgoing;
+
+    /* The queue is replaced first, as completing operations may trigger
+     * new ones */
+    outgoing = self->priv->helper_outgoing;
+    self->priv->helper_outgoing = g_queue_new ();
+    while (!g_queue_is_empty (outgoing))
+        helper_fallback (self, g_queue_pop_head (outgoing));
+    g_queue_free (outgoing);
+}
+
+static void
+helper_close (MMDispatcher *self,
+              const GError *error)
+{
+    GQueue *awaiting;
+    GTask  *task;
+
+    if (self->priv->helper_connection)
+        mm_obj_dbg (self, "closing helper connection: %s", error ? error->message : "unknown error");
+
+    /* A write in progress completes with an error right away */
+    if (self->priv->helper_writing_active && self->priv->helper_io_cancellable)
+        g_cancellable_cancel (self->priv->helper_io_cancellable);
+
+    g_clear_object (&self->priv->helper_input);
+    if (self->priv->helper_connection) {
+        g_io_stream_close (G_IO_STREAM (self->priv->helper_connection), NULL, NULL);
+        g_clear_object (&self->priv->helper_connection);
+    }
+    self->priv->helper_reading = FALSE;
+
+    /* Fail all operations waiting for a reply; operations that already timed
+     * out are kept as NULL placeholders in the queue. The queue is replaced
+     * first, as completing operations may trigger new ones. */
+    awaiting = self->priv->helper_awaiting;
+    self->priv->helper_awaiting = g_queue_new ();
+    while (!g_queue_is_empty (awaiting)) {
+        task = g_queue_pop_head (awaiting);
+        if (!task)
+            continue;
+        run_complete (task,
+                      g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                   "%s operation helper connection closed: %s",
+                                   self->priv->operation_description,
+                                   error ? error->message : "unknown error"));
+    }
+    g_queue_free (awaiting);
+}
+
+static void
+helper_read_line_ready (GDataInputStream *input,
+                        GAsyncResult     *res,
+                        MMDispatcher     *self)
+{
+    g_autoptr(GError)  error = NULL;
+    g_autofree gchar  *line = NULL;
+    GTask             *task;
+    guint              status;
+
+    line = g_data_input_stream_read_line_finish (input, res, NULL, &error);
+
+    /* Ignore replies from a connection that was already closed */
+    if (input != self->priv->helper_input) {
+        g_object_unref (self);
+        return;
+    }
+
+    self->priv->helper_reading = FALSE;
+
+    if (!line) {
+        if (!error)
+            error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED, "end of stream");
+        helper_close (self, error);
+        /* Reconnect for the operations not sent yet, if any */
+        helper_process (self);
+        g_object_unref (self);
+        return;
+    }
+
+    /* Operations that already timed out have a NULL placeholder */
+    task = g_queue_pop_head (self->priv->helper_awaiting);
+    if (task) {
+        if (!mm_get_uint_from_str (g_strstrip (line), &status))
+            run_complete (task,
+                          g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                       "%s operation helper reply unexpected: %s",
+                                       self->priv->operation_description, line));
+        else if (status != 0)
+            run_complete (task,
+                          g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                       "%s operation finished with status %u",
+                                       self->priv->operation_description, status));
+        else
+            run_complete (task, NULL);
+    }
+
+    helper_read_next (self);
+    g_object_unref (self);
+}
+
+static void
+helper_read_next (MMDispatcher *self)
+{
+    if (self->priv->helper_reading ||
+        !self->priv->helper_input ||
+        g_queue_is_empty (self->priv->helper_awaiting))
+        return;
+
+    self->priv->helper_reading = TRUE;
+    g_data_input_stream_read_line_async (self->priv->helper_input,
+                                         G_PRIORITY_DEFAULT,
+                                         NULL,
+                                         (GAsyncReadyCallback) helper_read_line_ready,
+                                         g_object_ref (self));
+}
+
+static void
+helper_write_ready (GOutputStream *output,
+                    GAsyncResult  *res,
+                    MMDispatcher  *self)
+{
+    g_autoptr(GError)  error = NULL;
+    GTask             *task;
+
+    g_output_stream_write_all_finish (output, res, NULL, &error);
+    helper_io_timeout_stop (self);
+
+    /* NULL if the operation timed out while being written */
+    task = self->priv->helper_writing;
+    self->priv->helper_writing = NULL;
+    self->priv->helper_writing_active = FALSE;
+
+    /* The connection may have been closed while writing */
+    if (!error && (!self->priv->helper_connection ||
+                   output != g_io_stream_get_output_stream (G_IO_STREAM (self->priv->helper_connection))))
+        error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_ABORTED, "connection closed while writing");
+
+    if (error) {
+        if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+            g_clear_error (&error);
+            error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_TIMEOUT, "write timed out");
+        }
+        helper_close (self, error);
+        /* Fall back to executing the script directly */
+        if (task)
+            helper_fallback (self, task);
+    } else {
+        /* The helper replies even to operations that already timed out, so
+         * keep a placeholder for those */
+        g_queue_push_tail (self->priv->helper_awaiting, task);
+        helper_read_next (self);
+    }
+
+    helper_process (self);
+    g_object_unref (self);
+}
+
+static void
+helper_write_next (MMDispatcher *self)
+{
+    GString    *request;
+    RunContext *ctx;
+    GTask      *task;
+    guint       i;
+
+    task = g_queue_pop_head (self->priv->helper_outgoing);
+    ctx = g_task_get_task_data (task);
+
+    request = g_string_new (NULL);
+    for (i = 0; ctx->argv[i]; i++) {
+        g_autofree gchar *escaped = NULL;
+
+        escaped = g_strescape (ctx->argv[i], NULL);
+        g_string_append_printf (request, "%s%s", i ? " " : "", escaped);
+    }
+    g_string_append_c (request, '\n');
+
+    /* The buffer must be valid until the write finishes */
+    g_free (self->priv->helper_request);
+    self->priv->helper_request_len = request->len;
+    self->priv->helper_request = g_string_free (request, FALSE);
+
+    self->priv->helper_writing = task;
+    self->priv->helper_writing_active = TRUE;
+    g_output_stream_write_all_async (g_io_stream_get_output_stream (G_IO_STREAM (self->priv->helper_connection)),
+                                     self->priv->helper_request,
+                                     self->priv->helper_request_len,
+                                     G_PRIORITY_DEFAULT,
+                                     helper_io_timeout_start (self),
+                                     (GAsyncReadyCallback) helper_write_ready,
+                                     g_object_ref (self));
+}
+
+static void
+helper_connect_ready (GSocketClient *client,
+                      GAsyncResult  *res,
+                      MMDispatcher  *self)
+{
+    g_autoptr(GError) error = NULL;
+
+    self->priv->helper_connection = g_socket_client_connect_finish (client, res, &error);
+    helper_io_timeout_stop (self);
+    self->priv->helper_connecting = FALSE;
+
+    if (!self->priv->helper_connection) {
+        mm_obj_dbg (self, "couldn't connect to helper: %s", error->message);
+        helper_fallback_all (self);
+        g_object_unref (self);
+        return;
+    }
+
+    self->priv->helper_input = g_data_input_stream_new (g_io_stream_get_input_stream (G_IO_STREAM (self->priv->helper_connection)));
+    g_data_input_stream_set_newline_type (self->priv->helper_input, G_DATA_STREAM_NEWLINE_TYPE_LF);
+    mm_obj_dbg (self, "connected to helper");
+
+    helper_process (self);
+    g_object_unref (self);
+}
+
+static void
+helper_connect (MMDispatcher *self)
+{
+    g_autoptr(GSocketClient)  client = NULL;
+    g_autoptr(GSocketAddress) address = NULL;
+
+    client = g_socket_client_new ();
+    address = g_unix_socket_address_new (mm_context_get_dispatcher_helper_socket ());
+
+    self->priv->helper_connecting = TRUE;
+    g_socket_client_connect_async (client,
+                                   G_SOCKET_CONNECTABLE (address),
+                                   helper_io_timeout_start (self),
+                                   (GAsyncReadyCallback) helper_connect_ready,
+                                   g_object_ref (self));
+}
+
+/* Requests are written one at a time, in order, as the replies come in the
+ * same order */
+static void
+helper_process (MMDispatcher *self)
+{
+    if (self->priv->helper_connecting ||
+        self->priv->helper_writing_active ||
+        g_queue_is_empty (self->priv->helper_outgoing))
+        return;
+
+    if (!self->priv->helper_connection)
+        helper_connect (self);
+    else
+        helper_write_next (self);
+}
+
+/*****************************************************************************/
+/* Subprocess support */
+
+static gboolean
+run_timed_out (GTask *task)
+{
+    MMDispatcher *self;
+    RunContext   *ctx;
+    GList        *l;
 
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
     ctx->timeout_id = 0;
+
+    if (!ctx->via_helper) {
+        mm_obj_warn (self, "forcing exit on %s operation", self->priv->operation_description);
+        g_subprocess_force_exit (ctx->subprocess);
+        return G_SOURCE_REMOVE;
+    }
+
+    if ((l = g_queue_find (self->priv->helper_outgoing, task)) != NULL) {
+        /* Not sent to the helper yet */
+        g_queue_delete_link (self->priv->helper_outgoing, l);
+    } else if (self->priv->helper_writing == task) {
+        /* Being sent; a placeholder is queued once written */
+        self->priv->helper_writing = NULL;
+    } else {
+        /* The reply from the helper is still expected, so keep a placeholder */
+        l = g_queue_find (self->priv->helper_awaiting, task);
+        g_assert (l);
+        l->data = NULL;
+    }
+
+    run_complete (task,
+                  g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_TIMEOUT,
+                               "%s operation timed out in helper",
+                               self->priv->operation_description));
     return G_SOURCE_REMOVE;
 }
 
@@ -169,42 +598,159 @@ subprocess_wait_ready (GSubprocess  *subprocess,
 {
     GError       *error = NULL;
     MMDispatcher *self;
-    RunContext   *ctx;
 
     self = g_task_get_source_object (task);
-    ctx = g_task_get_task_data (task);
-
-    /* cleanup timeout before any return */
-    if (ctx->timeout_id) {
-        g_source_remove (ctx->timeout_id);
-        ctx->timeout_id = 0;
-    }
 
-    if (!g_subprocess_wait_finish (subprocess, res, &error)) {
+    if (!g_subprocess_wait_finish (subprocess, res, &error))
         g_prefix_error (&error, "%s operation wait failed: ", self->priv->operation_description);
-        g_task_return_error (task, error);
-    } else if (!g_subprocess_get_successful (subprocess)) {
+    else if (!g_subprocess_get_successful (subprocess)) {
         if (g_subprocess_get_if_signaled (subprocess))
-            g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                     "%s operation aborted with signal %d",
-                                     self->priv->operation_description,
-                                     g_subprocess_get_term_sig (subprocess));
+            error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                 "%s operation aborted with signal %d",
+                                 self->priv->operation_description,
+                                 g_subprocess_get_term_sig (subprocess));
         else if (g_subprocess_get_if_exited (subprocess))
-            g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                     "%s operation finished with status %d",
-                                     self->priv->operation_description,
-                                     g_subprocess_get_exit_status (subprocess));
+            error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                 "%s operation finished with status %d",
+                                 self->priv->operation_description,
+                                 g_subprocess_get_exit_status (subprocess));
         else
-            g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                     "%s operation failed", self->priv->operation_description);
-    } else
-        g_task_return_boolean (task, TRUE);
-    g_object_unref (task);
+            error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                 "%s operation failed", self->priv->operation_description);
+    }
+
+    run_complete (task, error);
+}
+
+static void
+run_start (MMDispatcher *self,
+           GTask        *task)
+{
+    RunContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+
+    if (g_task_return_error_if_cancelled (task)) {
+        g_object_unref (task);
+        return;
+    }
+
+    self->priv->n_running++;
+    g_hash_table_add (self->priv->running_keys, g_strdup (ctx->running_key));
+    ctx->running = TRUE;
+
+    /* setup timeout */
+    ctx->timeout_id = g_timeout_add_seconds (ctx->timeout_secs,
+                                             (GSourceFunc)run_timed_out,
+                                             task);
+
+    /* prefer the long-lived helper, if any */
+    if (mm_context_get_dispatcher_helper_socket ()) {
+        ctx->via_helper = TRUE;
+        g_queue_push_tail (self->priv->helper_outgoing, task);
+        helper_process (self);
+        return;
+    }
+
+    run_spawn (self, task);
+}
+
+static void
+run_spawn (MMDispatcher *self,
+           GTask        *task)
+{
+    RunContext *ctx;
+    GError     *error = NULL;
+
+    ctx = g_task_get_task_data (task);
+
+    /* create and launch subprocess */
+    ctx->subprocess = g_subprocess_launcher_spawnv (self->priv->launcher,
+                                                    (const gchar * const *)ctx->argv,
+                                                    &error);
+    if (!ctx->subprocess) {
+        g_prefix_error (&error, "%s operation launch from %s failed: ",
+                        self->priv->operation_description, ctx->argv[0]);
+        run_complete (task, error);
+        return;
+    }
+
+    /* wait for subprocess exit */
+    g_subprocess_wait_async (ctx->subprocess,
+                             g_task_get_cancellable (task),
+                             (GAsyncReadyCallback)subprocess_wait_ready,
+                             task);
+}
+
+static void
+queue_process (MMDispatcher *self)
+{
+    /* Starting an operation may complete others right away, which would
+     * process the queue again; avoid that, the loop below takes care */
+    if (self->priv->processing)
+        return;
+    self->priv->processing = TRUE;
+
+    while (self->priv->n_running < MAX_RUNNING) {
+        GTask *task;
+        GList *l;
+
+        /* Always restart from the head, as the queue may have changed */
+        for (l = self->priv->pending->head; l; l = g_list_next (l)) {
+            RunContext *ctx;
+
+            ctx = g_task_get_task_data (G_TASK (l->data));
+            if (!g_hash_table_contains (self->priv->running_keys, ctx->running_key))
+                break;
+        }
+        if (!l)
+            break;
+
+        task = G_TASK (l->data);
+        g_queue_delete_link (self->priv->pending, l);
+        run_start (self, task);
+    }
+
+    self->priv->processing = FALSE;
+}
+
+static void
+queue_supersede (MMDispatcher *self,
+                 RunContext   *new_ctx)
+{
+    GList *l;
+    GList *superseded = NULL;
+
+    l = self->priv->pending->head;
+    while (l) {
+        RunContext *ctx;
+        GList      *next;
+
+        next = g_list_next (l);
+        ctx = g_task_get_task_data (G_TASK (l->data));
+        if (g_str_equal (ctx->argv[0], new_ctx->argv[0]) && !g_strcmp0 (ctx->key, new_ctx->key)) {
+            mm_obj_dbg (self, "%s operation from %s superseded (%s)",
+                        self->priv->operation_description, ctx->argv[0], ctx->key);
+            superseded = g_list_append (superseded, l->data);
+            g_queue_delete_link (self->priv->pending, l);
+        }
+        l = next;
+    }
+
+    /* Complete only once the queue is no longer being iterated */
+    for (l = superseded; l; l = g_list_next (l)) {
+        g_task_return_new_error (G_TASK (l->data), MM_CORE_ERROR, MM_CORE_ERROR_CANCELLED,
+                                 "%s operation superseded by a newer one",
+                                 self->priv->operation_description);
+        g_object_unref (l->data);
+    }
+    g_list_free (superseded);
 }
 
 void
 mm_dispatcher_run (MMDispatcher        *self,
                    const GStrv          argv,
+                   const gchar         *key,
                    guint                timeout_secs,
                    GCancellable        *cancellable,
                    GAsyncReadyCallback  callback,
@@ -218,6 +764,10 @@ mm_dispatcher_run (MMDispatcher        *self,
 
     task = g_task_new (self, cancellable, callback, user_data);
     ctx = g_slice_new0 (RunContext);
+    ctx->argv = g_strdupv (argv);
+    ctx->key = g_strdup (key);
+    ctx->running_key = (key ? g_strdup_printf ("%s %s", argv[0], key) : g_strdup (argv[0]));
+    ctx->timeout_secs = timeout_secs;
     g_task_set_task_data (task, ctx, (GDestroyNotify) run_context_free);
 
     /* Validation checks to see if we should run it or not */
@@ -229,28 +779,11 @@ mm_dispatcher_run (MMDispatcher        *self,
         return;
     }
 
-    /* create and launch subprocess */
-    ctx->subprocess = g_subprocess_launcher_spawnv (self->priv->launcher,
-                                                    (const gchar * const *)argv,
-                                                    &error);
-    if (!ctx->subprocess) {
-        g_prefix_error (&error, "%s operation launch from %s failed: ",
-                        self->priv->operation_description, argv[0]);
-        g_task_return_error (task, error);
-        g_object_unref (task);
-        return;
-    }
+    if (key)
+        queue_supersede (self, ctx);
 
-    /* setup timeout */
-    ctx->timeout_id = g_timeout_add_seconds (timeout_secs,
-                                             (GSourceFunc)subprocess_wait_timed_out,
-                                             task);
-
-    /* wait for subprocess exit */
-    g_subprocess_wait_async (ctx->subprocess,
-                             cancellable,
-                             (GAsyncReadyCallback)subprocess_wait_ready,
-                             task);
+    g_queue_push_tail (self->priv->pending, task);
+    queue_process (self);
 }
 
 /*****************************************************************************/
@@ -264,6 +797,11 @@ mm_dispatcher_init (MMDispatcher *self)
     /* Create launcher and inherit parent's environment */
     self->priv->launcher = g_subprocess_launcher_new (G_SUBPROCESS_FLAGS_STDOUT_SILENCE | G_SUBPROCESS_FLAGS_STDERR_SILENCE);
     g_subprocess_launcher_set_environ (self->priv->launcher, NULL);
+
+    self->priv->pending = g_queue_new ();
+    self->priv->running_keys = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    self->priv->helper_outgoing = g_queue_new ();
+    self->priv->helper_awaiting = g_queue_new ();
 }
 
 static void
@@ -308,6 +846,7 @@ dispose (GObject *object)
 {
     MMDispatcher *self = MM_DISPATCHER (object);
 
+    helper_close (self, NULL);
     g_clear_object (&self->priv->launcher);
 
     G_OBJECT_CLASS (mm_dispatcher_parent_class)->dispose (object);
@@ -318,6 +857,14 @@ finalize (GObject *object)
 {
     MMDispatcher *self = MM_DISPATCHER (object);
 
+    /* every queued operation holds a reference to the dispatcher */
+    g_assert (g_queue_is_empty (self->priv->pending));
+    g_queue_free (self->priv->pending);
+    g_assert (g_queue_is_empty (self->priv->helper_outgoing));
+    g_queue_free (self->priv->helper_outgoing);
+    g_queue_free (self->priv->helper_awaiting);
+    g_free (self->priv->helper_request);
+    g_hash_table_unref (self->priv->running_keys);
     g_free (self->priv->operation_description);
 
     G_OBJECT_CLASS (mm_dispatcher_parent_class)->finalize (object);
@@ -44,8 +44,13 @@ struct _MMDispatcherClass {
 GType mm_dispatcher_get_type (void);
 G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMDispatcher, g_object_unref)
 
+/* Operations with the same script and key are run one after the other, and
+ * operations with different keys may run in parallel. If a key is given, a
+ * newer operation requested with the same script and key supersedes any
+ * older one still waiting in the queue. */
 void     mm_dispatcher_run        (MMDispatcher         *self,
                                    const GStrv           argv,
+                                   const gchar          *key,
                                    guint                 timeout_secs,
                                    GCancellable         *cancellable,
                                    GAsyncReadyCallback   callback,
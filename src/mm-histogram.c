@@ -0,0 +1,106 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <string.h>
+
+#include "mm-histogram.h"
+
+/* Values below this are recorded exactly, one bucket each */
+#define EXACT_LIMIT (2 * MM_HISTOGRAM_SUB_BUCKETS)
+
+void
+mm_histogram_reset (MMHistogram *histogram)
+{
+    memset (histogram, 0, sizeof (MMHistogram));
+}
+
+static guint
+bucket_index (guint64 value)
+{
+    guint shift;
+    guint index;
+
+    if (value < EXACT_LIMIT)
+        return (guint) value;
+
+    /* Keep the most significant bits of the value: the leading one gives
+     * the magnitude, the next ones the bucket within that magnitude */
+    shift = g_bit_storage (value) - 1 - MM_HISTOGRAM_SUB_BUCKET_BITS;
+    index = EXACT_LIMIT +
+            (shift - 1) * MM_HISTOGRAM_SUB_BUCKETS +
+            (guint) ((value >> shift) - MM_HISTOGRAM_SUB_BUCKETS);
+
+    return MIN (index, MM_HISTOGRAM_N_BUCKETS - 1);
+}
+
+static guint64
+bucket_upper_bound (guint index)
+{
+    guint shift;
+    guint sub;
+
+    if (index < EXACT_LIMIT)
+        return index;
+
+    shift = (index - EXACT_LIMIT) / MM_HISTOGRAM_SUB_BUCKETS + 1;
+    sub = (index - EXACT_LIMIT) % MM_HISTOGRAM_SUB_BUCKETS;
+    return (((guint64) (MM_HISTOGRAM_SUB_BUCKETS + sub + 1)) << shift) - 1;
+}
+
+void
+mm_histogram_add (MMHistogram *histogram,
+                  guint64      value)
+{
+    if (!histogram->count || value < histogram->min)
+        histogram->min = value;
+    if (value > histogram->max)
+        histogram->max = value;
+    histogram->count++;
+    histogram->sum += value;
+    histogram->buckets[bucket_index (value)]++;
+}
+
+guint64
+mm_histogram_get_percentile (const MMHistogram *histogram,
+                             gdouble            percentile)
+{
+    guint64 target;
+    guint64 accumulated = 0;
+    guint   i;
+
+    if (!histogram->count)
+        return 0;
+
+    percentile = CLAMP (percentile, 0.0, 100.0);
+    target = (guint64) (percentile * histogram->count / 100.0 + 0.5);
+    target = CLAMP (target, 1, histogram->count);
+
+    for (i = 0; i < MM_HISTOGRAM_N_BUCKETS; i++) {
+        accumulated += histogram->buckets[i];
+        if (accumulated >= target)
+            break;
+    }
+
+    /* The largest bucket also holds every value above it */
+    if (i >= MM_HISTOGRAM_N_BUCKETS - 1)
+        return histogram->max;
+    return MIN (bucket_upper_bound (i), histogram->max);
+}
+
+guint64
+mm_histogram_get_mean (const MMHistogram *histogram)
+{
+    return histogram->count ? histogram->sum / histogram->count : 0;
+}
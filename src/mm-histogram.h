@@ -0,0 +1,51 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#ifndef MM_HISTOGRAM_H
+#define MM_HISTOGRAM_H
+
+#include <glib.h>
+
+/* Fixed size log-linear histogram (as in HDR histograms), so that recording
+ * a value never allocates. Values below 32 are recorded exactly; above
+ * that, every power of two range is split in 16 buckets, so recorded values
+ * are within a 1/16 (6.25%) error. Values above the largest bucket (about
+ * 2^33, e.g. 2.4 hours in microseconds) are recorded in the largest one. */
+
+#define MM_HISTOGRAM_SUB_BUCKET_BITS 4
+#define MM_HISTOGRAM_SUB_BUCKETS     (1 << MM_HISTOGRAM_SUB_BUCKET_BITS)
+#define MM_HISTOGRAM_MAGNITUDES      28
+#define MM_HISTOGRAM_N_BUCKETS       (MM_HISTOGRAM_SUB_BUCKETS * (MM_HISTOGRAM_MAGNITUDES + 2))
+
+typedef struct {
+    guint64 count;
+    guint64 sum;
+    guint64 min;
+    guint64 max;
+    guint32 buckets[MM_HISTOGRAM_N_BUCKETS];
+} MMHistogram;
+
+void    mm_histogram_reset          (MMHistogram       *histogram);
+void    mm_histogram_add            (MMHistogram       *histogram,
+                                     guint64            value);
+
+/* Upper bound of the bucket holding the given percentile (0-100) of the
+ * recorded values, never above the maximum recorded; 0 if empty */
+guint64 mm_histogram_get_percentile (const MMHistogram *histogram,
+                                     gdouble            percentile);
+
+guint64 mm_histogram_get_mean       (const MMHistogram *histogram);
+
+#endif /* MM_HISTOGRAM_H */
@@ -31,6 +31,7 @@
 #include "mm-log.h"
 #include "mm-log-helpers.h"
 #include "mm-iface-op-lock.h"
+#include "mm-skeleton-batch.h"
 
 #define SUBSYSTEM_3GPP "3gpp"
 
@@ -2042,10 +2043,16 @@ mm_iface_modem_3gpp_run_registration_checks (MMIfaceModem3gpp    *self,
 
 /*****************************************************************************/
 
+/* The operator code and name are loaded one after the other, and only
+ * published in the skeleton once both are available, so that they are
+ * reported in one single PropertiesChanged signal instead of one per
+ * main loop iteration. */
 typedef struct {
     MmGdbusModem3gpp *skeleton;
     gboolean operator_code_loaded;
     gboolean operator_name_loaded;
+    gchar *operator_code;
+    gchar *operator_name;
 } ReloadCurrentRegistrationInfoContext;
 
 static void
@@ -2053,6 +2060,8 @@ reload_current_registration_info_context_free (ReloadCurrentRegistrationInfoCont
 {
     if (ctx->skeleton)
         g_object_unref (ctx->skeleton);
+    g_free (ctx->operator_code);
+    g_free (ctx->operator_name);
     g_slice_free (ReloadCurrentRegistrationInfoContext, ctx);
 }
 
@@ -2083,10 +2092,7 @@ load_operator_name_ready (MMIfaceModem3gpp *self,
         g_error_free (error);
     }
 
-    if (ctx->skeleton)
-        mm_gdbus_modem3gpp_set_operator_name (ctx->skeleton, str);
-    g_free (str);
-
+    ctx->operator_name = str;
     ctx->operator_name_loaded = TRUE;
     reload_current_registration_info_context_step (task);
 }
@@ -2111,15 +2117,11 @@ load_operator_code_ready (MMIfaceModem3gpp *self,
     }
     g_clear_error (&error);
 
-    if (ctx->skeleton)
-        mm_gdbus_modem3gpp_set_operator_code (ctx->skeleton, str);
-
     /* If we also implement the location interface, update the 3GPP location */
     if (str && MM_IS_IFACE_MODEM_LOCATION (self))
         mm_iface_modem_location_3gpp_update_operator_code (MM_IFACE_MODEM_LOCATION (self), str);
 
-    g_free (str);
-
+    ctx->operator_code = str;
     ctx->operator_code_loaded = TRUE;
     reload_current_registration_info_context_step (task);
 }
@@ -2151,7 +2153,10 @@ reload_current_registration_info_context_step (GTask *task)
         return;
     }
 
-    /* If all are loaded, all done */
+    /* If all are loaded, publish them together */
+    mm_gdbus_modem3gpp_set_operator_code (ctx->skeleton, ctx->operator_code);
+    mm_gdbus_modem3gpp_set_operator_name (ctx->skeleton, ctx->operator_name);
+
     g_task_return_boolean (task, TRUE);
     g_object_unref (task);
 }
@@ -2183,16 +2188,11 @@ mm_iface_modem_3gpp_reload_current_registration_info (MMIfaceModem3gpp *self,
 
     ctx->operator_code_loaded = !(MM_IFACE_MODEM_3GPP_GET_IFACE (self)->load_operator_code &&
                                   MM_IFACE_MODEM_3GPP_GET_IFACE (self)->load_operator_code_finish);
-    if (ctx->operator_code_loaded) {
-        mm_gdbus_modem3gpp_set_operator_code (ctx->skeleton, NULL);
-        if (MM_IS_IFACE_MODEM_LOCATION (self))
-            mm_iface_modem_location_3gpp_update_operator_code (MM_IFACE_MODEM_LOCATION (self), NULL);
-    }
+    if (ctx->operator_code_loaded && MM_IS_IFACE_MODEM_LOCATION (self))
+        mm_iface_modem_location_3gpp_update_operator_code (MM_IFACE_MODEM_LOCATION (self), NULL);
 
     ctx->operator_name_loaded = !(MM_IFACE_MODEM_3GPP_GET_IFACE (self)->load_operator_name &&
                                   MM_IFACE_MODEM_3GPP_GET_IFACE (self)->load_operator_name_finish);
-    if (ctx->operator_name_loaded)
-        mm_gdbus_modem3gpp_set_operator_name (ctx->skeleton, NULL);
 
     reload_current_registration_info_context_step (task);
 }
@@ -2283,6 +2283,32 @@ mm_iface_modem_3gpp_update_location (MMIfaceModem3gpp *self,
 static void update_packet_service_state (MMIfaceModem3gpp              *self,
                                          MMModem3gppPacketServiceState  new_state);
 
+/* All the 3GPP interface property updates done when a new registration state
+ * is committed (registration state, packet service state, operator info...)
+ * are reported in one single PropertiesChanged signal, emitted right away. */
+static MmGdbusModem3gpp *
+registration_update_begin (MMIfaceModem3gpp *self)
+{
+    MmGdbusModem3gpp *skeleton = NULL;
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_3GPP_DBUS_SKELETON, &skeleton,
+                  NULL);
+    if (skeleton)
+        mm_skeleton_batch_begin (skeleton);
+    return skeleton;
+}
+
+static void
+registration_update_end (MmGdbusModem3gpp *skeleton)
+{
+    if (!skeleton)
+        return;
+    mm_skeleton_batch_flush (skeleton);
+    mm_skeleton_batch_end (skeleton);
+    g_object_unref (skeleton);
+}
+
 static void
 update_registration_reload_current_registration_info_ready (MMIfaceModem3gpp *self,
                                                             GAsyncResult     *res,
@@ -2290,12 +2316,14 @@ update_registration_reload_current_registration_info_ready (MMIfaceModem3gpp *se
 {
     Private                      *priv;
     MMModem3gppRegistrationState  new_state;
+    MmGdbusModem3gpp             *skeleton;
 
     priv = get_private (self);
     if (!priv->iface_enabled)
         return;
 
     new_state = GPOINTER_TO_UINT (user_data);
+    skeleton = registration_update_begin (self);
 
     /* Update packet service state if we don't support external updates */
     if (!priv->packet_service_state_update_supported)
@@ -2322,6 +2350,7 @@ update_registration_reload_current_registration_info_ready (MMIfaceModem3gpp *se
                                            MM_MODEM_STATE_CHANGE_REASON_UNKNOWN);
 
     priv->reloading_registration_info = FALSE;
+    registration_update_end (skeleton);
 }
 
 static void
@@ -2329,12 +2358,15 @@ update_non_registered_state (MMIfaceModem3gpp             *self,
                              MMModem3gppRegistrationState  old_state,
                              MMModem3gppRegistrationState  new_state)
 {
-    Private *priv;
+    Private          *priv;
+    MmGdbusModem3gpp *skeleton;
 
     priv = get_private (self);
     if (!priv->iface_enabled)
         return;
 
+    skeleton = registration_update_begin (self);
+
     /* Not registered neither in home nor roaming network */
     mm_iface_modem_3gpp_clear_current_operator (self);
 
@@ -2356,6 +2388,8 @@ update_non_registered_state (MMIfaceModem3gpp             *self,
          MM_MODEM_STATE_SEARCHING :
          MM_MODEM_STATE_ENABLED),
         MM_MODEM_STATE_CHANGE_REASON_UNKNOWN);
+
+    registration_update_end (skeleton);
 }
 
 static void
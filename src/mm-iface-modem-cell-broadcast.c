@@ -757,6 +757,45 @@ mm_iface_modem_cell_broadcast_take_part (MMIfaceModemCellBroadcast  *self,
     return added;
 }
 
+gboolean
+mm_iface_modem_cell_broadcast_take_pdu (MMIfaceModemCellBroadcast  *self,
+                                        GObject                    *bind_to,
+                                        const guint8               *pdu,
+                                        gsize                       pdu_len,
+                                        MMCbmState                  state,
+                                        GError                    **error)
+{
+    g_autoptr(MMCbmList)  list = NULL;
+    MMCbmPart            *cbm_part;
+    guint16               serial;
+    guint16               channel;
+    guint8                part_num;
+
+    if (!mm_cbm_part_peek_header (pdu, pdu_len, &serial, &channel, &part_num)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "PDU too short, cannot read CBM header: %" G_GSIZE_FORMAT " bytes",
+                     pdu_len);
+        return FALSE;
+    }
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_CELL_BROADCAST_CBM_LIST, &list,
+                  NULL);
+    if (list && mm_cbm_list_check_duplicate_page (list, serial, channel, part_num)) {
+        mm_obj_dbg (self, "ignoring repeated CBM page %u with serial %u and id %u",
+                    part_num, serial, channel);
+        return TRUE;
+    }
+
+    cbm_part = mm_cbm_part_new_from_binary_pdu (pdu, pdu_len, self, error);
+    if (!cbm_part) {
+        g_prefix_error (error, "couldn't parse PDU: ");
+        return FALSE;
+    }
+
+    return mm_iface_modem_cell_broadcast_take_part (self, bind_to, cbm_part, state, error);
+}
+
 /*****************************************************************************/
 
 static void
@@ -131,4 +131,13 @@ gboolean mm_iface_modem_cell_broadcast_take_part (MMIfaceModemCellBroadcast *sel
                                                   MMCbmState state,
                                                   GError **error);
 
+/* Report new CBM PDU; pages already received are ignored before parsing the
+ * PDU, and TRUE is returned for them */
+gboolean mm_iface_modem_cell_broadcast_take_pdu (MMIfaceModemCellBroadcast *self,
+                                                 GObject *bind_to,
+                                                 const guint8 *pdu,
+                                                 gsize pdu_len,
+                                                 MMCbmState state,
+                                                 GError **error);
+
 #endif /* MM_IFACE_MODEM_CELLBROADCAST_H */
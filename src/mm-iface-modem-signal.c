@@ -14,6 +14,8 @@
  * Copyright (C) 2021 Intel Corporation
  */
 
+#include <math.h>
+
 #include <ModemManager.h>
 #define _LIBMM_INSIDE_MM
 #include <libmm-glib.h>
@@ -37,6 +39,16 @@ G_DEFINE_INTERFACE (MMIfaceModemSignal, mm_iface_modem_signal, MM_TYPE_IFACE_MOD
 #define PRIVATE_TAG "signal-private-tag"
 static GQuark private_quark;
 
+typedef enum {
+    SIGNAL_RAT_CDMA,
+    SIGNAL_RAT_EVDO,
+    SIGNAL_RAT_GSM,
+    SIGNAL_RAT_UMTS,
+    SIGNAL_RAT_LTE,
+    SIGNAL_RAT_NR5G,
+    SIGNAL_RAT_LAST
+} SignalRat;
+
 typedef struct {
     /* interface enabled */
     gboolean enabled;
@@ -46,10 +58,29 @@ typedef struct {
     /* threshold-based reporting */
     guint    rssi_threshold;
     gboolean error_rate_threshold;
+    guint    rsrp_threshold;
+    guint    snr_threshold;
+    guint    max_interval;
+    /* software thresholds: last published values, and latest values
+     * held back because they didn't cross any threshold */
+    MMSignal *published[SIGNAL_RAT_LAST];
+    gint64    published_time;
+    MMSignal *held[SIGNAL_RAT_LAST];
+    gboolean  held_valid;
+    guint     max_interval_source;
     /* info logging control */
     GTimer   *info_log_timer;
 } Private;
 
+static void
+signal_array_clear (MMSignal **values)
+{
+    guint i;
+
+    for (i = 0; i < SIGNAL_RAT_LAST; i++)
+        g_clear_object (&values[i]);
+}
+
 static void
 private_free (Private *priv)
 {
@@ -57,6 +88,10 @@ private_free (Private *priv)
         g_timer_destroy (priv->info_log_timer);
     if (priv->timeout_source)
         g_source_remove (priv->timeout_source);
+    if (priv->max_interval_source)
+        g_source_remove (priv->max_interval_source);
+    signal_array_clear (priv->published);
+    signal_array_clear (priv->held);
     g_slice_free (Private, priv);
 }
 
@@ -131,6 +166,9 @@ internal_signal_update (MMIfaceModemSignal *self,
     g_autoptr(GVariant)                   dict_lte = NULL;
     g_autoptr(GVariant)                   dict_nr5g = NULL;
     g_autoptr(MmGdbusModemSignalSkeleton) skeleton = NULL;
+    Private                              *priv;
+    MMSignal                             *values[SIGNAL_RAT_LAST] = { cdma, evdo, gsm, umts, lte, nr5g };
+    guint                                 i;
 
     g_object_get (self,
                   MM_IFACE_MODEM_SIGNAL_DBUS_SKELETON, &skeleton,
@@ -140,6 +178,19 @@ internal_signal_update (MMIfaceModemSignal *self,
         return;
     }
 
+    /* Keep track of what is published, used as reference by the software
+     * thresholds; anything held back until now is superseded */
+    priv = get_private (self);
+    for (i = 0; i < SIGNAL_RAT_LAST; i++)
+        g_set_object (&priv->published[i], values[i]);
+    priv->published_time = g_get_monotonic_time ();
+    if (priv->max_interval_source) {
+        g_source_remove (priv->max_interval_source);
+        priv->max_interval_source = 0;
+    }
+    signal_array_clear (priv->held);
+    priv->held_valid = FALSE;
+
     if (cdma) {
         mm_obj_dbg (self, "cdma extended signal information updated");
         dict_cdma = mm_signal_get_dictionary (cdma);
@@ -184,6 +235,134 @@ internal_signal_update (MMIfaceModemSignal *self,
     g_dbus_interface_skeleton_flush (G_DBUS_INTERFACE_SKELETON (skeleton));
 }
 
+/*****************************************************************************/
+/* Software thresholds
+ *
+ * Not all devices support thresholds, and those that do only support RSSI and
+ * error rate thresholds. The thresholds are therefore also applied to every
+ * update received from the device, so that only updates with relevant changes
+ * w.r.t. the last published values are reported. Updates held back are
+ * reported anyway once the configured maximum interval expires.
+ */
+
+/* Polling rate used when thresholds are applied in software only, and the
+ * user didn't request any specific polling rate */
+#define SOFTWARE_THRESHOLDS_POLLING_RATE_SECS 5
+
+static gboolean
+thresholds_enabled (Private *priv)
+{
+    return (priv->rssi_threshold || priv->error_rate_threshold || priv->rsrp_threshold || priv->snr_threshold);
+}
+
+static gboolean
+hardware_thresholds_supported (MMIfaceModemSignal *self)
+{
+    return (MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds &&
+            MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds_finish);
+}
+
+static guint
+get_polling_rate (MMIfaceModemSignal *self)
+{
+    Private *priv;
+
+    priv = get_private (self);
+    if (!priv->enabled)
+        return 0;
+    if (priv->rate)
+        return priv->rate;
+    /* The device will not report updates by itself if it doesn't support
+     * thresholds, or if it cannot handle all the ones configured */
+    if (thresholds_enabled (priv) &&
+        (!hardware_thresholds_supported (self) || priv->rsrp_threshold || priv->snr_threshold))
+        return SOFTWARE_THRESHOLDS_POLLING_RATE_SECS;
+    return 0;
+}
+
+static gboolean
+signal_value_changed (gdouble previous,
+                      gdouble current,
+                      guint   threshold)
+{
+    if (!threshold)
+        return FALSE;
+    if ((previous == MM_SIGNAL_UNKNOWN) != (current == MM_SIGNAL_UNKNOWN))
+        return TRUE;
+    return (current != MM_SIGNAL_UNKNOWN && fabs (current - previous) >= threshold);
+}
+
+static gboolean
+signal_changed (Private  *priv,
+                MMSignal *previous,
+                MMSignal *current)
+{
+    if (!previous != !current)
+        return TRUE;
+    if (!current)
+        return FALSE;
+
+    return (signal_value_changed (mm_signal_get_rssi (previous), mm_signal_get_rssi (current), priv->rssi_threshold) ||
+            signal_value_changed (mm_signal_get_rsrp (previous), mm_signal_get_rsrp (current), priv->rsrp_threshold) ||
+            signal_value_changed (mm_signal_get_snr  (previous), mm_signal_get_snr  (current), priv->snr_threshold)  ||
+            signal_value_changed (mm_signal_get_sinr (previous), mm_signal_get_sinr (current), priv->snr_threshold)  ||
+            (priv->error_rate_threshold && (mm_signal_get_error_rate (previous) != mm_signal_get_error_rate (current))));
+}
+
+static gboolean
+max_interval_expired (MMIfaceModemSignal *self)
+{
+    Private *priv;
+
+    priv = get_private (self);
+    priv->max_interval_source = 0;
+
+    g_assert (priv->held_valid);
+    mm_obj_dbg (self, "reporting extended signal information held back for %us", priv->max_interval);
+    internal_signal_update (self,
+                            priv->held[SIGNAL_RAT_CDMA],
+                            priv->held[SIGNAL_RAT_EVDO],
+                            priv->held[SIGNAL_RAT_GSM],
+                            priv->held[SIGNAL_RAT_UMTS],
+                            priv->held[SIGNAL_RAT_LTE],
+                            priv->held[SIGNAL_RAT_NR5G]);
+    return G_SOURCE_REMOVE;
+}
+
+/* Returns TRUE if the update should be published right away */
+static gboolean
+software_thresholds_apply (MMIfaceModemSignal  *self,
+                           MMSignal           **values)
+{
+    Private *priv;
+    gint64   elapsed_ms;
+    guint    i;
+
+    priv = get_private (self);
+    if (!thresholds_enabled (priv))
+        return TRUE;
+
+    for (i = 0; i < SIGNAL_RAT_LAST; i++) {
+        if (signal_changed (priv, priv->published[i], values[i]))
+            return TRUE;
+    }
+
+    elapsed_ms = (g_get_monotonic_time () - priv->published_time) / 1000;
+    if (priv->max_interval && elapsed_ms >= (gint64) priv->max_interval * 1000)
+        return TRUE;
+
+    /* Hold back; the latest values are the ones reported if the maximum
+     * interval expires */
+    for (i = 0; i < SIGNAL_RAT_LAST; i++)
+        g_set_object (&priv->held[i], values[i]);
+    priv->held_valid = TRUE;
+    if (priv->max_interval && !priv->max_interval_source)
+        priv->max_interval_source = g_timeout_add ((guint) ((gint64) priv->max_interval * 1000 - elapsed_ms),
+                                                   (GSourceFunc) max_interval_expired,
+                                                   self);
+    return FALSE;
+}
+
 void
 mm_iface_modem_signal_update (MMIfaceModemSignal *self,
                               MMSignal           *cdma,
@@ -193,14 +372,20 @@ mm_iface_modem_signal_update (MMIfaceModemSignal *self,
                               MMSignal           *lte,
                               MMSignal           *nr5g)
 {
-    Private *priv;
+    Private  *priv;
+    MMSignal *values[SIGNAL_RAT_LAST] = { cdma, evdo, gsm, umts, lte, nr5g };
 
     priv = get_private (self);
-    if (!priv->enabled || (!priv->rate && !priv->rssi_threshold && !priv->error_rate_threshold)) {
+    if (!priv->enabled || (!priv->rate && !thresholds_enabled (priv))) {
         mm_obj_dbg (self, "skipping extended signal information update...");
         return;
     }
 
+    if (!software_thresholds_apply (self, values)) {
+        mm_obj_dbg (self, "extended signal information update held back: no threshold crossed");
+        return;
+    }
+
     internal_signal_update (self, cdma, evdo, gsm, umts, lte, nr5g);
 }
 
@@ -213,7 +398,7 @@ check_interface_reset (MMIfaceModemSignal *self)
 
     priv = get_private (self);
 
-    if (!priv->enabled || (!priv->rate && !priv->rssi_threshold && !priv->error_rate_threshold)) {
+    if (!priv->enabled || (!priv->rate && !thresholds_enabled (priv))) {
         mm_obj_dbg (self, "resetting extended signal information...");
         internal_signal_update (self, NULL, NULL, NULL, NULL, NULL, NULL);
     }
@@ -265,19 +450,20 @@ query_signal_values (MMIfaceModemSignal *self)
 static void
 polling_restart (MMIfaceModemSignal *self)
 {
-    Private  *priv;
-    gboolean  polling_setup;
+    Private *priv;
+    guint    rate;
 
     priv = get_private (self);
-    polling_setup = (priv->enabled && priv->rate);
+    rate = get_polling_rate (self);
 
-    if (polling_setup)
-        mm_obj_info (self, "setting up extended signal information polling: rate %u seconds", priv->rate);
+    if (rate)
+        mm_obj_info (self, "setting up extended signal information polling: rate %u seconds%s",
+                     rate, priv->rate ? "" : " (software thresholds)");
     else
         mm_obj_dbg (self, "cleaning up extended signal information polling");
 
     /* Stop polling */
-    if (!polling_setup) {
+    if (!rate) {
         if (priv->timeout_source) {
             g_source_remove (priv->timeout_source);
             priv->timeout_source = 0;
@@ -288,7 +474,7 @@ polling_restart (MMIfaceModemSignal *self)
     /* Start/restart polling */
     if (priv->timeout_source)
         g_source_remove (priv->timeout_source);
-    priv->timeout_source = g_timeout_add_seconds (priv->rate, (GSourceFunc) query_signal_values, self);
+    priv->timeout_source = g_timeout_add_seconds (rate, (GSourceFunc) query_signal_values, self);
 
     /* Also launch right away */
     query_signal_values (self);
@@ -333,8 +519,8 @@ thresholds_restart (MMIfaceModemSignal  *self,
 
     task = g_task_new (self, NULL, callback, user_data);
 
-    if (!MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds ||
-        !MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds_finish) {
+    /* Thresholds are then only applied in software */
+    if (!hardware_thresholds_supported (self)) {
         g_task_return_boolean (task, TRUE);
         g_object_unref (task);
         return;
@@ -434,6 +620,9 @@ typedef struct {
     GVariant              *settings;
     guint                  previous_rssi_threshold;
     gboolean               previous_error_rate_threshold;
+    guint                  previous_rsrp_threshold;
+    guint                  previous_snr_threshold;
+    guint                  previous_max_interval;
 } HandleSetupThresholdsContext;
 
 static void
@@ -459,11 +648,18 @@ setup_thresholds_restart_ready (MMIfaceModemSignal           *self,
     if (!thresholds_restart_finish (self, res, &error)) {
         priv->rssi_threshold = ctx->previous_rssi_threshold;
         priv->error_rate_threshold = ctx->previous_error_rate_threshold;
+        priv->rsrp_threshold = ctx->previous_rsrp_threshold;
+        priv->snr_threshold = ctx->previous_snr_threshold;
+        priv->max_interval = ctx->previous_max_interval;
         mm_dbus_method_invocation_take_error (ctx->invocation, error);
     } else {
+        polling_restart (self);
         check_interface_reset (self);
         mm_gdbus_modem_signal_set_rssi_threshold (ctx->skeleton, priv->rssi_threshold);
         mm_gdbus_modem_signal_set_error_rate_threshold (ctx->skeleton, priv->error_rate_threshold);
+        mm_gdbus_modem_signal_set_rsrp_threshold (ctx->skeleton, priv->rsrp_threshold);
+        mm_gdbus_modem_signal_set_snr_threshold (ctx->skeleton, priv->snr_threshold);
+        mm_gdbus_modem_signal_set_threshold_max_interval (ctx->skeleton, priv->max_interval);
         mm_gdbus_modem_signal_complete_setup_thresholds (ctx->skeleton, ctx->invocation);
     }
 
@@ -481,6 +677,9 @@ handle_setup_thresholds_auth_ready (MMIfaceAuth                  *_self,
     Private                                *priv;
     guint                                   new_rssi_threshold;
     gboolean                                new_error_rate_threshold;
+    guint                                   new_rsrp_threshold;
+    guint                                   new_snr_threshold;
+    guint                                   new_max_interval;
 
     priv = get_private (self);
 
@@ -490,14 +689,6 @@ handle_setup_thresholds_auth_ready (MMIfaceAuth                  *_self,
         return;
     }
 
-    if (!MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds ||
-        !MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds_finish) {
-        mm_dbus_method_invocation_return_error_literal (ctx->invocation, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
-                                                        "Cannot setup thresholds: operation not supported");
-        handle_setup_thresholds_context_free (ctx);
-        return;
-    }
-
     if (mm_iface_modem_abort_invocation_if_state_not_reached (MM_IFACE_MODEM (self),
                                                               ctx->invocation,
                                                               MM_MODEM_STATE_DISABLED)) {
@@ -511,11 +702,17 @@ handle_setup_thresholds_auth_ready (MMIfaceAuth                  *_self,
         handle_setup_thresholds_context_free (ctx);
         return;
     }
-    new_rssi_threshold       = mm_signal_threshold_properties_get_rssi       (properties);
-    new_error_rate_threshold = mm_signal_threshold_properties_get_error_rate (properties);
+    new_rssi_threshold       = mm_signal_threshold_properties_get_rssi         (properties);
+    new_error_rate_threshold = mm_signal_threshold_properties_get_error_rate   (properties);
+    new_rsrp_threshold       = mm_signal_threshold_properties_get_rsrp         (properties);
+    new_snr_threshold        = mm_signal_threshold_properties_get_snr          (properties);
+    new_max_interval         = mm_signal_threshold_properties_get_max_interval (properties);
 
     if ((new_rssi_threshold == priv->rssi_threshold) &&
-        (new_error_rate_threshold == priv->error_rate_threshold)) {
+        (new_error_rate_threshold == priv->error_rate_threshold) &&
+        (new_rsrp_threshold == priv->rsrp_threshold) &&
+        (new_snr_threshold == priv->snr_threshold) &&
+        (new_max_interval == priv->max_interval)) {
         mm_gdbus_modem_signal_complete_setup_thresholds (ctx->skeleton, ctx->invocation);
         handle_setup_thresholds_context_free (ctx);
         return;
@@ -524,8 +721,14 @@ handle_setup_thresholds_auth_ready (MMIfaceAuth                  *_self,
     mm_obj_info (self, "processing user request to setup signal thresholds...");
     ctx->previous_rssi_threshold = priv->rssi_threshold;
     ctx->previous_error_rate_threshold = priv->error_rate_threshold;
+    ctx->previous_rsrp_threshold = priv->rsrp_threshold;
+    ctx->previous_snr_threshold = priv->snr_threshold;
+    ctx->previous_max_interval = priv->max_interval;
     priv->rssi_threshold = new_rssi_threshold;
     priv->error_rate_threshold = new_error_rate_threshold;
+    priv->rsrp_threshold = new_rsrp_threshold;
+    priv->snr_threshold = new_snr_threshold;
+    priv->max_interval = new_max_interval;
 
     thresholds_restart (self,
                         (GAsyncReadyCallback)setup_thresholds_restart_ready,
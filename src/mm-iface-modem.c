@@ -35,6 +35,9 @@
 #include "mm-context.h"
 #include "mm-iface-op-lock.h"
 #include "mm-dispatcher-fcc-unlock.h"
+#include "mm-skeleton-batch.h"
+#include "mm-modem-info-cache.h"
+#include "mm-cell-table.h"
 #if defined WITH_QMI
 # include "mm-broadband-modem-qmi.h"
 #endif
@@ -96,6 +99,13 @@ typedef struct {
     /* Flag indicating whether a primary SIM slot switch operation is
      * ongoing */
     gboolean ongoing_primary_sim_slot_switch;
+
+    /* Cell info monitoring support */
+    MMCellTable *cell_table;
+    guint        cell_info_rate;
+    guint        cell_info_timeout_source;
+    gboolean     cell_info_running;
+    gboolean     cell_info_refresh_pending;
 } Private;
 
 static void
@@ -109,6 +119,9 @@ private_free (Private *priv)
         g_source_remove (priv->signal_check_timeout_source);
     if (priv->restart_initialize_idle_id)
         g_source_remove (priv->restart_initialize_idle_id);
+    if (priv->cell_info_timeout_source)
+        g_source_remove (priv->cell_info_timeout_source);
+    g_clear_pointer (&priv->cell_table, mm_cell_table_free);
     g_clear_pointer (&priv->power_state_timer, (GDestroyNotify) g_timer_destroy);
     g_slice_free (Private, priv);
 }
@@ -243,10 +256,16 @@ mm_iface_modem_check_for_sim_swap (MMIfaceModem *self,
                                    GAsyncReadyCallback callback,
                                    gpointer user_data)
 {
-    GTask *task;
+    g_autoptr(MMBaseSim)  sim = NULL;
+    GTask                *task;
 
     task = g_task_new (self, NULL, callback, user_data);
 
+    /* The SIM files may have changed, so don't rely on the cached contents */
+    g_object_get (self, MM_IFACE_MODEM_SIM, &sim, NULL);
+    if (sim)
+        mm_base_sim_forget_files (sim);
+
     if (MM_IFACE_MODEM_GET_IFACE (self)->check_basic_sim_details &&
         MM_IFACE_MODEM_GET_IFACE (self)->check_basic_sim_details_finish) {
         mm_obj_info (self, "started checking for basic SIM details...");
@@ -1558,6 +1577,7 @@ get_cell_info_ready (MMIfaceModem             *self,
         mm_obj_dbg (self, "cell info retrieved");
         dict_array = get_cell_info_build_result (info_list);
         mm_gdbus_modem_complete_get_cell_info (ctx->skeleton, ctx->invocation, dict_array);
+        mm_iface_modem_update_cell_info (self, info_list);
     }
 
     g_list_free_full (info_list, (GDestroyNotify)g_object_unref);
@@ -1617,6 +1637,261 @@ handle_get_cell_info (MmGdbusModem          *skeleton,
     return TRUE;
 }
 
+/*****************************************************************************/
+/* Cell info monitoring */
+
+/* Shortest refresh rate allowed. Periodic reloads are anyway skipped while
+ * the previous one is still running, so the control port is never kept
+ * busy with back to back cell info queries */
+#define CELL_INFO_RATE_MIN_MS 250
+
+static MMCellTable *
+peek_cell_table (MMIfaceModem *self)
+{
+    Private *priv;
+
+    priv = get_private (self);
+    if (!priv->cell_table)
+        priv->cell_table = mm_cell_table_new ();
+    return priv->cell_table;
+}
+
+static void
+cell_info_updated (MMIfaceModem *self,
+                   gboolean      updated,
+                   GVariant     *added,
+                   GVariant     *changed,
+                   GVariant     *removed)
+{
+    g_autoptr(MmGdbusModem) skeleton = NULL;
+
+    g_variant_ref_sink (added);
+    g_variant_ref_sink (changed);
+    g_variant_ref_sink (removed);
+
+    if (updated) {
+        mm_obj_dbg (self, "cell info updated: %" G_GSIZE_FORMAT " added, %" G_GSIZE_FORMAT " changed, %" G_GSIZE_FORMAT " removed",
+                    g_variant_n_children (added), g_variant_n_children (changed), g_variant_n_children (removed));
+
+        g_object_get (self,
+                      MM_IFACE_MODEM_DBUS_SKELETON, &skeleton,
+                      NULL);
+        if (skeleton)
+            mm_gdbus_modem_emit_cell_info_updated (skeleton, added, changed, removed);
+    }
+
+    g_variant_unref (added);
+    g_variant_unref (changed);
+    g_variant_unref (removed);
+}
+
+void
+mm_iface_modem_update_cell_info (MMIfaceModem *self,
+                                 GList        *cell_info_list)
+{
+    MMCellTable *table;
+    GVariant    *added = NULL;
+    GVariant    *changed = NULL;
+    GVariant    *removed = NULL;
+    gboolean     updated;
+
+    table = peek_cell_table (self);
+
+    /* A periodic reload is feeding the table right now; it will report the
+     * up to date contents itself */
+    if (mm_cell_table_is_updating (table))
+        return;
+
+    updated = mm_cell_table_update (table, cell_info_list, &added, &changed, &removed);
+    cell_info_updated (self, updated, added, changed, removed);
+}
+
+static void cell_info_reload (MMIfaceModem *self);
+
+static void
+cell_info_reload_ready (MMIfaceModem *self,
+                        GAsyncResult *res)
+{
+    Private           *priv;
+    MMCellTable       *table;
+    GVariant          *added = NULL;
+    GVariant          *changed = NULL;
+    GVariant          *removed = NULL;
+    gboolean           updated;
+    g_autoptr(GError)  error = NULL;
+
+    priv = get_private (self);
+    priv->cell_info_running = FALSE;
+
+    table = peek_cell_table (self);
+    if (!MM_IFACE_MODEM_GET_IFACE (self)->load_cell_info_finish (self, res, &error)) {
+        mm_obj_dbg (self, "couldn't reload cell info: %s", error->message);
+        mm_cell_table_update_abort (table);
+    } else {
+        updated = mm_cell_table_update_end (table, &added, &changed, &removed);
+        cell_info_updated (self, updated, added, changed, removed);
+    }
+
+    if (priv->cell_info_refresh_pending) {
+        priv->cell_info_refresh_pending = FALSE;
+        /* Monitoring may have been disabled while the operation was running */
+        if (priv->cell_info_rate)
+            cell_info_reload (self);
+    }
+}
+
+static void
+cell_info_reload (MMIfaceModem *self)
+{
+    Private      *priv;
+    MMModemState  state = MM_MODEM_STATE_UNKNOWN;
+
+    priv = get_private (self);
+
+    /* Only one single operation at a time; new requests while one is running
+     * end up in one single additional reload */
+    if (priv->cell_info_running) {
+        priv->cell_info_refresh_pending = TRUE;
+        return;
+    }
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_STATE, &state,
+                  NULL);
+    if (state < MM_MODEM_STATE_ENABLED)
+        return;
+
+    /* The loaded cells are given directly to the table, so periodic samples
+     * don't build a new list of cells */
+    priv->cell_info_running = TRUE;
+    mm_cell_table_update_begin (peek_cell_table (self));
+    MM_IFACE_MODEM_GET_IFACE (self)->load_cell_info (self,
+                                                     peek_cell_table (self),
+                                                     (GAsyncReadyCallback)cell_info_reload_ready,
+                                                     NULL);
+}
+
+static gboolean
+cell_info_timeout_cb (MMIfaceModem *self)
+{
+    /* Skip this sample if the previous one is still running, instead of
+     * queueing another reload right after it */
+    if (get_private (self)->cell_info_running) {
+        mm_obj_dbg (self, "skipping cell info reload: previous one still running");
+        return G_SOURCE_CONTINUE;
+    }
+
+    cell_info_reload (self);
+    return G_SOURCE_CONTINUE;
+}
+
+void
+mm_iface_modem_refresh_cell_info (MMIfaceModem *self)
+{
+    if (!get_private (self)->cell_info_rate)
+        return;
+
+    cell_info_reload (self);
+}
+
+static void
+cell_info_monitoring_setup (MMIfaceModem *self,
+                            guint         rate)
+{
+    Private *priv;
+
+    priv = get_private (self);
+
+    if (priv->cell_info_timeout_source) {
+        g_source_remove (priv->cell_info_timeout_source);
+        priv->cell_info_timeout_source = 0;
+    }
+    priv->cell_info_rate = rate;
+    priv->cell_info_refresh_pending = FALSE;
+
+    if (!rate) {
+        mm_obj_dbg (self, "cell info monitoring disabled");
+        return;
+    }
+
+    mm_obj_dbg (self, "cell info monitoring enabled (%ums)", rate);
+    priv->cell_info_timeout_source = g_timeout_add (rate, (GSourceFunc)cell_info_timeout_cb, self);
+    cell_info_reload (self);
+}
+
+typedef struct {
+    MmGdbusModem          *skeleton;
+    GDBusMethodInvocation *invocation;
+    MMIfaceModem          *self;
+    guint                  rate;
+} HandleSetupCellInfoContext;
+
+static void
+handle_setup_cell_info_context_free (HandleSetupCellInfoContext *ctx)
+{
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->self);
+    g_slice_free (HandleSetupCellInfoContext, ctx);
+}
+
+static void
+handle_setup_cell_info_auth_ready (MMIfaceAuth                *self,
+                                   GAsyncResult               *res,
+                                   HandleSetupCellInfoContext *ctx)
+{
+    GError *error = NULL;
+
+    if (!mm_iface_auth_authorize_finish (self, res, &error)) {
+        mm_dbus_method_invocation_take_error (ctx->invocation, error);
+        handle_setup_cell_info_context_free (ctx);
+        return;
+    }
+
+    if (!MM_IFACE_MODEM_GET_IFACE (self)->load_cell_info ||
+        !MM_IFACE_MODEM_GET_IFACE (self)->load_cell_info_finish) {
+        mm_dbus_method_invocation_return_error_literal (ctx->invocation, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
+                                                        "Cannot setup cell info: operation not supported");
+        handle_setup_cell_info_context_free (ctx);
+        return;
+    }
+
+    if (ctx->rate && ctx->rate < CELL_INFO_RATE_MIN_MS) {
+        mm_dbus_method_invocation_return_error (ctx->invocation, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                                                "Cannot setup cell info: rate must be at least %ums",
+                                                CELL_INFO_RATE_MIN_MS);
+        handle_setup_cell_info_context_free (ctx);
+        return;
+    }
+
+    mm_obj_info (self, "processing user request to setup cell info monitoring...");
+    cell_info_monitoring_setup (ctx->self, ctx->rate);
+    mm_gdbus_modem_complete_setup_cell_info (ctx->skeleton, ctx->invocation);
+    handle_setup_cell_info_context_free (ctx);
+}
+
+static gboolean
+handle_setup_cell_info (MmGdbusModem          *skeleton,
+                        GDBusMethodInvocation *invocation,
+                        guint                  rate,
+                        MMIfaceModem          *self)
+{
+    HandleSetupCellInfoContext *ctx;
+
+    ctx = g_slice_new0 (HandleSetupCellInfoContext);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->self = g_object_ref (self);
+    ctx->rate = rate;
+
+    mm_iface_auth_authorize (MM_IFACE_AUTH (self),
+                             invocation,
+                             MM_AUTHORIZATION_DEVICE_CONTROL,
+                             (GAsyncReadyCallback)handle_setup_cell_info_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
 /*****************************************************************************/
 
 void
@@ -1785,6 +2060,31 @@ mm_iface_modem_update_signal_quality (MMIfaceModem *self,
 /*****************************************************************************/
 /* Signal info (quality and access technology) polling */
 
+/* Signal quality and access technology updates done together are reported in
+ * one single PropertiesChanged signal, emitted right away. */
+static MmGdbusModem *
+signal_update_begin (MMIfaceModem *self)
+{
+    MmGdbusModem *skeleton = NULL;
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_DBUS_SKELETON, &skeleton,
+                  NULL);
+    if (skeleton)
+        mm_skeleton_batch_begin (skeleton);
+    return skeleton;
+}
+
+static void
+signal_update_end (MmGdbusModem *skeleton)
+{
+    if (!skeleton)
+        return;
+    mm_skeleton_batch_flush (skeleton);
+    mm_skeleton_batch_end (skeleton);
+    g_object_unref (skeleton);
+}
+
 typedef enum {
     SIGNAL_CHECK_STEP_FIRST,
     SIGNAL_CHECK_STEP_SIGNAL_QUALITY,
@@ -1792,9 +2092,14 @@ typedef enum {
     SIGNAL_CHECK_STEP_LAST,
 } SignalCheckStep;
 
+/* The values polled are published together once all steps are done, so
+ * that they are reported in one single PropertiesChanged signal instead of
+ * one per reply received. */
 typedef struct {
     /* Values polled in this iteration */
+    gboolean                signal_quality_loaded;
     guint                   signal_quality;
+    gboolean                access_technologies_loaded;
     MMModemAccessTechnology access_technologies;
     guint                   access_technologies_mask;
     /* Steps triggered when polling active */
@@ -1847,10 +2152,8 @@ load_access_technologies_ready (MMIfaceModem *self,
         /* Ignore logging any message if the error is in 'in-progress' */
         else if (!g_error_matches (error, MM_CORE_ERROR, MM_CORE_ERROR_IN_PROGRESS))
             mm_obj_dbg (self, "couldn't refresh access technologies: %s", error->message);
-    }
-    /* We may have been disabled while this command was running. */
-    else if (priv->signal_check_enabled)
-        mm_iface_modem_update_access_technologies (self, ctx->access_technologies, ctx->access_technologies_mask);
+    } else
+        ctx->access_technologies_loaded = TRUE;
 
     /* Go on */
     ctx->running_step++;
@@ -1879,10 +2182,8 @@ load_signal_quality_ready (MMIfaceModem *self,
         /* Ignore logging any message if the error is in 'in-progress' */
         else if (!g_error_matches (error, MM_CORE_ERROR, MM_CORE_ERROR_IN_PROGRESS))
             mm_obj_dbg (self, "couldn't refresh signal quality: %s", error->message);
-    }
-    /* We may have been disabled while this command was running. */
-    else if (priv->signal_check_enabled)
-        update_signal_quality (self, ctx->signal_quality, TRUE);
+    } else
+        ctx->signal_quality_loaded = TRUE;
 
     /* Go on */
     ctx->running_step++;
@@ -1935,7 +2236,16 @@ periodic_signal_check_step (GTask *task)
     case SIGNAL_CHECK_STEP_LAST:
         /* If we have been disabled while we were running the steps, we don't
          * do anything else. */
-        if (!priv->signal_check_enabled) {
+        if (priv->signal_check_enabled) {
+            MmGdbusModem *skeleton;
+
+            skeleton = signal_update_begin (self);
+            if (ctx->signal_quality_loaded)
+                update_signal_quality (self, ctx->signal_quality, TRUE);
+            if (ctx->access_technologies_loaded)
+                mm_iface_modem_update_access_technologies (self, ctx->access_technologies, ctx->access_technologies_mask);
+            signal_update_end (skeleton);
+        } else {
             mm_obj_dbg (self, "periodic signal quality and access technology checks not rescheduled: disabled");
             periodic_signal_check_complete (task);
             return;
@@ -2065,12 +2375,16 @@ periodic_signal_check_disable (MMIfaceModem *self,
 
     /* Clear access technology and signal quality */
     if (clear) {
+        MmGdbusModem *skeleton;
+
+        skeleton = signal_update_begin (self);
         if (priv->signal_quality_polling_supported)
             update_signal_quality (self, 0, FALSE);
         if (priv->access_technology_polling_supported)
             mm_iface_modem_update_access_technologies (self,
                                                        MM_MODEM_ACCESS_TECHNOLOGY_UNKNOWN,
                                                        MM_MODEM_ACCESS_TECHNOLOGY_ANY);
+        signal_update_end (skeleton);
     }
 
     /* Remove scheduled timeout */
@@ -5079,10 +5393,12 @@ typedef enum {
     INITIALIZATION_STEP_CARRIER_CONFIG,
     INITIALIZATION_STEP_HARDWARE_REVISION,
     INITIALIZATION_STEP_EQUIPMENT_ID,
+    INITIALIZATION_STEP_INFO_CACHE_LOOKUP,
     INITIALIZATION_STEP_DEVICE_ID,
     INITIALIZATION_STEP_SUPPORTED_MODES,
     INITIALIZATION_STEP_SUPPORTED_BANDS,
     INITIALIZATION_STEP_SUPPORTED_IP_FAMILIES,
+    INITIALIZATION_STEP_INFO_CACHE_STORE,
     INITIALIZATION_STEP_POWER_STATE,
     INITIALIZATION_STEP_CURRENT_MODES,
     INITIALIZATION_STEP_CURRENT_BANDS,
@@ -5101,6 +5417,7 @@ struct _InitializationContext {
     MmGdbusModem *skeleton;
     MMModemCharset supported_charsets;
     const MMModemCharset *current_charset;
+    gboolean info_cache_hit;
     GError *fatal_error;
 };
 
@@ -6022,6 +6339,18 @@ interface_initialization_step (GTask *task)
         ctx->step++;
         /* fall-through */
 
+    case INITIALIZATION_STEP_INFO_CACHE_LOOKUP:
+        /* Static info cached from a previous run is used only if the
+         * manufacturer, model, revision and equipment identifier just loaded
+         * are the same ones */
+        if (!mm_context_get_no_modem_info_cache ())
+            ctx->info_cache_hit = mm_modem_info_cache_lookup (mm_modem_info_cache_get (),
+                                                              mm_gdbus_modem_get_device (ctx->skeleton),
+                                                              mm_gdbus_modem_get_plugin (ctx->skeleton),
+                                                              ctx->skeleton);
+        ctx->step++;
+        /* fall-through */
+
     case INITIALIZATION_STEP_DEVICE_ID:
         /* Device ID is meant to be loaded only once during the whole
          * lifetime of the modem. Therefore, if we already have them loaded,
@@ -6113,6 +6442,15 @@ interface_initialization_step (GTask *task)
         ctx->step++;
         /* fall-through */
 
+    case INITIALIZATION_STEP_INFO_CACHE_STORE:
+        if (!ctx->info_cache_hit && !mm_context_get_no_modem_info_cache ())
+            mm_modem_info_cache_store (mm_modem_info_cache_get (),
+                                       mm_gdbus_modem_get_device (ctx->skeleton),
+                                       mm_gdbus_modem_get_plugin (ctx->skeleton),
+                                       ctx->skeleton);
+        ctx->step++;
+        /* fall-through */
+
     case INITIALIZATION_STEP_POWER_STATE:
         /* Initial power state is meant to be loaded only once. Therefore, if we
          * already have it loaded, don't try to load it again. */
@@ -6384,6 +6722,7 @@ interface_initialization_step (GTask *task)
                           "signal::handle-set-current-modes",        G_CALLBACK (handle_set_current_modes),        self,
                           "signal::handle-set-primary-sim-slot",     G_CALLBACK (handle_set_primary_sim_slot),     self,
                           "signal::handle-get-cell-info",            G_CALLBACK (handle_get_cell_info),            self,
+                          "signal::handle-setup-cell-info",          G_CALLBACK (handle_setup_cell_info),          self,
                           NULL);
 
         /* Finally, export the new interface, even if we got errors, but only if not
@@ -6494,6 +6833,9 @@ mm_iface_modem_shutdown (MMIfaceModem *self)
     /* Remove running restart initialization idle, if any */
     restart_initialize_idle_disable (self);
 
+    /* Make sure cell info monitoring is disabled */
+    cell_info_monitoring_setup (self, 0);
+
     /* Cleanup SIM hot swap, if any */
     if (MM_IFACE_MODEM_GET_IFACE (self)->cleanup_sim_hot_swap)
         MM_IFACE_MODEM_GET_IFACE (self)->cleanup_sim_hot_swap (self);
@@ -6531,6 +6873,30 @@ mm_iface_modem_get_access_technologies (MMIfaceModem *self)
 
 /*****************************************************************************/
 
+guint
+mm_iface_modem_get_signal_quality (MMIfaceModem *self)
+{
+    guint         signal_quality = 0;
+    MmGdbusModem *skeleton;
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_DBUS_SKELETON, &skeleton,
+                  NULL);
+
+    if (skeleton) {
+        GVariant *value;
+
+        value = mm_gdbus_modem_get_signal_quality (skeleton);
+        if (value)
+            g_variant_get (value, "(ub)", &signal_quality, NULL);
+        g_object_unref (skeleton);
+    }
+
+    return signal_quality;
+}
+
+/*****************************************************************************/
+
 static gboolean
 find_supported_mode (MMIfaceModem *self,
                      MMModemMode mode,
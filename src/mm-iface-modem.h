@@ -29,6 +29,7 @@
 #include "mm-base-bearer.h"
 #include "mm-base-sim.h"
 #include "mm-bearer-list.h"
+#include "mm-cell-table.h"
 
 #define MM_TYPE_IFACE_MODEM mm_iface_modem_get_type ()
 G_DECLARE_INTERFACE (MMIfaceModem, mm_iface_modem, MM, IFACE_MODEM, MMBaseModem)
@@ -420,11 +421,25 @@ struct _MMIfaceModemInterface {
     GList * (* get_cell_info_finish) (MMIfaceModem         *self,
                                       GAsyncResult         *res,
                                       GError              **error);
+
+    /* Asynchronous cell info load used by the periodic monitoring; instead
+     * of returning a list, the loaded cells are given one by one to the
+     * ongoing update of the given table with mm_cell_table_update_add() */
+    void     (* load_cell_info)        (MMIfaceModem         *self,
+                                        MMCellTable          *table,
+                                        GAsyncReadyCallback   callback,
+                                        gpointer              user_data);
+    gboolean (* load_cell_info_finish) (MMIfaceModem         *self,
+                                        GAsyncResult         *res,
+                                        GError              **error);
 };
 
 /* Helpers to query access technologies */
 MMModemAccessTechnology mm_iface_modem_get_access_technologies (MMIfaceModem *self);
 
+/* Helpers to query signal quality */
+guint mm_iface_modem_get_signal_quality (MMIfaceModem *self);
+
 /* Helpers to query capabilities */
 MMModemCapability mm_iface_modem_get_current_capabilities (MMIfaceModem *self);
 gboolean          mm_iface_modem_is_3gpp                  (MMIfaceModem *self);
@@ -566,6 +581,12 @@ void mm_iface_modem_update_signal_quality (MMIfaceModem *self,
 /* Allow requesting to refresh signal via polling */
 void mm_iface_modem_refresh_signal (MMIfaceModem *self);
 
+/* Allow reporting new cell info, and requesting to reload it if cell info
+ * monitoring is enabled (e.g. when the serving cell changes) */
+void mm_iface_modem_update_cell_info  (MMIfaceModem *self,
+                                       GList        *cell_info_list);
+void mm_iface_modem_refresh_cell_info (MMIfaceModem *self);
+
 /* Allow setting allowed modes */
 void     mm_iface_modem_set_current_modes        (MMIfaceModem *self,
                                                   MMModemMode allowed,
@@ -25,6 +25,7 @@ static GQuark private_quark;
 
 typedef struct {
   gchar *owner_id;
+  gchar *self_id;
   gchar *id;
 } Private;
 
@@ -32,6 +33,7 @@ static void
 private_free (Private *priv)
 {
     g_free (priv->owner_id);
+    g_free (priv->self_id);
     g_free (priv->id);
     g_slice_free (Private, priv);
 }
@@ -53,6 +55,17 @@ get_private (MMLogObject *self)
     return priv;
 }
 
+const gchar *
+mm_log_object_get_self_id (MMLogObject *self)
+{
+    Private *priv;
+
+    priv = get_private (self);
+    if (!priv->self_id)
+        priv->self_id = MM_LOG_OBJECT_GET_IFACE (self)->build_id (self);
+    return priv->self_id;
+}
+
 const gchar *
 mm_log_object_get_id (MMLogObject *self)
 {
@@ -60,14 +73,13 @@ mm_log_object_get_id (MMLogObject *self)
 
     priv = get_private (self);
     if (!priv->id) {
-        gchar *self_id;
+        const gchar *self_id;
 
-        self_id = MM_LOG_OBJECT_GET_IFACE (self)->build_id (self);
-        if (self_id && priv->owner_id) {
+        self_id = mm_log_object_get_self_id (self);
+        if (self_id && priv->owner_id)
             priv->id = g_strdup_printf ("%s/%s", priv->owner_id, self_id);
-            g_free (self_id);
-        } else
-            priv->id = self_id;
+        else
+            priv->id = g_strdup (self_id);
     }
     return priv->id;
 }
@@ -91,6 +103,7 @@ mm_log_object_reset_id (MMLogObject *self)
     Private *priv;
 
     priv = get_private (self);
+    g_clear_pointer (&priv->self_id, g_free);
     g_clear_pointer (&priv->id, g_free);
 }
 
@@ -32,6 +32,8 @@ struct _MMLogObjectInterface
 };
 
 const gchar *mm_log_object_get_id       (MMLogObject *self);
+/* The id built by the object itself, without the id of its owner */
+const gchar *mm_log_object_get_self_id  (MMLogObject *self);
 void         mm_log_object_set_owner_id (MMLogObject *self,
                                          const gchar *owner_id);
 void         mm_log_object_reset_id     (MMLogObject *self);
@@ -21,6 +21,16 @@
 
 /* This is a common logging method to be used by all test applications */
 
+guint32 _mm_log_level_mask = 0xFFFFFFFF;
+
+gboolean
+_mm_log_enabled (gpointer     obj,
+                 const gchar *module,
+                 MMLogLevel   level)
+{
+    return g_test_verbose ();
+}
+
 void
 _mm_log (gpointer     obj,
          const gchar *module,
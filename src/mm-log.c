@@ -60,6 +60,18 @@ static int      logfd = -1;
 static gboolean append_log_level_text = TRUE;
 static gboolean personal_info = FALSE;
 
+/* Union of the global level and the levels of all filters */
+guint32 _mm_log_level_mask = MM_LOG_LEVEL_MSG | MM_LOG_LEVEL_WARN | MM_LOG_LEVEL_ERR;
+
+/* Runtime filters, by module name or by log object id */
+typedef struct {
+    gboolean  module;
+    gchar    *name;
+    guint32   level;
+} LogFilter;
+
+static GArray *log_filters = NULL;
+
 static void (*log_backend) (const char *loc,
                             const char *func,
                             int         syslog_level,
@@ -224,7 +236,77 @@ mm_log_get_show_personal_info (void)
 gboolean
 mm_log_check_level_enabled (MMLogLevel level)
 {
-    return (log_level & level);
+    return (_mm_log_level_mask & level);
+}
+
+/* Object filters match the full id or any of its components, e.g. the
+ * "modem0" filter matches "modem0" and "modem0/ttyUSB2/at", and the
+ * "ttyUSB2" filter matches "modem0/ttyUSB2/at". */
+static gboolean
+log_filter_match_object_id (const gchar *filter,
+                            const gchar *id)
+{
+    gsize        filter_len;
+    const gchar *p;
+
+    filter_len = strlen (filter);
+    for (p = id; p; p = strchr (p, '/')) {
+        if (*p == '/')
+            p++;
+        if (!strncmp (p, filter, filter_len) && (p[filter_len] == '\0' || p[filter_len] == '/'))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/* Object filters take precedence over module filters, and these over the
+ * global level. If several object filters match, the longest one wins. */
+static guint32
+log_filters_get_level (gpointer     obj,
+                       const gchar *module)
+{
+    const gchar *id = NULL;
+    guint32      level;
+    gsize        matched_len = 0;
+    gboolean     object_matched = FALSE;
+    guint        i;
+
+    level = log_level;
+    if (obj)
+        id = mm_log_object_get_id (MM_LOG_OBJECT (obj));
+
+    for (i = 0; i < log_filters->len; i++) {
+        LogFilter *filter;
+        gsize      len;
+
+        filter = &g_array_index (log_filters, LogFilter, i);
+        if (filter->module) {
+            if (!object_matched && module && !g_strcmp0 (filter->name, module))
+                level = filter->level;
+            continue;
+        }
+
+        if (!id || !log_filter_match_object_id (filter->name, id))
+            continue;
+        len = strlen (filter->name);
+        if (!object_matched || len > matched_len) {
+            level = filter->level;
+            matched_len = len;
+            object_matched = TRUE;
+        }
+    }
+
+    return level;
+}
+
+gboolean
+_mm_log_enabled (gpointer     obj,
+                 const gchar *module,
+                 MMLogLevel   level)
+{
+    if (G_LIKELY (!log_filters))
+        return (log_level & level);
+    return (log_filters_get_level (obj, module) & level);
 }
 
 void
@@ -239,7 +321,7 @@ _mm_log (gpointer     obj,
     va_list  args;
     GTimeVal tv;
 
-    if (!mm_log_check_level_enabled (level))
+    if (!_mm_log_enabled (obj, module, level))
         return;
 
     if (g_once_init_enter (&msgbuf_once)) {
@@ -303,25 +385,95 @@ log_handler (const gchar    *log_domain,
              message);
 }
 
-gboolean
-mm_log_set_level (const gchar  *level,
-                  GError      **error)
+static gboolean
+log_level_parse (const gchar  *str,
+                 guint32      *out_level,
+                 GError      **error)
 {
     guint i;
 
-    for (i = 0; i < G_N_ELEMENTS (level_descs); i++) {
-        if (!g_ascii_strcasecmp (level_descs[i].name, level)) {
-            log_level = level_descs[i].num;
-            break;
+    for (i = 0; level_descs[i].name; i++) {
+        if (!g_ascii_strcasecmp (level_descs[i].name, str)) {
+            *out_level = level_descs[i].num;
+            return TRUE;
         }
     }
 
-    if (i == G_N_ELEMENTS (level_descs)) {
-        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
-                     "Unknown log level '%s'", level);
+    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                 "Unknown log level '%s'", str);
+    return FALSE;
+}
+
+static void
+log_filter_clear (LogFilter *filter)
+{
+    g_free (filter->name);
+}
+
+/*
+ * The level string is a global level optionally followed by a comma
+ * separated list of filters, e.g.:
+ *   "INFO,modem0=DEBUG,module:shared-qmi=WARN"
+ */
+gboolean
+mm_log_set_level (const gchar  *level,
+                  GError      **error)
+{
+    g_auto(GStrv)     split = NULL;
+    g_autoptr(GArray) filters = NULL;
+    guint32           new_level;
+    guint32           new_mask;
+    guint             i;
+
+    split = g_strsplit (level, ",", -1);
+    if (!log_level_parse (g_strstrip (split[0]), &new_level, error))
         return FALSE;
+    new_mask = new_level;
+
+    for (i = 1; split[i]; i++) {
+        LogFilter  filter = { 0 };
+        gchar     *name;
+        gchar     *value;
+
+        name = g_strstrip (split[i]);
+        value = strchr (name, '=');
+        if (!value) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "Invalid log filter '%s': missing level", name);
+            return FALSE;
+        }
+        *(value++) = '\0';
+        g_strstrip (name);
+        g_strstrip (value);
+
+        if (g_str_has_prefix (name, "module:")) {
+            filter.module = TRUE;
+            name += strlen ("module:");
+        }
+        if (!name[0]) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "Invalid log filter: missing %s", filter.module ? "module name" : "object id");
+            return FALSE;
+        }
+        if (!log_level_parse (value, &filter.level, error))
+            return FALSE;
+
+        filter.name = g_strdup (name);
+        if (!filters) {
+            filters = g_array_new (FALSE, FALSE, sizeof (LogFilter));
+            g_array_set_clear_func (filters, (GDestroyNotify) log_filter_clear);
+        }
+        g_array_append_val (filters, filter);
+        new_mask |= filter.level;
     }
 
+    g_clear_pointer (&log_filters, g_array_unref);
+    log_filters = g_steal_pointer (&filters);
+    log_level = new_level;
+    _mm_log_level_mask = new_mask;
+
+    /* QMI and MBIM traces are not bound to any object, so they follow
+     * the global level only */
 #if defined WITH_QMI
     qmi_utils_set_traces_enabled (log_level & MM_LOG_LEVEL_DEBUG ? TRUE : FALSE);
 #endif
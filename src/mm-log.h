@@ -35,12 +35,24 @@ typedef enum {
 # define MM_LOG_MODULE_NAME (const gchar *)NULL
 #endif
 
-#define mm_obj_log(obj, level, ...) _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, level,              ## __VA_ARGS__ )
-#define mm_obj_err(obj, ...)        _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, MM_LOG_LEVEL_ERR,   ## __VA_ARGS__ )
-#define mm_obj_warn(obj, ...)       _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, MM_LOG_LEVEL_WARN,  ## __VA_ARGS__ )
-#define mm_obj_msg(obj, ...)        _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, MM_LOG_LEVEL_MSG,   ## __VA_ARGS__ )
-#define mm_obj_info(obj, ...)       _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, MM_LOG_LEVEL_INFO,  ## __VA_ARGS__ )
-#define mm_obj_dbg(obj, ...)        _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, MM_LOG_LEVEL_DEBUG, ## __VA_ARGS__ )
+/* The level is checked before any of the arguments are evaluated, so
+ * that disabled logs don't pay the cost of building the message. The
+ * mask includes every level enabled either globally or in any of the
+ * filters, the full check is only done if the level is in the mask. */
+#define mm_obj_log_enabled(obj, level)                                  \
+    G_UNLIKELY ((_mm_log_level_mask & (level)) &&                       \
+                _mm_log_enabled (obj, MM_LOG_MODULE_NAME, level))
+
+#define mm_obj_log(obj, level, ...)                                     \
+    G_STMT_START {                                                      \
+        if (mm_obj_log_enabled (obj, level))                            \
+            _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, level, ## __VA_ARGS__ ); \
+    } G_STMT_END
+#define mm_obj_err(obj, ...)  mm_obj_log (obj, MM_LOG_LEVEL_ERR,   ## __VA_ARGS__ )
+#define mm_obj_warn(obj, ...) mm_obj_log (obj, MM_LOG_LEVEL_WARN,  ## __VA_ARGS__ )
+#define mm_obj_msg(obj, ...)  mm_obj_log (obj, MM_LOG_LEVEL_MSG,   ## __VA_ARGS__ )
+#define mm_obj_info(obj, ...) mm_obj_log (obj, MM_LOG_LEVEL_INFO,  ## __VA_ARGS__ )
+#define mm_obj_dbg(obj, ...)  mm_obj_log (obj, MM_LOG_LEVEL_DEBUG, ## __VA_ARGS__ )
 
 /* only allow using non-object logging API if explicitly requested
  * (e.g. in the main daemon source) */
@@ -58,6 +70,12 @@ typedef enum {
 #define mm_log_info_enabled()  mm_log_check_level_enabled (MM_LOG_LEVEL_INFO)
 #define mm_log_debug_enabled() mm_log_check_level_enabled (MM_LOG_LEVEL_DEBUG)
 
+extern guint32 _mm_log_level_mask;
+
+gboolean _mm_log_enabled (gpointer     obj,
+                          const gchar *module,
+                          MMLogLevel   level);
+
 void _mm_log (gpointer     obj,
               const gchar *module,
               const gchar *loc,
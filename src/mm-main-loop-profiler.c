@@ -0,0 +1,243 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+#include <string.h>
+
+#define MM_LOG_NO_OBJECT
+#include "mm-log-object.h"
+#include "mm-main-loop-profiler.h"
+
+typedef struct {
+    const gchar *name;
+    const gchar *object_id;
+} EntryKey;
+
+struct _MMMainLoopProfilerEntry {
+    /* Must be first, entries are looked up by key */
+    EntryKey    key;
+    MMHistogram histogram;
+};
+
+static gboolean    enabled;
+static gint64      stall_threshold;
+static GHashTable *entries;
+static GPollFunc   default_poll_func;
+
+/* Time spent dispatching each main loop iteration */
+static MMHistogram iterations;
+/* When the last poll() returned, 0 if none yet */
+static gint64      poll_returned;
+/* Longest profiled callback in the current iteration */
+static MMMainLoopProfilerEntry *iteration_longest_entry;
+static gint64                   iteration_longest;
+
+/*****************************************************************************/
+
+static guint
+entry_key_hash (const EntryKey *key)
+{
+    return g_str_hash (key->name) * 31 + (key->object_id ? g_str_hash (key->object_id) : 0);
+}
+
+static gboolean
+entry_key_equal (const EntryKey *a,
+                 const EntryKey *b)
+{
+    return g_str_equal (a->name, b->name) && !g_strcmp0 (a->object_id, b->object_id);
+}
+
+static gchar *
+entry_build_description (MMMainLoopProfilerEntry *entry)
+{
+    if (entry->key.object_id)
+        return g_strdup_printf ("%s [%s]", entry->key.name, entry->key.object_id);
+    return g_strdup (entry->key.name);
+}
+
+/*****************************************************************************/
+
+static gint
+profiler_poll (GPollFD *fds,
+               guint    nfds,
+               gint     timeout)
+{
+    gint ret;
+
+    if (poll_returned) {
+        gint64 busy;
+
+        busy = g_get_monotonic_time () - poll_returned;
+        mm_histogram_add (&iterations, (guint64) busy);
+        if (busy >= stall_threshold) {
+            if (iteration_longest_entry) {
+                g_autofree gchar *description = NULL;
+
+                description = entry_build_description (iteration_longest_entry);
+                mm_msg ("main loop stalled for %" G_GINT64_FORMAT " ms, longest callback: %s (%" G_GINT64_FORMAT " ms)",
+                        busy / 1000, description, iteration_longest / 1000);
+            } else
+                mm_msg ("main loop stalled for %" G_GINT64_FORMAT " ms in callbacks not profiled",
+                        busy / 1000);
+        }
+    }
+
+    iteration_longest_entry = NULL;
+    iteration_longest = 0;
+
+    ret = default_poll_func (fds, nfds, timeout);
+    poll_returned = g_get_monotonic_time ();
+    return ret;
+}
+
+void
+mm_main_loop_profiler_enable (guint stall_threshold_ms)
+{
+    if (enabled)
+        return;
+
+    enabled = TRUE;
+    stall_threshold = (gint64) stall_threshold_ms * 1000;
+    entries = g_hash_table_new ((GHashFunc) entry_key_hash, (GEqualFunc) entry_key_equal);
+
+    /* Wrap poll() to know when each iteration of the default main context
+     * starts and ends dispatching */
+    default_poll_func = g_main_context_get_poll_func (NULL);
+    g_main_context_set_poll_func (NULL, profiler_poll);
+}
+
+gboolean
+mm_main_loop_profiler_is_enabled (void)
+{
+    return enabled;
+}
+
+/*****************************************************************************/
+
+void
+mm_main_loop_profiler_begin (MMMainLoopProfilerScope *scope,
+                             const gchar             *name,
+                             gpointer                 object)
+{
+    MMMainLoopProfilerEntry *entry;
+    EntryKey                 key;
+
+    scope->entry = NULL;
+    scope->start = 0;
+
+    if (!enabled)
+        return;
+
+    key.name = name;
+    /* Without the owner id, so that the same port reprobed by a new modem
+     * object keeps using the same entry */
+    key.object_id = object ? mm_log_object_get_self_id (MM_LOG_OBJECT (object)) : NULL;
+
+    /* Entries are only allocated the first time a callback is seen */
+    entry = g_hash_table_lookup (entries, &key);
+    if (!entry) {
+        entry = g_new0 (MMMainLoopProfilerEntry, 1);
+        entry->key.name = name;
+        entry->key.object_id = g_strdup (key.object_id);
+        g_hash_table_add (entries, entry);
+    }
+
+    scope->entry = entry;
+    scope->start = g_get_monotonic_time ();
+}
+
+void
+mm_main_loop_profiler_end (MMMainLoopProfilerScope *scope)
+{
+    gint64 duration;
+
+    if (!scope->entry)
+        return;
+
+    duration = g_get_monotonic_time () - scope->start;
+    mm_histogram_add (&scope->entry->histogram, (guint64) duration);
+    if (duration > iteration_longest) {
+        iteration_longest = duration;
+        iteration_longest_entry = scope->entry;
+    }
+    scope->entry = NULL;
+}
+
+/*****************************************************************************/
+
+static gint
+entry_cmp_total (MMMainLoopProfilerEntry **a,
+                 MMMainLoopProfilerEntry **b)
+{
+    if ((*a)->histogram.sum == (*b)->histogram.sum)
+        return 0;
+    return ((*a)->histogram.sum > (*b)->histogram.sum) ? -1 : 1;
+}
+
+void
+mm_main_loop_profiler_report (guint n_top)
+{
+    g_autoptr(GPtrArray) sorted = NULL;
+    GHashTableIter       iter;
+    gpointer             entry;
+    guint                i;
+
+    if (!enabled) {
+        mm_msg ("main loop profiling not enabled");
+        return;
+    }
+
+    mm_msg ("main loop profile: %" G_GUINT64_FORMAT " iterations, dispatching %" G_GUINT64_FORMAT " us (p50), %" G_GUINT64_FORMAT " us (p99), %" G_GUINT64_FORMAT " us (max)",
+            iterations.count,
+            mm_histogram_get_percentile (&iterations, 50),
+            mm_histogram_get_percentile (&iterations, 99),
+            iterations.max);
+
+    sorted = g_ptr_array_sized_new (g_hash_table_size (entries));
+    g_hash_table_iter_init (&iter, entries);
+    while (g_hash_table_iter_next (&iter, &entry, NULL))
+        g_ptr_array_add (sorted, entry);
+    g_ptr_array_sort (sorted, (GCompareFunc) entry_cmp_total);
+
+    for (i = 0; i < MIN (n_top, sorted->len); i++) {
+        MMMainLoopProfilerEntry *top;
+        g_autofree gchar        *description = NULL;
+
+        top = g_ptr_array_index (sorted, i);
+        description = entry_build_description (top);
+        mm_msg ("  %s: %" G_GUINT64_FORMAT " calls, %" G_GUINT64_FORMAT " ms total, "
+                "%" G_GUINT64_FORMAT " us (mean), %" G_GUINT64_FORMAT " us (p99), %" G_GUINT64_FORMAT " us (max)",
+                description,
+                top->histogram.count,
+                top->histogram.sum / 1000,
+                mm_histogram_get_mean (&top->histogram),
+                mm_histogram_get_percentile (&top->histogram, 99),
+                top->histogram.max);
+    }
+}
+
+const MMHistogram *
+mm_main_loop_profiler_peek_histogram (const gchar *name,
+                                      const gchar *object_id)
+{
+    MMMainLoopProfilerEntry *entry;
+    EntryKey                 key = { name, object_id };
+
+    if (!enabled)
+        return NULL;
+
+    entry = g_hash_table_lookup (entries, &key);
+    return entry ? &entry->histogram : NULL;
+}
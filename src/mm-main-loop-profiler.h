@@ -0,0 +1,57 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#ifndef MM_MAIN_LOOP_PROFILER_H
+#define MM_MAIN_LOOP_PROFILER_H
+
+#include <glib.h>
+
+#include "mm-histogram.h"
+
+/* Opt-in profiling of the default main context.
+ *
+ * Every main loop iteration is timed from the moment poll() returns until
+ * the next poll() starts, i.e. the time spent dispatching sources, and
+ * iterations longer than the stall threshold are reported. Callbacks
+ * wrapped with begin()/end() are recorded in a histogram per callback name
+ * and object, so that the ones causing the stalls can be found. Objects are
+ * identified by their own log id, without the one of their owner, so that
+ * e.g. a port keeps the same histogram when its modem is recreated. */
+
+typedef struct _MMMainLoopProfilerEntry MMMainLoopProfilerEntry;
+
+typedef struct {
+    MMMainLoopProfilerEntry *entry;
+    gint64                   start;
+} MMMainLoopProfilerScope;
+
+void     mm_main_loop_profiler_enable     (guint stall_threshold_ms);
+gboolean mm_main_loop_profiler_is_enabled (void);
+
+/* The name must be a static string; the object, if any, must implement
+ * MMLogObject and is only used in begin() */
+void     mm_main_loop_profiler_begin      (MMMainLoopProfilerScope *scope,
+                                           const gchar             *name,
+                                           gpointer                 object);
+void     mm_main_loop_profiler_end        (MMMainLoopProfilerScope *scope);
+
+/* Logs the callbacks taking the most time in total */
+void     mm_main_loop_profiler_report     (guint n_top);
+
+/* For testing */
+const MMHistogram *mm_main_loop_profiler_peek_histogram (const gchar *name,
+                                                         const gchar *object_id);
+
+#endif /* MM_MAIN_LOOP_PROFILER_H */
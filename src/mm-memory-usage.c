@@ -0,0 +1,135 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#if defined HAVE_MALLINFO2
+# include <malloc.h>
+#endif
+
+#include "mm-memory-usage.h"
+
+static const gchar *subsystem_names[] = {
+    [MM_MEMORY_SUBSYSTEM_CORE]                 = "core",
+    [MM_MEMORY_SUBSYSTEM_MODEM]                = "modem",
+    [MM_MEMORY_SUBSYSTEM_3GPP]                 = "3gpp",
+    [MM_MEMORY_SUBSYSTEM_3GPP_PROFILE_MANAGER] = "3gpp-profile-manager",
+    [MM_MEMORY_SUBSYSTEM_3GPP_USSD]            = "3gpp-ussd",
+    [MM_MEMORY_SUBSYSTEM_CDMA]                 = "cdma",
+    [MM_MEMORY_SUBSYSTEM_MESSAGING]            = "messaging",
+    [MM_MEMORY_SUBSYSTEM_TIME]                 = "time",
+    [MM_MEMORY_SUBSYSTEM_SIGNAL]               = "signal",
+    [MM_MEMORY_SUBSYSTEM_OMA]                  = "oma",
+    [MM_MEMORY_SUBSYSTEM_SAR]                  = "sar",
+    [MM_MEMORY_SUBSYSTEM_CELL_BROADCAST]       = "cell-broadcast",
+    [MM_MEMORY_SUBSYSTEM_LOCATION]             = "location",
+    [MM_MEMORY_SUBSYSTEM_VOICE]                = "voice",
+    [MM_MEMORY_SUBSYSTEM_FIRMWARE]             = "firmware",
+    [MM_MEMORY_SUBSYSTEM_SIMPLE]               = "simple",
+    [MM_MEMORY_SUBSYSTEM_ENABLING]             = "enabling",
+};
+
+G_STATIC_ASSERT (G_N_ELEMENTS (subsystem_names) == MM_MEMORY_SUBSYSTEM_LAST);
+
+gboolean
+mm_memory_usage_supported (void)
+{
+#if defined HAVE_MALLINFO2
+    return TRUE;
+#else
+    return FALSE;
+#endif
+}
+
+gint64
+mm_memory_usage_sample (void)
+{
+#if defined HAVE_MALLINFO2
+    struct mallinfo2 info;
+
+    /* Space in use in the main heap plus the mmap-ed chunks */
+    info = mallinfo2 ();
+    return (gint64) (info.uordblks + info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+const gchar *
+mm_memory_subsystem_get_string (MMMemorySubsystem subsystem)
+{
+    g_return_val_if_fail (subsystem < MM_MEMORY_SUBSYSTEM_LAST, NULL);
+    return subsystem_names[subsystem];
+}
+
+void
+mm_memory_usage_account (MMMemoryUsage     *usage,
+                         MMMemorySubsystem  subsystem,
+                         gint64             since)
+{
+    gint64 now;
+
+    g_return_if_fail (subsystem < MM_MEMORY_SUBSYSTEM_LAST);
+
+    if (since < 0)
+        return;
+
+    now = mm_memory_usage_sample ();
+    if (now < 0)
+        return;
+
+    /* Memory released by other users of the heap may show up as a negative
+     * delta; never account less than nothing */
+    if (now > since)
+        usage->bytes[subsystem] += now - since;
+}
+
+void
+mm_memory_usage_reset (MMMemoryUsage     *usage,
+                       MMMemorySubsystem  subsystem)
+{
+    g_return_if_fail (subsystem < MM_MEMORY_SUBSYSTEM_LAST);
+
+    usage->bytes[subsystem] = 0;
+}
+
+gint64
+mm_memory_usage_get_total (const MMMemoryUsage *usage)
+{
+    gint64 total = 0;
+    guint  i;
+
+    for (i = 0; i < MM_MEMORY_SUBSYSTEM_LAST; i++)
+        total += usage->bytes[i];
+    return total;
+}
+
+gchar *
+mm_memory_usage_build_string (const MMMemoryUsage *usage)
+{
+    GString *str;
+    guint    i;
+
+    str = g_string_new (NULL);
+    for (i = 0; i < MM_MEMORY_SUBSYSTEM_LAST; i++) {
+        if (!usage->bytes[i])
+            continue;
+        g_string_append_printf (str, "%s%s: %.1f KiB",
+                                str->len ? ", " : "",
+                                subsystem_names[i],
+                                (gdouble) usage->bytes[i] / 1024.0);
+    }
+    return g_string_free (str, FALSE);
+}
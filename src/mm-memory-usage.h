@@ -0,0 +1,76 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#ifndef MM_MEMORY_USAGE_H
+#define MM_MEMORY_USAGE_H
+
+#include <glib.h>
+
+/* Approximate per-modem memory accounting, based on the difference in heap
+ * usage reported by the C library before and after each step that sets up a
+ * subsystem of the modem. The heap is shared by the whole process, so
+ * allocations done by other modems being set up at the same time are also
+ * accounted; the numbers are only accurate when modems are set up one at a
+ * time. */
+
+typedef enum {
+    MM_MEMORY_SUBSYSTEM_CORE,
+    MM_MEMORY_SUBSYSTEM_MODEM,
+    MM_MEMORY_SUBSYSTEM_3GPP,
+    MM_MEMORY_SUBSYSTEM_3GPP_PROFILE_MANAGER,
+    MM_MEMORY_SUBSYSTEM_3GPP_USSD,
+    MM_MEMORY_SUBSYSTEM_CDMA,
+    MM_MEMORY_SUBSYSTEM_MESSAGING,
+    MM_MEMORY_SUBSYSTEM_TIME,
+    MM_MEMORY_SUBSYSTEM_SIGNAL,
+    MM_MEMORY_SUBSYSTEM_OMA,
+    MM_MEMORY_SUBSYSTEM_SAR,
+    MM_MEMORY_SUBSYSTEM_CELL_BROADCAST,
+    MM_MEMORY_SUBSYSTEM_LOCATION,
+    MM_MEMORY_SUBSYSTEM_VOICE,
+    MM_MEMORY_SUBSYSTEM_FIRMWARE,
+    MM_MEMORY_SUBSYSTEM_SIMPLE,
+    MM_MEMORY_SUBSYSTEM_ENABLING,
+    MM_MEMORY_SUBSYSTEM_LAST
+} MMMemorySubsystem;
+
+typedef struct {
+    gint64 bytes[MM_MEMORY_SUBSYSTEM_LAST];
+} MMMemoryUsage;
+
+/* Whether the C library reports heap usage at all */
+gboolean     mm_memory_usage_supported      (void);
+
+/* Bytes of heap currently in use by the process, -1 if unsupported */
+gint64       mm_memory_usage_sample         (void);
+
+const gchar *mm_memory_subsystem_get_string (MMMemorySubsystem subsystem);
+
+/* Accounts to the subsystem the heap usage growth since the given sample */
+void         mm_memory_usage_account        (MMMemoryUsage     *usage,
+                                             MMMemorySubsystem  subsystem,
+                                             gint64             since);
+
+/* Forgets what was accounted to the subsystem, e.g. before running again a
+ * sequence whose allocations are released when undone */
+void         mm_memory_usage_reset          (MMMemoryUsage     *usage,
+                                             MMMemorySubsystem  subsystem);
+
+gint64       mm_memory_usage_get_total      (const MMMemoryUsage *usage);
+
+/* e.g. "modem: 12.5 KiB, 3gpp: 4.1 KiB" skipping empty subsystems */
+gchar       *mm_memory_usage_build_string   (const MMMemoryUsage *usage);
+
+#endif /* MM_MEMORY_USAGE_H */
@@ -2243,67 +2243,126 @@ mm_3gpp_parse_cmgf_test_response (const gchar *reply,
 
 /*************************************************************************/
 
-MM3gppPduInfo *
-mm_3gpp_parse_cmgr_read_response (const gchar *reply,
-                                  guint index,
-                                  GError **error)
+/* Reads a non-negative decimal integer; returns FALSE if there are no digits
+ * or if the value doesn't fit in a gint, setting *overflow in the latter case */
+static gboolean
+pdu_read_int (const gchar **p,
+              gint         *out,
+              gboolean     *overflow)
 {
-    g_autoptr(GRegex)      r = NULL;
-    g_autoptr(GMatchInfo)  match_info = NULL;
-    gint                   count;
-    gint                   status;
-    gchar                 *pdu;
-    MM3gppPduInfo         *info = NULL;
-
-    /* +CMGR: <stat>,<alpha>,<length>(whitespace)<pdu> */
-    /* The <alpha> and <length> fields are matched, but not currently used */
-    r = g_regex_new ("\\+CMGR:\\s*(\\d+)\\s*,([^,]*),\\s*(\\d+)\\s*([^\\r\\n]*)", 0, 0, NULL);
-    g_assert (r);
+    const gchar *q = *p;
+    gint64       value = 0;
 
-    if (!g_regex_match (r, reply, 0, &match_info)) {
-        g_set_error (error,
-                     MM_CORE_ERROR,
-                     MM_CORE_ERROR_FAILED,
-                     "Failed to parse CMGR read result: response didn't match '%s'",
-                     reply);
-        return NULL;
-    }
+    if (!g_ascii_isdigit (*q))
+        return FALSE;
 
-    /* g_match_info_get_match_count includes match #0 */
-    if ((count = g_match_info_get_match_count (match_info)) != 5) {
-        g_set_error (error,
-                     MM_CORE_ERROR,
-                     MM_CORE_ERROR_FAILED,
-                     "Failed to match CMGR fields (matched %d) '%s'",
-                     count,
-                     reply);
-        return NULL;
+    for (; g_ascii_isdigit (*q); q++) {
+        value = (value * 10) + (*q - '0');
+        if (value > G_MAXINT) {
+            *overflow = TRUE;
+            return FALSE;
+        }
     }
 
-    if (!mm_get_int_from_match_info (match_info, 1, &status)) {
-        g_set_error (error,
-                     MM_CORE_ERROR,
-                     MM_CORE_ERROR_FAILED,
-                     "Failed to extract CMGR status field '%s'",
-                     reply);
-        return NULL;
+    *out = (gint) value;
+    *p = q;
+    return TRUE;
+}
+
+static void
+pdu_skip_spaces (const gchar **p)
+{
+    while (g_ascii_isspace (**p))
+        (*p)++;
+}
+
+/* Strips the optional quotes (and any whitespace inside them) around a PDU */
+static void
+pdu_unquote (const gchar **pdu,
+             const gchar **pdu_end)
+{
+    if ((*pdu_end - *pdu >= 2) && ((*pdu)[0] == '"') && ((*pdu_end)[-1] == '"')) {
+        (*pdu)++;
+        (*pdu_end)--;
+        while (*pdu < *pdu_end && g_ascii_isspace (**pdu))
+            (*pdu)++;
+        while (*pdu_end > *pdu && g_ascii_isspace ((*pdu_end)[-1]))
+            (*pdu_end)--;
     }
+}
+
+gboolean
+mm_3gpp_parse_cmgr_read_response_pdu (const gchar  *reply,
+                                      gint         *out_status,
+                                      const gchar **out_pdu,
+                                      gsize        *out_pdu_len,
+                                      GError      **error)
+{
+    const gchar *p;
+    const gchar *pdu_end;
+    gint         status = 0;
+    gint         length = 0;
+    gboolean     overflow = FALSE;
+
+    /* +CMGR: <stat>,<alpha>,<length>(whitespace)<pdu>
+     * The <alpha> and <length> fields are parsed, but not currently used.
+     * The response is scanned in place, without any intermediate copy. */
+    p = strstr (reply, "+CMGR:");
+    if (!p)
+        goto out_error;
+    p += strlen ("+CMGR:");
+
+    pdu_skip_spaces (&p);
+    if (!pdu_read_int (&p, &status, &overflow))
+        goto out_error;
+    pdu_skip_spaces (&p);
+    if (*p++ != ',')
+        goto out_error;
+    p = strchr (p, ',');
+    if (!p)
+        goto out_error;
+    p++;
+    pdu_skip_spaces (&p);
+    if (!pdu_read_int (&p, &length, &overflow))
+        goto out_error;
+    pdu_skip_spaces (&p);
+
+    pdu_end = p + strcspn (p, "\r\n");
+    pdu_unquote (&p, &pdu_end);
+    if (p == pdu_end)
+        goto out_error;
+
+    *out_status = status;
+    *out_pdu = p;
+    *out_pdu_len = pdu_end - p;
+    return TRUE;
 
+out_error:
+    g_set_error (error,
+                 MM_CORE_ERROR,
+                 MM_CORE_ERROR_FAILED,
+                 "Failed to parse CMGR read result: '%s'",
+                 reply);
+    return FALSE;
+}
 
-    pdu = mm_get_string_unquoted_from_match_info (match_info, 4);
-    if (!pdu) {
-        g_set_error (error,
-                     MM_CORE_ERROR,
-                     MM_CORE_ERROR_FAILED,
-                     "Failed to extract CMGR pdu field '%s'",
-                     reply);
+MM3gppPduInfo *
+mm_3gpp_parse_cmgr_read_response (const gchar *reply,
+                                  guint index,
+                                  GError **error)
+{
+    MM3gppPduInfo *info;
+    const gchar   *pdu;
+    gsize          pdu_len;
+    gint           status;
+
+    if (!mm_3gpp_parse_cmgr_read_response_pdu (reply, &status, &pdu, &pdu_len, error))
         return NULL;
-    }
 
     info = g_new0 (MM3gppPduInfo, 1);
     info->index = index;
     info->status = status;
-    info->pdu = pdu;
+    info->pdu = g_strndup (pdu, pdu_len);
     return info;
 }
 
@@ -4264,53 +4323,116 @@ mm_3gpp_pdu_info_list_free (GList *info_list)
     g_list_free_full (info_list, (GDestroyNotify)mm_3gpp_pdu_info_free);
 }
 
-GList *
-mm_3gpp_parse_pdu_cmgl_response (const gchar *str,
-                                 GError **error)
+gboolean
+mm_3gpp_parse_pdu_cmgl_response_foreach (const gchar         *str,
+                                         MM3gppPduForeachFn   callback,
+                                         gpointer             user_data,
+                                         GError             **error)
 {
-    g_autoptr(GRegex)      r = NULL;
-    g_autoptr(GMatchInfo)  match_info = NULL;
-    GError                *inner_error = NULL;
-    GList                 *list = NULL;
+    const gchar *p = str;
 
     /*
      * +CMGL: <index>, <status>, [<alpha>], <length>
      *   or
      * +CMGL: <index>, <status>, <length>
      *
-     * We just read <index>, <stat> and the PDU itself.
+     * We just read <index>, <stat> and the PDU itself, which is given in the
+     * next line. The response is scanned in place, without any intermediate
+     * copy.
      */
-    r = g_regex_new ("\\+CMGL:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,(.*)\\r\\n([^\\r\\n]*)(\\r\\n)?",
-                     G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
-    while (!inner_error && g_match_info_matches (match_info)) {
-        MM3gppPduInfo *info;
-
-        info = g_new0 (MM3gppPduInfo, 1);
-        if (mm_get_int_from_match_info (match_info, 1, &info->index) &&
-            mm_get_int_from_match_info (match_info, 2, &info->status) &&
-            (info->pdu = mm_get_string_unquoted_from_match_info (match_info, 4)) != NULL) {
-            /* Append to our list of results and keep on */
-            list = g_list_append (list, info);
-            g_match_info_next (match_info, &inner_error);
-        } else {
-            mm_3gpp_pdu_info_free (info);
-            inner_error = g_error_new (MM_CORE_ERROR,
-                                       MM_CORE_ERROR_FAILED,
-                                       "Error parsing +CMGL response: '%s'",
-                                       str);
+    while ((p = strstr (p, "+CMGL:")) != NULL) {
+        const gchar *q;
+        const gchar *pdu;
+        const gchar *pdu_end;
+        gint         index = 0;
+        gint         status = 0;
+        gboolean     overflow = FALSE;
+
+        q = p + strlen ("+CMGL:");
+        /* Skip the prefix in case the header is not valid */
+        p = q;
+
+        pdu_skip_spaces (&q);
+        if (!pdu_read_int (&q, &index, &overflow)) {
+            if (overflow)
+                goto out_error;
+            continue;
+        }
+        pdu_skip_spaces (&q);
+        if (*q++ != ',')
+            continue;
+        pdu_skip_spaces (&q);
+        if (!pdu_read_int (&q, &status, &overflow)) {
+            if (overflow)
+                goto out_error;
+            continue;
         }
+        pdu_skip_spaces (&q);
+        if (*q++ != ',')
+            continue;
+
+        /* Rest of the header line, which must end with CRLF */
+        q = strchr (q, '\n');
+        if (!q || q[-1] != '\r')
+            continue;
+        q++;
+
+        /* PDU line, up to the next CR, LF or the end of the string */
+        pdu = q;
+        pdu_end = pdu + strcspn (pdu, "\r\n");
+        p = pdu_end;
+        if (p[0] == '\r' && p[1] == '\n')
+            p += 2;
+
+        pdu_unquote (&pdu, &pdu_end);
+        if (pdu == pdu_end)
+            goto out_error;
+
+        callback (index, status, pdu, pdu_end - pdu, user_data);
     }
 
-    if (inner_error) {
-        g_propagate_error (error, inner_error);
+    return TRUE;
+
+out_error:
+    g_set_error (error,
+                 MM_CORE_ERROR,
+                 MM_CORE_ERROR_FAILED,
+                 "Error parsing +CMGL response: '%s'",
+                 str);
+    return FALSE;
+}
+
+static void
+cmgl_pdu_info_add (gint         index,
+                   gint         status,
+                   const gchar *pdu,
+                   gsize        pdu_len,
+                   GList      **list)
+{
+    MM3gppPduInfo *info;
+
+    info = g_new0 (MM3gppPduInfo, 1);
+    info->index = index;
+    info->status = status;
+    info->pdu = g_strndup (pdu, pdu_len);
+    *list = g_list_prepend (*list, info);
+}
+
+GList *
+mm_3gpp_parse_pdu_cmgl_response (const gchar *str,
+                                 GError **error)
+{
+    GList *list = NULL;
+
+    if (!mm_3gpp_parse_pdu_cmgl_response_foreach (str,
+                                                  (MM3gppPduForeachFn) cmgl_pdu_info_add,
+                                                  &list,
+                                                  error)) {
         mm_3gpp_pdu_info_list_free (list);
         return NULL;
     }
 
-    return list;
+    return g_list_reverse (list);
 }
 
 /*************************************************************************/
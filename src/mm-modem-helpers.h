@@ -372,10 +372,28 @@ void   mm_3gpp_pdu_info_list_free      (GList *info_list);
 GList *mm_3gpp_parse_pdu_cmgl_response (const gchar *str,
                                         GError **error);
 
-/* AT+CMGR (Read message) response parser */
-MM3gppPduInfo *mm_3gpp_parse_cmgr_read_response (const gchar *reply,
-                                                 guint index,
-                                                 GError **error);
+/* Streaming version of the CMGL parser; the PDU given in the callback points
+ * to the hex string within the response, and is not NUL-terminated. */
+typedef void (* MM3gppPduForeachFn) (gint         index,
+                                     gint         status,
+                                     const gchar *pdu,
+                                     gsize        pdu_len,
+                                     gpointer     user_data);
+gboolean mm_3gpp_parse_pdu_cmgl_response_foreach (const gchar         *str,
+                                                  MM3gppPduForeachFn   callback,
+                                                  gpointer             user_data,
+                                                  GError             **error);
+
+/* AT+CMGR (Read message) response parser; the in-place variant returns the
+ * PDU as a slice of the reply string */
+gboolean       mm_3gpp_parse_cmgr_read_response_pdu (const gchar  *reply,
+                                                     gint         *out_status,
+                                                     const gchar **out_pdu,
+                                                     gsize        *out_pdu_len,
+                                                     GError      **error);
+MM3gppPduInfo *mm_3gpp_parse_cmgr_read_response     (const gchar *reply,
+                                                     guint index,
+                                                     GError **error);
 
 
 /* AT+CRSM response parser */
@@ -0,0 +1,278 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#include "mm-modem-info-cache.h"
+#include "mm-log-object.h"
+#include "mm-utils.h"
+
+#if !defined PKGSTATEDIR
+# error PKGSTATEDIR is not defined
+#endif
+
+#define MODEM_INFO_STATE_FILE "modems.ini"
+
+/* Devices that were seen long ago are removed so that the file doesn't grow
+ * forever */
+#define MODEM_INFO_MAX_DEVICES 32
+
+#define MODEM_INFO_PLUGIN_KEY                "plugin"
+#define MODEM_INFO_MANUFACTURER_KEY          "manufacturer"
+#define MODEM_INFO_MODEL_KEY                 "model"
+#define MODEM_INFO_REVISION_KEY              "revision"
+#define MODEM_INFO_EQUIPMENT_IDENTIFIER_KEY  "equipment-identifier"
+#define MODEM_INFO_DEVICE_IDENTIFIER_KEY     "device-identifier"
+#define MODEM_INFO_SUPPORTED_IP_FAMILIES_KEY "supported-ip-families"
+
+/*****************************************************************************/
+
+static void log_object_iface_init (MMLogObjectInterface *iface);
+
+struct _MMModemInfoCache {
+    GObject   parent;
+    gchar    *filename;
+    GKeyFile *key_file;
+};
+
+struct _MMModemInfoCacheClass {
+    GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_EXTENDED (MMModemInfoCache, mm_modem_info_cache, G_TYPE_OBJECT, 0,
+                        G_IMPLEMENT_INTERFACE (MM_TYPE_LOG_OBJECT, log_object_iface_init))
+
+/*****************************************************************************/
+
+static gchar *
+log_object_build_id (MMLogObject *_self)
+{
+    return g_strdup ("modem-info-cache");
+}
+
+/*****************************************************************************/
+
+static GKeyFile *
+peek_key_file (MMModemInfoCache *self)
+{
+    g_autoptr(GError) error = NULL;
+
+    if (self->key_file)
+        return self->key_file;
+
+    self->key_file = g_key_file_new ();
+    if (!g_key_file_load_from_file (self->key_file, self->filename, G_KEY_FILE_NONE, &error) &&
+        !g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+        mm_obj_warn (self, "couldn't load modem info cache from %s: %s", self->filename, error->message);
+    return self->key_file;
+}
+
+static void
+save_key_file (MMModemInfoCache *self)
+{
+    g_autoptr(GError) error = NULL;
+
+    if (!g_key_file_save_to_file (self->key_file, self->filename, &error))
+        mm_obj_warn (self, "couldn't save modem info cache to %s: %s", self->filename, error->message);
+}
+
+/* Group names in key files cannot include square brackets */
+static gchar *
+build_group_name (const gchar *device)
+{
+    return g_strdelimit (g_strdup (device), "[]", '_');
+}
+
+/*****************************************************************************/
+
+static gboolean
+key_matches (GKeyFile    *key_file,
+             const gchar *group,
+             const gchar *key,
+             const gchar *value)
+{
+    g_autofree gchar *cached = NULL;
+
+    cached = g_key_file_get_string (key_file, group, key, NULL);
+    return (cached && value && g_str_equal (cached, value));
+}
+
+/* For values that some modems don't report at all */
+static gboolean
+optional_key_matches (GKeyFile    *key_file,
+                      const gchar *group,
+                      const gchar *key,
+                      const gchar *value)
+{
+    g_autofree gchar *cached = NULL;
+
+    cached = g_key_file_get_string (key_file, group, key, NULL);
+    return !g_strcmp0 (cached, value);
+}
+
+gboolean
+mm_modem_info_cache_lookup (MMModemInfoCache *self,
+                            const gchar      *device,
+                            const gchar      *plugin,
+                            MmGdbusModem     *skeleton)
+{
+    GKeyFile         *key_file;
+    g_autofree gchar *group = NULL;
+    g_autofree gchar *device_identifier = NULL;
+    MMBearerIpFamily  ip_families;
+
+    if (!device || !plugin)
+        return FALSE;
+
+    key_file = peek_key_file (self);
+    group = build_group_name (device);
+    if (!g_key_file_has_group (key_file, group))
+        return FALSE;
+
+    if (!key_matches (key_file, group, MODEM_INFO_PLUGIN_KEY, plugin) ||
+        !optional_key_matches (key_file, group, MODEM_INFO_MANUFACTURER_KEY, mm_gdbus_modem_get_manufacturer (skeleton)) ||
+        !optional_key_matches (key_file, group, MODEM_INFO_MODEL_KEY, mm_gdbus_modem_get_model (skeleton)) ||
+        !key_matches (key_file, group, MODEM_INFO_REVISION_KEY, mm_gdbus_modem_get_revision (skeleton)) ||
+        !key_matches (key_file, group, MODEM_INFO_EQUIPMENT_IDENTIFIER_KEY, mm_gdbus_modem_get_equipment_identifier (skeleton))) {
+        mm_obj_dbg (self, "cached info for device %s is outdated", device);
+        return FALSE;
+    }
+
+    device_identifier = g_key_file_get_string (key_file, group, MODEM_INFO_DEVICE_IDENTIFIER_KEY, NULL);
+    if (device_identifier && !mm_gdbus_modem_get_device_identifier (skeleton))
+        mm_gdbus_modem_set_device_identifier (skeleton, device_identifier);
+
+    ip_families = (MMBearerIpFamily) g_key_file_get_uint64 (key_file, group, MODEM_INFO_SUPPORTED_IP_FAMILIES_KEY, NULL);
+    if (ip_families != MM_BEARER_IP_FAMILY_NONE &&
+        mm_gdbus_modem_get_supported_ip_families (skeleton) == MM_BEARER_IP_FAMILY_NONE)
+        mm_gdbus_modem_set_supported_ip_families (skeleton, ip_families);
+
+    mm_obj_dbg (self, "using cached info for device %s", device);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+static void
+set_string_if_known (GKeyFile    *key_file,
+                     const gchar *group,
+                     const gchar *key,
+                     const gchar *value)
+{
+    if (value)
+        g_key_file_set_string (key_file, group, key, value);
+}
+
+void
+mm_modem_info_cache_store (MMModemInfoCache *self,
+                           const gchar      *device,
+                           const gchar      *plugin,
+                           MmGdbusModem     *skeleton)
+{
+    GKeyFile         *key_file;
+    g_autofree gchar *group = NULL;
+    const gchar      *revision;
+    const gchar      *equipment_identifier;
+    g_auto(GStrv)     groups = NULL;
+    gsize             n_groups = 0;
+    gsize             i;
+
+    /* Without the values used to validate the entry, it would never be used */
+    revision = mm_gdbus_modem_get_revision (skeleton);
+    equipment_identifier = mm_gdbus_modem_get_equipment_identifier (skeleton);
+    if (!device || !plugin || !revision || !equipment_identifier)
+        return;
+
+    key_file = peek_key_file (self);
+    group = build_group_name (device);
+
+    /* Always rewrite the whole group, as it may have been added by a different
+     * modem; the group is also moved to the end of the file in this way. */
+    g_key_file_remove_group (key_file, group, NULL);
+
+    /* Drop the oldest devices */
+    groups = g_key_file_get_groups (key_file, &n_groups);
+    for (i = 0; i + MODEM_INFO_MAX_DEVICES <= n_groups; i++)
+        g_key_file_remove_group (key_file, groups[i], NULL);
+
+    g_key_file_set_string (key_file, group, MODEM_INFO_PLUGIN_KEY,               plugin);
+    g_key_file_set_string (key_file, group, MODEM_INFO_REVISION_KEY,             revision);
+    g_key_file_set_string (key_file, group, MODEM_INFO_EQUIPMENT_IDENTIFIER_KEY, equipment_identifier);
+    set_string_if_known (key_file, group, MODEM_INFO_MANUFACTURER_KEY,      mm_gdbus_modem_get_manufacturer (skeleton));
+    set_string_if_known (key_file, group, MODEM_INFO_MODEL_KEY,             mm_gdbus_modem_get_model (skeleton));
+    set_string_if_known (key_file, group, MODEM_INFO_DEVICE_IDENTIFIER_KEY, mm_gdbus_modem_get_device_identifier (skeleton));
+    g_key_file_set_uint64 (key_file, group, MODEM_INFO_SUPPORTED_IP_FAMILIES_KEY,
+                           mm_gdbus_modem_get_supported_ip_families (skeleton));
+
+    mm_obj_dbg (self, "storing info for device %s", device);
+    save_key_file (self);
+}
+
+void
+mm_modem_info_cache_remove (MMModemInfoCache *self,
+                            const gchar      *device)
+{
+    g_autofree gchar *group = NULL;
+
+    group = build_group_name (device);
+    if (g_key_file_remove_group (peek_key_file (self), group, NULL))
+        save_key_file (self);
+}
+
+/*****************************************************************************/
+
+MMModemInfoCache *
+mm_modem_info_cache_new_for_file (const gchar *file)
+{
+    MMModemInfoCache *self;
+
+    self = MM_MODEM_INFO_CACHE (g_object_new (MM_TYPE_MODEM_INFO_CACHE, NULL));
+    g_free (self->filename);
+    self->filename = g_strdup (file);
+    return self;
+}
+
+static void
+mm_modem_info_cache_init (MMModemInfoCache *self)
+{
+    self->filename = g_build_path (G_DIR_SEPARATOR_S, PKGSTATEDIR, MODEM_INFO_STATE_FILE, NULL);
+}
+
+static void
+finalize (GObject *object)
+{
+    MMModemInfoCache *self = MM_MODEM_INFO_CACHE (object);
+
+    g_clear_pointer (&self->key_file, g_key_file_unref);
+    g_free (self->filename);
+
+    G_OBJECT_CLASS (mm_modem_info_cache_parent_class)->finalize (object);
+}
+
+static void
+log_object_iface_init (MMLogObjectInterface *iface)
+{
+    iface->build_id = log_object_build_id;
+}
+
+static void
+mm_modem_info_cache_class_init (MMModemInfoCacheClass *klass)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+    object_class->finalize = finalize;
+}
+
+MM_DEFINE_SINGLETON_GETTER (MMModemInfoCache, mm_modem_info_cache_get, MM_TYPE_MODEM_INFO_CACHE);
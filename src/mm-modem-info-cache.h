@@ -0,0 +1,60 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#ifndef MM_MODEM_INFO_CACHE_H
+#define MM_MODEM_INFO_CACHE_H
+
+#include <glib.h>
+#include <glib-object.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#define MM_TYPE_MODEM_INFO_CACHE            (mm_modem_info_cache_get_type ())
+#define MM_MODEM_INFO_CACHE(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), MM_TYPE_MODEM_INFO_CACHE, MMModemInfoCache))
+#define MM_MODEM_INFO_CACHE_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST ((klass),  MM_TYPE_MODEM_INFO_CACHE, MMModemInfoCacheClass))
+#define MM_IS_MODEM_INFO_CACHE(obj)         (G_TYPE_CHECK_INSTANCE_TYPE ((obj), MM_TYPE_MODEM_INFO_CACHE))
+#define MM_IS_MODEM_INFO_CACHE_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE ((klass),  MM_TYPE_MODEM_INFO_CACHE))
+#define MM_MODEM_INFO_CACHE_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS ((obj),  MM_TYPE_MODEM_INFO_CACHE, MMModemInfoCacheClass))
+
+typedef struct _MMModemInfoCache MMModemInfoCache;
+typedef struct _MMModemInfoCacheClass MMModemInfoCacheClass;
+
+GType mm_modem_info_cache_get_type (void);
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMModemInfoCache, g_object_unref)
+
+/* Cache stored in the default state file */
+MMModemInfoCache *mm_modem_info_cache_get (void);
+
+/* Cache stored in a custom file, used in tests */
+MMModemInfoCache *mm_modem_info_cache_new_for_file (const gchar *file);
+
+/* Static modem information (device identifier and supported IP families) is
+ * cached per device UID and plugin, and it is only considered valid if the
+ * manufacturer, model, revision and equipment identifier already loaded in the
+ * skeleton match the cached ones. On a cache hit, the skeleton properties not
+ * loaded yet are filled in. */
+gboolean mm_modem_info_cache_lookup (MMModemInfoCache *self,
+                                     const gchar      *device,
+                                     const gchar      *plugin,
+                                     MmGdbusModem     *skeleton);
+void     mm_modem_info_cache_store  (MMModemInfoCache *self,
+                                     const gchar      *device,
+                                     const gchar      *plugin,
+                                     MmGdbusModem     *skeleton);
+void     mm_modem_info_cache_remove (MMModemInfoCache *self,
+                                     const gchar      *device);
+
+#endif /* MM_MODEM_INFO_CACHE_H */
@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include <linux/if_link.h>
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 #include <net/if.h>
@@ -42,6 +43,12 @@ struct _MMNetlink {
     /* Netlink state */
     guint       current_sequence_id;
     GHashTable *transactions;
+    /* Link stats monitoring */
+    GHashTable *link_stats_watches;
+    guint       link_stats_watch_next_id;
+    guint       link_stats_interval;
+    guint       link_stats_timeout_id;
+    gboolean    link_stats_ongoing;
 };
 
 struct _MMNetlinkClass {
@@ -168,6 +175,35 @@ netlink_message_new_getlink (guint ifindex)
     return netlink_message_new (ifindex, RTM_GETLINK);
 }
 
+typedef struct {
+    struct nlmsghdr      msghdr;
+    struct if_stats_msg  statsreq;
+} NetlinkStatsHeader;
+
+static NetlinkMessage *
+netlink_message_new_getstats_dump (void)
+{
+    NetlinkMessage     *msg;
+    NetlinkStatsHeader *hdr;
+
+    int size = sizeof (NetlinkStatsHeader);
+
+    msg = g_byte_array_new ();
+    g_byte_array_set_size (msg, size);
+    memset ((char *) msg->data, 0, size);
+
+    /* Request the 64bit link stats of all interfaces in a single dump, so
+     * that we don't get any other link attribute we don't care about */
+    hdr = (NetlinkStatsHeader *) (msg->data);
+    hdr->msghdr.nlmsg_len = msg->len;
+    hdr->msghdr.nlmsg_type = RTM_GETSTATS;
+    hdr->msghdr.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    hdr->statsreq.family = AF_UNSPEC;
+    hdr->statsreq.filter_mask = IFLA_STATS_FILTER_BIT (IFLA_STATS_LINK_64);
+
+    return msg;
+}
+
 static void
 netlink_message_free (NetlinkMessage *msg)
 {
@@ -185,6 +221,8 @@ typedef struct {
     GSource   *timeout_source;
     GTask     *completion_task;
     MsgFunc    completion_fn;
+    /* Only in multipart (dump) transactions */
+    MsgFunc    part_fn;
 } Transaction;
 
 static gboolean
@@ -260,11 +298,12 @@ transaction_free (Transaction *tr)
 }
 
 static Transaction *
-transaction_new (MMNetlink      *self,
-                 NetlinkMessage *msg,
-                 guint           timeout,
-                 GTask          *task,
-                 MsgFunc         completion_fn)
+transaction_new_multipart (MMNetlink      *self,
+                           NetlinkMessage *msg,
+                           guint           timeout,
+                           GTask          *task,
+                           MsgFunc         part_fn,
+                           MsgFunc         completion_fn)
 {
     Transaction *tr;
 
@@ -283,6 +322,7 @@ transaction_new (MMNetlink      *self,
     }
     tr->completion_task = g_object_ref (task);
     tr->completion_fn = completion_fn;
+    tr->part_fn = part_fn;
 
     g_hash_table_insert (self->transactions,
                          GUINT_TO_POINTER (tr->sequence_id),
@@ -290,6 +330,16 @@ transaction_new (MMNetlink      *self,
     return tr;
 }
 
+static Transaction *
+transaction_new (MMNetlink      *self,
+                 NetlinkMessage *msg,
+                 guint           timeout,
+                 GTask          *task,
+                 MsgFunc         completion_fn)
+{
+    return transaction_new_multipart (self, msg, timeout, task, NULL, completion_fn);
+}
+
 /*****************************************************************************/
 
 gboolean
@@ -455,6 +505,282 @@ mm_netlink_get_hwaddr (MMNetlink           *self,
 
 /*****************************************************************************/
 
+GHashTable *
+mm_netlink_get_link_stats_finish (MMNetlink     *self,
+                                  GAsyncResult  *res,
+                                  GError       **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static gboolean
+get_link_stats_part (GTask *task, struct nlmsghdr *hdr, GError **error)
+{
+    GHashTable                     *link_stats;
+    const struct if_stats_msg      *ifsm;
+    const struct rtnl_link_stats64 *kstats;
+    MMNetlinkLinkStats             *stats;
+    struct rtattr                  *rta;
+    int                             attr_len;
+
+    if (hdr->nlmsg_type != RTM_NEWSTATS) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "unexpected GETSTATS reply message type %d",
+                     hdr->nlmsg_type);
+        return FALSE;
+    }
+
+    ifsm = NLMSG_DATA (hdr);
+    if (ifsm->ifindex <= 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "unexpected link index %u",
+                     ifsm->ifindex);
+        return FALSE;
+    }
+
+    attr_len = hdr->nlmsg_len - NLMSG_LENGTH (sizeof (struct if_stats_msg));
+    rta = (struct rtattr *) ((gchar *) ifsm + NLMSG_ALIGN (sizeof (struct if_stats_msg)));
+    for (; RTA_OK (rta, attr_len); rta = RTA_NEXT (rta, attr_len)) {
+        if (rta->rta_type != IFLA_STATS_LINK_64)
+            continue;
+
+        if (RTA_PAYLOAD (rta) < sizeof (struct rtnl_link_stats64)) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "invalid link stats length %u",
+                         (guint) RTA_PAYLOAD (rta));
+            return FALSE;
+        }
+
+        kstats = RTA_DATA (rta);
+        stats = g_slice_new0 (MMNetlinkLinkStats);
+        stats->rx_packets = kstats->rx_packets;
+        stats->tx_packets = kstats->tx_packets;
+        stats->rx_bytes   = kstats->rx_bytes;
+        stats->tx_bytes   = kstats->tx_bytes;
+        stats->rx_errors  = kstats->rx_errors;
+        stats->tx_errors  = kstats->tx_errors;
+        stats->rx_dropped = kstats->rx_dropped;
+        stats->tx_dropped = kstats->tx_dropped;
+
+        link_stats = g_task_get_task_data (task);
+        g_hash_table_insert (link_stats, GUINT_TO_POINTER (ifsm->ifindex), stats);
+        return TRUE;
+    }
+
+    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                 "no link stats found for link index %u",
+                 ifsm->ifindex);
+    return FALSE;
+}
+
+static gboolean
+get_link_stats_complete (GTask *task, struct nlmsghdr *hdr, GError **error)
+{
+    GHashTable *link_stats;
+
+    link_stats = g_task_get_task_data (task);
+    g_task_return_pointer (task, g_hash_table_ref (link_stats), (GDestroyNotify) g_hash_table_unref);
+    return TRUE;
+}
+
+static void
+link_stats_free (MMNetlinkLinkStats *stats)
+{
+    g_slice_free (MMNetlinkLinkStats, stats);
+}
+
+void
+mm_netlink_get_link_stats (MMNetlink           *self,
+                           GCancellable        *cancellable,
+                           GAsyncReadyCallback  callback,
+                           gpointer             user_data)
+{
+    GTask          *task;
+    NetlinkMessage *msg;
+    Transaction    *tr;
+    gssize          bytes_sent;
+    GError         *error = NULL;
+
+    task = g_task_new (self, cancellable, callback, user_data);
+
+    if (!self->socket) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                 "netlink support not available");
+        g_object_unref (task);
+        return;
+    }
+
+    g_task_set_task_data (task,
+                          g_hash_table_new_full (g_direct_hash,
+                                                 g_direct_equal,
+                                                 NULL,
+                                                 (GDestroyNotify) link_stats_free),
+                          (GDestroyNotify) g_hash_table_unref);
+
+    msg = netlink_message_new_getstats_dump ();
+
+    /* The task ownership is transferred to the transaction. */
+    tr = transaction_new_multipart (self, msg, 5, task, get_link_stats_part, get_link_stats_complete);
+
+    bytes_sent = g_socket_send (self->socket,
+                                (const gchar *) msg->data,
+                                msg->len,
+                                cancellable,
+                                &error);
+    netlink_message_free (msg);
+
+    if (bytes_sent < 0)
+        transaction_complete_with_error (tr, error);
+
+    g_object_unref (task);
+}
+
+/*****************************************************************************/
+/* Link stats monitoring
+ *
+ * All watched links are refreshed with one single stats dump request, so
+ * that the cost of the periodic poll does not depend on how many bearers
+ * are connected at the same time.
+ */
+
+typedef struct {
+    guint                  ifindex;
+    guint                  interval;
+    MMNetlinkLinkStatsFunc callback;
+    gpointer               user_data;
+} LinkStatsWatch;
+
+static void
+link_stats_watch_free (LinkStatsWatch *watch)
+{
+    g_slice_free (LinkStatsWatch, watch);
+}
+
+static void link_stats_schedule (MMNetlink *self);
+
+static void
+link_stats_ready (MMNetlink    *self,
+                  GAsyncResult *res)
+{
+    g_autoptr(GHashTable) link_stats = NULL;
+    g_autoptr(GError)     error = NULL;
+    g_autoptr(GList)      watch_ids = NULL;
+    GList                *l;
+
+    self->link_stats_ongoing = FALSE;
+
+    link_stats = mm_netlink_get_link_stats_finish (self, res, &error);
+    if (!link_stats) {
+        mm_obj_dbg (self, "couldn't load link stats: %s", error->message);
+        return;
+    }
+
+    /* Iterate over the watch ids, as callbacks may remove watches */
+    watch_ids = g_hash_table_get_keys (self->link_stats_watches);
+    for (l = watch_ids; l; l = g_list_next (l)) {
+        LinkStatsWatch           *watch;
+        const MMNetlinkLinkStats *stats;
+
+        watch = g_hash_table_lookup (self->link_stats_watches, l->data);
+        if (!watch)
+            continue;
+
+        stats = g_hash_table_lookup (link_stats, GUINT_TO_POINTER (watch->ifindex));
+        if (stats)
+            watch->callback (self, watch->ifindex, stats, watch->user_data);
+    }
+}
+
+static gboolean
+link_stats_timeout_cb (MMNetlink *self)
+{
+    /* Don't stack up requests if the previous one is still ongoing */
+    if (!self->link_stats_ongoing) {
+        self->link_stats_ongoing = TRUE;
+        mm_netlink_get_link_stats (self,
+                                   NULL,
+                                   (GAsyncReadyCallback) link_stats_ready,
+                                   NULL);
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+link_stats_schedule (MMNetlink *self)
+{
+    GHashTableIter  iter;
+    LinkStatsWatch *watch;
+    guint           interval = 0;
+
+    /* The shared poll runs at the fastest rate requested */
+    g_hash_table_iter_init (&iter, self->link_stats_watches);
+    while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &watch)) {
+        if (!interval || watch->interval < interval)
+            interval = watch->interval;
+    }
+
+    if (interval == self->link_stats_interval)
+        return;
+
+    if (self->link_stats_timeout_id) {
+        g_source_remove (self->link_stats_timeout_id);
+        self->link_stats_timeout_id = 0;
+    }
+
+    self->link_stats_interval = interval;
+    if (!interval)
+        return;
+
+    mm_obj_dbg (self, "link stats monitoring every %ums", interval);
+    self->link_stats_timeout_id = g_timeout_add (interval,
+                                                 (GSourceFunc) link_stats_timeout_cb,
+                                                 self);
+}
+
+guint
+mm_netlink_link_stats_watch_add (MMNetlink              *self,
+                                 guint                   ifindex,
+                                 guint                   interval,
+                                 MMNetlinkLinkStatsFunc  callback,
+                                 gpointer                user_data)
+{
+    LinkStatsWatch *watch;
+    guint           id;
+
+    g_return_val_if_fail (ifindex > 0, 0);
+    g_return_val_if_fail (interval > 0, 0);
+    g_return_val_if_fail (callback != NULL, 0);
+
+    if (!self->socket)
+        return 0;
+
+    watch = g_slice_new0 (LinkStatsWatch);
+    watch->ifindex = ifindex;
+    watch->interval = interval;
+    watch->callback = callback;
+    watch->user_data = user_data;
+
+    id = ++self->link_stats_watch_next_id;
+    if (G_UNLIKELY (!id))
+        id = ++self->link_stats_watch_next_id;
+    g_hash_table_insert (self->link_stats_watches, GUINT_TO_POINTER (id), watch);
+
+    link_stats_schedule (self);
+    return id;
+}
+
+void
+mm_netlink_link_stats_watch_remove (MMNetlink *self,
+                                    guint      id)
+{
+    if (!g_hash_table_remove (self->link_stats_watches, GUINT_TO_POINTER (id)))
+        return;
+
+    link_stats_schedule (self);
+}
+
+/*****************************************************************************/
+
 static gboolean
 netlink_messages_cb (GSocket      *socket,
                      GIOCondition  condition,
@@ -464,7 +790,7 @@ netlink_messages_cb (GSocket      *socket,
     GInputVector        iv;
     GSocketAddress     *addr = NULL;
     struct sockaddr_nl  source_sockaddr;
-    gchar               buf[2048];
+    gchar               buf[8192];
     gssize              bytes_received;
     guint               buffer_len;
     struct nlmsghdr    *hdr;
@@ -510,7 +836,7 @@ netlink_messages_cb (GSocket      *socket,
 
     buffer_len = (guint) bytes_received;
     for (hdr = (struct nlmsghdr *) buf; NLMSG_OK (hdr, buffer_len);
-         NLMSG_NEXT (hdr, buffer_len)) {
+         hdr = NLMSG_NEXT (hdr, buffer_len)) {
         Transaction     *tr;
         struct nlmsgerr *err;
         gint             nlerr = 0;
@@ -522,10 +848,21 @@ netlink_messages_cb (GSocket      *socket,
 
         switch (hdr->nlmsg_type) {
         case NLMSG_ERROR:
-            err = NLMSG_DATA (buf);
+            err = NLMSG_DATA (hdr);
             nlerr = err->error;
             break;
         case RTM_NEWLINK:
+        case RTM_NEWSTATS:
+            /* In multipart transactions, each message is processed
+             * separately and the transaction is completed on DONE */
+            if (tr->part_fn) {
+                g_autoptr(GError) inner_error = NULL;
+
+                if (!tr->part_fn (tr->completion_task, hdr, &inner_error))
+                    mm_obj_dbg (self, "ignored multipart message: %s", inner_error->message);
+                continue;
+            }
+            break;
         case NLMSG_DONE:
             break;
         default:
@@ -591,6 +928,11 @@ mm_netlink_init (MMNetlink *self)
 {
     g_autoptr(GError) error = NULL;
 
+    self->link_stats_watches = g_hash_table_new_full (g_direct_hash,
+                                                      g_direct_equal,
+                                                      NULL,
+                                                      (GDestroyNotify) link_stats_watch_free);
+
     if (!setup_netlink_socket (self, &error)) {
         mm_obj_warn (self, "couldn't setup netlink socket: %s", error->message);
         return;
@@ -608,7 +950,13 @@ dispose (GObject *object)
 {
     MMNetlink *self = MM_NETLINK (object);
 
-    g_assert (g_hash_table_size (self->transactions) == 0);
+    if (self->link_stats_timeout_id) {
+        g_source_remove (self->link_stats_timeout_id);
+        self->link_stats_timeout_id = 0;
+    }
+    g_clear_pointer (&self->link_stats_watches, g_hash_table_unref);
+
+    g_assert (!self->transactions || g_hash_table_size (self->transactions) == 0);
 
     g_clear_pointer (&self->transactions, g_hash_table_unref);
     if (self->source)
@@ -58,6 +58,42 @@ GByteArray *mm_netlink_get_hwaddr_finish (MMNetlink            *self,
                                           GAsyncResult         *res,
                                           GError              **error);
 
+typedef struct {
+    guint64 rx_packets;
+    guint64 tx_packets;
+    guint64 rx_bytes;
+    guint64 tx_bytes;
+    guint64 rx_errors;
+    guint64 tx_errors;
+    guint64 rx_dropped;
+    guint64 tx_dropped;
+} MMNetlinkLinkStats;
+
+/* Returns a hash table with ifindex as key and MMNetlinkLinkStats as value,
+ * covering all the links known by the kernel */
+void        mm_netlink_get_link_stats        (MMNetlink           *self,
+                                              GCancellable        *cancellable,
+                                              GAsyncReadyCallback  callback,
+                                              gpointer             user_data);
+GHashTable *mm_netlink_get_link_stats_finish (MMNetlink            *self,
+                                              GAsyncResult         *res,
+                                              GError              **error);
+
+/* Periodic link stats monitoring; all watches are served by one single
+ * stats dump request, run at the shortest interval (in ms) requested. */
+typedef void (* MMNetlinkLinkStatsFunc) (MMNetlink                *self,
+                                         guint                     ifindex,
+                                         const MMNetlinkLinkStats *stats,
+                                         gpointer                  user_data);
+
+guint mm_netlink_link_stats_watch_add    (MMNetlink              *self,
+                                          guint                   ifindex,
+                                          guint                   interval,
+                                          MMNetlinkLinkStatsFunc  callback,
+                                          gpointer                user_data);
+void  mm_netlink_link_stats_watch_remove (MMNetlink              *self,
+                                          guint                   id);
+
 G_END_DECLS
 
 #endif  /* MM_MODEM_HELPERS_NETLINK_H */
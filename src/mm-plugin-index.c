@@ -0,0 +1,270 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+#include <string.h>
+
+#include "mm-plugin-index.h"
+
+/* Filters restricting each plugin */
+typedef enum {
+    FILTER_NONE      = 0,
+    FILTER_SUBSYSTEM = 1 << 0,
+    FILTER_DRIVER    = 1 << 1,
+    FILTER_ID        = 1 << 2,
+    FILTER_UDEV_TAG  = 1 << 3,
+} Filter;
+
+#define PRODUCT_KEY(vendor, product) GUINT_TO_POINTER (((guint) (vendor) << 16) | (product))
+
+struct _MMPluginIndex {
+    /* Filters applying to each plugin, by position */
+    GArray     *filters;
+    /* Filters matched by each plugin in the current lookup */
+    GArray     *matched;
+
+    /* key -> GArray of plugin positions */
+    GHashTable *subsystems;
+    GHashTable *drivers;
+    GHashTable *vendor_ids;
+    GHashTable *product_ids;
+    GHashTable *udev_tags;
+};
+
+static void
+index_insert (GHashTable    *table,
+              gconstpointer  key,
+              guint          position)
+{
+    GArray *positions;
+
+    positions = g_hash_table_lookup (table, key);
+    if (!positions) {
+        positions = g_array_new (FALSE, FALSE, sizeof (guint));
+        g_hash_table_insert (table, (gpointer) key, positions);
+    }
+
+    /* Avoid duplicates if the same value is listed twice */
+    if (positions->len && g_array_index (positions, guint, positions->len - 1) == position)
+        return;
+    g_array_append_val (positions, position);
+}
+
+static void
+index_insert_strv (GHashTable          *table,
+                   const gchar * const *strv,
+                   guint                position)
+{
+    guint i;
+
+    for (i = 0; strv[i]; i++) {
+        gpointer key;
+
+        /* Keys are owned by the table */
+        if (!g_hash_table_lookup_extended (table, strv[i], &key, NULL))
+            key = g_strdup (strv[i]);
+        index_insert (table, key, position);
+    }
+}
+
+static void
+index_match (MMPluginIndex *self,
+             GHashTable    *table,
+             gconstpointer  key,
+             Filter         filter)
+{
+    GArray *positions;
+    guint   i;
+
+    positions = g_hash_table_lookup (table, key);
+    if (!positions)
+        return;
+
+    for (i = 0; i < positions->len; i++)
+        g_array_index (self->matched, guint8, g_array_index (positions, guint, i)) |= filter;
+}
+
+/*****************************************************************************/
+
+guint
+mm_plugin_index_add (MMPluginIndex              *self,
+                     const MMPluginIndexFilters *filters)
+{
+    guint8 filter = FILTER_NONE;
+    guint8 matched = FILTER_NONE;
+    guint  position;
+    guint  i;
+
+    position = self->filters->len;
+
+    if (filters->subsystems) {
+        filter |= FILTER_SUBSYSTEM;
+        index_insert_strv (self->subsystems, filters->subsystems, position);
+    }
+    if (filters->drivers) {
+        filter |= FILTER_DRIVER;
+        index_insert_strv (self->drivers, filters->drivers, position);
+    }
+    if (filters->vendor_ids || filters->product_ids) {
+        filter |= FILTER_ID;
+        for (i = 0; filters->vendor_ids && filters->vendor_ids[i]; i++)
+            index_insert (self->vendor_ids, GUINT_TO_POINTER (filters->vendor_ids[i]), position);
+        for (i = 0; filters->product_ids && filters->product_ids[i].l; i++)
+            index_insert (self->product_ids,
+                          PRODUCT_KEY (filters->product_ids[i].l, filters->product_ids[i].r),
+                          position);
+        for (i = 0; filters->subsystem_vendor_ids && filters->subsystem_vendor_ids[i].l; i++)
+            index_insert (self->vendor_ids, GUINT_TO_POINTER (filters->subsystem_vendor_ids[i].l), position);
+    }
+    if (filters->udev_tags) {
+        filter |= FILTER_UDEV_TAG;
+        index_insert_strv (self->udev_tags, filters->udev_tags, position);
+    }
+
+    g_array_append_val (self->filters, filter);
+    g_array_append_val (self->matched, matched);
+    return position;
+}
+
+guint
+mm_plugin_index_lookup (MMPluginIndex            *self,
+                        const MMPluginIndexQuery *query,
+                        gboolean                 *candidates)
+{
+    GHashTableIter iter;
+    gpointer       key;
+    guint          n_candidates = 0;
+    guint          i;
+
+    memset (self->matched->data, 0, self->matched->len);
+
+    if (query->subsystem)
+        index_match (self, self->subsystems, query->subsystem, FILTER_SUBSYSTEM);
+    for (i = 0; query->drivers && query->drivers[i]; i++)
+        index_match (self, self->drivers, query->drivers[i], FILTER_DRIVER);
+    if (query->vendor) {
+        index_match (self, self->vendor_ids, GUINT_TO_POINTER (query->vendor), FILTER_ID);
+        if (query->product)
+            index_match (self, self->product_ids, PRODUCT_KEY (query->vendor, query->product), FILTER_ID);
+    }
+    /* Each udev tag requested by any plugin is checked once */
+    if (query->has_tag) {
+        g_hash_table_iter_init (&iter, self->udev_tags);
+        while (g_hash_table_iter_next (&iter, &key, NULL)) {
+            if (query->has_tag ((const gchar *) key, query->has_tag_user_data))
+                index_match (self, self->udev_tags, key, FILTER_UDEV_TAG);
+        }
+    }
+
+    for (i = 0; i < self->filters->len; i++) {
+        guint8 filter;
+
+        filter = g_array_index (self->filters, guint8, i);
+        candidates[i] = ((g_array_index (self->matched, guint8, i) & filter) == filter);
+        if (candidates[i])
+            n_candidates++;
+    }
+
+    return n_candidates;
+}
+
+/*****************************************************************************/
+
+static gboolean
+strv_contains (const gchar * const *strv,
+               const gchar         *str)
+{
+    return (str && g_strv_contains (strv, str));
+}
+
+gboolean
+mm_plugin_index_filters_match (const MMPluginIndexFilters *filters,
+                               const MMPluginIndexQuery   *query)
+{
+    guint i;
+
+    if (filters->subsystems && !strv_contains (filters->subsystems, query->subsystem))
+        return FALSE;
+
+    if (filters->drivers) {
+        gboolean found = FALSE;
+
+        for (i = 0; query->drivers && query->drivers[i] && !found; i++)
+            found = g_strv_contains (filters->drivers, query->drivers[i]);
+        if (!found)
+            return FALSE;
+    }
+
+    if (filters->vendor_ids || filters->product_ids) {
+        gboolean found = FALSE;
+
+        for (i = 0; query->vendor && filters->vendor_ids && filters->vendor_ids[i] && !found; i++)
+            found = (filters->vendor_ids[i] == query->vendor);
+        for (i = 0; query->vendor && query->product && filters->product_ids && filters->product_ids[i].l && !found; i++)
+            found = (filters->product_ids[i].l == query->vendor && filters->product_ids[i].r == query->product);
+        for (i = 0; query->vendor && filters->subsystem_vendor_ids && filters->subsystem_vendor_ids[i].l && !found; i++)
+            found = (filters->subsystem_vendor_ids[i].l == query->vendor);
+        if (!found)
+            return FALSE;
+    }
+
+    if (filters->udev_tags) {
+        gboolean found = FALSE;
+
+        for (i = 0; query->has_tag && filters->udev_tags[i] && !found; i++)
+            found = query->has_tag (filters->udev_tags[i], query->has_tag_user_data);
+        if (!found)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+guint
+mm_plugin_index_get_n_plugins (MMPluginIndex *self)
+{
+    return self->filters->len;
+}
+
+MMPluginIndex *
+mm_plugin_index_new (void)
+{
+    MMPluginIndex *self;
+
+    self = g_slice_new0 (MMPluginIndex);
+    self->filters = g_array_new (FALSE, FALSE, sizeof (guint8));
+    self->matched = g_array_new (FALSE, FALSE, sizeof (guint8));
+    self->subsystems = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_array_unref);
+    self->drivers = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_array_unref);
+    self->vendor_ids = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_array_unref);
+    self->product_ids = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_array_unref);
+    self->udev_tags = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_array_unref);
+    return self;
+}
+
+void
+mm_plugin_index_free (MMPluginIndex *self)
+{
+    g_array_unref (self->filters);
+    g_array_unref (self->matched);
+    g_hash_table_unref (self->subsystems);
+    g_hash_table_unref (self->drivers);
+    g_hash_table_unref (self->vendor_ids);
+    g_hash_table_unref (self->product_ids);
+    g_hash_table_unref (self->udev_tags);
+    g_slice_free (MMPluginIndex, self);
+}
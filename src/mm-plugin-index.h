@@ -0,0 +1,82 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#ifndef MM_PLUGIN_INDEX_H
+#define MM_PLUGIN_INDEX_H
+
+#include <glib.h>
+
+#include "mm-private-boxed-types.h"
+
+/* Index of the plugin pre-probing filters, used to preselect which plugins
+ * may support a given port without running the filters of every plugin.
+ *
+ * Each plugin is registered with the filters that fully discard a port when
+ * they don't match: allowed subsystems, drivers, vendor and product IDs and
+ * udev tags. A NULL filter doesn't restrict anything. The lookup returns the
+ * plugins matching all their filters, which is a superset of the plugins
+ * accepting the port after running all pre-probing filters, as the index
+ * ignores the filters that only discard ports (e.g. forbidden drivers). */
+
+typedef struct {
+    const gchar * const  *subsystems;
+    const gchar * const  *drivers;
+    /* 0-terminated */
+    const guint16        *vendor_ids;
+    /* {0,0}-terminated */
+    const mm_uint16_pair *product_ids;
+    /* {0,0}-terminated; only the vendor ID is indexed, and only if vendor or
+     * product IDs are also given */
+    const mm_uint16_pair *subsystem_vendor_ids;
+    const gchar * const  *udev_tags;
+} MMPluginIndexFilters;
+
+typedef gboolean (* MMPluginIndexHasTagFn) (const gchar *tag,
+                                            gpointer     user_data);
+
+typedef struct {
+    const gchar          *subsystem;
+    const gchar * const  *drivers;
+    guint16               vendor;
+    guint16               product;
+    MMPluginIndexHasTagFn has_tag;
+    gpointer              has_tag_user_data;
+} MMPluginIndexQuery;
+
+typedef struct _MMPluginIndex MMPluginIndex;
+
+MMPluginIndex *mm_plugin_index_new           (void);
+void           mm_plugin_index_free          (MMPluginIndex *self);
+guint          mm_plugin_index_get_n_plugins (MMPluginIndex *self);
+
+/* Returns the position of the plugin in the index, which is the order in
+ * which plugins were added */
+guint          mm_plugin_index_add           (MMPluginIndex              *self,
+                                              const MMPluginIndexFilters *filters);
+
+/* Sets in candidates, which must have room for as many items as plugins
+ * in the index, whether each plugin may support the port; returns the number
+ * of candidates found */
+guint          mm_plugin_index_lookup        (MMPluginIndex            *self,
+                                              const MMPluginIndexQuery *query,
+                                              gboolean                 *candidates);
+
+/* Runs the same checks as the index for a single plugin; used as reference */
+gboolean       mm_plugin_index_filters_match (const MMPluginIndexFilters *filters,
+                                              const MMPluginIndexQuery   *query);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMPluginIndex, mm_plugin_index_free)
+
+#endif /* MM_PLUGIN_INDEX_H */
@@ -29,6 +29,8 @@
 
 #include "mm-plugin-manager.h"
 #include "mm-plugin.h"
+#include "mm-plugin-manifest.h"
+#include "mm-context.h"
 #include "mm-shared.h"
 #include "mm-utils.h"
 #include "mm-log-object.h"
@@ -65,10 +67,13 @@ struct _MMPluginManagerPrivate {
     /* Device filter */
     MMFilter *filter;
 
-    /* This list contains all plugins except for the generic one, order is not
-     * important. It is loaded once when the program starts, and the list is NOT
-     * expected to change after that.*/
-    GList *plugins;
+    /* This array contains all plugins except for the generic one, order is not
+     * important. It is built once when the program starts, and the array is NOT
+     * expected to change after that. Plugins found in the manifest are only
+     * loaded once a port may be supported by them. */
+    GArray *plugins;
+    /* Pre-probing filters of the plugins in the array, in the same order */
+    MMPluginIndex *index;
     /* Last, the generic plugin. */
     MMPlugin *generic;
 
@@ -79,6 +84,66 @@ struct _MMPluginManagerPrivate {
     gchar **subsystems;
 };
 
+/*****************************************************************************/
+/* Plugins, loaded or not */
+
+typedef struct {
+    /* The plugin, NULL until loaded if deferred */
+    MMPlugin *plugin;
+    /* File name of the plugin module, NULL for builtin plugins */
+    gchar    *module;
+    /* Name given in the manifest, for deferred plugins */
+    gchar    *name;
+    /* Whether loading a deferred plugin was already tried */
+    gboolean  load_tried;
+} PluginSlot;
+
+static void
+plugin_slot_clear (PluginSlot *slot)
+{
+    g_clear_object (&slot->plugin);
+    g_clear_pointer (&slot->module, g_free);
+    g_clear_pointer (&slot->name, g_free);
+}
+
+static const gchar *
+plugin_slot_get_name (PluginSlot *slot)
+{
+    return slot->plugin ? mm_plugin_get_name (slot->plugin) : slot->name;
+}
+
+#if !defined WITH_BUILTIN_PLUGINS
+static MMPlugin *load_external_plugin (MMPluginManager *self,
+                                       const gchar     *path);
+#endif
+
+static MMPlugin *
+plugin_manager_peek_plugin_at (MMPluginManager *self,
+                               guint            i)
+{
+    PluginSlot *slot;
+
+    slot = &g_array_index (self->priv->plugins, PluginSlot, i);
+
+#if !defined WITH_BUILTIN_PLUGINS
+    if (!slot->plugin && !slot->load_tried) {
+        g_autofree gchar *path = NULL;
+
+        /* Don't retry if loading fails */
+        slot->load_tried = TRUE;
+        path = g_build_filename (self->priv->plugin_dir, slot->module, NULL);
+        slot->plugin = load_external_plugin (self, path);
+        if (slot->plugin && !g_str_equal (mm_plugin_get_name (slot->plugin), slot->name)) {
+            mm_obj_warn (self, "ignored plugin '%s': listed as '%s' in the manifest",
+                         mm_plugin_get_name (slot->plugin), slot->name);
+            g_clear_object (&slot->plugin);
+        }
+    }
+#endif
+
+    return slot->plugin;
+}
+
 /*****************************************************************************/
 /* Build plugin list for a single port */
 
@@ -88,24 +153,46 @@ plugin_manager_build_plugins_list (MMPluginManager *self,
                                    MMKernelDevice  *port)
 {
     GList *list = NULL;
-    GList *l;
     gboolean supported_found = FALSE;
+    MMPluginIndexQuery query;
+    gboolean *candidates;
+    guint n_candidates;
+    guint i;
+
+    /* Preselect the plugins whose subsystem, driver, vendor/product ID and
+     * udev tag filters match the port, so that the full set of pre-probing
+     * filters only runs for those */
+    candidates = g_newa (gboolean, mm_plugin_index_get_n_plugins (self->priv->index));
+    mm_plugin_build_index_query (device, port, &query);
+    n_candidates = mm_plugin_index_lookup (self->priv->index, &query, candidates);
+    mm_obj_dbg (self, "preselected %u/%u plugins for port %s",
+                n_candidates, mm_plugin_index_get_n_plugins (self->priv->index),
+                mm_kernel_device_get_name (port));
+
+    for (i = 0; i < self->priv->plugins->len && !supported_found; i++) {
+        MMPlugin             *plugin;
+        MMPluginSupportsHint  hint;
+
+        if (!candidates[i])
+            continue;
 
-    for (l = self->priv->plugins; l && !supported_found; l = g_list_next (l)) {
-        MMPluginSupportsHint hint;
+        /* Deferred plugins are loaded here, the first time they're needed */
+        plugin = plugin_manager_peek_plugin_at (self, i);
+        if (!plugin)
+            continue;
 
-        hint = mm_plugin_discard_port_early (MM_PLUGIN (l->data), device, port);
+        hint = mm_plugin_discard_port_early (plugin, device, port);
         switch (hint) {
         case MM_PLUGIN_SUPPORTS_HINT_UNSUPPORTED:
             /* Fully discard */
             break;
         case MM_PLUGIN_SUPPORTS_HINT_MAYBE:
             /* Maybe supported, add to tail of list */
-            list = g_list_append (list, g_object_ref (l->data));
+            list = g_list_append (list, g_object_ref (plugin));
             break;
         case MM_PLUGIN_SUPPORTS_HINT_LIKELY:
             /* Likely supported, add to head of list */
-            list = g_list_prepend (list, g_object_ref (l->data));
+            list = g_list_prepend (list, g_object_ref (plugin));
             break;
         case MM_PLUGIN_SUPPORTS_HINT_SUPPORTED:
             /* Really supported, clean existing list and add it alone */
@@ -113,7 +200,7 @@ plugin_manager_build_plugins_list (MMPluginManager *self,
                 g_list_free_full (list, g_object_unref);
                 list = NULL;
             }
-            list = g_list_prepend (list, g_object_ref (l->data));
+            list = g_list_prepend (list, g_object_ref (plugin));
             /* This will end the loop as well */
             supported_found = TRUE;
             break;
@@ -1640,16 +1727,14 @@ MMPlugin *
 mm_plugin_manager_peek_plugin (MMPluginManager *self,
                                const gchar *plugin_name)
 {
-    GList *l;
+    guint i;
 
     if (self->priv->generic && g_str_equal (plugin_name, mm_plugin_get_name (self->priv->generic)))
         return self->priv->generic;
 
-    for (l = self->priv->plugins; l; l = g_list_next (l)) {
-        MMPlugin *plugin = MM_PLUGIN (l->data);
-
-        if (g_str_equal (plugin_name, mm_plugin_get_name (plugin)))
-            return plugin;
+    for (i = 0; i < self->priv->plugins->len; i++) {
+        if (g_str_equal (plugin_name, plugin_slot_get_name (&g_array_index (self->priv->plugins, PluginSlot, i))))
+            return plugin_manager_peek_plugin_at (self, i);
     }
 
     return NULL;
@@ -1666,77 +1751,89 @@ mm_plugin_manager_get_subsystems (MMPluginManager *self)
 /*****************************************************************************/
 
 static void
-register_plugin_allowlist_tags (MMPluginManager *self,
-                                MMPlugin        *plugin)
+register_plugin_allowlist_tags (MMPluginManager            *self,
+                                const MMPluginIndexFilters *allowed)
 {
-    const gchar **tags;
-    guint         i;
+    guint i;
 
     if (!mm_filter_check_rule_enabled (self->priv->filter, MM_FILTER_RULE_PLUGIN_ALLOWLIST))
         return;
 
-    tags = mm_plugin_get_allowed_udev_tags (plugin);
-    for (i = 0; tags && tags[i]; i++)
-        mm_filter_register_plugin_allowlist_tag (self->priv->filter, tags[i]);
+    for (i = 0; allowed->udev_tags && allowed->udev_tags[i]; i++)
+        mm_filter_register_plugin_allowlist_tag (self->priv->filter, allowed->udev_tags[i]);
 }
 
 static void
-register_plugin_allowlist_vendor_ids (MMPluginManager *self,
-                                       MMPlugin        *plugin)
+register_plugin_allowlist_vendor_ids (MMPluginManager            *self,
+                                      const MMPluginIndexFilters *allowed)
 {
-    const guint16 *vendor_ids;
-    guint          i;
+    guint i;
 
     if (!mm_filter_check_rule_enabled (self->priv->filter, MM_FILTER_RULE_PLUGIN_ALLOWLIST))
         return;
 
-    vendor_ids = mm_plugin_get_allowed_vendor_ids (plugin);
-    for (i = 0; vendor_ids && vendor_ids[i]; i++)
-        mm_filter_register_plugin_allowlist_vendor_id (self->priv->filter, vendor_ids[i]);
+    for (i = 0; allowed->vendor_ids && allowed->vendor_ids[i]; i++)
+        mm_filter_register_plugin_allowlist_vendor_id (self->priv->filter, allowed->vendor_ids[i]);
 }
 
 static void
-register_plugin_allowlist_product_ids (MMPluginManager *self,
-                                       MMPlugin        *plugin)
+register_plugin_allowlist_product_ids (MMPluginManager            *self,
+                                       const MMPluginIndexFilters *allowed)
 {
-    const mm_uint16_pair *product_ids;
-    guint                 i;
+    guint i;
 
     if (!mm_filter_check_rule_enabled (self->priv->filter, MM_FILTER_RULE_PLUGIN_ALLOWLIST))
         return;
 
-    product_ids = mm_plugin_get_allowed_product_ids (plugin);
-    for (i = 0; product_ids && product_ids[i].l; i++)
-        mm_filter_register_plugin_allowlist_product_id (self->priv->filter, product_ids[i].l, product_ids[i].r);
+    for (i = 0; allowed->product_ids && allowed->product_ids[i].l; i++)
+        mm_filter_register_plugin_allowlist_product_id (self->priv->filter, allowed->product_ids[i].l, allowed->product_ids[i].r);
 }
 
 static void
-register_plugin_allowlist_subsystem_vendor_ids (MMPluginManager *self,
-                                                MMPlugin        *plugin)
+register_plugin_allowlist_subsystem_vendor_ids (MMPluginManager            *self,
+                                                const MMPluginIndexFilters *allowed)
 {
-    const mm_uint16_pair *subsystem_vendor_ids;
-    guint                 i;
+    guint i;
 
     if (!mm_filter_check_rule_enabled (self->priv->filter, MM_FILTER_RULE_PLUGIN_ALLOWLIST))
         return;
 
-    subsystem_vendor_ids = mm_plugin_get_allowed_subsystem_vendor_ids (plugin);
-    for (i = 0; subsystem_vendor_ids && subsystem_vendor_ids[i].l; i++)
-        mm_filter_register_plugin_allowlist_subsystem_vendor_id (self->priv->filter, subsystem_vendor_ids[i].l, subsystem_vendor_ids[i].r);
+    for (i = 0; allowed->subsystem_vendor_ids && allowed->subsystem_vendor_ids[i].l; i++)
+        mm_filter_register_plugin_allowlist_subsystem_vendor_id (self->priv->filter, allowed->subsystem_vendor_ids[i].l, allowed->subsystem_vendor_ids[i].r);
+}
+
+static void
+track_plugin_filters (MMPluginManager             *self,
+                      const MMPluginIndexFilters  *allowed,
+                      GPtrArray                  **subsystems)
+{
+    guint i;
+
+    /* Track required subsystems, avoiding duplicates in the list */
+    for (i = 0; allowed->subsystems[i]; i++) {
+        if (!g_ptr_array_find_with_equal_func (*subsystems, allowed->subsystems[i], g_str_equal, NULL))
+            g_ptr_array_add (*subsystems, g_strdup (allowed->subsystems[i]));
+    }
+
+    /* Register plugin allowlist rules in filter, if any */
+    register_plugin_allowlist_tags                 (self, allowed);
+    register_plugin_allowlist_vendor_ids           (self, allowed);
+    register_plugin_allowlist_product_ids          (self, allowed);
+    register_plugin_allowlist_subsystem_vendor_ids (self, allowed);
 }
 
 static gboolean
 track_plugin (MMPluginManager  *self,
               MMPlugin         *plugin,
+              const gchar      *module,
               GPtrArray       **subsystems,
               GError          **error)
 {
-    const gchar **plugin_subsystems;
-    guint         i;
+    MMPluginIndexFilters allowed;
 
     /* Ignore plugins that don't specify subsystems */
-    plugin_subsystems = mm_plugin_get_allowed_subsystems (plugin);
-    if (!plugin_subsystems) {
+    mm_plugin_get_allowed_filters (plugin, &allowed, NULL);
+    if (!allowed.subsystems) {
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
                      "Allowed subsystems not specified");
         return FALSE;
@@ -1750,24 +1847,44 @@ track_plugin (MMPluginManager  *self,
             return FALSE;
         }
         self->priv->generic = g_object_ref (plugin);
-    } else
-        self->priv->plugins = g_list_append (self->priv->plugins, g_object_ref (plugin));
+    } else {
+        PluginSlot           slot = { 0 };
+        MMPluginIndexFilters filters;
 
-    /* Track required subsystems, avoiding duplicates in the list */
-    for (i = 0; plugin_subsystems[i]; i++) {
-        if (!g_ptr_array_find_with_equal_func (*subsystems, plugin_subsystems[i], g_str_equal, NULL))
-            g_ptr_array_add (*subsystems, g_strdup (plugin_subsystems[i]));
+        slot.plugin = g_object_ref (plugin);
+        slot.module = g_strdup (module);
+        g_array_append_val (self->priv->plugins, slot);
+        mm_plugin_get_index_filters (plugin, &filters);
+        mm_plugin_index_add (self->priv->index, &filters);
     }
 
-    /* Register plugin allowlist rules in filter, if any */
-    register_plugin_allowlist_tags                 (self, plugin);
-    register_plugin_allowlist_vendor_ids           (self, plugin);
-    register_plugin_allowlist_product_ids          (self, plugin);
-    register_plugin_allowlist_subsystem_vendor_ids (self, plugin);
-
+    track_plugin_filters (self, &allowed, subsystems);
     return TRUE;
 }
 
+#if !defined WITH_BUILTIN_PLUGINS
+
+/* Plugins in the manifest are tracked with the filters given there, and the
+ * module is loaded once a port may be supported by the plugin */
+static void
+track_deferred_plugin (MMPluginManager              *self,
+                       const MMPluginManifestEntry  *entry,
+                       GPtrArray                   **subsystems)
+{
+    PluginSlot           slot = { 0 };
+    MMPluginIndexFilters filters;
+
+    slot.module = g_strdup (entry->module);
+    slot.name = g_strdup (entry->name);
+    g_array_append_val (self->priv->plugins, slot);
+    mm_plugin_manifest_entry_get_index_filters (entry, &filters);
+    mm_plugin_index_add (self->priv->index, &filters);
+
+    track_plugin_filters (self, &entry->filters, subsystems);
+}
+
+#endif
+
 static gboolean
 validate_tracked_plugins (MMPluginManager  *self,
                           GPtrArray        *subsystems_take,
@@ -1780,7 +1897,7 @@ validate_tracked_plugins (MMPluginManager  *self,
         mm_obj_dbg (self, "generic plugin not loaded");
 
     /* Treat as error if we don't find any plugin */
-    if (!self->priv->plugins && !self->priv->generic) {
+    if (!self->priv->plugins->len && !self->priv->generic) {
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_NO_PLUGINS, "no plugins found");
         return FALSE;
     }
@@ -1798,7 +1915,7 @@ validate_tracked_plugins (MMPluginManager  *self,
     subsystems_str = g_strjoinv (", ", self->priv->subsystems);
 
     mm_obj_dbg (self, "successfully loaded %u plugins registering %u subsystems: %s",
-                g_list_length (self->priv->plugins) + !!self->priv->generic,
+                self->priv->plugins->len + !!self->priv->generic,
                 g_strv_length (self->priv->subsystems), subsystems_str);
 
     return TRUE;
@@ -1925,18 +2042,68 @@ out:
     g_free (path_display);
 }
 
+/* The manifest of the default plugin directory is kept in the package state
+ * directory; the one of a custom plugin directory is kept in that directory */
+static gchar *
+build_plugin_manifest_path (MMPluginManager *self)
+{
+    if (g_str_equal (self->priv->plugin_dir, PLUGINDIR))
+        return mm_plugin_manifest_build_state_path ();
+    return g_build_filename (self->priv->plugin_dir, MM_PLUGIN_MANIFEST_FILE_NAME, NULL);
+}
+
+static MMPluginManifest *
+load_plugin_manifest (MMPluginManager *self,
+                      const gchar     *path)
+{
+    g_autoptr(GError)  error = NULL;
+    MMPluginManifest  *manifest;
+
+    manifest = mm_plugin_manifest_new_from_file (path, MM_DIST_VERSION, &error);
+    if (!manifest) {
+        if (g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+            mm_obj_dbg (self, "no plugin manifest found: loading all plugins");
+        else
+            mm_obj_warn (self, "ignored plugin manifest: %s", error->message);
+        return NULL;
+    }
+
+    mm_obj_dbg (self, "plugin manifest loaded with %u plugins", mm_plugin_manifest_get_n_entries (manifest));
+    return manifest;
+}
+
+static void
+update_plugin_manifest (MMPluginManager  *self,
+                        MMPluginManifest *updated,
+                        const gchar      *path)
+{
+    g_autoptr(GError) error = NULL;
+
+    if (!mm_plugin_manifest_write (updated, path, &error))
+        mm_obj_warn (self, "couldn't update plugin manifest: %s", error->message);
+    else
+        mm_obj_dbg (self, "plugin manifest updated with %u plugins", mm_plugin_manifest_get_n_entries (updated));
+}
+
 static gboolean
 load_external_plugins (MMPluginManager  *self,
                        GError          **error)
 {
-    GDir             *dir = NULL;
-    const gchar      *fname;
-    GList            *shared_paths = NULL;
-    GList            *plugin_paths = NULL;
-    GList            *l;
-    GPtrArray        *subsystems = NULL;
-    g_autofree gchar *plugindir_display = NULL;
-    gboolean          valid_plugins = FALSE;
+    GDir                        *dir = NULL;
+    const gchar                 *fname;
+    GList                       *shared_paths = NULL;
+    GList                       *plugin_paths = NULL;
+    GList                       *l;
+    GPtrArray                   *subsystems = NULL;
+    g_autofree gchar            *plugindir_display = NULL;
+    g_autofree gchar            *manifest_path = NULL;
+    g_autoptr(MMPluginManifest)  manifest = NULL;
+    g_autoptr(MMPluginManifest)  updated_manifest = NULL;
+    gboolean                     manifest_outdated = FALSE;
+    GTimer                      *timer = NULL;
+    guint                        n_loaded = 0;
+    guint                        n_deferred = 0;
+    gboolean                     valid_plugins = FALSE;
 
     if (!g_module_supported ()) {
         g_set_error (error,
@@ -1966,35 +2133,126 @@ load_external_plugins (MMPluginManager  *self,
             plugin_paths = g_list_prepend (plugin_paths, g_module_build_path (self->priv->plugin_dir, fname));
     }
 
-    /* Load all shared utils */
+    timer = g_timer_new ();
+
+    /* All plugins are needed to write the manifest. Otherwise, the manifest
+     * is rewritten whenever any of its entries is missing or outdated, with
+     * the modules loaded in this run. */
+    if (!mm_context_get_test_no_plugin_manifest () && !mm_context_get_test_write_plugin_manifest ()) {
+        manifest_path = build_plugin_manifest_path (self);
+        manifest = load_plugin_manifest (self, manifest_path);
+        updated_manifest = mm_plugin_manifest_new (MM_DIST_VERSION);
+        manifest_outdated = !manifest;
+    }
+
+    /* Load all shared utils, which the plugins need to be loaded */
     for (l = shared_paths; l; l = g_list_next (l))
         load_external_shared (self, (const gchar *)(l->data));
 
-    /* Load all plugins */
+    /* Load all plugins, except for the ones in the manifest which are loaded
+     * only once a port may be supported by them */
     subsystems = g_ptr_array_new ();
     for (l = plugin_paths; l; l = g_list_next (l)) {
-        g_autoptr(MMPlugin) plugin = NULL;
-        g_autoptr(GError)   inner_error = NULL;
+        g_autoptr(MMPlugin)          plugin = NULL;
+        g_autoptr(GError)            inner_error = NULL;
+        g_autofree gchar            *module = NULL;
+        const MMPluginManifestEntry *entry;
+
+        module = g_path_get_basename ((const gchar *)(l->data));
+        entry = manifest ? mm_plugin_manifest_lookup (manifest, module) : NULL;
+        /* A module rebuilt or replaced after the manifest was generated may
+         * not match the filters in the manifest any more */
+        if (entry && !mm_plugin_manifest_entry_matches_module (entry, (const gchar *)(l->data))) {
+            mm_obj_dbg (self, "plugin module '%s' changed since the manifest was generated: loading it", module);
+            entry = NULL;
+        }
+        if (entry) {
+            track_deferred_plugin (self, entry, &subsystems);
+            if (updated_manifest)
+                mm_plugin_manifest_add_entry (updated_manifest, entry);
+            n_deferred++;
+            continue;
+        }
+
+        if (manifest)
+            manifest_outdated = TRUE;
 
         plugin = load_external_plugin (self, (const gchar *)(l->data));
         if (!plugin)
             continue;
 
-        if (!track_plugin (self, plugin, &subsystems, &inner_error))
+        if (!track_plugin (self, plugin, module, &subsystems, &inner_error)) {
             mm_obj_warn (self, "ignored plugin '%s': %s", mm_plugin_get_name (plugin), inner_error->message);
+            continue;
+        }
+        n_loaded++;
+
+        if (updated_manifest) {
+            MMPluginIndexFilters allowed;
+            gboolean             probe_strings;
+
+            mm_plugin_get_allowed_filters (plugin, &allowed, &probe_strings);
+            if (!mm_plugin_manifest_add (updated_manifest, (const gchar *)(l->data), mm_plugin_get_name (plugin),
+                                         &allowed, probe_strings, &inner_error))
+                mm_obj_dbg (self, "plugin '%s' not added to the manifest: %s", mm_plugin_get_name (plugin), inner_error->message);
+        }
     }
 
+    /* Entries of modules no longer installed also make the manifest outdated */
+    if (manifest && (n_deferred != mm_plugin_manifest_get_n_entries (manifest)))
+        manifest_outdated = TRUE;
+
     valid_plugins = validate_tracked_plugins (self, subsystems, error);
+    if (valid_plugins) {
+        mm_obj_dbg (self, "plugins set up in %.1f ms: %u loaded, %u deferred",
+                    g_timer_elapsed (timer, NULL) * 1000.0, n_loaded, n_deferred);
+        if (manifest_outdated)
+            update_plugin_manifest (self, updated_manifest, manifest_path);
+    }
 
 out:
     g_list_free_full (shared_paths, g_free);
     g_list_free_full (plugin_paths, g_free);
     if (dir)
         g_dir_close (dir);
+    if (timer)
+        g_timer_destroy (timer);
 
     return valid_plugins;
 }
 
+gboolean
+mm_plugin_manager_write_manifest (MMPluginManager  *self,
+                                  const gchar      *path,
+                                  GError          **error)
+{
+    g_autoptr(MMPluginManifest) manifest = NULL;
+    guint                       i;
+
+    /* The generic plugin is not included, so it's always loaded */
+    manifest = mm_plugin_manifest_new (MM_DIST_VERSION);
+    for (i = 0; i < self->priv->plugins->len; i++) {
+        PluginSlot           *slot;
+        MMPlugin             *plugin;
+        MMPluginIndexFilters  allowed;
+        gboolean              probe_strings;
+        g_autofree gchar     *path = NULL;
+
+        plugin = plugin_manager_peek_plugin_at (self, i);
+        if (!plugin)
+            continue;
+
+        slot = &g_array_index (self->priv->plugins, PluginSlot, i);
+        mm_plugin_get_allowed_filters (plugin, &allowed, &probe_strings);
+        path = g_build_filename (self->priv->plugin_dir, slot->module, NULL);
+        if (!mm_plugin_manifest_add (manifest, path, mm_plugin_get_name (plugin), &allowed, probe_strings, error))
+            return FALSE;
+    }
+
+    mm_obj_dbg (self, "writing manifest of %u plugins to '%s'", mm_plugin_manifest_get_n_entries (manifest), path);
+    return mm_plugin_manifest_write (manifest, path, error);
+}
+
 #else
 
 static gboolean
@@ -2014,7 +2272,7 @@ load_builtin_plugins (MMPluginManager  *self,
 
         plugin = MM_PLUGIN (l->data);
         mm_obj_dbg (self, "loaded builtin plugin '%s'", mm_plugin_get_name (plugin));
-        tracked = track_plugin (self, plugin, &subsystems, NULL);
+        tracked = track_plugin (self, plugin, NULL, &subsystems, NULL);
         g_assert (tracked);
     }
     g_list_free_full (builtin_plugins, (GDestroyNotify)g_object_unref);
@@ -2058,6 +2316,9 @@ mm_plugin_manager_init (MMPluginManager *self)
     self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self,
                                               MM_TYPE_PLUGIN_MANAGER,
                                               MMPluginManagerPrivate);
+    self->priv->plugins = g_array_new (FALSE, TRUE, sizeof (PluginSlot));
+    g_array_set_clear_func (self->priv->plugins, (GDestroyNotify) plugin_slot_clear);
+    self->priv->index = mm_plugin_index_new ();
 }
 
 static void
@@ -2125,7 +2386,8 @@ dispose (GObject *object)
 {
     MMPluginManager *self = MM_PLUGIN_MANAGER (object);
 
-    g_list_free_full (g_steal_pointer (&self->priv->plugins), g_object_unref);
+    g_clear_pointer (&self->priv->plugins, g_array_unref);
+    g_clear_pointer (&self->priv->index, mm_plugin_index_free);
     g_clear_object (&self->priv->generic);
     g_clear_object (&self->priv->filter);
     g_clear_pointer (&self->priv->subsystems, g_strfreev);
@@ -79,4 +79,11 @@ MMPlugin        *mm_plugin_manager_peek_plugin                 (MMPluginManager
                                                                 const gchar          *plugin_name);
 const gchar    **mm_plugin_manager_get_subsystems              (MMPluginManager      *self);
 
+#if !defined WITH_BUILTIN_PLUGINS
+/* Writes the manifest of the loaded plugins, see mm-plugin-manifest.h */
+gboolean         mm_plugin_manager_write_manifest              (MMPluginManager      *self,
+                                                                const gchar          *path,
+                                                                GError              **error);
+#endif
+
 #endif /* MM_PLUGIN_MANAGER_H */
@@ -0,0 +1,511 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+#include <errno.h>
+#include <string.h>
+
+#include <glib/gstdio.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-plugin-manifest.h"
+
+#if !defined PKGSTATEDIR
+# error PKGSTATEDIR is not defined
+#endif
+
+#define MANIFEST_GROUP                    "ModemManager"
+#define MANIFEST_VERSION_KEY              "version"
+
+#define ENTRY_MODULE_SIZE_KEY             "module-size"
+#define ENTRY_MODULE_MTIME_KEY            "module-mtime"
+#define ENTRY_NAME_KEY                    "name"
+#define ENTRY_SUBSYSTEMS_KEY              "subsystems"
+#define ENTRY_DRIVERS_KEY                 "drivers"
+#define ENTRY_VENDOR_IDS_KEY              "vendor-ids"
+#define ENTRY_PRODUCT_IDS_KEY             "product-ids"
+#define ENTRY_SUBSYSTEM_VENDOR_IDS_KEY    "subsystem-vendor-ids"
+#define ENTRY_UDEV_TAGS_KEY               "udev-tags"
+#define ENTRY_PROBE_STRINGS_KEY           "probe-strings"
+
+struct _MMPluginManifest {
+    gchar      *version;
+    /* module -> MMPluginManifestEntry */
+    GHashTable *entries;
+};
+
+/*****************************************************************************/
+
+static void
+entry_free (MMPluginManifestEntry *entry)
+{
+    g_free (entry->module);
+    g_free (entry->name);
+    g_strfreev ((gchar **) entry->filters.subsystems);
+    g_strfreev ((gchar **) entry->filters.drivers);
+    g_free ((gpointer) entry->filters.vendor_ids);
+    g_free ((gpointer) entry->filters.product_ids);
+    g_free ((gpointer) entry->filters.subsystem_vendor_ids);
+    g_strfreev ((gchar **) entry->filters.udev_tags);
+    g_slice_free (MMPluginManifestEntry, entry);
+}
+
+static guint16 *
+vendor_ids_dup (const guint16 *vendor_ids)
+{
+    guint n = 0;
+
+    if (!vendor_ids)
+        return NULL;
+    while (vendor_ids[n])
+        n++;
+    return g_memdup (vendor_ids, (n + 1) * sizeof (guint16));
+}
+
+static mm_uint16_pair *
+pairs_dup (const mm_uint16_pair *pairs)
+{
+    guint n = 0;
+
+    if (!pairs)
+        return NULL;
+    while (pairs[n].l)
+        n++;
+    return g_memdup (pairs, (n + 1) * sizeof (mm_uint16_pair));
+}
+
+static gboolean
+module_stat (const gchar  *module_path,
+             guint64      *size,
+             gint64       *mtime,
+             GError      **error)
+{
+    GStatBuf st;
+
+    if (g_stat (module_path, &st) != 0) {
+        int errsv = errno;
+
+        g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errsv),
+                     "couldn't stat module %s: %s", module_path, g_strerror (errsv));
+        return FALSE;
+    }
+    *size = (guint64) st.st_size;
+    *mtime = (gint64) st.st_mtime;
+    return TRUE;
+}
+
+static void
+manifest_add_entry (MMPluginManifest           *self,
+                    const gchar                *module,
+                    guint64                     module_size,
+                    gint64                      module_mtime,
+                    const gchar                *name,
+                    const MMPluginIndexFilters *filters,
+                    gboolean                    probe_strings)
+{
+    MMPluginManifestEntry *entry;
+
+    entry = g_slice_new0 (MMPluginManifestEntry);
+    entry->module = g_strdup (module);
+    entry->module_size = module_size;
+    entry->module_mtime = module_mtime;
+    entry->name = g_strdup (name);
+    entry->filters.subsystems = (const gchar * const *) g_strdupv ((gchar **) filters->subsystems);
+    entry->filters.drivers = (const gchar * const *) g_strdupv ((gchar **) filters->drivers);
+    entry->filters.vendor_ids = vendor_ids_dup (filters->vendor_ids);
+    entry->filters.product_ids = pairs_dup (filters->product_ids);
+    entry->filters.subsystem_vendor_ids = pairs_dup (filters->subsystem_vendor_ids);
+    entry->filters.udev_tags = (const gchar * const *) g_strdupv ((gchar **) filters->udev_tags);
+    entry->probe_strings = probe_strings;
+
+    g_hash_table_replace (self->entries, entry->module, entry);
+}
+
+gboolean
+mm_plugin_manifest_add (MMPluginManifest           *self,
+                        const gchar                *module_path,
+                        const gchar                *name,
+                        const MMPluginIndexFilters *filters,
+                        gboolean                    probe_strings,
+                        GError                    **error)
+{
+    g_autofree gchar *module = NULL;
+    guint64           module_size;
+    gint64            module_mtime;
+
+    if (!module_stat (module_path, &module_size, &module_mtime, error))
+        return FALSE;
+
+    module = g_path_get_basename (module_path);
+    manifest_add_entry (self, module, module_size, module_mtime, name, filters, probe_strings);
+    return TRUE;
+}
+
+void
+mm_plugin_manifest_add_entry (MMPluginManifest            *self,
+                              const MMPluginManifestEntry *entry)
+{
+    manifest_add_entry (self,
+                        entry->module,
+                        entry->module_size,
+                        entry->module_mtime,
+                        entry->name,
+                        &entry->filters,
+                        entry->probe_strings);
+}
+
+const MMPluginManifestEntry *
+mm_plugin_manifest_lookup (MMPluginManifest *self,
+                           const gchar      *module)
+{
+    return g_hash_table_lookup (self->entries, module);
+}
+
+guint
+mm_plugin_manifest_get_n_entries (MMPluginManifest *self)
+{
+    return g_hash_table_size (self->entries);
+}
+
+gchar *
+mm_plugin_manifest_build_state_path (void)
+{
+    return g_build_filename (PKGSTATEDIR, MM_PLUGIN_MANIFEST_FILE_NAME, NULL);
+}
+
+gboolean
+mm_plugin_manifest_entry_matches_module (const MMPluginManifestEntry *entry,
+                                         const gchar                 *module_path)
+{
+    guint64 module_size;
+    gint64  module_mtime;
+
+    if (!module_stat (module_path, &module_size, &module_mtime, NULL))
+        return FALSE;
+    return (module_size == entry->module_size && module_mtime == entry->module_mtime);
+}
+
+void
+mm_plugin_manifest_entry_get_index_filters (const MMPluginManifestEntry *entry,
+                                            MMPluginIndexFilters        *filters)
+{
+    *filters = entry->filters;
+    if (entry->probe_strings) {
+        filters->vendor_ids = NULL;
+        filters->product_ids = NULL;
+        filters->subsystem_vendor_ids = NULL;
+    }
+}
+
+/*****************************************************************************/
+/* Key file serialization
+ *
+ * A missing key means that the filter doesn't apply, an empty list means that
+ * the filter applies and nothing matches it. IDs are given in hex, and pairs
+ * of IDs are separated by a colon. */
+
+static void
+set_strv (GKeyFile            *key_file,
+          const gchar         *group,
+          const gchar         *key,
+          const gchar * const *strv)
+{
+    if (strv)
+        g_key_file_set_string_list (key_file, group, key, strv, g_strv_length ((gchar **) strv));
+}
+
+static void
+set_vendor_ids (GKeyFile      *key_file,
+                const gchar   *group,
+                const gchar   *key,
+                const guint16 *vendor_ids)
+{
+    g_autoptr(GPtrArray) list = NULL;
+    guint                i;
+
+    if (!vendor_ids)
+        return;
+
+    list = g_ptr_array_new_with_free_func (g_free);
+    for (i = 0; vendor_ids[i]; i++)
+        g_ptr_array_add (list, g_strdup_printf ("%04x", vendor_ids[i]));
+    g_key_file_set_string_list (key_file, group, key, (const gchar * const *) list->pdata, list->len);
+}
+
+static void
+set_pairs (GKeyFile             *key_file,
+           const gchar          *group,
+           const gchar          *key,
+           const mm_uint16_pair *pairs)
+{
+    g_autoptr(GPtrArray) list = NULL;
+    guint                i;
+
+    if (!pairs)
+        return;
+
+    list = g_ptr_array_new_with_free_func (g_free);
+    for (i = 0; pairs[i].l; i++)
+        g_ptr_array_add (list, g_strdup_printf ("%04x:%04x", pairs[i].l, pairs[i].r));
+    g_key_file_set_string_list (key_file, group, key, (const gchar * const *) list->pdata, list->len);
+}
+
+static gboolean
+get_strv (GKeyFile             *key_file,
+          const gchar          *group,
+          const gchar          *key,
+          const gchar * const **out,
+          GError              **error)
+{
+    gchar **strv;
+
+    *out = NULL;
+    if (!g_key_file_has_key (key_file, group, key, NULL))
+        return TRUE;
+
+    strv = g_key_file_get_string_list (key_file, group, key, NULL, NULL);
+    /* an empty list applies the filter with no allowed values */
+    if (!strv)
+        strv = g_new0 (gchar *, 1);
+    *out = (const gchar * const *) strv;
+    return TRUE;
+}
+
+static gboolean
+parse_id (const gchar  *str,
+          gboolean      allow_zero,
+          guint16      *out,
+          GError      **error)
+{
+    guint id;
+
+    /* Zero terminates the lists of IDs */
+    if (!mm_get_uint_from_hex_str (str, &id) || (!id && !allow_zero) || id > G_MAXUINT16) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS, "invalid ID '%s'", str);
+        return FALSE;
+    }
+    *out = (guint16) id;
+    return TRUE;
+}
+
+static gboolean
+get_vendor_ids (GKeyFile       *key_file,
+                const gchar    *group,
+                const gchar    *key,
+                const guint16 **out,
+                GError        **error)
+{
+    g_auto(GStrv)       list = NULL;
+    g_autofree guint16 *vendor_ids = NULL;
+    gsize               len = 0;
+    guint               i;
+
+    *out = NULL;
+    if (!g_key_file_has_key (key_file, group, key, NULL))
+        return TRUE;
+
+    list = g_key_file_get_string_list (key_file, group, key, &len, NULL);
+    vendor_ids = g_new0 (guint16, len + 1);
+    for (i = 0; i < len; i++) {
+        if (!parse_id (list[i], FALSE, &vendor_ids[i], error))
+            return FALSE;
+    }
+    *out = g_steal_pointer (&vendor_ids);
+    return TRUE;
+}
+
+static gboolean
+get_pairs (GKeyFile              *key_file,
+           const gchar           *group,
+           const gchar           *key,
+           const mm_uint16_pair **out,
+           GError               **error)
+{
+    g_auto(GStrv)              list = NULL;
+    g_autofree mm_uint16_pair *pairs = NULL;
+    gsize                      len = 0;
+    guint                      i;
+
+    *out = NULL;
+    if (!g_key_file_has_key (key_file, group, key, NULL))
+        return TRUE;
+
+    list = g_key_file_get_string_list (key_file, group, key, &len, NULL);
+    pairs = g_new0 (mm_uint16_pair, len + 1);
+    for (i = 0; i < len; i++) {
+        g_auto(GStrv) split = NULL;
+
+        split = g_strsplit (list[i], ":", -1);
+        if (g_strv_length (split) != 2) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS, "invalid ID pair '%s'", list[i]);
+            return FALSE;
+        }
+        if (!parse_id (split[0], FALSE, &pairs[i].l, error) || !parse_id (split[1], TRUE, &pairs[i].r, error))
+            return FALSE;
+    }
+    *out = g_steal_pointer (&pairs);
+    return TRUE;
+}
+
+static MMPluginManifestEntry *
+entry_new_from_key_file (GKeyFile     *key_file,
+                         const gchar  *group,
+                         GError      **error)
+{
+    MMPluginManifestEntry *entry;
+    GError                *inner_error = NULL;
+
+    entry = g_slice_new0 (MMPluginManifestEntry);
+    entry->module = g_strdup (group);
+
+    entry->name = g_key_file_get_string (key_file, group, ENTRY_NAME_KEY, &inner_error);
+    if (!entry->name)
+        goto out;
+
+    entry->module_size = g_key_file_get_uint64 (key_file, group, ENTRY_MODULE_SIZE_KEY, &inner_error);
+    if (inner_error)
+        goto out;
+
+    entry->module_mtime = g_key_file_get_int64 (key_file, group, ENTRY_MODULE_MTIME_KEY, &inner_error);
+    if (inner_error)
+        goto out;
+
+    entry->probe_strings = g_key_file_get_boolean (key_file, group, ENTRY_PROBE_STRINGS_KEY, &inner_error);
+    if (inner_error)
+        goto out;
+
+    if (!get_strv (key_file, group, ENTRY_SUBSYSTEMS_KEY, &entry->filters.subsystems, &inner_error) ||
+        !get_strv (key_file, group, ENTRY_DRIVERS_KEY, &entry->filters.drivers, &inner_error) ||
+        !get_vendor_ids (key_file, group, ENTRY_VENDOR_IDS_KEY, &entry->filters.vendor_ids, &inner_error) ||
+        !get_pairs (key_file, group, ENTRY_PRODUCT_IDS_KEY, &entry->filters.product_ids, &inner_error) ||
+        !get_pairs (key_file, group, ENTRY_SUBSYSTEM_VENDOR_IDS_KEY, &entry->filters.subsystem_vendor_ids, &inner_error) ||
+        !get_strv (key_file, group, ENTRY_UDEV_TAGS_KEY, &entry->filters.udev_tags, &inner_error))
+        goto out;
+
+    if (!entry->filters.subsystems)
+        inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS, "allowed subsystems not specified");
+
+out:
+    if (inner_error) {
+        g_propagate_prefixed_error (error, inner_error, "invalid plugin '%s': ", group);
+        entry_free (entry);
+        return NULL;
+    }
+    return entry;
+}
+
+gboolean
+mm_plugin_manifest_write (MMPluginManifest  *self,
+                          const gchar       *path,
+                          GError           **error)
+{
+    g_autoptr(GKeyFile)  key_file = NULL;
+    g_autoptr(GList)     modules = NULL;
+    GList               *l;
+
+    key_file = g_key_file_new ();
+    g_key_file_set_string (key_file, MANIFEST_GROUP, MANIFEST_VERSION_KEY, self->version);
+
+    /* Sorted, so that the output is reproducible */
+    modules = g_list_sort (g_hash_table_get_keys (self->entries), (GCompareFunc) g_strcmp0);
+    for (l = modules; l; l = g_list_next (l)) {
+        const MMPluginManifestEntry *entry;
+
+        entry = g_hash_table_lookup (self->entries, l->data);
+        g_key_file_set_string  (key_file, entry->module, ENTRY_NAME_KEY, entry->name);
+        g_key_file_set_uint64  (key_file, entry->module, ENTRY_MODULE_SIZE_KEY, entry->module_size);
+        g_key_file_set_int64   (key_file, entry->module, ENTRY_MODULE_MTIME_KEY, entry->module_mtime);
+        set_strv               (key_file, entry->module, ENTRY_SUBSYSTEMS_KEY, entry->filters.subsystems);
+        set_strv               (key_file, entry->module, ENTRY_DRIVERS_KEY, entry->filters.drivers);
+        set_vendor_ids         (key_file, entry->module, ENTRY_VENDOR_IDS_KEY, entry->filters.vendor_ids);
+        set_pairs              (key_file, entry->module, ENTRY_PRODUCT_IDS_KEY, entry->filters.product_ids);
+        set_pairs              (key_file, entry->module, ENTRY_SUBSYSTEM_VENDOR_IDS_KEY, entry->filters.subsystem_vendor_ids);
+        set_strv               (key_file, entry->module, ENTRY_UDEV_TAGS_KEY, entry->filters.udev_tags);
+        g_key_file_set_boolean (key_file, entry->module, ENTRY_PROBE_STRINGS_KEY, entry->probe_strings);
+    }
+
+    if (!g_key_file_save_to_file (key_file, path, error)) {
+        g_prefix_error (error, "Error saving plugin manifest to %s: ", path);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+MMPluginManifest *
+mm_plugin_manifest_new_from_file (const gchar  *path,
+                                  const gchar  *version,
+                                  GError      **error)
+{
+    g_autoptr(MMPluginManifest)  self = NULL;
+    g_autoptr(GKeyFile)          key_file = NULL;
+    g_auto(GStrv)                groups = NULL;
+    g_autofree gchar            *file_version = NULL;
+    guint                        i;
+
+    key_file = g_key_file_new ();
+    if (!g_key_file_load_from_file (key_file, path, G_KEY_FILE_NONE, error)) {
+        g_prefix_error (error, "Error loading plugin manifest from %s: ", path);
+        return NULL;
+    }
+
+    file_version = g_key_file_get_string (key_file, MANIFEST_GROUP, MANIFEST_VERSION_KEY, NULL);
+    if (g_strcmp0 (file_version, version) != 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
+                     "Plugin manifest %s generated for version %s, %s is required",
+                     path, file_version ? file_version : "unknown", version);
+        return NULL;
+    }
+
+    self = mm_plugin_manifest_new (version);
+    groups = g_key_file_get_groups (key_file, NULL);
+    for (i = 0; groups[i]; i++) {
+        MMPluginManifestEntry *entry;
+
+        if (g_str_equal (groups[i], MANIFEST_GROUP))
+            continue;
+
+        entry = entry_new_from_key_file (key_file, groups[i], error);
+        if (!entry) {
+            g_prefix_error (error, "Error loading plugin manifest from %s: ", path);
+            return NULL;
+        }
+        g_hash_table_replace (self->entries, entry->module, entry);
+    }
+
+    return g_steal_pointer (&self);
+}
+
+MMPluginManifest *
+mm_plugin_manifest_new (const gchar *version)
+{
+    MMPluginManifest *self;
+
+    self = g_slice_new0 (MMPluginManifest);
+    self->version = g_strdup (version);
+    self->entries = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) entry_free);
+    return self;
+}
+
+void
+mm_plugin_manifest_free (MMPluginManifest *self)
+{
+    g_hash_table_unref (self->entries);
+    g_free (self->version);
+    g_slice_free (MMPluginManifest, self);
+}
@@ -0,0 +1,93 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#ifndef MM_PLUGIN_MANIFEST_H
+#define MM_PLUGIN_MANIFEST_H
+
+#include <glib.h>
+
+#include "mm-plugin-index.h"
+
+/* Manifest of the external plugin modules, recording the name and
+ * pre-probing filters of each plugin so that the module only needs to be
+ * loaded once a port may be supported by it.
+ *
+ * The manifest is a key file with one group per plugin module, named after
+ * the module file name. A manifest generated for a different version than
+ * the one loading it is rejected as a whole. Each entry also records the
+ * size and modification time of the module file, so that an entry is only
+ * used while the module it was generated from is the one installed.
+ *
+ * The daemon keeps the manifest up to date itself, from the modules as they
+ * are installed: modules without a valid entry are loaded when the daemon
+ * starts, and the manifest is then rewritten including them. */
+
+#define MM_PLUGIN_MANIFEST_FILE_NAME "mm-plugins.manifest"
+
+typedef struct {
+    gchar                *module;
+    /* Size and modification time (seconds) of the module file */
+    guint64               module_size;
+    gint64                module_mtime;
+    gchar                *name;
+    /* All filters allowed by the plugin */
+    MMPluginIndexFilters  filters;
+    /* Whether ports not matching the vendor/product IDs may still be
+     * supported after probing vendor/product strings */
+    gboolean              probe_strings;
+} MMPluginManifestEntry;
+
+typedef struct _MMPluginManifest MMPluginManifest;
+
+MMPluginManifest            *mm_plugin_manifest_new           (const gchar       *version);
+MMPluginManifest            *mm_plugin_manifest_new_from_file (const gchar       *path,
+                                                               const gchar       *version,
+                                                               GError           **error);
+void                         mm_plugin_manifest_free          (MMPluginManifest  *self);
+gboolean                     mm_plugin_manifest_write         (MMPluginManifest  *self,
+                                                               const gchar       *path,
+                                                               GError           **error);
+guint                        mm_plugin_manifest_get_n_entries (MMPluginManifest  *self);
+
+/* The filters are copied; the module size and modification time are read
+ * from the file at module_path */
+gboolean                     mm_plugin_manifest_add           (MMPluginManifest           *self,
+                                                               const gchar                *module_path,
+                                                               const gchar                *name,
+                                                               const MMPluginIndexFilters *filters,
+                                                               gboolean                    probe_strings,
+                                                               GError                    **error);
+/* The entry is copied */
+void                         mm_plugin_manifest_add_entry     (MMPluginManifest            *self,
+                                                               const MMPluginManifestEntry *entry);
+const MMPluginManifestEntry *mm_plugin_manifest_lookup        (MMPluginManifest           *self,
+                                                               const gchar                *module);
+
+/* Location of the manifest of the default plugin directory, which isn't
+ * expected to be writable at runtime */
+gchar                       *mm_plugin_manifest_build_state_path        (void);
+
+/* Whether the module file at module_path is still the one the entry was
+ * generated from */
+gboolean                     mm_plugin_manifest_entry_matches_module    (const MMPluginManifestEntry *entry,
+                                                                         const gchar                 *module_path);
+
+/* Same filters as mm_plugin_get_index_filters() for the loaded plugin */
+void                         mm_plugin_manifest_entry_get_index_filters (const MMPluginManifestEntry *entry,
+                                                                         MMPluginIndexFilters        *filters);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMPluginManifest, mm_plugin_manifest_free)
+
+#endif /* MM_PLUGIN_MANIFEST_H */
@@ -899,6 +899,70 @@ mm_plugin_supports_port (MMPlugin            *self,
 
 /*****************************************************************************/
 
+void
+mm_plugin_get_allowed_filters (MMPlugin             *self,
+                               MMPluginIndexFilters *filters,
+                               gboolean             *probe_strings)
+{
+    memset (filters, 0, sizeof (*filters));
+
+    filters->subsystems = (const gchar * const *) self->priv->subsystems;
+    filters->drivers = (const gchar * const *) self->priv->drivers;
+    filters->vendor_ids = self->priv->vendor_ids;
+    filters->product_ids = self->priv->product_ids;
+    filters->subsystem_vendor_ids = self->priv->subsystem_vendor_ids;
+    filters->udev_tags = (const gchar * const *) self->priv->udev_tags;
+
+    /* Ports not matching vendor/product IDs may still be supported after
+     * probing vendor/product strings */
+    if (probe_strings)
+        *probe_strings = (self->priv->vendor_strings ||
+                          self->priv->product_strings ||
+                          self->priv->forbidden_product_strings);
+}
+
+void
+mm_plugin_get_index_filters (MMPlugin             *self,
+                             MMPluginIndexFilters *filters)
+{
+    gboolean probe_strings;
+
+    /* Only the filters that fully discard a port when not matched, as done in
+     * apply_pre_probing_filters() */
+    mm_plugin_get_allowed_filters (self, filters, &probe_strings);
+    if (probe_strings) {
+        filters->vendor_ids = NULL;
+        filters->product_ids = NULL;
+        filters->subsystem_vendor_ids = NULL;
+    }
+}
+
+static gboolean
+index_query_has_tag (const gchar    *tag,
+                     MMKernelDevice *port)
+{
+    return mm_kernel_device_get_global_property_as_boolean (port, tag);
+}
+
+void
+mm_plugin_build_index_query (MMDevice           *device,
+                             MMKernelDevice     *port,
+                             MMPluginIndexQuery *query)
+{
+    static const gchar *virtual_drivers [] = { "virtual", NULL };
+
+    query->subsystem = mm_kernel_device_get_subsystem (port);
+    query->drivers = (is_virtual_port (mm_kernel_device_get_name (port)) ?
+                      virtual_drivers :
+                      mm_device_get_drivers (device));
+    query->vendor = mm_device_get_vendor (device);
+    query->product = mm_device_get_product (device);
+    query->has_tag = (MMPluginIndexHasTagFn) index_query_has_tag;
+    query->has_tag_user_data = port;
+}
+
+/*****************************************************************************/
+
 MMPluginSupportsHint
 mm_plugin_discard_port_early (MMPlugin       *self,
                               MMDevice       *device,
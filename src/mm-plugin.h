@@ -27,6 +27,7 @@
 #include "mm-port-probe.h"
 #include "mm-device.h"
 #include "mm-kernel-device.h"
+#include "mm-plugin-index.h"
 
 #define MM_PLUGIN_MAJOR_VERSION 5
 #define MM_PLUGIN_MINOR_VERSION 0
@@ -134,6 +135,18 @@ const mm_uint16_pair  *mm_plugin_get_allowed_product_ids          (MMPlugin *sel
 const mm_uint16_pair  *mm_plugin_get_allowed_subsystem_vendor_ids (MMPlugin *self);
 gboolean               mm_plugin_is_generic                       (MMPlugin *self);
 
+/* Filters to register the plugin in the preselection index, and query to
+ * look up the plugins that may support a port. The allowed filters include
+ * the vendor/product IDs also when they don't discard ports early. */
+void mm_plugin_get_allowed_filters (MMPlugin             *self,
+                                    MMPluginIndexFilters *filters,
+                                    gboolean             *probe_strings);
+void mm_plugin_get_index_filters   (MMPlugin             *self,
+                                    MMPluginIndexFilters *filters);
+void mm_plugin_build_index_query   (MMDevice             *device,
+                                    MMKernelDevice       *port,
+                                    MMPluginIndexQuery   *query);
+
 /* This method will run all pre-probing filters, to see if we can discard this
  * plugin from the probing logic as soon as possible. */
 MMPluginSupportsHint mm_plugin_discard_port_early (MMPlugin       *self,
@@ -28,6 +28,7 @@
 #include "mm-port-mbim.h"
 #include "mm-port-net.h"
 #include "mm-log-object.h"
+#include "mm-main-loop-profiler.h"
 
 G_DEFINE_TYPE (MMPortMbim, mm_port_mbim, MM_TYPE_PORT)
 
@@ -439,7 +440,11 @@ static void
 notification_cb (MMPortMbim  *self,
                  MbimMessage *notification)
 {
+    MMMainLoopProfilerScope scope;
+
+    mm_main_loop_profiler_begin (&scope, "mbim-notification", self);
     g_signal_emit (self, signals[SIGNAL_NOTIFICATION], 0, notification);
+    mm_main_loop_profiler_end (&scope);
 }
 
 static void
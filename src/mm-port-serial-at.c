@@ -408,6 +408,65 @@ iface_port_at_command (MMIfacePortAt        *self,
 
 /*****************************************************************************/
 
+void
+mm_port_serial_at_build_command_stats_key (const gchar *command,
+                                           gsize        command_len,
+                                           gchar       *key,
+                                           gsize        key_size)
+{
+    gsize i;
+    gsize n = 0;
+
+    g_assert (key_size > 0);
+
+    /* Raw data, e.g. SMS PDUs, is not a command */
+    if (command_len < 3 || g_ascii_strncasecmp (command, "AT", 2) != 0) {
+        g_strlcpy (key, "raw", key_size);
+        return;
+    }
+
+    /* Basic commands (e.g. ATD, ATE0, AT&F) are kept by their command letter
+     * only, so that dialed numbers or parameters don't end up in the key */
+    if (g_ascii_isalpha (command[2]) || (command[2] == '&' && command_len > 3)) {
+        for (i = 0; i < command_len && n + 1 < key_size; i++) {
+            key[n++] = g_ascii_toupper (command[i]);
+            if (g_ascii_isalpha (command[i]) && i >= 2)
+                break;
+        }
+        key[n] = '\0';
+        return;
+    }
+
+    /* Extended commands (e.g. AT+CREG?) are kept by name and type: set,
+     * query or test, but not their arguments */
+    for (i = 0; i < command_len && n + 1 < key_size; i++) {
+        gchar c = command[i];
+
+        if (c == '\r' || c == '\n' || c == ';')
+            break;
+        key[n++] = g_ascii_toupper (c);
+        if (c == '?')
+            break;
+        if (c == '=') {
+            if (i + 1 < command_len && command[i + 1] == '?' && n + 1 < key_size)
+                key[n++] = '?';
+            break;
+        }
+    }
+    key[n] = '\0';
+}
+
+static void
+build_command_stats_key (MMPortSerial     *self,
+                         const GByteArray *command,
+                         gchar            *key,
+                         gsize             key_size)
+{
+    mm_port_serial_at_build_command_stats_key ((const gchar *) command->data, command->len, key, key_size);
+}
+
+/*****************************************************************************/
+
 static void
 debug_log (MMPortSerial *self,
            const gchar  *prefix,
@@ -633,6 +692,7 @@ mm_port_serial_at_class_init (MMPortSerialAtClass *klass)
     serial_class->parse_response = parse_response;
     serial_class->debug_log = debug_log;
     serial_class->config = config;
+    serial_class->build_command_stats_key = build_command_stats_key;
 
     g_object_class_install_property
         (object_class, PROP_REMOVE_ECHO,
@@ -116,6 +116,13 @@ gchar *mm_port_serial_at_command_finish       (MMPortSerialAt *self,
                                                GAsyncResult *res,
                                                GError **error);
 
+/* Builds the key under which the statistics of the command are kept: the
+ * command name without arguments, or a generic key for raw data */
+void     mm_port_serial_at_build_command_stats_key (const gchar *command,
+                                                    gsize        command_len,
+                                                    gchar       *key,
+                                                    gsize        key_size);
+
 /* Just for unit tests */
 void     mm_port_serial_at_set_flags (MMPortSerialAt *self,
                                       MMPortSerialAtFlag flags);
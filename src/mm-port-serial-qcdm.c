@@ -41,32 +41,37 @@ struct _MMPortSerialQcdmPrivate {
 static gboolean
 find_qcdm_start (GByteArray *response, gsize *start)
 {
-    guint i;
-    gint  last = -1;
+    const guint8 *marker;
+    gsize         i = 0;
+    gint          last = -1;
 
     /* Look for 3 bytes and a QCDM frame marker, ie enough data for a valid
      * frame.  There will usually be three cases here; (1) a QCDM frame
      * starting with data and terminated by 0x7E, and (2) a QCDM frame starting
      * with 0x7E and ending with 0x7E, and (3) a non-QCDM frame that still
      * uses HDLC framing (like Sierra CnS) that starts and ends with 0x7E.
+     *
+     * Markers are looked for with memchr(), which is much faster than a
+     * bytewise loop on the long buffers seen while receiving log packets.
      */
-    for (i = 0; i < response->len; i++) {
-        /* Marker found */
-        if (response->data[i] == 0x7E) {
-            /* If we didn't get an initial marker, count at least 3 bytes since
-             * origin; if we did get an initial marker, count at least 3 bytes
-             * since the marker.
-             */
-            if (((last == -1) && (i >= 3)) || ((last >= 0) && (i > (guint)(last + 3)))) {
-                /* Got a full QCDM frame; 3 non-0x7E bytes and a terminator */
-                if (start)
-                    *start = last + 1;
-                return TRUE;
-            }
-
-            /* Save position of the last QCDM frame marker */
-            last = i;
+    while (i < response->len &&
+           (marker = memchr (&response->data[i], DIAG_CONTROL_CHAR, response->len - i)) != NULL) {
+        i = marker - response->data;
+
+        /* If we didn't get an initial marker, count at least 3 bytes since
+         * origin; if we did get an initial marker, count at least 3 bytes
+         * since the marker.
+         */
+        if (((last == -1) && (i >= 3)) || ((last >= 0) && (i > (gsize)(last + 3)))) {
+            /* Got a full QCDM frame; 3 non-0x7E bytes and a terminator */
+            if (start)
+                *start = last + 1;
+            return TRUE;
         }
+
+        /* Save position of the last QCDM frame marker */
+        last = i;
+        i++;
     }
     return FALSE;
 }
@@ -111,12 +116,14 @@ parse_qcdm (GByteArray *response,
     if (response->len == 0)
         return MM_PORT_SERIAL_RESPONSE_NONE;
 
-    /* Try to decapsulate the response into a buffer */
-    unescaped_buffer = g_malloc (1024);
+    /* Try to decapsulate the response into a buffer; the unescaped frame is
+     * never longer than the escaped data, so size the buffer after the input
+     * instead of using a fixed size that large log packets would overflow. */
+    unescaped_buffer = g_malloc (response->len);
     if (!dm_decapsulate_buffer ((const char *)(response->data),
                                 response->len,
                                 (char *)unescaped_buffer,
-                                1024,
+                                response->len,
                                 &unescaped_len,
                                 &used,
                                 &more)) {
@@ -148,7 +155,7 @@ parse_qcdm (GByteArray *response,
 
     /* Successfully decapsulated the DM command. We'll build a new byte array
      * with the response, and leave the input buffer cleaned up. */
-    g_assert (unescaped_len <= 1024);
+    g_assert (unescaped_len < response->len);
     unescaped_buffer = g_realloc (unescaped_buffer, unescaped_len);
     *parsed_response = g_byte_array_new_take (unescaped_buffer, unescaped_len);
 
@@ -221,6 +228,29 @@ mm_port_serial_qcdm_command (MMPortSerialQcdm *self,
                             task);
 }
 
+static void
+build_command_stats_key (MMPortSerial     *self,
+                         const GByteArray *command,
+                         gchar            *key,
+                         gsize             key_size)
+{
+    guint i = 0;
+    guint8 code;
+
+    /* Skip the leading frame marker, if any, and unescape the command code */
+    while (i < command->len && command->data[i] == 0x7E)
+        i++;
+    if (i >= command->len) {
+        g_strlcpy (key, "other", key_size);
+        return;
+    }
+    code = command->data[i];
+    if (code == 0x7D && i + 1 < command->len)
+        code = command->data[i + 1] ^ 0x20;
+
+    g_snprintf (key, key_size, "DM 0x%02x", code);
+}
+
 static void
 debug_log (MMPortSerial *self,
            const gchar  *prefix,
@@ -436,4 +466,5 @@ mm_port_serial_qcdm_class_init (MMPortSerialQcdmClass *klass)
     port_class->parse_response = parse_response;
     port_class->config_fd = config_fd;
     port_class->debug_log = debug_log;
+    port_class->build_command_stats_key = build_command_stats_key;
 }
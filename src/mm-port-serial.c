@@ -34,6 +34,7 @@
 #include <mm-errors-types.h>
 
 #include "mm-port-serial.h"
+#include "mm-main-loop-profiler.h"
 #include "mm-log-object.h"
 #include "mm-helper-enums-types.h"
 #include "mm-port-scheduler.h"
@@ -76,6 +77,12 @@ static guint signals[LAST_SIGNAL] = { 0 };
 
 #define SERIAL_BUF_SIZE 2048
 
+/* Command statistics are kept for this many different commands at most, any
+ * other one is accounted under a common key */
+#define COMMAND_STATS_KEY_SIZE  32
+#define COMMAND_STATS_MAX_KEYS  32
+#define COMMAND_STATS_OTHER_KEY "other"
+
 struct _MMPortSerialPrivate {
     guint32 open_count;
     gboolean forced_close;
@@ -113,6 +120,9 @@ struct _MMPortSerialPrivate {
 
     guint n_consecutive_timeouts;
 
+    /* Command key -> MMPortSerialCommandStats, created on first command */
+    GHashTable *command_stats;
+
     guint connected_id;
 
     GTask *flash_task;
@@ -127,9 +137,11 @@ typedef struct {
     guint32 timeout;
     gboolean allow_cached;
     guint32 eagain_count;
+    guint32 n_retries;
 
     guint32 idx;
     gboolean started;
+    gint64 started_time;
     gboolean done;
 } CommandContext;
 
@@ -522,6 +534,10 @@ serial_debug (MMPortSerial *self,
 {
     g_return_if_fail (len > 0);
 
+    /* Avoid building the printable string if it wouldn't be logged */
+    if (!mm_obj_log_enabled (self, MM_LOG_LEVEL_DEBUG))
+        return;
+
     if (MM_PORT_SERIAL_GET_CLASS (self)->debug_log)
         MM_PORT_SERIAL_GET_CLASS (self)->debug_log (self, prefix, buf, len);
 }
@@ -550,6 +566,7 @@ port_serial_process_command (MMPortSerial *self,
     /* Only print command the first time */
     if (ctx->started == FALSE) {
         ctx->started = TRUE;
+        ctx->started_time = g_get_monotonic_time ();
         serial_debug (self, "-->", (const gchar *) ctx->command->data, ctx->command->len);
     }
 
@@ -590,6 +607,7 @@ port_serial_process_command (MMPortSerial *self,
         case G_IO_STATUS_AGAIN:
             /* We're in a non-blocking channel and therefore we're up to receive
              * EAGAIN; just retry in this case. */
+            ctx->n_retries++;
             ctx->eagain_count--;
             if (ctx->eagain_count <= 0) {
                 /* If we reach the limit of EAGAIN errors, treat as a timeout error. */
@@ -626,6 +644,7 @@ port_serial_process_command (MMPortSerial *self,
 
             g_error_free (inner_error);
 
+            ctx->n_retries++;
             ctx->eagain_count--;
             if (ctx->eagain_count <= 0) {
                 /* If we reach the limit of EAGAIN errors, treat as a timeout error. */
@@ -697,14 +716,111 @@ port_serial_schedule_queue_process (MMPortSerial *self, guint timeout_ms)
         self->priv->queue_id = g_idle_add (port_serial_queue_process, self);
 }
 
+/*****************************************************************************/
+/* Command statistics */
+
+/* Each command type takes about 2 KiB, so only collected if enabled */
+static gboolean command_stats_enabled;
+
+void
+mm_port_serial_enable_command_stats (void)
+{
+    command_stats_enabled = TRUE;
+}
+
+static void
+default_build_command_stats_key (MMPortSerial     *self,
+                                 const GByteArray *command,
+                                 gchar            *key,
+                                 gsize             key_size)
+{
+    /* Binary protocols usually start the message with the command code */
+    if (command->len > 0)
+        g_snprintf (key, key_size, "0x%02x", command->data[0]);
+    else
+        g_strlcpy (key, COMMAND_STATS_OTHER_KEY, key_size);
+}
+
+static void
+port_serial_command_stats_record (MMPortSerial   *self,
+                                  CommandContext *ctx,
+                                  const GError   *error)
+{
+    MMPortSerialCommandStats *stats;
+    gchar                     key[COMMAND_STATS_KEY_SIZE];
+
+    /* Cached replies and cancelled commands tell nothing about the device */
+    if (!command_stats_enabled || !ctx->started || g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        return;
+
+    if (!self->priv->command_stats)
+        self->priv->command_stats = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+
+    MM_PORT_SERIAL_GET_CLASS (self)->build_command_stats_key (self, ctx->command, key, sizeof (key));
+
+    /* Only allocate the first time a command is seen */
+    stats = g_hash_table_lookup (self->priv->command_stats, key);
+    if (!stats) {
+        if (g_hash_table_size (self->priv->command_stats) >= COMMAND_STATS_MAX_KEYS)
+            g_strlcpy (key, COMMAND_STATS_OTHER_KEY, sizeof (key));
+        stats = g_hash_table_lookup (self->priv->command_stats, key);
+        if (!stats) {
+            stats = g_new0 (MMPortSerialCommandStats, 1);
+            g_hash_table_insert (self->priv->command_stats, g_strdup (key), stats);
+        }
+    }
+
+    stats->retries += ctx->n_retries;
+    if (g_error_matches (error, MM_SERIAL_ERROR, MM_SERIAL_ERROR_RESPONSE_TIMEOUT) ||
+        g_error_matches (error, MM_SERIAL_ERROR, MM_SERIAL_ERROR_SEND_TIMEOUT)) {
+        stats->timeouts++;
+        return;
+    }
+
+    if (error)
+        stats->errors++;
+
+    /* Error responses are still round trips to the device, but failures
+     * while sending aren't */
+    if (ctx->done)
+        mm_histogram_add (&stats->latency, (guint64) (g_get_monotonic_time () - ctx->started_time));
+}
+
+void
+mm_port_serial_command_stats_foreach (MMPortSerial                        *self,
+                                      MMPortSerialCommandStatsForeachFunc  func,
+                                      gpointer                             user_data)
+{
+    GHashTableIter iter;
+    gpointer       key;
+    gpointer       value;
+
+    g_return_if_fail (MM_IS_PORT_SERIAL (self));
+
+    if (!self->priv->command_stats)
+        return;
+
+    g_hash_table_iter_init (&iter, self->priv->command_stats);
+    while (g_hash_table_iter_next (&iter, &key, &value))
+        func ((const gchar *) key, (const MMPortSerialCommandStats *) value, user_data);
+}
+
+/*****************************************************************************/
+
 static void
 port_serial_got_response (MMPortSerial *self,
                           GByteArray   *parsed_response,
                           GError *error)
 {
+    GTask *head;
+
     /* Either one or the other, not both */
     g_assert ((parsed_response && !error) || (!parsed_response && error));
 
+    head = g_queue_peek_head (self->priv->queue);
+    if (head)
+        port_serial_command_stats_record (self, g_task_get_task_data (head), error);
+
     if (self->priv->timeout_id) {
         g_source_remove (self->priv->timeout_id);
         self->priv->timeout_id = 0;
@@ -758,8 +874,11 @@ static gboolean
 port_serial_timed_out (gpointer data)
 {
     MMPortSerial *self = MM_PORT_SERIAL (data);
+    MMMainLoopProfilerScope scope;
     GError *error;
 
+    mm_main_loop_profiler_begin (&scope, "serial-timeout", self);
+
     self->priv->timeout_id = 0;
 
     /* Update number of consecutive timeouts found */
@@ -783,6 +902,7 @@ port_serial_timed_out (gpointer data)
     }
     g_object_unref (self);
 
+    mm_main_loop_profiler_end (&scope);
     return G_SOURCE_REMOVE;
 }
 
@@ -1067,12 +1187,25 @@ common_input_available (MMPortSerial *self,
     return keep_source;
 }
 
+static gboolean
+profiled_input_available (MMPortSerial *self,
+                          GIOCondition condition)
+{
+    MMMainLoopProfilerScope scope;
+    gboolean keep_source;
+
+    mm_main_loop_profiler_begin (&scope, "serial-input", self);
+    keep_source = common_input_available (self, condition);
+    mm_main_loop_profiler_end (&scope);
+    return keep_source;
+}
+
 static gboolean
 iochannel_input_available (GIOChannel *iochannel,
                            GIOCondition condition,
                            gpointer data)
 {
-    return common_input_available (MM_PORT_SERIAL (data), condition);
+    return profiled_input_available (MM_PORT_SERIAL (data), condition);
 }
 
 static gboolean
@@ -1080,7 +1213,7 @@ socket_input_available (GSocket *socket,
                         GIOCondition condition,
                         gpointer data)
 {
-    return common_input_available (MM_PORT_SERIAL (data), condition);
+    return profiled_input_available (MM_PORT_SERIAL (data), condition);
 }
 
 static void
@@ -2199,6 +2332,8 @@ finalize (GObject *object)
 
     g_hash_table_destroy (self->priv->reply_cache);
     g_queue_free (self->priv->queue);
+    if (self->priv->command_stats)
+        g_hash_table_destroy (self->priv->command_stats);
 
     G_OBJECT_CLASS (mm_port_serial_parent_class)->finalize (object);
 }
@@ -2218,6 +2353,7 @@ mm_port_serial_class_init (MMPortSerialClass *klass)
     object_class->finalize     = finalize;
 
     klass->config_fd = real_config_fd;
+    klass->build_command_stats_key = default_build_command_stats_key;
 
     /* Properties */
     g_object_class_install_property
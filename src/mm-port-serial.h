@@ -22,6 +22,7 @@
 #include <gio/gio.h>
 
 #include "mm-modem-helpers.h"
+#include "mm-histogram.h"
 #include "mm-port.h"
 
 #define MM_TYPE_PORT_SERIAL            (mm_port_serial_get_type ())
@@ -54,6 +55,14 @@ typedef enum {
     MM_PORT_SERIAL_FLUSH_BOTH,
 } MMPortSerialFlushType;
 
+/* Statistics kept for each type of command sent through the port */
+typedef struct {
+    MMHistogram latency;  /* us, until a response or error response is received */
+    guint64     errors;   /* error responses and send failures */
+    guint64     timeouts; /* no response, or unable to send the command */
+    guint64     retries;  /* writes retried because the port was busy (EAGAIN) */
+} MMPortSerialCommandStats;
+
 typedef struct _MMPortSerial MMPortSerial;
 typedef struct _MMPortSerialClass MMPortSerialClass;
 typedef struct _MMPortSerialPrivate MMPortSerialPrivate;
@@ -107,6 +116,14 @@ struct _MMPortSerialClass {
                                    const gchar  *buf,
                                    gsize         len);
 
+    /* Called to build the key under which the statistics of a command are
+     * kept, e.g. the command name without its arguments. The key must be a
+     * NUL-terminated string fitting in @key_size bytes. */
+    void (*build_command_stats_key) (MMPortSerial     *self,
+                                     const GByteArray *command,
+                                     gchar            *key,
+                                     gsize             key_size);
+
     /* Signals */
     void (*buffer_full)           (MMPortSerial *port, const GByteArray *buffer);
     void (*forced_close)          (MMPortSerial *port);
@@ -168,4 +185,15 @@ gboolean mm_port_serial_set_flow_control (MMPortSerial   *self,
                                           GError        **error);
 
 MMFlowControl mm_port_serial_get_flow_control (MMPortSerial *self);
+
+/* Command statistics are only collected once enabled, for all ports */
+void mm_port_serial_enable_command_stats (void);
+
+typedef void (* MMPortSerialCommandStatsForeachFunc) (const gchar                    *command,
+                                                      const MMPortSerialCommandStats *stats,
+                                                      gpointer                        user_data);
+
+void mm_port_serial_command_stats_foreach (MMPortSerial                        *self,
+                                           MMPortSerialCommandStatsForeachFunc  func,
+                                           gpointer                             user_data);
 #endif /* MM_PORT_SERIAL_H */
@@ -106,6 +106,12 @@ typedef struct {
     gulong     uim_slot_status_indication_id;
     gulong     uim_refresh_indication_id;
     guint      uim_refresh_start_timeout_id;
+    gulong     uim_card_status_indication_id;
+
+    /* Card status cache */
+    QmiMessageUimGetCardStatusOutput *card_status;
+    GList                            *card_status_tasks;
+    guint                             card_status_generation;
 
     /* Cached last location from nmea */
     MMLocationCache *location_cache;
@@ -138,6 +144,11 @@ private_free (Private *priv)
         g_array_unref (priv->slots_status);
     if (priv->uim_refresh_indication_id)
         g_signal_handler_disconnect (priv->uim_client, priv->uim_refresh_indication_id);
+    if (priv->uim_card_status_indication_id)
+        g_signal_handler_disconnect (priv->uim_client, priv->uim_card_status_indication_id);
+    g_assert (!priv->card_status_tasks);
+    if (priv->card_status)
+        qmi_message_uim_get_card_status_output_unref (priv->card_status);
     if (priv->uim_client)
         g_object_unref (priv->uim_client);
     if (priv->uim_refresh_start_timeout_id)
@@ -3625,6 +3636,144 @@ mm_shared_qmi_set_primary_sim_slot (MMIfaceModem        *self,
                                     task);
 }
 
+/*****************************************************************************/
+/* UIM card status */
+
+typedef struct {
+    MMSharedQmi *self;
+    guint        generation;
+} GetCardStatusContext;
+
+void
+mm_shared_qmi_uim_card_status_invalidate (MMSharedQmi *self)
+{
+    Private *priv;
+
+    priv = get_private (self);
+    if (priv->card_status) {
+        mm_obj_dbg (self, "UIM card status cache invalidated");
+        g_clear_pointer (&priv->card_status, qmi_message_uim_get_card_status_output_unref);
+    }
+    /* Also make sure the result of any ongoing request isn't cached */
+    priv->card_status_generation++;
+}
+
+QmiMessageUimGetCardStatusOutput *
+mm_shared_qmi_uim_get_card_status_finish (MMSharedQmi   *self,
+                                          GAsyncResult  *res,
+                                          GError       **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+uim_get_card_status_ready (QmiClientUim         *client,
+                           GAsyncResult         *res,
+                           GetCardStatusContext *ctx)
+{
+    g_autoptr(QmiMessageUimGetCardStatusOutput)  output = NULL;
+    g_autoptr(GError)                            error = NULL;
+    MMSharedQmi                                 *self;
+    Private                                     *priv;
+    GList                                       *tasks;
+    GList                                       *l;
+
+    self = ctx->self;
+    priv = get_private (self);
+
+    output = qmi_client_uim_get_card_status_finish (client, res, &error);
+    if (output && !qmi_message_uim_get_card_status_output_get_result (output, &error))
+        g_clear_pointer (&output, qmi_message_uim_get_card_status_output_unref);
+
+    /* The result is cached only if we're going to be notified when it changes,
+     * and only if the card is ready; transient states (e.g. card not yet
+     * detected after power on) are always queried again. */
+    if (output &&
+        priv->uim_card_status_indication_id &&
+        priv->card_status_generation == ctx->generation &&
+        mm_qmi_uim_get_card_status_output_parse (self, output, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL)) {
+        g_assert (!priv->card_status);
+        priv->card_status = qmi_message_uim_get_card_status_output_ref (output);
+    }
+
+    tasks = g_steal_pointer (&priv->card_status_tasks);
+    for (l = tasks; l; l = g_list_next (l)) {
+        GTask *task = l->data;
+
+        if (output)
+            g_task_return_pointer (task,
+                                   qmi_message_uim_get_card_status_output_ref (output),
+                                   (GDestroyNotify) qmi_message_uim_get_card_status_output_unref);
+        else
+            g_task_return_error (task, g_error_copy (error));
+        g_object_unref (task);
+    }
+    g_list_free (tasks);
+
+    g_object_unref (ctx->self);
+    g_slice_free (GetCardStatusContext, ctx);
+}
+
+void
+mm_shared_qmi_uim_get_card_status (MMSharedQmi         *self,
+                                   GCancellable        *cancellable,
+                                   GAsyncReadyCallback  callback,
+                                   gpointer             user_data)
+{
+    GetCardStatusContext *ctx;
+    QmiClient            *client;
+    Private              *priv;
+    GTask                *task;
+    GError               *error = NULL;
+
+    priv = get_private (self);
+    task = g_task_new (self, cancellable, callback, user_data);
+
+    if (priv->card_status) {
+        mm_obj_dbg (self, "UIM card status loaded from cache");
+        g_task_return_pointer (task,
+                               qmi_message_uim_get_card_status_output_ref (priv->card_status),
+                               (GDestroyNotify) qmi_message_uim_get_card_status_output_unref);
+        g_object_unref (task);
+        return;
+    }
+
+    /* Request already ongoing, wait for it */
+    if (priv->card_status_tasks) {
+        priv->card_status_tasks = g_list_append (priv->card_status_tasks, task);
+        return;
+    }
+
+    client = mm_shared_qmi_peek_client (self, QMI_SERVICE_UIM, MM_PORT_QMI_FLAG_DEFAULT, &error);
+    if (!client) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    priv->card_status_tasks = g_list_append (NULL, task);
+
+    /* The operation is shared among all requesters, so it is never cancelled */
+    ctx = g_slice_new0 (GetCardStatusContext);
+    ctx->self = g_object_ref (self);
+    ctx->generation = priv->card_status_generation;
+    qmi_client_uim_get_card_status (QMI_CLIENT_UIM (client),
+                                    NULL,
+                                    5,
+                                    NULL,
+                                    (GAsyncReadyCallback) uim_get_card_status_ready,
+                                    ctx);
+}
+
+static void
+uim_card_status_indication_cb (QmiClientUim                     *client,
+                               QmiIndicationUimCardStatusOutput *output,
+                               MMSharedQmi                      *self)
+{
+    mm_obj_dbg (self, "received card status indication");
+    mm_shared_qmi_uim_card_status_invalidate (self);
+}
+
 /*****************************************************************************/
 /* UIM refresh indication handling */
 
@@ -3704,6 +3853,8 @@ uim_refresh_indication_cb (QmiClientUim                  *client,
                 qmi_uim_refresh_stage_get_string (stage),
                 qmi_uim_refresh_mode_get_string (mode));
 
+    mm_shared_qmi_uim_card_status_invalidate (self);
+
     /* Support only the first slot for now. Primary GW provisioning is used in old modems. */
     if (session_type != QMI_UIM_SESSION_TYPE_CARD_SLOT_1 &&
         session_type != QMI_UIM_SESSION_TYPE_PRIMARY_GW_PROVISIONING) {
@@ -3856,6 +4007,8 @@ uim_slot_status_indication_cb (QmiClientUim                     *client,
     priv = get_private (self);
     mm_obj_dbg (self, "received slot status indication");
 
+    mm_shared_qmi_uim_card_status_invalidate (self);
+
     if (!priv->slots_status) {
         mm_obj_dbg (self, "initial slot status is not loaded yet");
         return;
@@ -3910,6 +4063,8 @@ typedef enum {
     SETUP_SIM_HOT_SWAP_STEP_UIM_REGISTER_SLOT_STATUS,
     SETUP_SIM_HOT_SWAP_STEP_UIM_CHECK_SLOT_STATUS,
     SETUP_SIM_HOT_SWAP_STEP_UIM_SLOT_STATUS_INDICATION,
+    SETUP_SIM_HOT_SWAP_STEP_UIM_REGISTER_CARD_STATUS,
+    SETUP_SIM_HOT_SWAP_STEP_UIM_CARD_STATUS_INDICATION,
     SETUP_SIM_HOT_SWAP_STEP_UIM_REFRESH_REGISTER_ALL,
     SETUP_SIM_HOT_SWAP_STEP_UIM_REFRESH_REGISTER_ICCID,
     SETUP_SIM_HOT_SWAP_STEP_UIM_REFRESH_REGISTER_IMSI,
@@ -3921,11 +4076,13 @@ typedef struct {
     SetupSimHotSwapStep step;
     gboolean            register_slot_status_supported;
     gboolean            get_slot_status_supported;
+    gboolean            register_card_status_supported;
     gboolean            refresh_all_supported;
     gboolean            refresh_file_supported;
     QmiClient          *uim_client;
     gulong              uim_slot_status_indication_id;
     gulong              uim_refresh_indication_id;
+    gulong              uim_card_status_indication_id;
 } SetupSimHotSwapContext;
 
 static void setup_sim_hot_swap_step (GTask *task);
@@ -3937,6 +4094,8 @@ setup_sim_hot_swap_context_free (SetupSimHotSwapContext *ctx)
         g_signal_handler_disconnect (ctx->uim_client, ctx->uim_slot_status_indication_id);
     if (ctx->uim_client && ctx->uim_refresh_indication_id)
         g_signal_handler_disconnect (ctx->uim_client, ctx->uim_refresh_indication_id);
+    if (ctx->uim_client && ctx->uim_card_status_indication_id)
+        g_signal_handler_disconnect (ctx->uim_client, ctx->uim_card_status_indication_id);
     g_clear_object (&ctx->uim_client);
     g_slice_free (SetupSimHotSwapContext, ctx);
 }
@@ -4093,6 +4252,34 @@ uim_check_get_slot_status_ready (QmiClientUim *client,
     setup_sim_hot_swap_step (task);
 }
 
+static void
+uim_register_card_status_events_ready (QmiClientUim *client,
+                                       GAsyncResult *res,
+                                       GTask        *task)
+{
+    g_autoptr(QmiMessageUimRegisterEventsOutput)  output = NULL;
+    g_autoptr(GError)                             error = NULL;
+    MMIfaceModem                                 *self;
+    SetupSimHotSwapContext                       *ctx;
+
+    self = g_task_get_source_object (task);
+    ctx  = g_task_get_task_data (task);
+
+    /* If event registration fails, go on with initialization. In that case
+     * the card status will not be cached. */
+    output = qmi_client_uim_register_events_finish (client, res, &error);
+    if (!output || !qmi_message_uim_register_events_output_get_result (output, &error)) {
+        mm_obj_dbg (self, "not registered for card status indications: %s", error->message);
+    } else {
+        mm_obj_dbg (self, "registered for card status indications");
+        ctx->register_card_status_supported = TRUE;
+    }
+
+    /* Go on to next step */
+    ctx->step++;
+    setup_sim_hot_swap_step (task);
+}
+
 static void
 uim_register_events_ready (QmiClientUim *client,
                            GAsyncResult *res,
@@ -4189,6 +4376,42 @@ setup_sim_hot_swap_step (GTask *task)
         ctx->step++;
         /* fall-through */
 
+    case SETUP_SIM_HOT_SWAP_STEP_UIM_REGISTER_CARD_STATUS: {
+        g_autoptr(QmiMessageUimRegisterEventsInput) register_events_input = NULL;
+        QmiUimEventRegistrationFlag                 mask;
+
+        mm_obj_dbg (self, "setup SIM hot swap (%u/%u): registering for card status indications...",
+                    ctx->step, SETUP_SIM_HOT_SWAP_STEP_LAST);
+        /* The registration mask replaces the previous one, so keep the slot
+         * status indications enabled if already registered */
+        mask = QMI_UIM_EVENT_REGISTRATION_FLAG_CARD_STATUS;
+        if (ctx->register_slot_status_supported)
+            mask |= QMI_UIM_EVENT_REGISTRATION_FLAG_PHYSICAL_SLOT_STATUS;
+        register_events_input = qmi_message_uim_register_events_input_new ();
+        qmi_message_uim_register_events_input_set_event_registration_mask (register_events_input, mask, NULL);
+        qmi_client_uim_register_events (QMI_CLIENT_UIM (ctx->uim_client),
+                                        register_events_input,
+                                        10,
+                                        NULL,
+                                        (GAsyncReadyCallback) uim_register_card_status_events_ready,
+                                        task);
+        return;
+    }
+
+    case SETUP_SIM_HOT_SWAP_STEP_UIM_CARD_STATUS_INDICATION:
+        if (ctx->register_card_status_supported) {
+            mm_obj_dbg (self, "setup SIM hot swap (%u/%u): monitoring card status indications...",
+                        ctx->step, SETUP_SIM_HOT_SWAP_STEP_LAST);
+            ctx->uim_card_status_indication_id = g_signal_connect (ctx->uim_client,
+                                                                   "card-status",
+                                                                   G_CALLBACK (uim_card_status_indication_cb),
+                                                                   self);
+        } else
+            mm_obj_dbg (self, "setup SIM hot swap (%u/%u): no need to monitor for card status indications...",
+                        ctx->step, SETUP_SIM_HOT_SWAP_STEP_LAST);
+        ctx->step++;
+        /* fall-through */
+
     case SETUP_SIM_HOT_SWAP_STEP_UIM_REFRESH_REGISTER_ALL: {
         g_autoptr(QmiMessageUimRefreshRegisterAllInput) refresh_register_all_input = NULL;
         g_autoptr(GArray)                               placeholder_aid = NULL;
@@ -4279,6 +4502,11 @@ setup_sim_hot_swap_step (GTask *task)
                 priv->uim_refresh_indication_id = ctx->uim_refresh_indication_id;
                 ctx->uim_refresh_indication_id = 0;
             }
+            if (ctx->uim_card_status_indication_id) {
+                g_assert (!priv->uim_card_status_indication_id);
+                priv->uim_card_status_indication_id = ctx->uim_card_status_indication_id;
+                ctx->uim_card_status_indication_id = 0;
+            }
             mm_obj_dbg (self, "setup SIM hot swap (%u/%u): successfully finished",
                         ctx->step, SETUP_SIM_HOT_SWAP_STEP_LAST);
             g_task_return_boolean (task, TRUE);
@@ -200,6 +200,18 @@ gboolean           mm_shared_qmi_setup_sim_hot_swap_finish          (MMIfaceMode
                                                                      GAsyncResult         *res,
                                                                      GError              **error);
 
+/* UIM card status, shared by all users in the modem. Concurrent requests are
+ * served by a single Get Card Status operation, and the result is cached
+ * until card status changes are reported by the device. */
+void                              mm_shared_qmi_uim_get_card_status        (MMSharedQmi          *self,
+                                                                            GCancellable         *cancellable,
+                                                                            GAsyncReadyCallback   callback,
+                                                                            gpointer              user_data);
+QmiMessageUimGetCardStatusOutput *mm_shared_qmi_uim_get_card_status_finish (MMSharedQmi          *self,
+                                                                            GAsyncResult         *res,
+                                                                            GError              **error);
+void                              mm_shared_qmi_uim_card_status_invalidate (MMSharedQmi          *self);
+
 /* Shared QMI location support */
 
 void                               mm_shared_qmi_location_load_capabilities                     (MMIfaceModemLocation   *self,
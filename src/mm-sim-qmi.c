@@ -51,6 +51,24 @@ struct _MMSimQmiPrivate {
 static const guint16 mf_file_path[]  = { 0x3F00 };
 static const guint16 adf_file_path[] = { 0x3F00, 0x7FFF };
 
+#define FILE_ID_ICCID 0x2FE2
+#define FILE_ID_IMSI  0x6F07
+#define FILE_ID_AD    0x6FAD
+#define FILE_ID_SPN   0x6F46
+#define FILE_ID_GID1  0x6F3E
+#define FILE_ID_GID2  0x6F3F
+
+/* Only files that are never updated by us can be cached; the ICCID and
+ * IMSI are the cache key themselves, so they must always be read. */
+static gboolean
+file_id_is_cacheable (guint16 file_id)
+{
+    return (file_id == FILE_ID_AD   ||
+            file_id == FILE_ID_SPN  ||
+            file_id == FILE_ID_GID1 ||
+            file_id == FILE_ID_GID2);
+}
+
 /*****************************************************************************/
 
 static gboolean
@@ -88,6 +106,18 @@ ensure_qmi_client (GTask       *task,
     return TRUE;
 }
 
+static void
+card_status_invalidate (MMSimQmi *self)
+{
+    g_autoptr(MMBaseModem) modem = NULL;
+
+    g_object_get (self,
+                  MM_BASE_SIM_MODEM, &modem,
+                  NULL);
+    if (modem)
+        mm_shared_qmi_uim_card_status_invalidate (MM_SHARED_QMI (modem));
+}
+
 /*****************************************************************************/
 /* Wait for SIM ready */
 
@@ -95,14 +125,14 @@ ensure_qmi_client (GTask       *task,
 #define SIM_READY_CHECKS_TIMEOUT_SECS 1
 
 typedef struct {
-    QmiClient *client_uim;
-    guint      ready_checks_n;
+    MMBaseModem *modem;
+    guint        ready_checks_n;
 } WaitSimReadyContext;
 
 static void
 wait_sim_ready_context_free (WaitSimReadyContext *ctx)
 {
-    g_clear_object (&ctx->client_uim);
+    g_clear_object (&ctx->modem);
     g_slice_free (WaitSimReadyContext, ctx);
 }
 
@@ -130,7 +160,7 @@ sim_ready_retry (GTask *task)
 }
 
 static void
-uim_get_card_status_ready (QmiClientUim *client,
+uim_get_card_status_ready (MMSharedQmi  *modem,
                            GAsyncResult *res,
                            GTask        *task)
 {
@@ -140,9 +170,8 @@ uim_get_card_status_ready (QmiClientUim *client,
 
     self = g_task_get_source_object (task);
 
-    output = qmi_client_uim_get_card_status_finish (client, res, &error);
+    output = mm_shared_qmi_uim_get_card_status_finish (modem, res, &error);
     if (!output ||
-        !qmi_message_uim_get_card_status_output_get_result (output, &error) ||
         (!mm_qmi_uim_get_card_status_output_parse (self, output, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &error) &&
          (g_error_matches (error, MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_SIM_NOT_INSERTED) ||
           g_error_matches (error, MM_CORE_ERROR, MM_CORE_ERROR_RETRY)))) {
@@ -175,12 +204,10 @@ sim_ready_check (GTask *task)
     }
 
     mm_obj_dbg (self, "checking SIM readiness");
-    qmi_client_uim_get_card_status (QMI_CLIENT_UIM (ctx->client_uim),
-                                    NULL,
-                                    5,
-                                    NULL,
-                                    (GAsyncReadyCallback) uim_get_card_status_ready,
-                                    task);
+    mm_shared_qmi_uim_get_card_status (MM_SHARED_QMI (ctx->modem),
+                                       NULL,
+                                       (GAsyncReadyCallback) uim_get_card_status_ready,
+                                       task);
 }
 
 static void
@@ -207,7 +234,9 @@ wait_sim_ready (MMBaseSim           *_self,
         return;
 
     ctx = g_slice_new0 (WaitSimReadyContext);
-    ctx->client_uim = g_object_ref (client);
+    g_object_get (self,
+                  MM_BASE_SIM_MODEM, &ctx->modem,
+                  NULL);
     g_task_set_task_data (task, ctx, (GDestroyNotify) wait_sim_ready_context_free);
 
     sim_ready_check (task);
@@ -231,6 +260,9 @@ uim_read_ready (QmiClientUim *client,
 {
     QmiMessageUimReadTransparentOutput *output;
     GError *error = NULL;
+    guint16 file_id;
+
+    file_id = GPOINTER_TO_UINT (g_task_get_task_data (task));
 
     output = qmi_client_uim_read_transparent_finish (client, res, &error);
     if (!output) {
@@ -243,6 +275,11 @@ uim_read_ready (QmiClientUim *client,
         GArray *read_result = NULL;
 
         qmi_message_uim_read_transparent_output_get_read_result (output, &read_result, NULL);
+        if (read_result && file_id_is_cacheable (file_id))
+            mm_base_sim_store_file (MM_BASE_SIM (g_task_get_source_object (task)),
+                                    file_id,
+                                    (const guint8 *) read_result->data,
+                                    read_result->len);
         if (read_result)
             g_task_return_pointer (task,
                                    g_array_ref (read_result),
@@ -277,6 +314,23 @@ uim_read (MMSimQmi            *self,
 
     task = g_task_new (self, NULL, callback, user_data);
 
+    if (file_id_is_cacheable (file_id)) {
+        g_autoptr(GBytes)  contents = NULL;
+        const guint8      *data;
+        gsize              data_len;
+
+        contents = mm_base_sim_lookup_file (MM_BASE_SIM (self), file_id);
+        if (contents) {
+            data = g_bytes_get_data (contents, &data_len);
+            g_task_return_pointer (task,
+                                   g_array_append_vals (g_array_sized_new (FALSE, FALSE, 1, data_len), data, data_len),
+                                   (GDestroyNotify) g_array_unref);
+            g_object_unref (task);
+            return;
+        }
+    }
+    g_task_set_task_data (task, GUINT_TO_POINTER (file_id), NULL);
+
     if (!ensure_qmi_client (task,
                             self,
                             QMI_SERVICE_UIM, &client))
@@ -359,7 +413,7 @@ uim_get_iccid (MMSimQmi *self,
                GTask    *task)
 {
     uim_read (self,
-              0x2FE2,
+              FILE_ID_ICCID,
               mf_file_path,
               G_N_ELEMENTS (mf_file_path),
               (GAsyncReadyCallback)uim_get_iccid_ready,
@@ -489,7 +543,7 @@ uim_get_imsi (MMSimQmi *self,
               GTask    *task)
 {
     uim_read (self,
-              0x6F07,
+              FILE_ID_IMSI,
               adf_file_path,
               G_N_ELEMENTS (adf_file_path),
               (GAsyncReadyCallback)uim_get_imsi_ready,
@@ -631,7 +685,7 @@ load_gid1 (MMBaseSim           *self,
            GAsyncReadyCallback  callback,
            gpointer             user_data)
 {
-    common_load_gid (self, 0x6F3E, callback, user_data);
+    common_load_gid (self, FILE_ID_GID1, callback, user_data);
 }
 
 static GByteArray *
@@ -647,7 +701,7 @@ load_gid2 (MMBaseSim           *self,
            GAsyncReadyCallback  callback,
            gpointer             user_data)
 {
-    common_load_gid (self, 0x6F3F, callback, user_data);
+    common_load_gid (self, FILE_ID_GID2, callback, user_data);
 }
 
 /*****************************************************************************/
@@ -712,7 +766,7 @@ load_operator_identifier (MMBaseSim           *_self,
     }
 
     uim_read (self,
-              0x6FAD,
+              FILE_ID_AD,
               adf_file_path,
               G_N_ELEMENTS (adf_file_path),
               (GAsyncReadyCallback)uim_read_efad_ready,
@@ -770,13 +824,93 @@ load_operator_name (MMBaseSim           *_self,
     mm_obj_dbg (self, "loading SIM operator name...");
 
     uim_read (self,
-              0x6F46,
+              FILE_ID_SPN,
               adf_file_path,
               G_N_ELEMENTS (adf_file_path),
               (GAsyncReadyCallback)uim_read_efspn_ready,
               task);
 }
 
+/*****************************************************************************/
+/* Prefetch files */
+
+static gboolean
+prefetch_files_finish (MMBaseSim     *self,
+                       GAsyncResult  *res,
+                       GError       **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+prefetch_file_ready (MMSimQmi     *self,
+                     GAsyncResult *res,
+                     GTask        *task)
+{
+    g_autoptr(GArray)  read_result = NULL;
+    g_autoptr(GError)  error = NULL;
+    guint             *n_pending;
+
+    /* Errors are ignored here, the file will be read again when loading the
+     * specific property and the error reported there */
+    read_result = uim_read_finish (NULL, res, &error);
+    if (!read_result)
+        mm_obj_dbg (self, "couldn't prefetch SIM file: %s", error->message);
+
+    n_pending = g_task_get_task_data (task);
+    g_assert (*n_pending > 0);
+    if (--(*n_pending) == 0)
+        g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+static void
+prefetch_files (MMBaseSim           *_self,
+                GAsyncReadyCallback  callback,
+                gpointer             user_data)
+{
+    MMSimQmi *self;
+    GTask    *task;
+    guint16   file_ids[4];
+    guint     n_file_ids = 0;
+    guint    *n_pending;
+    guint     i;
+
+    self = MM_SIM_QMI (_self);
+    task = g_task_new (self, NULL, callback, user_data);
+
+    /* Plan all the reads required by the remaining load operations */
+    if (!mm_gdbus_sim_get_operator_identifier (MM_GDBUS_SIM (self)) && self->priv->imsi)
+        file_ids[n_file_ids++] = FILE_ID_AD;
+    if (!mm_gdbus_sim_get_operator_name (MM_GDBUS_SIM (self)))
+        file_ids[n_file_ids++] = FILE_ID_SPN;
+    if (!mm_gdbus_sim_get_gid1 (MM_GDBUS_SIM (self)))
+        file_ids[n_file_ids++] = FILE_ID_GID1;
+    if (!mm_gdbus_sim_get_gid2 (MM_GDBUS_SIM (self)))
+        file_ids[n_file_ids++] = FILE_ID_GID2;
+
+    if (!n_file_ids) {
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+        return;
+    }
+
+    /* All requests are sent right away, without waiting for the previous
+     * ones to finish; the responses are stored in the file cache */
+    mm_obj_dbg (self, "prefetching %u SIM files...", n_file_ids);
+    n_pending = g_new (guint, 1);
+    *n_pending = n_file_ids;
+    g_task_set_task_data (task, n_pending, g_free);
+    for (i = 0; i < n_file_ids; i++)
+        uim_read (self,
+                  file_ids[i],
+                  adf_file_path,
+                  G_N_ELEMENTS (adf_file_path),
+                  (GAsyncReadyCallback)prefetch_file_ready,
+                  g_object_ref (task));
+    g_object_unref (task);
+}
+
 /*****************************************************************************/
 /* Load preferred networks */
 
@@ -1139,6 +1273,8 @@ send_pin_finish (MMBaseSim     *self,
                  GAsyncResult  *res,
                  GError       **error)
 {
+    /* The card status changes after any PIN operation, even failed ones */
+    card_status_invalidate (MM_SIM_QMI (self));
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
@@ -1297,6 +1433,8 @@ send_puk_finish (MMBaseSim     *self,
                  GAsyncResult  *res,
                  GError       **error)
 {
+    /* The card status changes after any PIN operation, even failed ones */
+    card_status_invalidate (MM_SIM_QMI (self));
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
@@ -1467,6 +1605,8 @@ change_pin_finish (MMBaseSim     *self,
                    GAsyncResult  *res,
                    GError       **error)
 {
+    /* The card status changes after any PIN operation, even failed ones */
+    card_status_invalidate (MM_SIM_QMI (self));
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
@@ -1636,6 +1776,8 @@ enable_pin_finish (MMBaseSim *self,
                    GAsyncResult *res,
                    GError **error)
 {
+    /* The card status changes after any PIN operation, even failed ones */
+    card_status_invalidate (MM_SIM_QMI (self));
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
@@ -1941,6 +2083,8 @@ mm_sim_qmi_class_init (MMSimQmiClass *klass)
     base_sim_class->load_gid1_finish = load_gid1_finish;
     base_sim_class->load_gid2 = load_gid2;
     base_sim_class->load_gid2_finish = load_gid2_finish;
+    base_sim_class->prefetch_files = prefetch_files;
+    base_sim_class->prefetch_files_finish = prefetch_files_finish;
     base_sim_class->load_preferred_networks = load_preferred_networks;
     base_sim_class->load_preferred_networks_finish = load_preferred_networks_finish;
     base_sim_class->set_preferred_networks = set_preferred_networks;
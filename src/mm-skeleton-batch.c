@@ -0,0 +1,89 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include "mm-skeleton-batch.h"
+
+static GQuark batch_quark;
+
+typedef struct {
+    guint    depth;
+    gboolean flush_pending;
+} Batch;
+
+static Batch *
+get_batch (gpointer skeleton,
+           gboolean create)
+{
+    Batch *batch;
+
+    if (G_UNLIKELY (!batch_quark))
+        batch_quark = g_quark_from_static_string ("mm-skeleton-batch");
+
+    batch = g_object_get_qdata (G_OBJECT (skeleton), batch_quark);
+    if (!batch && create) {
+        batch = g_slice_new0 (Batch);
+        g_object_set_qdata (G_OBJECT (skeleton), batch_quark, batch);
+    }
+    return batch;
+}
+
+void
+mm_skeleton_batch_begin (gpointer skeleton)
+{
+    Batch *batch;
+
+    g_return_if_fail (G_IS_DBUS_INTERFACE_SKELETON (skeleton));
+
+    batch = get_batch (skeleton, TRUE);
+    batch->depth++;
+}
+
+void
+mm_skeleton_batch_end (gpointer skeleton)
+{
+    Batch    *batch;
+    gboolean  flush;
+
+    g_return_if_fail (G_IS_DBUS_INTERFACE_SKELETON (skeleton));
+
+    batch = get_batch (skeleton, FALSE);
+    g_return_if_fail (batch && batch->depth > 0);
+
+    if (--batch->depth > 0)
+        return;
+
+    flush = batch->flush_pending;
+    g_object_set_qdata (G_OBJECT (skeleton), batch_quark, NULL);
+    g_slice_free (Batch, batch);
+
+    if (flush)
+        g_dbus_interface_skeleton_flush (G_DBUS_INTERFACE_SKELETON (skeleton));
+}
+
+void
+mm_skeleton_batch_flush (gpointer skeleton)
+{
+    Batch *batch;
+
+    g_return_if_fail (G_IS_DBUS_INTERFACE_SKELETON (skeleton));
+
+    batch = get_batch (skeleton, FALSE);
+    if (batch) {
+        batch->flush_pending = TRUE;
+        return;
+    }
+
+    g_dbus_interface_skeleton_flush (G_DBUS_INTERFACE_SKELETON (skeleton));
+}
@@ -0,0 +1,39 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#ifndef MM_SKELETON_BATCH_H
+#define MM_SKELETON_BATCH_H
+
+#include <glib.h>
+#include <gio/gio.h>
+
+/* Property change batching in D-Bus interface skeletons.
+ *
+ * The skeletons already coalesce all the property changes done in the same
+ * main loop iteration into one single PropertiesChanged signal, unless they
+ * are explicitly flushed. Within a batch, explicit flush requests done with
+ * mm_skeleton_batch_flush() are deferred until the outermost batch ends, so
+ * that a multi-step update ends up emitting one single signal per interface.
+ *
+ * Flushes that must happen before emitting some other signal (e.g. the
+ * state before StateChanged) should keep on using
+ * g_dbus_interface_skeleton_flush() directly.
+ */
+
+void mm_skeleton_batch_begin (gpointer skeleton);
+void mm_skeleton_batch_end   (gpointer skeleton);
+void mm_skeleton_batch_flush (gpointer skeleton);
+
+#endif /* MM_SKELETON_BATCH_H */
@@ -134,13 +134,11 @@ sms_decode_address (const guint8  *address,
     address++;
 
     if (addrtype == SMS_NUMBER_TYPE_ALPHA) {
-        g_autoptr(GByteArray)  unpacked_array = NULL;
-        guint8                *unpacked = NULL;
-        guint32                unpacked_len;
+        g_autofree guint8 *unpacked = NULL;
+        guint32            unpacked_len;
 
         unpacked = mm_charset_gsm_unpack (address, (len_digits * 4) / 7, 0, &unpacked_len);
-        unpacked_array = g_byte_array_new_take (unpacked, unpacked_len);
-        utf8 = mm_modem_charset_bytearray_to_utf8 (unpacked_array, MM_MODEM_CHARSET_GSM, FALSE, error);
+        utf8 = mm_modem_charset_bytes_to_utf8 (unpacked, unpacked_len, MM_MODEM_CHARSET_GSM, FALSE, error);
     } else if (addrtype == SMS_NUMBER_TYPE_INTL &&
                addrplan == SMS_NUMBER_PLAN_TELEPHONE) {
         /* International telphone number, format as "+1234567890" */
@@ -261,14 +259,12 @@ mm_sms_decode_text (const guint8   *text,
     }
 
     if (encoding == MM_SMS_ENCODING_GSM7) {
-        g_autoptr(GByteArray)  unpacked_array = NULL;
-        guint8                *unpacked = NULL;
-        guint32                unpacked_len;
-        gchar                 *utf8;
+        g_autofree guint8 *unpacked = NULL;
+        guint32            unpacked_len;
+        gchar             *utf8;
 
         unpacked = mm_charset_gsm_unpack ((const guint8 *) text, len, bit_offset, &unpacked_len);
-        unpacked_array = g_byte_array_new_take (unpacked, unpacked_len);
-        utf8 = mm_modem_charset_bytearray_to_utf8 (unpacked_array, MM_MODEM_CHARSET_GSM, FALSE, error);
+        utf8 = mm_modem_charset_bytes_to_utf8 (unpacked, unpacked_len, MM_MODEM_CHARSET_GSM, FALSE, error);
         if (utf8)
             mm_obj_dbg (log_object, "converted SMS part text from GSM-7 to UTF-8: %s", utf8);
         return utf8;
@@ -276,11 +272,9 @@ mm_sms_decode_text (const guint8   *text,
 
     /* Always assume UTF-16 instead of UCS-2! */
     if (encoding == MM_SMS_ENCODING_UCS2) {
-        g_autoptr(GByteArray)  bytearray = NULL;
-        gchar                 *utf8;
+        gchar *utf8;
 
-        bytearray = g_byte_array_append (g_byte_array_sized_new (len), (const guint8 *)text, len);
-        utf8 = mm_modem_charset_bytearray_to_utf8 (bytearray, MM_MODEM_CHARSET_UTF16, FALSE, error);
+        utf8 = mm_modem_charset_bytes_to_utf8 (text, len, MM_MODEM_CHARSET_UTF16, FALSE, error);
         if (utf8)
             mm_obj_dbg (log_object, "converted SMS part text from UTF-16BE to UTF-8: %s", utf8);
         return utf8;
@@ -349,25 +343,65 @@ validity_to_relative (guint validity)
     return 255; /* 63 weeks */
 }
 
+/* Large enough for any SMSC address plus TPDU, so that the binary PDU can be
+ * kept in the stack */
+#define PDU_DECODE_BUFFER_SIZE 256
+
 MMSmsPart *
-mm_sms_part_3gpp_new_from_pdu (guint         index,
-                               const gchar  *hexpdu,
-                               gpointer      log_object,
-                               GError      **error)
+mm_sms_part_3gpp_new_from_hex_pdu (guint         index,
+                                   const gchar  *hexpdu,
+                                   gssize        hexpdu_len,
+                                   gpointer      log_object,
+                                   GError      **error)
 {
-    g_autofree guint8 *pdu = NULL;
+    guint8             buffer[PDU_DECODE_BUFFER_SIZE];
+    g_autofree guint8 *allocated = NULL;
+    guint8            *pdu;
     gsize              pdu_len;
+    gsize              i;
 
-    /* Convert PDU from hex to binary */
-    pdu = mm_utils_hexstr2bin (hexpdu, -1, &pdu_len, error);
-    if (!pdu) {
-        g_prefix_error (error, "Couldn't convert 3GPP PDU from hex to binary: ");
+    if (hexpdu_len < 0)
+        hexpdu_len = strlen (hexpdu);
+
+    if (hexpdu_len == 0 || (hexpdu_len % 2) != 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                     "Couldn't convert 3GPP PDU from hex to binary: invalid input length");
         return NULL;
     }
 
+    /* Convert PDU from hex to binary */
+    pdu_len = hexpdu_len / 2;
+    if (pdu_len <= sizeof (buffer))
+        pdu = buffer;
+    else
+        pdu = allocated = g_malloc (pdu_len);
+
+    for (i = 0; i < pdu_len; i++) {
+        gint byte;
+
+        byte = mm_utils_hex2byte (&hexpdu[2 * i]);
+        if (byte < 0) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "Couldn't convert 3GPP PDU from hex to binary: "
+                         "hex byte conversion from '%c%c' failed",
+                         hexpdu[2 * i], hexpdu[2 * i + 1]);
+            return NULL;
+        }
+        pdu[i] = (guint8) byte;
+    }
+
     return mm_sms_part_3gpp_new_from_binary_pdu (index, pdu, pdu_len, log_object, FALSE, error);
 }
 
+MMSmsPart *
+mm_sms_part_3gpp_new_from_pdu (guint         index,
+                               const gchar  *hexpdu,
+                               gpointer      log_object,
+                               GError      **error)
+{
+    return mm_sms_part_3gpp_new_from_hex_pdu (index, hexpdu, -1, log_object, error);
+}
+
 MMSmsPart *
 mm_sms_part_3gpp_new_from_binary_pdu (guint         index,
                                       const guint8  *pdu,
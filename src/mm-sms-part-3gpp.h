@@ -26,6 +26,13 @@ MMSmsPart *mm_sms_part_3gpp_new_from_pdu        (guint          index,
                                                  const gchar   *hexpdu,
                                                  gpointer       log_object,
                                                  GError       **error);
+/* Same as mm_sms_part_3gpp_new_from_pdu(), but the hex PDU doesn't need to be
+ * NUL-terminated, so that it can be read directly from a command response */
+MMSmsPart *mm_sms_part_3gpp_new_from_hex_pdu    (guint          index,
+                                                 const gchar   *hexpdu,
+                                                 gssize         hexpdu_len,
+                                                 gpointer       log_object,
+                                                 GError       **error);
 MMSmsPart *mm_sms_part_3gpp_new_from_binary_pdu (guint          index,
                                                  const guint8  *pdu,
                                                  gsize          pdu_len,
@@ -106,139 +106,116 @@ load_connection_status_finish (MMBaseBearer  *bearer,
     return (MMBearerConnectionStatus) aux;
 }
 
+/* Some modems require a delay before the SWWAN status is updated after the
+ * connection and disconnection requests, so unexpected statuses reported
+ * before this time are not taken into account */
+#define SWWAN_STATUS_SETTLE_TIME_MS 1000
+
+/* Number of additional status checks allowed after the connection request */
+#define SWWAN_CONNECT_STATUS_RETRIES 5
+
 typedef struct {
-    guint     cid;
-    guint     retries;
-    gboolean  delay;
-    gboolean  retry;
-} LoadConnectionContext;
+    guint  cid;
+    guint  retries;
+    gint64 start_time;
+} SwwanPollContext;
 
 static void
-load_connection_context_free (LoadConnectionContext *ctx)
+swwan_poll_context_init (SwwanPollContext *poll_ctx,
+                         guint             cid,
+                         guint             retries)
 {
-    g_slice_free (LoadConnectionContext, ctx);
+    poll_ctx->cid = cid;
+    poll_ctx->retries = retries;
+    poll_ctx->start_time = g_get_monotonic_time ();
 }
 
-static gboolean swwan_check_status (GTask *task);
-
-static void
-swwan_check_status_ready (MMBaseModem  *modem,
-                          GAsyncResult *res,
-                          GTask        *task)
+static gboolean
+swwan_poll_context_settled (SwwanPollContext *poll_ctx)
 {
-    MMBroadbandBearerCinterion *self;
-    const gchar                *response;
-    GError                     *error = NULL;
-    MMBearerConnectionStatus    status;
-    LoadConnectionContext       *ctx;
-
-    self = g_task_get_source_object (task);
-    ctx  = g_task_get_task_data (task);
-
-    response = mm_base_modem_at_command_finish (modem, res, &error);
-    if (!response) {
-        g_task_return_error (task, error);
-        goto out;
-    }
+    return (g_get_monotonic_time () - poll_ctx->start_time) >= (SWWAN_STATUS_SETTLE_TIME_MS * 1000);
+}
 
-    status = mm_cinterion_parse_swwan_response (response, ctx->cid, self, &error);
-    if (status == MM_BEARER_CONNECTION_STATUS_UNKNOWN) {
-        g_task_return_error (task, error);
-        goto out;
-    } else if (ctx->retry && status == MM_BEARER_CONNECTION_STATUS_DISCONNECTED) {
-        mm_obj_dbg (self, "check status retry");
-        if (ctx->retries == 0) {
-            g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                 "CID %u status check retry exceeded", ctx->cid);
-            goto out;
-        } else {
-            if (ctx->delay) {
-                g_timeout_add_seconds (1, (GSourceFunc)swwan_check_status, task);
-            } else {
-                g_idle_add ((GSourceFunc)swwan_check_status, task);
-            }
-            ctx->retries--;
-            return;
-        }
-    }
+static MMBearerConnectionStatus
+swwan_status_finish (MMBroadbandBearer  *self,
+                     GAsyncResult       *res,
+                     guint               cid,
+                     GError            **error)
+{
+    g_autoptr(MMBaseModem)  modem = NULL;
+    const gchar            *response;
 
-    g_assert (status == MM_BEARER_CONNECTION_STATUS_DISCONNECTED ||
-              status == MM_BEARER_CONNECTION_STATUS_CONNECTED);
-    g_task_return_int (task, (gssize) status);
+    g_object_get (self,
+                  MM_BASE_BEARER_MODEM, &modem,
+                  NULL);
+    response = mm_base_modem_at_command_finish (modem, res, error);
+    if (!response)
+        return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
 
-out:
-    g_object_unref (task);
+    return mm_cinterion_parse_swwan_response (response, cid, self, error);
 }
 
-static gboolean
-swwan_check_status (GTask *task)
+static void
+swwan_poll (MMBroadbandBearer   *self,
+            SwwanPollContext    *poll_ctx,
+            GAsyncReadyCallback  callback,
+            gpointer             user_data)
 {
-    MMBroadbandBearerCinterion *bearer;
-    g_autoptr(MMBaseModem)  modem = NULL;
+    g_autoptr(MMBaseModem) modem = NULL;
 
-    bearer = g_task_get_source_object (task);
-    g_object_get (bearer,
+    g_object_get (self,
                   MM_BASE_BEARER_MODEM, &modem,
                   NULL);
     mm_base_modem_at_command (modem,
                               "^SWWAN?",
                               5,
                               FALSE,
-                              (GAsyncReadyCallback) swwan_check_status_ready,
-                              task);
+                              callback,
+                              user_data);
+}
 
-    return G_SOURCE_REMOVE;
+static void
+load_connection_status_ready (MMBroadbandBearer *self,
+                              GAsyncResult      *res,
+                              GTask             *task)
+{
+    MMBearerConnectionStatus  status;
+    GError                   *error = NULL;
+
+    status = swwan_status_finish (self, res, GPOINTER_TO_UINT (g_task_get_task_data (task)), &error);
+    if (status == MM_BEARER_CONNECTION_STATUS_UNKNOWN)
+        g_task_return_error (task, error);
+    else {
+        g_assert (status == MM_BEARER_CONNECTION_STATUS_DISCONNECTED ||
+                  status == MM_BEARER_CONNECTION_STATUS_CONNECTED);
+        g_task_return_int (task, (gssize) status);
+    }
+    g_object_unref (task);
 }
 
 static void
-load_connection_status_by_cid (MMBroadbandBearerCinterion *bearer,
-                               gint                        cid,
-                               gboolean                    delay,
-                               gboolean                    retry,
-                               GAsyncReadyCallback         callback,
-                               gpointer                    user_data)
+load_connection_status (MMBaseBearer        *bearer,
+                        GAsyncReadyCallback  callback,
+                        gpointer             user_data)
 {
-    GTask                 *task;
-    LoadConnectionContext *ctx;
+    GTask *task;
+    gint   cid;
 
     task = g_task_new (bearer, NULL, callback, user_data);
+
+    cid = mm_base_bearer_get_profile_id (bearer);
     if (cid == MM_3GPP_PROFILE_ID_UNKNOWN) {
         g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
                                  "Unknown profile id to check connection status");
         g_object_unref (task);
         return;
     }
+    g_task_set_task_data (task, GUINT_TO_POINTER ((guint) cid), NULL);
 
-    ctx = g_slice_new0 (LoadConnectionContext);
-    g_task_set_task_data (task, ctx, (GDestroyNotify) load_connection_context_free);
-
-    /* Setup context */
-    ctx->cid     = cid;
-    ctx->retries = 5;
-    ctx->delay = delay;
-    ctx->retry = retry;
-
-    /* Some modems require a delay before querying the SWWAN status
-     * This is only needed for step DIAL_3GPP_CONTEXT_STEP_VALIDATE_CONNECTION
-     * and DISCONNECT_3GPP_CONTEXT_STEP_CONNECTION_STATUS. */
-    if (delay) {
-        g_timeout_add_seconds (1, (GSourceFunc)swwan_check_status, task);
-    } else {
-        g_idle_add ((GSourceFunc)swwan_check_status, task);
-    }
-}
-
-static void
-load_connection_status (MMBaseBearer        *bearer,
-                        GAsyncReadyCallback  callback,
-                        gpointer             user_data)
-{
-    load_connection_status_by_cid (MM_BROADBAND_BEARER_CINTERION (bearer),
-                                   mm_base_bearer_get_profile_id (bearer),
-                                   FALSE,
-                                   FALSE,
-                                   callback,
-                                   user_data);
+    swwan_poll (MM_BROADBAND_BEARER (bearer),
+                NULL,
+                (GAsyncReadyCallback) load_connection_status_ready,
+                task);
 }
 
 /******************************************************************************/
@@ -260,6 +237,7 @@ typedef struct {
     MMPort                     *data;
     gint                        usb_interface_config_index;
     Dial3gppContextStep         step;
+    SwwanPollContext            poll;
 } Dial3gppContext;
 
 static void
@@ -282,33 +260,49 @@ dial_3gpp_finish (MMBroadbandBearer  *self,
 
 static void dial_3gpp_context_step (GTask *task);
 
+static MMBearerConnectionStatus
+dial_swwan_poll_finish (MMBroadbandBearer  *self,
+                        GAsyncResult       *res,
+                        SwwanPollContext   *poll_ctx,
+                        GError            **error)
+{
+    MMBearerConnectionStatus status;
+
+    status = swwan_status_finish (self, res, poll_ctx->cid, error);
+    if (status == MM_BEARER_CONNECTION_STATUS_DISCONNECTED && swwan_poll_context_settled (poll_ctx)) {
+        mm_obj_dbg (self, "check status retry");
+        if (poll_ctx->retries == 0) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "CID %u status check retry exceeded", poll_ctx->cid);
+            return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
+        }
+        poll_ctx->retries--;
+    }
+    return status;
+}
+
 static void
-dial_connection_status_ready (MMBroadbandBearerCinterion *self,
-                              GAsyncResult               *res,
-                              GTask                      *task)
+dial_connection_status_ready (MMBroadbandBearer *self,
+                              GAsyncResult      *res,
+                              GTask             *task)
 {
-    MMBearerConnectionStatus  status;
-    Dial3gppContext          *ctx;
-    GError                   *error = NULL;
+    Dial3gppContext *ctx;
+    GError          *error = NULL;
 
     ctx = (Dial3gppContext *) g_task_get_task_data (task);
 
-    status = load_connection_status_finish (MM_BASE_BEARER (self), res, &error);
-    if (status == MM_BEARER_CONNECTION_STATUS_UNKNOWN) {
+    if (!mm_broadband_bearer_wait_connection_status_finish (self, res, &error)) {
+        /* On cancellation, let the step logic stop the SWWAN connection */
+        if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+            g_error_free (error);
+            dial_3gpp_context_step (task);
+            return;
+        }
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
     }
 
-    if (status == MM_BEARER_CONNECTION_STATUS_DISCONNECTED) {
-        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                 "CID %u is reported disconnected", ctx->cid);
-        g_object_unref (task);
-        return;
-    }
-
-    g_assert (status == MM_BEARER_CONNECTION_STATUS_CONNECTED);
-
     /* Go to next step */
     ctx->step++;
     dial_3gpp_context_step (task);
@@ -473,12 +467,18 @@ dial_3gpp_context_step (GTask *task)
         g_assert (default_swwan_behavior);
         mm_obj_dbg (self, "dial step %u/%u: checking SWWAN interface %u status...",
                     ctx->step, DIAL_3GPP_CONTEXT_STEP_LAST, usb_interface_configs[ctx->usb_interface_config_index].swwan_index);
-        load_connection_status_by_cid (ctx->self,
-                                       (gint) ctx->cid,
-                                       TRUE,
-                                       TRUE,
-                                       (GAsyncReadyCallback) dial_connection_status_ready,
-                                       task);
+        /* Some modems require a delay before the SWWAN status is updated,
+         * so keep on polling until connected */
+        swwan_poll_context_init (&ctx->poll, ctx->cid, SWWAN_CONNECT_STATUS_RETRIES);
+        mm_broadband_bearer_wait_connection_status (MM_BROADBAND_BEARER (ctx->self),
+                                                    MM_BEARER_CONNECTION_STATUS_CONNECTED,
+                                                    MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
+                                                    (MMBroadbandBearerStatusPollFn) swwan_poll,
+                                                    (MMBroadbandBearerStatusPollFinishFn) dial_swwan_poll_finish,
+                                                    &ctx->poll,
+                                                    g_task_get_cancellable (task),
+                                                    (GAsyncReadyCallback) dial_connection_status_ready,
+                                                    task);
         return;
 
     case DIAL_3GPP_CONTEXT_STEP_LAST:
@@ -559,6 +559,7 @@ typedef struct {
     guint                       cid;
     gint                        usb_interface_config_index;
     Disconnect3gppContextStep   step;
+    SwwanPollContext            poll;
 } Disconnect3gppContext;
 
 static void
@@ -581,35 +582,44 @@ disconnect_3gpp_finish (MMBroadbandBearer  *self,
 
 static void disconnect_3gpp_context_step (GTask *task);
 
-static void
-disconnect_connection_status_ready (MMBroadbandBearerCinterion *self,
-                                    GAsyncResult               *res,
-                                    GTask                      *task)
+static MMBearerConnectionStatus
+disconnect_swwan_poll_finish (MMBroadbandBearer  *self,
+                              GAsyncResult       *res,
+                              SwwanPollContext   *poll_ctx,
+                              GError            **error)
 {
     MMBearerConnectionStatus  status;
-    Disconnect3gppContext    *ctx;
-    GError                   *error = NULL;
+    g_autoptr(GError)         inner_error = NULL;
+
+    status = swwan_status_finish (self, res, poll_ctx->cid, &inner_error);
+    if (status == MM_BEARER_CONNECTION_STATUS_UNKNOWN) {
+        /* Assume disconnected */
+        mm_obj_dbg (self, "couldn't get CID %u status, assume disconnected: %s",
+                    poll_ctx->cid, inner_error->message);
+        return MM_BEARER_CONNECTION_STATUS_DISCONNECTED;
+    }
+    if (status == MM_BEARER_CONNECTION_STATUS_CONNECTED && swwan_poll_context_settled (poll_ctx)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "CID %u is reported connected", poll_ctx->cid);
+        return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
+    }
+    return status;
+}
+
+static void
+disconnect_connection_status_ready (MMBroadbandBearer *self,
+                                    GAsyncResult      *res,
+                                    GTask             *task)
+{
+    Disconnect3gppContext *ctx;
+    GError                *error = NULL;
 
     ctx = (Disconnect3gppContext *) g_task_get_task_data (task);
 
-    status = load_connection_status_finish (MM_BASE_BEARER (self), res, &error);
-    switch (status) {
-    case MM_BEARER_CONNECTION_STATUS_UNKNOWN:
-        /* Assume disconnected */
-        mm_obj_dbg (self, "couldn't get CID %u status, assume disconnected: %s", ctx->cid, error->message);
-        g_clear_error (&error);
-        break;
-    case MM_BEARER_CONNECTION_STATUS_DISCONNECTED:
-        break;
-    case MM_BEARER_CONNECTION_STATUS_CONNECTED:
-        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                 "CID %u is reported connected", ctx->cid);
+    if (!mm_broadband_bearer_wait_connection_status_finish (self, res, &error)) {
+        g_task_return_error (task, error);
         g_object_unref (task);
         return;
-    case MM_BEARER_CONNECTION_STATUS_DISCONNECTING:
-    case MM_BEARER_CONNECTION_STATUS_CONNECTION_FAILED:
-    default:
-        g_assert_not_reached ();
     }
 
     /* Go on to next step */
@@ -673,13 +683,17 @@ disconnect_3gpp_context_step (GTask *task)
         mm_obj_dbg (self, "disconnect step %u/%u: checking SWWAN interface %u status...",
                     ctx->step, DISCONNECT_3GPP_CONTEXT_STEP_LAST,
                     usb_interface_configs[ctx->usb_interface_config_index].swwan_index);
-        load_connection_status_by_cid (MM_BROADBAND_BEARER_CINTERION (ctx->self),
-                                       (gint) ctx->cid,
-                                       TRUE,
-                                       FALSE,
-                                       (GAsyncReadyCallback) disconnect_connection_status_ready,
-                                       task);
-         return;
+        swwan_poll_context_init (&ctx->poll, ctx->cid, 0);
+        mm_broadband_bearer_wait_connection_status (MM_BROADBAND_BEARER (ctx->self),
+                                                    MM_BEARER_CONNECTION_STATUS_DISCONNECTED,
+                                                    MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT,
+                                                    (MMBroadbandBearerStatusPollFn) swwan_poll,
+                                                    (MMBroadbandBearerStatusPollFinishFn) disconnect_swwan_poll_finish,
+                                                    &ctx->poll,
+                                                    g_task_get_cancellable (task),
+                                                    (GAsyncReadyCallback) disconnect_connection_status_ready,
+                                                    task);
+        return;
 
     case DISCONNECT_3GPP_CONTEXT_STEP_LAST:
         mm_obj_dbg (self, "disconnect step %u/%u: finished",
@@ -59,6 +59,90 @@ get_dial_port (MMBroadbandModemHuawei *modem,
     return g_object_ref (primary);
 }
 
+/*****************************************************************************/
+/* Connection status polling with ^NDISSTATQRY, used while waiting for the
+ * ^NDISSTAT unsolicited message */
+
+typedef struct {
+    /* Borrowed from the connection/disconnection context */
+    MMBaseModem              *modem;
+    MMPortSerialAt           *primary;
+    MMBearerConnectionStatus  status;
+    guint                     failed_count;
+} NdisstatqryPollContext;
+
+static MMBearerConnectionStatus
+ndisstatqry_poll_finish (MMBroadbandBearer       *self,
+                         GAsyncResult            *res,
+                         NdisstatqryPollContext  *poll_ctx,
+                         GError                 **error)
+{
+    const gchar *response;
+    GError      *inner_error = NULL;
+    gboolean     ipv4_available = FALSE;
+    gboolean     ipv4_connected = FALSE;
+    gboolean     ipv6_available = FALSE;
+    gboolean     ipv6_connected = FALSE;
+
+    response = mm_base_modem_at_command_full_finish (poll_ctx->modem, res, &inner_error);
+    if (!response ||
+        !mm_huawei_parse_ndisstatqry_response (response,
+                                               &ipv4_available,
+                                               &ipv4_connected,
+                                               &ipv6_available,
+                                               &ipv6_connected,
+                                               &inner_error)) {
+        poll_ctx->failed_count++;
+        mm_obj_dbg (self, "unexpected response to ^NDISSTATQRY command: %s (%u attempts so far)",
+                    inner_error->message, poll_ctx->failed_count);
+        g_error_free (inner_error);
+
+        /* Give up if too many unexpected responses to NIDSSTATQRY are encountered. */
+        if (poll_ctx->failed_count > 10) {
+            g_set_error_literal (error,
+                                 MM_MOBILE_EQUIPMENT_ERROR,
+                                 MM_MOBILE_EQUIPMENT_ERROR_NOT_SUPPORTED,
+                                 (poll_ctx->status == MM_BEARER_CONNECTION_STATUS_CONNECTED ?
+                                  "Connection attempt not supported." :
+                                  "Disconnection attempt not supported."));
+        }
+        return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
+    }
+
+    return ((ipv4_available && ipv4_connected) || (ipv6_available && ipv6_connected)) ?
+            MM_BEARER_CONNECTION_STATUS_CONNECTED :
+            MM_BEARER_CONNECTION_STATUS_DISCONNECTED;
+}
+
+static void
+ndisstatqry_poll (MMBroadbandBearer      *self,
+                  NdisstatqryPollContext *poll_ctx,
+                  GAsyncReadyCallback     callback,
+                  gpointer                user_data)
+{
+    mm_base_modem_at_command_full (poll_ctx->modem,
+                                   MM_IFACE_PORT_AT (poll_ctx->primary),
+                                   "^NDISSTATQRY?",
+                                   3,
+                                   FALSE,
+                                   FALSE,
+                                   NULL,
+                                   callback,
+                                   user_data);
+}
+
+static void
+ndisstatqry_poll_context_init (NdisstatqryPollContext   *poll_ctx,
+                               MMBaseModem              *modem,
+                               MMPortSerialAt           *primary,
+                               MMBearerConnectionStatus  status)
+{
+    poll_ctx->modem = modem;
+    poll_ctx->primary = primary;
+    poll_ctx->status = status;
+    poll_ctx->failed_count = 0;
+}
+
 /*****************************************************************************/
 /* Connect 3GPP */
 
@@ -75,8 +159,7 @@ typedef struct {
     MMPortSerialAt *primary;
     MMPort *data;
     Connect3gppContextStep step;
-    guint check_count;
-    guint failed_ndisstatqry_count;
+    NdisstatqryPollContext poll;
     MMBearerIpFamily ip_family;
     MMBearerIpConfig *ipv4_config;
     MMBearerIpConfig *ipv6_config;
@@ -186,37 +269,14 @@ connect_dhcp_check_ready (MMBaseModem *modem,
     connect_3gpp_context_step (task);
 }
 
-static gboolean
-connect_retry_ndisstatqry_check_cb (MMBroadbandBearerHuawei *self)
-{
-    GTask *task;
-
-    /* Recover context */
-    task = self->priv->connect_pending;
-    g_assert (task != NULL);
-
-    /* Balance refcount */
-    g_object_unref (self);
-
-    /* Retry same step */
-    connect_3gpp_context_step (task);
-
-    return G_SOURCE_REMOVE;
-}
-
 static void
-connect_ndisstatqry_check_ready (MMBaseModem *modem,
-                                 GAsyncResult *res,
-                                 MMBroadbandBearerHuawei *self)
+connect_wait_connected_ready (MMBroadbandBearer       *_self,
+                              GAsyncResult            *res,
+                              MMBroadbandBearerHuawei *self)
 {
     GTask *task;
     Connect3gppContext *ctx;
-    const gchar *response;
     GError *error = NULL;
-    gboolean ipv4_available = FALSE;
-    gboolean ipv4_connected = FALSE;
-    gboolean ipv6_available = FALSE;
-    gboolean ipv6_connected = FALSE;
 
     task = self->priv->connect_pending;
     g_assert (task != NULL);
@@ -226,32 +286,25 @@ connect_ndisstatqry_check_ready (MMBaseModem *modem,
     /* Balance refcount */
     g_object_unref (self);
 
-    response = mm_base_modem_at_command_full_finish (modem, res, &error);
-    if (!response ||
-        !mm_huawei_parse_ndisstatqry_response (response,
-                                               &ipv4_available,
-                                               &ipv4_connected,
-                                               &ipv6_available,
-                                               &ipv6_connected,
-                                               &error)) {
-        ctx->failed_ndisstatqry_count++;
-        mm_obj_dbg (self, "unexpected response to ^NDISSTATQRY command: %s (%u attempts so far)",
-                    error->message, ctx->failed_ndisstatqry_count);
-        g_error_free (error);
-    }
+    if (!mm_broadband_bearer_wait_connection_status_finish (_self, res, &error)) {
+        /* On cancellation, let the step logic tear down the context with
+         * ^NDISDUP=1,0 before completing the task */
+        if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+            g_error_free (error);
+            connect_3gpp_context_step (task);
+            return;
+        }
 
-    /* Connected? */
-    if ((ipv4_available && ipv4_connected) || (ipv6_available && ipv6_connected)) {
-        /* Success! */
-        ctx->step++;
-        connect_3gpp_context_step (task);
+        /* Clear task */
+        self->priv->connect_pending = NULL;
+        g_task_return_error (task, error);
+        g_object_unref (task);
         return;
     }
 
-    /* Setup timeout to retry the same step */
-    g_timeout_add_seconds (1,
-                           (GSourceFunc)connect_retry_ndisstatqry_check_cb,
-                           g_object_ref (self));
+    /* Success! */
+    ctx->step++;
+    connect_3gpp_context_step (task);
 }
 
 static void
@@ -399,44 +452,22 @@ connect_3gpp_context_step (GTask *task)
     }
 
     case CONNECT_3GPP_CONTEXT_STEP_NDISSTATQRY:
-        /* Wait for dial up timeout, retries for 180 times
-         * (1s between the retries, so it means 3 minutes).
-         * If too many retries, failed
-         */
-        if (ctx->check_count > MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT) {
-            /* Clear context */
-            self->priv->connect_pending = NULL;
-            g_task_return_new_error (task,
-                                     MM_MOBILE_EQUIPMENT_ERROR,
-                                     MM_MOBILE_EQUIPMENT_ERROR_NETWORK_TIMEOUT,
-                                     "Connection attempt timed out");
-            g_object_unref (task);
-            return;
-        }
-
-        /* Give up if too many unexpected responses to NIDSSTATQRY are encountered. */
-        if (ctx->failed_ndisstatqry_count > 10) {
-            /* Clear context */
-            self->priv->connect_pending = NULL;
-            g_task_return_new_error (task,
-                                     MM_MOBILE_EQUIPMENT_ERROR,
-                                     MM_MOBILE_EQUIPMENT_ERROR_NOT_SUPPORTED,
-                                     "Connection attempt not supported.");
-            g_object_unref (task);
-            return;
-        }
-
-        /* Check if connected */
-        ctx->check_count++;
-        mm_base_modem_at_command_full (ctx->modem,
-                                       MM_IFACE_PORT_AT (ctx->primary),
-                                       "^NDISSTATQRY?",
-                                       3,
-                                       FALSE,
-                                       FALSE,
-                                       NULL,
-                                       (GAsyncReadyCallback)connect_ndisstatqry_check_ready,
-                                       g_object_ref (self));
+        /* Wait for the ^NDISSTAT unsolicited message reporting the
+         * connection, polling with ^NDISSTATQRY? meanwhile, for up to
+         * 3 minutes. */
+        ndisstatqry_poll_context_init (&ctx->poll,
+                                       ctx->modem,
+                                       ctx->primary,
+                                       MM_BEARER_CONNECTION_STATUS_CONNECTED);
+        mm_broadband_bearer_wait_connection_status (MM_BROADBAND_BEARER (self),
+                                                    MM_BEARER_CONNECTION_STATUS_CONNECTED,
+                                                    MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
+                                                    (MMBroadbandBearerStatusPollFn) ndisstatqry_poll,
+                                                    (MMBroadbandBearerStatusPollFinishFn) ndisstatqry_poll_finish,
+                                                    &ctx->poll,
+                                                    g_task_get_cancellable (task),
+                                                    (GAsyncReadyCallback)connect_wait_connected_ready,
+                                                    g_object_ref (self));
         return;
 
     case CONNECT_3GPP_CONTEXT_STEP_IP_CONFIG:
@@ -524,7 +555,7 @@ connect_3gpp (MMBroadbandBearer *_self,
         mm_bearer_ip_config_set_method (ctx->ipv6_config, MM_BEARER_IP_METHOD_DHCP);
     }
 
-    task = g_task_new (self, NULL, callback, user_data);
+    task = g_task_new (self, cancellable, callback, user_data);
     g_task_set_task_data (task, ctx, (GDestroyNotify)connect_3gpp_context_free);
     g_task_set_check_cancellable (task, FALSE);
 
@@ -546,8 +577,7 @@ typedef struct {
     MMBaseModem *modem;
     MMPortSerialAt *primary;
     Disconnect3gppContextStep step;
-    guint check_count;
-    guint failed_ndisstatqry_count;
+    NdisstatqryPollContext poll;
 } Disconnect3gppContext;
 
 static void
@@ -568,36 +598,14 @@ disconnect_3gpp_finish (MMBroadbandBearer *self,
 
 static void disconnect_3gpp_context_step (GTask *task);
 
-static gboolean
-disconnect_retry_ndisstatqry_check_cb (MMBroadbandBearerHuawei *self)
-{
-    GTask *task;
-
-    /* Recover context */
-    task = self->priv->disconnect_pending;
-    g_assert (task != NULL);
-
-    /* Balance refcount */
-    g_object_unref (self);
-
-    /* Retry same step */
-    disconnect_3gpp_context_step (task);
-    return G_SOURCE_REMOVE;
-}
-
 static void
-disconnect_ndisstatqry_check_ready (MMBaseModem *modem,
-                                    GAsyncResult *res,
+disconnect_wait_disconnected_ready (MMBroadbandBearer       *_self,
+                                    GAsyncResult            *res,
                                     MMBroadbandBearerHuawei *self)
 {
     GTask *task;
     Disconnect3gppContext *ctx;
-    const gchar *response;
     GError *error = NULL;
-    gboolean ipv4_available = FALSE;
-    gboolean ipv4_connected = FALSE;
-    gboolean ipv6_available = FALSE;
-    gboolean ipv6_connected = FALSE;
 
     task = self->priv->disconnect_pending;
     g_assert (task != NULL);
@@ -607,32 +615,17 @@ disconnect_ndisstatqry_check_ready (MMBaseModem *modem,
     /* Balance refcount */
     g_object_unref (self);
 
-    response = mm_base_modem_at_command_full_finish (modem, res, &error);
-    if (!response ||
-        !mm_huawei_parse_ndisstatqry_response (response,
-                                               &ipv4_available,
-                                               &ipv4_connected,
-                                               &ipv6_available,
-                                               &ipv6_connected,
-                                               &error)) {
-        ctx->failed_ndisstatqry_count++;
-        mm_obj_dbg (self, "unexpected response to ^NDISSTATQRY command: %s (%u attempts so far)",
-                    error->message, ctx->failed_ndisstatqry_count);
-        g_error_free (error);
-    }
-
-    /* Disconnected? */
-    if (!((ipv4_available && ipv4_connected) || (ipv6_available && ipv6_connected))) {
-        /* Success! */
-        ctx->step++;
-        disconnect_3gpp_context_step (task);
+    if (!mm_broadband_bearer_wait_connection_status_finish (_self, res, &error)) {
+        /* Clear task */
+        self->priv->disconnect_pending = NULL;
+        g_task_return_error (task, error);
+        g_object_unref (task);
         return;
     }
 
-    /* Setup timeout to retry the same step */
-    g_timeout_add_seconds (1,
-                           (GSourceFunc)disconnect_retry_ndisstatqry_check_cb,
-                           g_object_ref (self));
+    /* Success! */
+    ctx->step++;
+    disconnect_3gpp_context_step (task);
 }
 
 static void
@@ -691,41 +684,21 @@ disconnect_3gpp_context_step (GTask *task)
         return;
 
     case DISCONNECT_3GPP_CONTEXT_STEP_NDISSTATQRY:
-        /* If too many retries (1s of wait between the retries), failed */
-        if (ctx->check_count > MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT) {
-            /* Clear task */
-            self->priv->disconnect_pending = NULL;
-            g_task_return_new_error (task,
-                                     MM_MOBILE_EQUIPMENT_ERROR,
-                                     MM_MOBILE_EQUIPMENT_ERROR_NETWORK_TIMEOUT,
-                                     "Disconnection attempt timed out");
-            g_object_unref (task);
-            return;
-        }
-
-        /* Give up if too many unexpected responses to NIDSSTATQRY are encountered. */
-        if (ctx->failed_ndisstatqry_count > 10) {
-            /* Clear task */
-            self->priv->disconnect_pending = NULL;
-            g_task_return_new_error (task,
-                                     MM_MOBILE_EQUIPMENT_ERROR,
-                                     MM_MOBILE_EQUIPMENT_ERROR_NOT_SUPPORTED,
-                                     "Disconnection attempt not supported.");
-            g_object_unref (task);
-            return;
-        }
-
-        /* Check if disconnected */
-        ctx->check_count++;
-        mm_base_modem_at_command_full (ctx->modem,
-                                       MM_IFACE_PORT_AT (ctx->primary),
-                                       "^NDISSTATQRY?",
-                                       3,
-                                       FALSE,
-                                       FALSE,
-                                       NULL,
-                                       (GAsyncReadyCallback)disconnect_ndisstatqry_check_ready,
-                                       g_object_ref (self));
+        /* Wait for the ^NDISSTAT unsolicited message reporting the
+         * disconnection, polling with ^NDISSTATQRY? meanwhile */
+        ndisstatqry_poll_context_init (&ctx->poll,
+                                       ctx->modem,
+                                       ctx->primary,
+                                       MM_BEARER_CONNECTION_STATUS_DISCONNECTED);
+        mm_broadband_bearer_wait_connection_status (MM_BROADBAND_BEARER (self),
+                                                    MM_BEARER_CONNECTION_STATUS_DISCONNECTED,
+                                                    MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT,
+                                                    (MMBroadbandBearerStatusPollFn) ndisstatqry_poll,
+                                                    (MMBroadbandBearerStatusPollFinishFn) ndisstatqry_poll_finish,
+                                                    &ctx->poll,
+                                                    g_task_get_cancellable (task),
+                                                    (GAsyncReadyCallback)disconnect_wait_disconnected_ready,
+                                                    g_object_ref (self));
         return;
 
     case DISCONNECT_3GPP_CONTEXT_STEP_LAST:
@@ -787,9 +760,13 @@ report_connection_status (MMBaseBearer             *bearer,
               status == MM_BEARER_CONNECTION_STATUS_DISCONNECTING ||
               status == MM_BEARER_CONNECTION_STATUS_DISCONNECTED);
 
-    /* When a pending connection / disconnection attempt is in progress, we use
-     * ^NDISSTATQRY? to check the connection status and thus temporarily ignore
-     * ^NDISSTAT unsolicited messages */
+    /* When a pending connection / disconnection attempt is waiting for the
+     * connection status, ^NDISSTAT completes the wait right away */
+    if (mm_broadband_bearer_wait_connection_status_report (MM_BROADBAND_BEARER (self), status, NULL))
+        return;
+
+    /* Otherwise, ignore ^NDISSTAT while the pending attempt is still
+     * running its previous steps */
     if (self->priv->connect_pending || self->priv->disconnect_pending)
         return;
 
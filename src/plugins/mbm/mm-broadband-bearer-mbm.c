@@ -51,6 +51,58 @@ struct _MMBroadbandBearerMbmPrivate {
     GTask *disconnect_pending;
 };
 
+/*****************************************************************************/
+/* Connection status polling with *ENAP?, used while waiting for the *E2NAP
+ * unsolicited message; very old F3507g/MD300 firmware may not send it. */
+
+static MMBearerConnectionStatus
+enap_poll_finish (MMBroadbandBearer  *self,
+                  GAsyncResult       *res,
+                  MMPortSerialAt     *primary,
+                  GError            **error)
+{
+    g_autoptr(MMBaseModem)  modem = NULL;
+    const gchar            *response;
+    guint                   state;
+
+    g_object_get (self,
+                  MM_BASE_BEARER_MODEM, &modem,
+                  NULL);
+    response = mm_base_modem_at_command_full_finish (modem, res, error);
+    if (!response)
+        return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
+
+    if (sscanf (response, "*ENAP: %d", &state) == 1) {
+        if (state == 1)
+            return MM_BEARER_CONNECTION_STATUS_CONNECTED;
+        if (state == 0)
+            return MM_BEARER_CONNECTION_STATUS_DISCONNECTED;
+    }
+    return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
+}
+
+static void
+enap_poll (MMBroadbandBearer   *self,
+           MMPortSerialAt      *primary,
+           GAsyncReadyCallback  callback,
+           gpointer             user_data)
+{
+    g_autoptr(MMBaseModem) modem = NULL;
+
+    g_object_get (self,
+                  MM_BASE_BEARER_MODEM, &modem,
+                  NULL);
+    mm_base_modem_at_command_full (modem,
+                                   MM_IFACE_PORT_AT (primary),
+                                   "AT*ENAP?",
+                                   3,
+                                   FALSE,
+                                   FALSE, /* raw */
+                                   NULL, /* cancellable */
+                                   callback,
+                                   user_data);
+}
+
 /*****************************************************************************/
 /* 3GPP Dialing (sub-step of the 3GPP Connection sequence) */
 
@@ -59,15 +111,12 @@ typedef struct {
     MMPortSerialAt *primary;
     guint           cid;
     MMPort         *data;
-    guint           poll_count;
-    guint           poll_id;
     GError         *saved_error;
 } Dial3gppContext;
 
 static void
 dial_3gpp_context_free (Dial3gppContext *ctx)
 {
-    g_assert (!ctx->poll_id);
     g_assert (!ctx->saved_error);
     g_clear_object (&ctx->data);
     g_clear_object (&ctx->primary);
@@ -138,11 +187,6 @@ process_pending_connect_attempt (MMBroadbandBearerMbm     *self,
 
     ctx = g_task_get_task_data (task);
 
-    if (ctx->poll_id) {
-        g_source_remove (ctx->poll_id);
-        ctx->poll_id = 0;
-    }
-
     /* Received 'CONNECTED' during a connection attempt? */
     if (status == MM_BEARER_CONNECTION_STATUS_CONNECTED) {
         /* If we wanted to get cancelled before, do it now. */
@@ -168,93 +212,39 @@ process_pending_connect_attempt (MMBroadbandBearerMbm     *self,
     g_object_unref (task);
 }
 
-static gboolean connect_poll_cb (MMBroadbandBearerMbm *self);
-
 static void
-connect_poll_ready (MMBaseModem          *modem,
-                    GAsyncResult         *res,
-                    MMBroadbandBearerMbm *self)
+connect_wait_connected_ready (MMBroadbandBearer *_self,
+                              GAsyncResult      *res,
+                              gpointer           user_data)
 {
-    GTask           *task;
-    Dial3gppContext *ctx;
-    GError          *error = NULL;
-    const gchar     *response;
-    guint            state;
+    MMBroadbandBearerMbm *self = MM_BROADBAND_BEARER_MBM (_self);
+    GTask                *task;
+    Dial3gppContext      *ctx;
+    GError               *error = NULL;
 
     task = g_steal_pointer (&self->priv->connect_pending);
-
-    if (!task) {
-        mm_obj_dbg (self, "connection context was finished already by an unsolicited message");
-        /* Run _finish() to finalize the async call, even if we don't care
-         * the result */
-        mm_base_modem_at_command_full_finish (modem, res, NULL);
-        return;
-    }
-
+    g_assert (task);
     ctx = g_task_get_task_data (task);
 
-    response = mm_base_modem_at_command_full_finish (modem, res, &error);
-    if (!response) {
-        ctx->saved_error = error;
+    if (!mm_broadband_bearer_wait_connection_status_finish (_self, res, &error)) {
+        /* Cancellation is reported by connect_reset() itself */
+        if (g_cancellable_is_cancelled (g_task_get_cancellable (task)))
+            g_error_free (error);
+        else
+            ctx->saved_error = error;
         connect_reset (task);
         return;
     }
 
-    if (sscanf (response, "*ENAP: %d", &state) == 1 && state == 1) {
-        /* Success!  Connected... */
-        g_task_return_pointer (task, g_object_ref (ctx->data), g_object_unref);
-        g_object_unref (task);
-        return;
-    }
-
-    /* Restore pending task and check again in one second */
-    self->priv->connect_pending = task;
-    g_assert (ctx->poll_id == 0);
-    ctx->poll_id = g_timeout_add_seconds (1, (GSourceFunc) connect_poll_cb, self);
-}
-
-static gboolean
-connect_poll_cb (MMBroadbandBearerMbm *self)
-{
-    GTask           *task;
-    Dial3gppContext *ctx;
-
-    task = g_steal_pointer (&self->priv->connect_pending);
-
-    g_assert (task);
-    ctx = g_task_get_task_data (task);
-
-    ctx->poll_id = 0;
-
-    /* Complete if we were cancelled */
+    /* If we wanted to get cancelled before, do it now. */
     if (g_cancellable_is_cancelled (g_task_get_cancellable (task))) {
         connect_reset (task);
-        return G_SOURCE_REMOVE;
-    }
-
-    /* Too many retries... */
-    if (ctx->poll_count > MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT) {
-        g_assert (!ctx->saved_error);
-        ctx->saved_error = g_error_new (MM_MOBILE_EQUIPMENT_ERROR,
-                                        MM_MOBILE_EQUIPMENT_ERROR_NETWORK_TIMEOUT,
-                                        "Connection attempt timed out");
-        connect_reset (task);
-        return G_SOURCE_REMOVE;
+        return;
     }
 
-    /* Restore pending task and poll */
-    self->priv->connect_pending = task;
-    ctx->poll_count++;
-    mm_base_modem_at_command_full (ctx->modem,
-                                   MM_IFACE_PORT_AT (ctx->primary),
-                                   "AT*ENAP?",
-                                   3,
-                                   FALSE,
-                                   FALSE, /* raw */
-                                   g_task_get_cancellable (task),
-                                   (GAsyncReadyCallback)connect_poll_ready,
-                                   self);
-    return G_SOURCE_REMOVE;
+    /* Success!  Connected... */
+    g_task_return_pointer (task, g_object_ref (ctx->data), g_object_unref);
+    g_object_unref (task);
 }
 
 static void
@@ -291,7 +281,15 @@ activate_ready (MMBaseModem          *modem,
     /* No unsolicited E2NAP status yet; wait for it and periodically poll
      * to handle very old F3507g/MD300 firmware that may not send E2NAP. */
     self->priv->connect_pending = task;
-    ctx->poll_id = g_timeout_add_seconds (1, (GSourceFunc)connect_poll_cb, self);
+    mm_broadband_bearer_wait_connection_status (MM_BROADBAND_BEARER (self),
+                                                MM_BEARER_CONNECTION_STATUS_CONNECTED,
+                                                MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
+                                                (MMBroadbandBearerStatusPollFn) enap_poll,
+                                                (MMBroadbandBearerStatusPollFinishFn) enap_poll_finish,
+                                                ctx->primary,
+                                                g_task_get_cancellable (task),
+                                                (GAsyncReadyCallback) connect_wait_connected_ready,
+                                                NULL);
 
  out:
     /* Balance refcount with the extra ref we passed to command_full() */
@@ -583,14 +581,11 @@ get_ip_config_3gpp (MMBroadbandBearer *self,
 typedef struct {
     MMBaseModem    *modem;
     MMPortSerialAt *primary;
-    guint           poll_count;
-    guint           poll_id;
 } DisconnectContext;
 
 static void
 disconnect_context_free (DisconnectContext *ctx)
 {
-    g_assert (!ctx->poll_id);
     g_clear_object (&ctx->primary);
     g_clear_object (&ctx->modem);
     g_free (ctx);
@@ -608,17 +603,10 @@ static void
 process_pending_disconnect_attempt (MMBroadbandBearerMbm     *self,
                                     MMBearerConnectionStatus  status)
 {
-    GTask             *task;
-    DisconnectContext *ctx;
+    GTask *task;
 
     /* Recover disconnection task */
     task = g_steal_pointer (&self->priv->disconnect_pending);
-    ctx  = g_task_get_task_data (task);
-
-    if (ctx->poll_id) {
-        g_source_remove (ctx->poll_id);
-        ctx->poll_id = 0;
-    }
 
     /* Received 'DISCONNECTED' during a disconnection attempt? */
     if (status == MM_BEARER_CONNECTION_STATUS_DISCONNECTED) {
@@ -631,92 +619,23 @@ process_pending_disconnect_attempt (MMBroadbandBearerMbm     *self,
     g_object_unref (task);
 }
 
-static gboolean disconnect_poll_cb (MMBroadbandBearerMbm *self);
-
 static void
-disconnect_poll_ready (MMBaseModem          *modem,
-                       GAsyncResult         *res,
-                       MMBroadbandBearerMbm *self)
-
+disconnect_wait_disconnected_ready (MMBroadbandBearer *_self,
+                                    GAsyncResult      *res,
+                                    gpointer           user_data)
 {
-    GTask             *task;
-    DisconnectContext *ctx;
-    GError            *error = NULL;
-    const gchar       *response;
-    guint              state;
+    MMBroadbandBearerMbm *self = MM_BROADBAND_BEARER_MBM (_self);
+    GTask                *task;
+    GError               *error = NULL;
 
     task = g_steal_pointer (&self->priv->disconnect_pending);
+    g_assert (task);
 
-    if (!task) {
-        mm_obj_dbg (self, "disconnection context was finished already by an unsolicited message");
-        /* Run _finish() to finalize the async call, even if we don't care
-         * the result */
-        mm_base_modem_at_command_full_finish (modem, res, NULL);
-        goto out;
-    }
-
-    response = mm_base_modem_at_command_full_finish (modem, res, &error);
-    if (!response) {
+    if (!mm_broadband_bearer_wait_connection_status_finish (_self, res, &error))
         g_task_return_error (task, error);
-        g_object_unref (task);
-        goto out;
-    }
-
-    if (sscanf (response, "*ENAP: %d", &state) == 1 && state == 0) {
-        /* Disconnected */
+    else
         g_task_return_boolean (task, TRUE);
-        g_object_unref (task);
-        goto out;
-    }
-
-    /* Restore pending task and check in 1s */
-    self->priv->disconnect_pending = task;
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->poll_id == 0);
-    ctx->poll_id = g_timeout_add_seconds (1, (GSourceFunc) disconnect_poll_cb, self);
-
- out:
-    /* Balance refcount with the extra ref we passed to command_full() */
-    g_object_unref (self);
-}
-
-static gboolean
-disconnect_poll_cb (MMBroadbandBearerMbm *self)
-{
-    GTask             *task;
-    DisconnectContext *ctx;
-
-    task = self->priv->disconnect_pending;
-    self->priv->disconnect_pending = NULL;
-
-    g_assert (task);
-    ctx = g_task_get_task_data (task);
-
-    ctx->poll_id = 0;
-
-    /* Too many retries... */
-    if (ctx->poll_count > MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT) {
-        g_task_return_new_error (task,
-                                 MM_MOBILE_EQUIPMENT_ERROR,
-                                 MM_MOBILE_EQUIPMENT_ERROR_NETWORK_TIMEOUT,
-                                 "Disconnection attempt timed out");
-        g_object_unref (task);
-        return G_SOURCE_REMOVE;
-    }
-
-    /* Restore pending task and poll */
-    self->priv->disconnect_pending = task;
-    ctx->poll_count++;
-    mm_base_modem_at_command_full (ctx->modem,
-                                   MM_IFACE_PORT_AT (ctx->primary),
-                                   "AT*ENAP?",
-                                   3,
-                                   FALSE,
-                                   FALSE, /* raw */
-                                   NULL, /* cancellable */
-                                   (GAsyncReadyCallback) disconnect_poll_ready,
-                                   g_object_ref (self)); /* we pass the bearer object! */
-    return G_SOURCE_REMOVE;
+    g_object_unref (task);
 }
 
 static void
@@ -749,7 +668,15 @@ disconnect_enap_ready (MMBaseModem          *modem,
     /* No unsolicited E2NAP status yet; wait for it and periodically poll
      * to handle very old F3507g/MD300 firmware that may not send E2NAP. */
     self->priv->disconnect_pending = task;
-    ctx->poll_id = g_timeout_add_seconds (1, (GSourceFunc)disconnect_poll_cb, self);
+    mm_broadband_bearer_wait_connection_status (MM_BROADBAND_BEARER (self),
+                                                MM_BEARER_CONNECTION_STATUS_DISCONNECTED,
+                                                MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT,
+                                                (MMBroadbandBearerStatusPollFn) enap_poll,
+                                                (MMBroadbandBearerStatusPollFinishFn) enap_poll_finish,
+                                                ctx->primary,
+                                                g_task_get_cancellable (task),
+                                                (GAsyncReadyCallback) disconnect_wait_disconnected_ready,
+                                                NULL);
 
  out:
     /* Balance refcount with the extra ref we passed to command_full() */
@@ -809,15 +736,26 @@ report_connection_status (MMBaseBearer             *_self,
               status == MM_BEARER_CONNECTION_STATUS_CONNECTION_FAILED ||
               status == MM_BEARER_CONNECTION_STATUS_DISCONNECTED);
 
-    /* Process pending connection attempt */
+    /* Process pending connection attempt, either waiting for the connection
+     * status or still waiting for the reply to *ENAP */
     if (self->priv->connect_pending) {
-        process_pending_connect_attempt (self, status);
+        g_autoptr(GError) error = NULL;
+
+        if (status != MM_BEARER_CONNECTION_STATUS_CONNECTED)
+            error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED, "Call setup failed");
+        if (!mm_broadband_bearer_wait_connection_status_report (MM_BROADBAND_BEARER (self), status, error))
+            process_pending_connect_attempt (self, status);
         return;
     }
 
     /* Process pending disconnection attempt */
     if (self->priv->disconnect_pending) {
-        process_pending_disconnect_attempt (self, status);
+        g_autoptr(GError) error = NULL;
+
+        if (status != MM_BEARER_CONNECTION_STATUS_DISCONNECTED)
+            error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED, "Disconnection failed");
+        if (!mm_broadband_bearer_wait_connection_status_report (MM_BROADBAND_BEARER (self), status, error))
+            process_pending_disconnect_attempt (self, status);
         return;
     }
 
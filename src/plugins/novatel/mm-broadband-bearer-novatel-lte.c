@@ -149,12 +149,13 @@ typedef struct {
     MMBaseModem *modem;
     MMPortSerialAt *primary;
     MMPort *data;
-    gint retries;
+    gchar *last_status;
 } DetailedConnectContext;
 
 static void
 detailed_connect_context_free (DetailedConnectContext *ctx)
 {
+    g_free (ctx->last_status);
     if (ctx->data)
         g_object_unref (ctx->data);
     g_object_unref (ctx->primary);
@@ -170,86 +171,55 @@ connect_3gpp_finish (MMBroadbandBearer *self,
     return g_task_propagate_pointer (G_TASK (res), error);
 }
 
-static gboolean connect_3gpp_qmistatus (GTask *task);
-
-static void
-connect_3gpp_qmistatus_ready (MMBaseModem *modem,
-                              GAsyncResult *res,
-                              GTask *task)
+static MMBearerConnectionStatus
+connect_3gpp_qmistatus_finish (MMBroadbandBearer       *self,
+                               GAsyncResult            *res,
+                               DetailedConnectContext  *ctx,
+                               GError                 **error)
 {
-    MMBroadbandBearerNovatelLte *self;
-    DetailedConnectContext *ctx;
     const gchar *result;
-    gchar *normalized_result;
-    GError *error = NULL;
-
-    self = g_task_get_source_object (task);
-    ctx  = g_task_get_task_data (task);
-
-    if (g_task_return_error_if_cancelled (task)) {
-        g_object_unref (task);
-        return;
-    }
+    GError *inner_error = NULL;
 
-    result = mm_base_modem_at_command_full_finish (modem, res, &error);
+    result = mm_base_modem_at_command_full_finish (ctx->modem, res, &inner_error);
     if (!result) {
-        if (!g_error_matches (error, MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_UNKNOWN)) {
-            g_task_return_error (task, error);
-            g_object_unref (task);
-            return;
+        if (!g_error_matches (inner_error, MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_UNKNOWN)) {
+            g_propagate_error (error, inner_error);
+            return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
         }
-        mm_obj_dbg (self, "connection status failed: %s; will retry", error->message);
-        g_error_free (error);
-        goto retry;
+        mm_obj_dbg (self, "connection status failed: %s; will retry", inner_error->message);
+        g_error_free (inner_error);
+        return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
     }
 
     if (is_qmistatus_connected (result)) {
-        MMBearerIpConfig *config;
-
         mm_obj_dbg (self, "connected");
-        config = mm_bearer_ip_config_new ();
-        mm_bearer_ip_config_set_method (config, MM_BEARER_IP_METHOD_DHCP);
-        g_task_return_pointer (
-            task,
-            mm_bearer_connect_result_new (ctx->data, config, NULL),
-            (GDestroyNotify)mm_bearer_connect_result_unref);
-        g_object_unref (task);
-        g_object_unref (config);
-        return;
+        return MM_BEARER_CONNECTION_STATUS_CONNECTED;
     }
 
+    g_free (ctx->last_status);
+    ctx->last_status = normalize_qmistatus (result);
+
     /* Don't retry if the call failed */
     if (is_qmistatus_call_failed (result)) {
         mm_obj_dbg (self, "not retrying: call failed");
-        ctx->retries = 0;
-    }
-
-retry:
-    if (ctx->retries > 0) {
-        ctx->retries--;
-        mm_obj_dbg (self, "retrying status check in a second: %d retries left", ctx->retries);
-        g_timeout_add_seconds (1, (GSourceFunc)connect_3gpp_qmistatus, task);
-        return;
+        g_set_error (error,
+                     MM_CORE_ERROR,
+                     MM_CORE_ERROR_FAILED,
+                     "QMI connect failed: %s",
+                     ctx->last_status);
+        return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
     }
 
-    /* Already exhausted all retries */
-    normalized_result = normalize_qmistatus (result);
-    g_task_return_new_error (task,
-                             MM_CORE_ERROR,
-                             MM_CORE_ERROR_FAILED,
-                             "QMI connect failed: %s",
-                             normalized_result);
-    g_object_unref (task);
-    g_free (normalized_result);
+    mm_obj_dbg (self, "not connected yet, will retry status check");
+    return MM_BEARER_CONNECTION_STATUS_DISCONNECTED;
 }
 
-static gboolean
-connect_3gpp_qmistatus (GTask *task)
+static void
+connect_3gpp_qmistatus (MMBroadbandBearer      *self,
+                        DetailedConnectContext *ctx,
+                        GAsyncReadyCallback     callback,
+                        gpointer                user_data)
 {
-    DetailedConnectContext *ctx;
-
-    ctx = g_task_get_task_data (task);
-
     mm_base_modem_at_command_full (
         ctx->modem,
         MM_IFACE_PORT_AT (ctx->primary),
@@ -257,11 +227,50 @@ connect_3gpp_qmistatus (GTask *task)
         3, /* timeout */
         FALSE, /* allow_cached */
         FALSE, /* is_raw */
-        g_task_get_cancellable (task),
-        (GAsyncReadyCallback)connect_3gpp_qmistatus_ready, /* callback */
-        task); /* user_data */
+        NULL, /* cancellable */
+        callback,
+        user_data);
+}
+
+static void
+connect_3gpp_wait_connected_ready (MMBroadbandBearer *self,
+                                   GAsyncResult      *res,
+                                   GTask             *task)
+{
+    DetailedConnectContext *ctx;
+    MMBearerIpConfig *config;
+    GError *error = NULL;
+
+    ctx = g_task_get_task_data (task);
 
-    return G_SOURCE_REMOVE;
+    if (!mm_broadband_bearer_wait_connection_status_finish (self, res, &error)) {
+        /* Already exhausted all retries */
+        if (g_error_matches (error, MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_NETWORK_TIMEOUT) &&
+            ctx->last_status) {
+            g_clear_error (&error);
+            error = g_error_new (MM_CORE_ERROR,
+                                 MM_CORE_ERROR_FAILED,
+                                 "QMI connect failed: %s",
+                                 ctx->last_status);
+        }
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    if (g_task_return_error_if_cancelled (task)) {
+        g_object_unref (task);
+        return;
+    }
+
+    config = mm_bearer_ip_config_new ();
+    mm_bearer_ip_config_set_method (config, MM_BEARER_IP_METHOD_DHCP);
+    g_task_return_pointer (
+        task,
+        mm_bearer_connect_result_new (ctx->data, config, NULL),
+        (GDestroyNotify)mm_bearer_connect_result_unref);
+    g_object_unref (task);
+    g_object_unref (config);
 }
 
 static void
@@ -285,7 +294,16 @@ connect_3gpp_qmiconnect_ready (MMBaseModem *modem,
      * happened. Instead, we need to poll the modem to see if it's
      * ready.
      */
-    g_timeout_add_seconds (1, (GSourceFunc)connect_3gpp_qmistatus, task);
+    mm_broadband_bearer_wait_connection_status (
+        MM_BROADBAND_BEARER (g_task_get_source_object (task)),
+        MM_BEARER_CONNECTION_STATUS_CONNECTED,
+        MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
+        (MMBroadbandBearerStatusPollFn)connect_3gpp_qmistatus,
+        (MMBroadbandBearerStatusPollFinishFn)connect_3gpp_qmistatus_finish,
+        g_task_get_task_data (task),
+        g_task_get_cancellable (task),
+        (GAsyncReadyCallback)connect_3gpp_wait_connected_ready,
+        task);
 }
 
 static void
@@ -336,7 +354,6 @@ connect_3gpp (MMBroadbandBearer *self,
     ctx = g_slice_new0 (DetailedConnectContext);
     ctx->modem = MM_BASE_MODEM (g_object_ref (modem));
     ctx->primary = g_object_ref (primary);
-    ctx->retries = MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT;
 
     task = g_task_new (self, cancellable, callback, user_data);
     g_task_set_task_data (task, ctx, (GDestroyNotify)detailed_connect_context_free);
@@ -363,12 +380,14 @@ typedef struct {
     MMBaseModem *modem;
     MMPortSerialAt *primary;
     MMPort *data;
-    gint retries;
+    gboolean is_connected;
+    gchar *last_status;
 } DetailedDisconnectContext;
 
 static void
 detailed_disconnect_context_free (DetailedDisconnectContext *ctx)
 {
+    g_free (ctx->last_status);
     g_object_unref (ctx->data);
     g_object_unref (ctx->primary);
     g_object_unref (ctx->modem);
@@ -383,72 +402,43 @@ disconnect_3gpp_finish (MMBroadbandBearer *self,
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
-static gboolean disconnect_3gpp_qmistatus (GTask *task);
-
-static void
-disconnect_3gpp_status_ready (MMBaseModem  *modem,
-                              GAsyncResult *res,
-                              GTask        *task)
+static MMBearerConnectionStatus
+disconnect_3gpp_qmistatus_finish (MMBroadbandBearer          *self,
+                                  GAsyncResult               *res,
+                                  DetailedDisconnectContext  *ctx,
+                                  GError                    **error)
 {
-    MMBroadbandBearerNovatelLte *self;
-    DetailedDisconnectContext   *ctx;
-    const gchar                 *result;
-    GError                      *error = NULL;
-    gboolean                     is_connected = FALSE;
+    const gchar *result;
+    GError *inner_error = NULL;
 
-    self = g_task_get_source_object (task);
+    ctx->is_connected = FALSE;
+    g_clear_pointer (&ctx->last_status, g_free);
 
-    result = mm_base_modem_at_command_full_finish (modem, res, &error);
-    if (result) {
-        mm_obj_dbg (self, "QMI connection status: %s", result);
-        if (is_qmistatus_disconnected (result)) {
-            g_task_return_boolean (task, TRUE);
-            g_object_unref (task);
-            return;
-        }
-        if (is_qmistatus_connected (result))
-            is_connected = TRUE;
-    } else {
-        mm_obj_dbg (self, "QMI connection status failed: %s", error->message);
-        g_error_free (error);
-        result = "Unknown error";
+    result = mm_base_modem_at_command_full_finish (ctx->modem, res, &inner_error);
+    if (!result) {
+        mm_obj_dbg (self, "QMI connection status failed: %s", inner_error->message);
+        g_error_free (inner_error);
+        return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
     }
 
-    ctx = g_task_get_task_data (task);
+    mm_obj_dbg (self, "QMI connection status: %s", result);
+    if (is_qmistatus_disconnected (result))
+        return MM_BEARER_CONNECTION_STATUS_DISCONNECTED;
 
-    if (ctx->retries > 0) {
-        ctx->retries--;
-        mm_obj_dbg (self, "retrying status check in a second: %d retries left", ctx->retries);
-        g_timeout_add_seconds (1, (GSourceFunc)disconnect_3gpp_qmistatus, task);
-        return;
+    if (is_qmistatus_connected (result)) {
+        ctx->is_connected = TRUE;
+        ctx->last_status = normalize_qmistatus (result);
+        return MM_BEARER_CONNECTION_STATUS_CONNECTED;
     }
-
-    /* If $NWQMISTATUS reports a CONNECTED QMI state, returns an error such that
-     * the modem state remains 'connected'. Otherwise, assumes the modem is
-     * disconnected from the network successfully. */
-    if (is_connected) {
-        gchar *normalized_result;
-
-        normalized_result = normalize_qmistatus (result);
-        g_task_return_new_error (task,
-                                 MM_CORE_ERROR,
-                                 MM_CORE_ERROR_FAILED,
-                                 "QMI disconnect failed: %s",
-                                 normalized_result);
-        g_free (normalized_result);
-    } else
-        g_task_return_boolean (task, TRUE);
-
-    g_object_unref (task);
+    return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
 }
 
-static gboolean
-disconnect_3gpp_qmistatus (GTask *task)
+static void
+disconnect_3gpp_qmistatus (MMBroadbandBearer         *self,
+                           DetailedDisconnectContext *ctx,
+                           GAsyncReadyCallback        callback,
+                           gpointer                   user_data)
 {
-    DetailedDisconnectContext *ctx;
-
-    ctx = g_task_get_task_data (task);
-
     mm_base_modem_at_command_full (
         ctx->modem,
         MM_IFACE_PORT_AT (ctx->primary),
@@ -457,11 +447,45 @@ disconnect_3gpp_qmistatus (GTask *task)
         FALSE, /* allow_cached */
         FALSE, /* is_raw */
         NULL, /* cancellable */
-        (GAsyncReadyCallback)disconnect_3gpp_status_ready,
-        task); /* user_data */
-    return G_SOURCE_REMOVE;
+        callback,
+        user_data);
 }
 
+static void
+disconnect_3gpp_wait_disconnected_ready (MMBroadbandBearer *self,
+                                         GAsyncResult      *res,
+                                         GTask             *task)
+{
+    DetailedDisconnectContext *ctx;
+    GError *error = NULL;
+
+    ctx = g_task_get_task_data (task);
+
+    if (!mm_broadband_bearer_wait_connection_status_finish (self, res, &error)) {
+        if (!g_error_matches (error, MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_NETWORK_TIMEOUT)) {
+            g_task_return_error (task, error);
+            g_object_unref (task);
+            return;
+        }
+        g_error_free (error);
+
+        /* If $NWQMISTATUS reports a CONNECTED QMI state, returns an error such that
+         * the modem state remains 'connected'. Otherwise, assumes the modem is
+         * disconnected from the network successfully. */
+        if (ctx->is_connected) {
+            g_task_return_new_error (task,
+                                     MM_CORE_ERROR,
+                                     MM_CORE_ERROR_FAILED,
+                                     "QMI disconnect failed: %s",
+                                     ctx->last_status);
+            g_object_unref (task);
+            return;
+        }
+    }
+
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
 
 static void
 disconnect_3gpp_check_status (MMBaseModem  *modem,
@@ -479,7 +503,16 @@ disconnect_3gpp_check_status (MMBaseModem  *modem,
         g_error_free (error);
     }
 
-    disconnect_3gpp_qmistatus (task);
+    mm_broadband_bearer_wait_connection_status (
+        MM_BROADBAND_BEARER (self),
+        MM_BEARER_CONNECTION_STATUS_DISCONNECTED,
+        MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT,
+        (MMBroadbandBearerStatusPollFn)disconnect_3gpp_qmistatus,
+        (MMBroadbandBearerStatusPollFinishFn)disconnect_3gpp_qmistatus_finish,
+        g_task_get_task_data (task),
+        g_task_get_cancellable (task),
+        (GAsyncReadyCallback)disconnect_3gpp_wait_disconnected_ready,
+        task);
 }
 
 static void
@@ -499,7 +532,6 @@ disconnect_3gpp (MMBroadbandBearer *self,
     ctx->modem = MM_BASE_MODEM (g_object_ref (modem));
     ctx->primary = g_object_ref (primary);
     ctx->data = g_object_ref (data);
-    ctx->retries = MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT;
 
     task = g_task_new (self, NULL, callback, user_data);
     g_task_set_task_data (task, ctx, (GDestroyNotify)detailed_disconnect_context_free);
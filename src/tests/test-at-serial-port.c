@@ -155,6 +155,54 @@ at_serial_parse_error (void)
     _run_parse_test (parse_error_tests, G_N_ELEMENTS(parse_error_tests));
 }
 
+typedef struct {
+    const gchar *command;
+    const gchar *key;
+} CommandStatsKeyTest;
+
+static const CommandStatsKeyTest command_stats_key_tests[] = {
+    { "AT\r",                   "AT"           },
+    { "AT+CGMI\r",              "AT+CGMI"      },
+    { "at+cgmi\r",              "AT+CGMI"      },
+    { "AT+CREG?\r",             "AT+CREG?"     },
+    { "AT+CREG=?\r",            "AT+CREG=?"    },
+    { "AT+CREG=2\r",            "AT+CREG="     },
+    { "AT+CMGS=23\r",           "AT+CMGS="     },
+    { "AT^SYSCFGEX?\r",         "AT^SYSCFGEX?" },
+    { "AT+CFUN=1;+CGATT=1\r",   "AT+CFUN="     },
+    { "ATD*99#\r",              "ATD"          },
+    { "ATD+123456789;\r",       "ATD"          },
+    { "ATE0\r",                 "ATE"          },
+    { "AT&F\r",                 "AT&F"         },
+    { "0791448720003023\x1a",   "raw"          },
+    { "",                        "raw"          },
+};
+
+static void
+at_serial_command_stats_key (void)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (command_stats_key_tests); i++) {
+        gchar key[32];
+
+        mm_port_serial_at_build_command_stats_key (command_stats_key_tests[i].command,
+                                                   strlen (command_stats_key_tests[i].command),
+                                                   key,
+                                                   sizeof (key));
+        g_assert_cmpstr (key, ==, command_stats_key_tests[i].key);
+    }
+}
+
+static void
+at_serial_command_stats_key_truncated (void)
+{
+    gchar key[6];
+
+    mm_port_serial_at_build_command_stats_key ("AT+CGDCONT?\r", 12, key, sizeof (key));
+    g_assert_cmpstr (key, ==, "AT+CG");
+}
+
 int main (int argc, char **argv)
 {
     g_test_init (&argc, &argv, NULL);
@@ -162,6 +210,8 @@ int main (int argc, char **argv)
     g_test_add_func ("/ModemManager/AT-serial/echo-removal", at_serial_echo_removal);
     g_test_add_func ("/ModemManager/AT-serial/parse-ok", at_serial_parse_ok);
     g_test_add_func ("/ModemManager/AT-serial/parse-error", at_serial_parse_error);
+    g_test_add_func ("/ModemManager/AT-serial/command-stats-key", at_serial_command_stats_key);
+    g_test_add_func ("/ModemManager/AT-serial/command-stats-key-truncated", at_serial_command_stats_key_truncated);
 
     return g_test_run ();
 }
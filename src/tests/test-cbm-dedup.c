@@ -0,0 +1,118 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#include <glib.h>
+#include <locale.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+#include "mm-log-test.h"
+#include "mm-cbm-dedup.h"
+#include "mm-cbm-part.h"
+
+#define SECONDS(s) ((gint64) (s) * G_USEC_PER_SEC)
+
+/*****************************************************************************/
+
+static void
+test_repeated (void)
+{
+    g_autoptr(MMCbmDedup) dedup = NULL;
+
+    dedup = mm_cbm_dedup_new (60);
+
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E80, 4370, 1, SECONDS (1)));
+    g_assert_true  (mm_cbm_dedup_check (dedup, 0x3E80, 4370, 1, SECONDS (2)));
+
+    /* other page, other channel, and new update number of the same message */
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E80, 4370, 2, SECONDS (3)));
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E80, 4371, 1, SECONDS (3)));
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E81, 4370, 1, SECONDS (3)));
+    g_assert_cmpuint (mm_cbm_dedup_get_size (dedup), ==, 4);
+
+    mm_cbm_dedup_clear (dedup);
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E80, 4370, 1, SECONDS (4)));
+}
+
+static void
+test_retention (void)
+{
+    g_autoptr(MMCbmDedup) dedup = NULL;
+
+    dedup = mm_cbm_dedup_new (60);
+
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E80, 4370, 1, SECONDS (0)));
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E80, 4371, 1, SECONDS (0)));
+
+    /* repeating a page keeps it in the index */
+    g_assert_true  (mm_cbm_dedup_check (dedup, 0x3E80, 4370, 1, SECONDS (50)));
+    g_assert_true  (mm_cbm_dedup_check (dedup, 0x3E80, 4370, 1, SECONDS (100)));
+
+    /* the other one expired, and is removed from the index */
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E81, 4371, 1, SECONDS (100)));
+    g_assert_cmpuint (mm_cbm_dedup_get_size (dedup), ==, 2);
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E80, 4371, 1, SECONDS (101)));
+
+    /* the first one expires as well */
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E80, 4370, 1, SECONDS (160)));
+}
+
+static void
+test_disabled (void)
+{
+    g_autoptr(MMCbmDedup) dedup = NULL;
+
+    dedup = mm_cbm_dedup_new (0);
+
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E80, 4370, 1, SECONDS (1)));
+    g_assert_false (mm_cbm_dedup_check (dedup, 0x3E80, 4370, 1, SECONDS (1)));
+    g_assert_cmpuint (mm_cbm_dedup_get_size (dedup), ==, 0);
+}
+
+static void
+test_peek_header (void)
+{
+    static const guint8 pdu[] = {
+        0x63, 0x40, 0x00, 0x32, 0x01, 0x23,
+        0xC8, 0x32, 0x9B, 0xFD, 0x06 };
+    guint16 serial = 0;
+    guint16 channel = 0;
+    guint8  part_num = 0;
+
+    g_assert_true (mm_cbm_part_peek_header (pdu, G_N_ELEMENTS (pdu), &serial, &channel, &part_num));
+    g_assert_cmpuint (serial, ==, 0x6340);
+    g_assert_cmpuint (channel, ==, 50);
+    g_assert_cmpuint (part_num, ==, 2);
+
+    g_assert_false (mm_cbm_part_peek_header (pdu, 5, &serial, &channel, &part_num));
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/cbm-dedup/repeated",    test_repeated);
+    g_test_add_func ("/MM/cbm-dedup/retention",   test_retention);
+    g_test_add_func ("/MM/cbm-dedup/disabled",    test_disabled);
+    g_test_add_func ("/MM/cbm-dedup/peek-header", test_peek_header);
+
+    return g_test_run ();
+}
@@ -0,0 +1,170 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#include <glib.h>
+#include <locale.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+#include "mm-log-test.h"
+#include "mm-cell-table.h"
+
+/*****************************************************************************/
+
+static MMCellInfo *
+build_lte_cell (const gchar *physical_ci,
+                guint        earfcn,
+                gdouble      rsrp,
+                gboolean     serving)
+{
+    MMCellInfo *info;
+
+    info = mm_cell_info_lte_new_from_dictionary (NULL);
+    mm_cell_info_set_serving (info, serving);
+    mm_cell_info_lte_set_physical_ci (MM_CELL_INFO_LTE (info), physical_ci);
+    mm_cell_info_lte_set_earfcn (MM_CELL_INFO_LTE (info), earfcn);
+    mm_cell_info_lte_set_rsrp (MM_CELL_INFO_LTE (info), rsrp);
+    return info;
+}
+
+static void
+check_update (MMCellTable *table,
+              GList       *cells,
+              gboolean     expected_updated,
+              gsize        expected_added,
+              gsize        expected_changed,
+              gsize        expected_removed)
+{
+    g_autoptr(GVariant) added = NULL;
+    g_autoptr(GVariant) changed = NULL;
+    g_autoptr(GVariant) removed = NULL;
+    gboolean            updated;
+
+    updated = mm_cell_table_update (table, cells, &added, &changed, &removed);
+    g_variant_ref_sink (added);
+    g_variant_ref_sink (changed);
+    g_variant_ref_sink (removed);
+
+    g_assert (updated == expected_updated);
+    g_assert_cmpuint (g_variant_n_children (added),   ==, expected_added);
+    g_assert_cmpuint (g_variant_n_children (changed), ==, expected_changed);
+    g_assert_cmpuint (g_variant_n_children (removed), ==, expected_removed);
+}
+
+static void
+test_updates (void)
+{
+    g_autoptr(MMCellTable) table = NULL;
+    GList                 *cells = NULL;
+
+    table = mm_cell_table_new ();
+
+    /* initial list */
+    cells = g_list_append (cells, build_lte_cell ("1A", 1300, -90.0, TRUE));
+    cells = g_list_append (cells, build_lte_cell ("2B", 1300, -100.0, FALSE));
+    check_update (table, cells, TRUE, 2, 0, 0);
+    g_assert_cmpuint (mm_cell_table_get_n_cells (table), ==, 2);
+
+    /* same values */
+    check_update (table, cells, FALSE, 0, 0, 0);
+    g_list_free_full (cells, g_object_unref);
+    cells = NULL;
+
+    /* new measurement in one cell, same PCI in a different channel, and a
+     * neighbor cell gone */
+    cells = g_list_append (cells, build_lte_cell ("1A", 1300, -95.0, TRUE));
+    cells = g_list_append (cells, build_lte_cell ("2B", 6300, -100.0, FALSE));
+    check_update (table, cells, TRUE, 1, 1, 1);
+    g_assert_cmpuint (mm_cell_table_get_n_cells (table), ==, 2);
+    g_list_free_full (cells, g_object_unref);
+    cells = NULL;
+
+    /* duplicates are reported once */
+    cells = g_list_append (cells, build_lte_cell ("1A", 1300, -95.0, TRUE));
+    cells = g_list_append (cells, build_lte_cell ("1A", 1300, -80.0, TRUE));
+    check_update (table, cells, TRUE, 0, 0, 1);
+    g_assert_cmpuint (mm_cell_table_get_n_cells (table), ==, 1);
+    g_list_free_full (cells, g_object_unref);
+
+    /* everything gone */
+    check_update (table, NULL, TRUE, 0, 0, 1);
+    g_assert_cmpuint (mm_cell_table_get_n_cells (table), ==, 0);
+}
+
+static void
+test_updates_one_by_one (void)
+{
+    g_autoptr(MMCellTable) table = NULL;
+    g_autoptr(GVariant)    added = NULL;
+    g_autoptr(GVariant)    changed = NULL;
+    g_autoptr(GVariant)    removed = NULL;
+    g_autoptr(MMCellInfo)  cell1 = NULL;
+    g_autoptr(MMCellInfo)  cell2 = NULL;
+    gboolean               updated;
+
+    table = mm_cell_table_new ();
+    cell1 = build_lte_cell ("1A", 1300, -90.0, TRUE);
+    cell2 = build_lte_cell ("2B", 1300, -100.0, FALSE);
+
+    mm_cell_table_update_begin (table);
+    g_assert (mm_cell_table_is_updating (table));
+    mm_cell_table_update_add (table, cell1);
+    mm_cell_table_update_add (table, cell2);
+    updated = mm_cell_table_update_end (table, &added, &changed, &removed);
+    g_variant_ref_sink (added);
+    g_variant_ref_sink (changed);
+    g_variant_ref_sink (removed);
+    g_assert (updated);
+    g_assert (!mm_cell_table_is_updating (table));
+    g_assert_cmpuint (g_variant_n_children (added), ==, 2);
+    g_assert_cmpuint (mm_cell_table_get_n_cells (table), ==, 2);
+
+    /* an aborted update doesn't remove the cells that were not given */
+    mm_cell_table_update_begin (table);
+    mm_cell_table_update_abort (table);
+    g_assert (!mm_cell_table_is_updating (table));
+    g_assert_cmpuint (mm_cell_table_get_n_cells (table), ==, 2);
+
+    /* and the next update still reports the changes against the table */
+    g_clear_pointer (&added, g_variant_unref);
+    g_clear_pointer (&changed, g_variant_unref);
+    g_clear_pointer (&removed, g_variant_unref);
+    mm_cell_table_update_begin (table);
+    mm_cell_table_update_add (table, cell1);
+    updated = mm_cell_table_update_end (table, &added, &changed, &removed);
+    g_variant_ref_sink (added);
+    g_variant_ref_sink (changed);
+    g_variant_ref_sink (removed);
+    g_assert (updated);
+    g_assert_cmpuint (g_variant_n_children (added),   ==, 0);
+    g_assert_cmpuint (g_variant_n_children (changed), ==, 0);
+    g_assert_cmpuint (g_variant_n_children (removed), ==, 1);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/cell-table/updates", test_updates);
+    g_test_add_func ("/MM/cell-table/updates-one-by-one", test_updates_one_by_one);
+
+    return g_test_run ();
+}
@@ -0,0 +1,329 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+#include <locale.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <gio/gio.h>
+#include <gio/gunixsocketaddress.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-context.h"
+#include "mm-dispatcher.h"
+#include "mm-log.h"
+
+/* The scripts are never run when the helper replies, but they must pass the
+ * same validation as real ones (e.g. being owned by root) */
+static const gchar *script_path;
+static gchar       *socket_path;
+
+/*****************************************************************************/
+/* Fake helper
+ *
+ * Each request is expected to have the reply delay, in milliseconds, and the
+ * exit status to reply with as script arguments. Requests are processed one
+ * by one, in order, as a real helper would.
+ */
+
+typedef struct {
+    GSocketService    *service;
+    GSocketConnection *connection;
+    GDataInputStream  *input;
+    gchar             *status;
+} FakeHelper;
+
+static void fake_helper_read_next (FakeHelper *helper);
+
+static gboolean
+fake_helper_reply (FakeHelper *helper)
+{
+    g_autofree gchar  *reply = NULL;
+    g_autoptr(GError)  error = NULL;
+
+    reply = g_strdup_printf ("%s\n", helper->status);
+    g_output_stream_write_all (g_io_stream_get_output_stream (G_IO_STREAM (helper->connection)),
+                               reply, strlen (reply), NULL, NULL, &error);
+    g_assert_no_error (error);
+    g_clear_pointer (&helper->status, g_free);
+
+    fake_helper_read_next (helper);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+fake_helper_read_line_ready (GDataInputStream *input,
+                             GAsyncResult     *res,
+                             FakeHelper       *helper)
+{
+    g_autofree gchar *line = NULL;
+    g_auto(GStrv)     args = NULL;
+    guint             delay_ms;
+
+    line = g_data_input_stream_read_line_finish (input, res, NULL, NULL);
+    if (!line)
+        return;
+
+    args = g_strsplit (line, " ", -1);
+    g_assert_cmpuint (g_strv_length (args), ==, 3);
+    g_assert_cmpstr (args[0], ==, script_path);
+    delay_ms = (guint) g_ascii_strtoull (args[1], NULL, 10);
+    helper->status = g_strdup (args[2]);
+
+    g_timeout_add (delay_ms, (GSourceFunc) fake_helper_reply, helper);
+}
+
+static void
+fake_helper_read_next (FakeHelper *helper)
+{
+    g_data_input_stream_read_line_async (helper->input,
+                                         G_PRIORITY_DEFAULT,
+                                         NULL,
+                                         (GAsyncReadyCallback) fake_helper_read_line_ready,
+                                         helper);
+}
+
+static gboolean
+fake_helper_incoming (GSocketService    *service,
+                      GSocketConnection *connection,
+                      GObject           *source_object,
+                      FakeHelper        *helper)
+{
+    g_assert (!helper->connection);
+    helper->connection = g_object_ref (connection);
+    helper->input = g_data_input_stream_new (g_io_stream_get_input_stream (G_IO_STREAM (connection)));
+    fake_helper_read_next (helper);
+    return TRUE;
+}
+
+static FakeHelper *
+fake_helper_new (void)
+{
+    g_autoptr(GSocketAddress)  address = NULL;
+    g_autoptr(GError)          error = NULL;
+    FakeHelper                *helper;
+
+    helper = g_new0 (FakeHelper, 1);
+    helper->service = g_socket_service_new ();
+
+    unlink (socket_path);
+    address = g_unix_socket_address_new (socket_path);
+    g_socket_listener_add_address (G_SOCKET_LISTENER (helper->service), address,
+                                   G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_DEFAULT,
+                                   NULL, NULL, &error);
+    g_assert_no_error (error);
+    g_signal_connect (helper->service, "incoming", G_CALLBACK (fake_helper_incoming), helper);
+    g_socket_service_start (helper->service);
+    return helper;
+}
+
+static void
+fake_helper_free (FakeHelper *helper)
+{
+    g_socket_service_stop (helper->service);
+    g_socket_listener_close (G_SOCKET_LISTENER (helper->service));
+    g_object_unref (helper->service);
+    if (helper->connection) {
+        g_io_stream_close (G_IO_STREAM (helper->connection), NULL, NULL);
+        g_object_unref (helper->connection);
+    }
+    g_clear_object (&helper->input);
+    g_free (helper->status);
+    g_free (helper);
+    unlink (socket_path);
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    GMainLoop *loop;
+    guint      n_pending;
+} TestContext;
+
+typedef struct {
+    TestContext *ctx;
+    GError      *error;
+    gboolean     success;
+} RunResult;
+
+static void
+run_ready (MMDispatcher *dispatcher,
+           GAsyncResult *res,
+           RunResult    *result)
+{
+    result->success = mm_dispatcher_run_finish (dispatcher, res, &result->error);
+    if (--result->ctx->n_pending == 0)
+        g_main_loop_quit (result->ctx->loop);
+}
+
+static void
+run (MMDispatcher *dispatcher,
+     TestContext  *ctx,
+     guint         delay_ms,
+     guint         status,
+     guint         timeout_secs,
+     RunResult    *result)
+{
+    g_autofree gchar *delay_str = NULL;
+    g_autofree gchar *status_str = NULL;
+    const gchar      *argv[4];
+
+    delay_str = g_strdup_printf ("%u", delay_ms);
+    status_str = g_strdup_printf ("%u", status);
+    argv[0] = script_path;
+    argv[1] = delay_str;
+    argv[2] = status_str;
+    argv[3] = NULL;
+
+    result->ctx = ctx;
+    ctx->n_pending++;
+    mm_dispatcher_run (dispatcher, (GStrv) argv, NULL, timeout_secs, NULL,
+                       (GAsyncReadyCallback) run_ready, result);
+}
+
+static MMDispatcher *
+dispatcher_new (void)
+{
+    return g_object_new (MM_TYPE_DISPATCHER,
+                         MM_DISPATCHER_OPERATION_DESCRIPTION, "test",
+                         NULL);
+}
+
+static void
+test_slow_reply (void)
+{
+    g_autoptr(MMDispatcher)  dispatcher = NULL;
+    TestContext              ctx = { 0 };
+    RunResult                result = { 0 };
+    FakeHelper              *helper;
+
+    helper = fake_helper_new ();
+    dispatcher = dispatcher_new ();
+    ctx.loop = g_main_loop_new (NULL, FALSE);
+
+    /* Replies may take longer than the time allowed for writing requests */
+    run (dispatcher, &ctx, 3000, 0, 5, &result);
+    g_main_loop_run (ctx.loop);
+
+    g_assert_no_error (result.error);
+    g_assert (result.success);
+
+    g_main_loop_unref (ctx.loop);
+    fake_helper_free (helper);
+}
+
+static void
+test_reply_after_timeout (void)
+{
+    g_autoptr(MMDispatcher)  dispatcher = NULL;
+    TestContext              ctx = { 0 };
+    RunResult                result_timeout = { 0 };
+    RunResult                result_status = { 0 };
+    FakeHelper              *helper;
+
+    helper = fake_helper_new ();
+    dispatcher = dispatcher_new ();
+    ctx.loop = g_main_loop_new (NULL, FALSE);
+
+    /* The late reply to the first operation must not be taken as the reply
+     * to the second one */
+    run (dispatcher, &ctx, 2000, 0, 1, &result_timeout);
+    run (dispatcher, &ctx, 0, 3, 5, &result_status);
+    g_main_loop_run (ctx.loop);
+
+    g_assert_error (result_timeout.error, MM_CORE_ERROR, MM_CORE_ERROR_TIMEOUT);
+    g_assert_error (result_status.error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED);
+    g_assert (g_str_has_suffix (result_status.error->message, "status 3"));
+    g_clear_error (&result_timeout.error);
+    g_clear_error (&result_status.error);
+
+    g_main_loop_unref (ctx.loop);
+    fake_helper_free (helper);
+}
+
+static void
+test_no_helper (void)
+{
+    g_autoptr(MMDispatcher) dispatcher = NULL;
+    TestContext             ctx = { 0 };
+    RunResult               result = { 0 };
+
+    dispatcher = dispatcher_new ();
+    ctx.loop = g_main_loop_new (NULL, FALSE);
+
+    /* Without helper, the script is run directly */
+    unlink (socket_path);
+    run (dispatcher, &ctx, 0, 0, 5, &result);
+    g_main_loop_run (ctx.loop);
+
+    g_assert_no_error (result.error);
+    g_assert (result.success);
+
+    g_main_loop_unref (ctx.loop);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    g_autoptr(GError)  error = NULL;
+    g_autofree gchar  *tmp_dir = NULL;
+    g_autofree gchar  *socket_arg = NULL;
+    const gchar       *test_args[3];
+    gboolean           success;
+    gint               ret;
+
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    tmp_dir = g_dir_make_tmp ("mm-test-dispatcher-XXXXXX", &error);
+    g_assert_no_error (error);
+    socket_path = g_build_filename (tmp_dir, "helper", NULL);
+    socket_arg = g_strdup_printf ("--dispatcher-helper-socket=%s", socket_path);
+
+    test_args[0] = argv[0];
+    test_args[1] = "--test-session";
+    test_args[2] = socket_arg;
+    mm_context_init (G_N_ELEMENTS (test_args), (gchar **) test_args);
+
+    success = mm_log_setup (mm_context_get_log_level (),
+                            mm_context_get_log_file (),
+                            mm_context_get_log_journal (),
+                            mm_context_get_log_timestamps (),
+                            mm_context_get_log_relative_timestamps (),
+                            mm_context_get_log_personal_info (),
+                            &error);
+    g_assert_no_error (error);
+    g_assert (success);
+
+    script_path = g_file_test ("/usr/bin/true", G_FILE_TEST_IS_EXECUTABLE) ? "/usr/bin/true" : "/bin/true";
+
+    g_test_add_func ("/MM/dispatcher/helper/slow-reply",          test_slow_reply);
+    g_test_add_func ("/MM/dispatcher/helper/reply-after-timeout", test_reply_after_timeout);
+    g_test_add_func ("/MM/dispatcher/helper/none",                test_no_helper);
+
+    ret = g_test_run ();
+
+    g_rmdir (tmp_dir);
+    g_free (socket_path);
+    return ret;
+}
@@ -0,0 +1,207 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#include <glib.h>
+#include <locale.h>
+
+#include "mm-log-test.h"
+#include "mm-histogram.h"
+#include "mm-main-loop-profiler.h"
+#include "mm-log-object.h"
+
+/*****************************************************************************/
+
+static void
+test_empty (void)
+{
+    MMHistogram histogram;
+
+    mm_histogram_reset (&histogram);
+    g_assert_cmpuint (histogram.count, ==, 0);
+    g_assert_cmpuint (mm_histogram_get_percentile (&histogram, 50), ==, 0);
+    g_assert_cmpuint (mm_histogram_get_mean (&histogram), ==, 0);
+}
+
+static void
+test_exact (void)
+{
+    MMHistogram histogram;
+    guint       i;
+
+    /* Small values are recorded exactly */
+    mm_histogram_reset (&histogram);
+    for (i = 0; i < 20; i++)
+        mm_histogram_add (&histogram, i);
+
+    g_assert_cmpuint (histogram.count, ==, 20);
+    g_assert_cmpuint (histogram.min, ==, 0);
+    g_assert_cmpuint (histogram.max, ==, 19);
+    g_assert_cmpuint (histogram.sum, ==, 190);
+    g_assert_cmpuint (mm_histogram_get_percentile (&histogram, 50), ==, 9);
+    g_assert_cmpuint (mm_histogram_get_percentile (&histogram, 100), ==, 19);
+    g_assert_cmpuint (mm_histogram_get_percentile (&histogram, 0), ==, 0);
+}
+
+static void
+test_percentiles (void)
+{
+    MMHistogram histogram;
+    guint64     value;
+    guint       i;
+
+    mm_histogram_reset (&histogram);
+    for (i = 1; i <= 1000; i++)
+        mm_histogram_add (&histogram, i * 1000);
+
+    g_assert_cmpuint (mm_histogram_get_mean (&histogram), ==, 500500);
+
+    /* Within the bucket precision */
+    value = mm_histogram_get_percentile (&histogram, 50);
+    g_assert_cmpuint (value, >=, 500000);
+    g_assert_cmpuint (value, <=, 500000 + 500000 / MM_HISTOGRAM_SUB_BUCKETS);
+
+    value = mm_histogram_get_percentile (&histogram, 99);
+    g_assert_cmpuint (value, >=, 990000);
+    g_assert_cmpuint (value, <=, 1000000);
+
+    /* Never above the maximum */
+    g_assert_cmpuint (mm_histogram_get_percentile (&histogram, 100), ==, 1000000);
+}
+
+static void
+test_overflow (void)
+{
+    MMHistogram histogram;
+
+    /* Values above the largest bucket are kept in it */
+    mm_histogram_reset (&histogram);
+    mm_histogram_add (&histogram, G_MAXUINT64 / 2);
+    mm_histogram_add (&histogram, 1);
+    g_assert_cmpuint (histogram.buckets[MM_HISTOGRAM_N_BUCKETS - 1], ==, 1);
+    g_assert_cmpuint (mm_histogram_get_percentile (&histogram, 100), ==, G_MAXUINT64 / 2);
+    g_assert_cmpuint (mm_histogram_get_percentile (&histogram, 50), ==, 1);
+}
+
+/*****************************************************************************/
+/* Log object standing for a port */
+
+#define TEST_TYPE_PORT test_port_get_type ()
+G_DECLARE_FINAL_TYPE (TestPort, test_port, TEST, PORT, GObject)
+
+struct _TestPort {
+    GObject parent;
+};
+
+static void test_port_log_object_init (MMLogObjectInterface *iface);
+
+G_DEFINE_TYPE_EXTENDED (TestPort, test_port, G_TYPE_OBJECT, 0,
+                        G_IMPLEMENT_INTERFACE (MM_TYPE_LOG_OBJECT, test_port_log_object_init))
+
+static gchar *
+test_port_build_id (MMLogObject *self)
+{
+    return g_strdup ("ttyUSB0/at");
+}
+
+static void
+test_port_log_object_init (MMLogObjectInterface *iface)
+{
+    iface->build_id = test_port_build_id;
+}
+
+static void
+test_port_init (TestPort *self)
+{
+}
+
+static void
+test_port_class_init (TestPortClass *klass)
+{
+}
+
+/*****************************************************************************/
+
+static void
+test_profiler (void)
+{
+    MMMainLoopProfilerScope  scope;
+    const MMHistogram       *histogram;
+    guint                    i;
+
+    /* Nothing recorded until enabled */
+    mm_main_loop_profiler_begin (&scope, "test-callback", NULL);
+    g_assert (!scope.entry);
+    mm_main_loop_profiler_end (&scope);
+    g_assert (!mm_main_loop_profiler_peek_histogram ("test-callback", NULL));
+
+    mm_main_loop_profiler_enable (1000);
+    g_assert (mm_main_loop_profiler_is_enabled ());
+
+    for (i = 0; i < 3; i++) {
+        mm_main_loop_profiler_begin (&scope, "test-callback", NULL);
+        g_usleep (2000);
+        mm_main_loop_profiler_end (&scope);
+    }
+
+    histogram = mm_main_loop_profiler_peek_histogram ("test-callback", NULL);
+    g_assert (histogram);
+    g_assert_cmpuint (histogram->count, ==, 3);
+    g_assert_cmpuint (histogram->min, >=, 2000);
+    g_assert (!mm_main_loop_profiler_peek_histogram ("other-callback", NULL));
+
+    /* The same port owned by a new modem object keeps its entry */
+    {
+        g_autoptr(GObject) port = NULL;
+
+        port = g_object_new (TEST_TYPE_PORT, NULL);
+        mm_log_object_set_owner_id (MM_LOG_OBJECT (port), "modem0");
+        mm_main_loop_profiler_begin (&scope, "test-callback", port);
+        mm_main_loop_profiler_end (&scope);
+        mm_log_object_set_owner_id (MM_LOG_OBJECT (port), "modem1");
+        g_assert_cmpstr (mm_log_object_get_id (MM_LOG_OBJECT (port)), ==, "modem1/ttyUSB0/at");
+        mm_main_loop_profiler_begin (&scope, "test-callback", port);
+        mm_main_loop_profiler_end (&scope);
+    }
+
+    histogram = mm_main_loop_profiler_peek_histogram ("test-callback", "ttyUSB0/at");
+    g_assert (histogram);
+    g_assert_cmpuint (histogram->count, ==, 2);
+    g_assert (!mm_main_loop_profiler_peek_histogram ("test-callback", "modem0/ttyUSB0/at"));
+
+    /* Iterating the main context goes through the profiled poll() */
+    for (i = 0; i < 3; i++)
+        g_main_context_iteration (NULL, FALSE);
+
+    mm_main_loop_profiler_report (5);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/histogram/empty",       test_empty);
+    g_test_add_func ("/MM/histogram/exact",       test_exact);
+    g_test_add_func ("/MM/histogram/percentiles", test_percentiles);
+    g_test_add_func ("/MM/histogram/overflow",    test_overflow);
+    g_test_add_func ("/MM/main-loop-profiler",    test_profiler);
+
+    return g_test_run ();
+}
@@ -0,0 +1,101 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#include <glib.h>
+#include <locale.h>
+
+#include "mm-log-test.h"
+#include "mm-memory-usage.h"
+
+/*****************************************************************************/
+
+static void
+test_account (void)
+{
+    MMMemoryUsage  usage = { 0 };
+    gint64         sample;
+    gpointer       data;
+
+    /* Nothing accounted without a valid sample */
+    mm_memory_usage_account (&usage, MM_MEMORY_SUBSYSTEM_MODEM, -1);
+    g_assert_cmpint (mm_memory_usage_get_total (&usage), ==, 0);
+
+    sample = mm_memory_usage_sample ();
+    if (!mm_memory_usage_supported ()) {
+        g_assert_cmpint (sample, ==, -1);
+        g_test_skip ("heap usage not reported by the C library");
+        return;
+    }
+    g_assert_cmpint (sample, >, 0);
+
+    data = g_malloc (64 * 1024);
+    mm_memory_usage_account (&usage, MM_MEMORY_SUBSYSTEM_VOICE, sample);
+    g_assert_cmpint (usage.bytes[MM_MEMORY_SUBSYSTEM_VOICE], >=, 64 * 1024);
+
+    /* Freed memory is never accounted as negative */
+    sample = mm_memory_usage_sample ();
+    g_free (data);
+    mm_memory_usage_account (&usage, MM_MEMORY_SUBSYSTEM_OMA, sample);
+    g_assert_cmpint (usage.bytes[MM_MEMORY_SUBSYSTEM_OMA], ==, 0);
+
+    g_assert_cmpint (mm_memory_usage_get_total (&usage), ==, usage.bytes[MM_MEMORY_SUBSYSTEM_VOICE]);
+
+    mm_memory_usage_reset (&usage, MM_MEMORY_SUBSYSTEM_VOICE);
+    g_assert_cmpint (mm_memory_usage_get_total (&usage), ==, 0);
+}
+
+static void
+test_build_string (void)
+{
+    MMMemoryUsage     usage = { 0 };
+    g_autofree gchar *str = NULL;
+    g_autofree gchar *empty = NULL;
+
+    empty = mm_memory_usage_build_string (&usage);
+    g_assert_cmpstr (empty, ==, "");
+
+    usage.bytes[MM_MEMORY_SUBSYSTEM_MODEM] = 2048;
+    usage.bytes[MM_MEMORY_SUBSYSTEM_3GPP_PROFILE_MANAGER] = 512;
+    str = mm_memory_usage_build_string (&usage);
+    g_assert_cmpstr (str, ==, "modem: 2.0 KiB, 3gpp-profile-manager: 0.5 KiB");
+    g_assert_cmpint (mm_memory_usage_get_total (&usage), ==, 2560);
+}
+
+static void
+test_subsystem_names (void)
+{
+    guint i;
+
+    for (i = 0; i < MM_MEMORY_SUBSYSTEM_LAST; i++)
+        g_assert (mm_memory_subsystem_get_string (i));
+    g_assert_cmpstr (mm_memory_subsystem_get_string (MM_MEMORY_SUBSYSTEM_CELL_BROADCAST), ==, "cell-broadcast");
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/memory-usage/account",         test_account);
+    g_test_add_func ("/MM/memory-usage/build-string",    test_build_string);
+    g_test_add_func ("/MM/memory-usage/subsystem-names", test_subsystem_names);
+
+    return g_test_run ();
+}
@@ -408,6 +408,54 @@ test_cmgl_response_pantech_multiple (void *f, gpointer d)
     test_cmgl_response (str, expected, G_N_ELEMENTS (expected));
 }
 
+static void
+test_cmgl_response_quoted (void *f, gpointer d)
+{
+    /* Quoted PDUs, an unexpected header and the final response code */
+    const gchar *str =
+        "+CMGL: 4,1,,29\r\n"
+        "\"079100F40D1101000F001000B917118336058F300\"\r\n"
+        "+CMGL: garbage\r\n"
+        "+CMGL: 5,0,,29\r\n"
+        "\" 079100F40D1101000F001000B917118336058F301 \"\r\n"
+        "\r\n"
+        "OK\r\n";
+
+    const MM3gppPduInfo expected [] = {
+        {
+            .index = 4,
+            .status = 1,
+            .pdu = (gchar *) "079100F40D1101000F001000B917118336058F300"
+        },
+        {
+            .index = 5,
+            .status = 0,
+            .pdu = (gchar *) "079100F40D1101000F001000B917118336058F301"
+        }
+    };
+
+    test_cmgl_response (str, expected, G_N_ELEMENTS (expected));
+}
+
+static void
+test_cmgl_response_invalid (void *f, gpointer d)
+{
+    GList  *list;
+    GError *error = NULL;
+
+    /* Header without PDU */
+    list = mm_3gpp_parse_pdu_cmgl_response ("+CMGL: 0,1,,147\r\n\r\nOK", &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED);
+    g_assert (list == NULL);
+    g_clear_error (&error);
+
+    /* Index out of range */
+    list = mm_3gpp_parse_pdu_cmgl_response ("+CMGL: 99999999999,1,,147\r\n0791\r\n", &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED);
+    g_assert (list == NULL);
+    g_clear_error (&error);
+}
+
 /*****************************************************************************/
 /* Test CMGR responses */
 
@@ -416,6 +464,10 @@ test_cmgr_response (const gchar *str,
                     const MM3gppPduInfo *expected)
 {
     MM3gppPduInfo *info;
+    const gchar *pdu;
+    gsize pdu_len;
+    gint status;
+    gboolean success;
     GError *error = NULL;
 
     info = mm_3gpp_parse_cmgr_read_response (str, 0, &error);
@@ -427,6 +479,15 @@ test_cmgr_response (const gchar *str,
     g_assert_cmpstr (info->pdu, ==, expected->pdu);
 
     mm_3gpp_pdu_info_free (info);
+
+    /* The in-place variant must return a slice of the reply itself */
+    success = mm_3gpp_parse_cmgr_read_response_pdu (str, &status, &pdu, &pdu_len, &error);
+    g_assert_no_error (error);
+    g_assert (success);
+    g_assert_cmpint (status, ==, expected->status);
+    g_assert (pdu >= str && pdu + pdu_len <= str + strlen (str));
+    g_assert_cmpuint (pdu_len, ==, strlen (expected->pdu));
+    g_assert (strncmp (pdu, expected->pdu, pdu_len) == 0);
 }
 
 static void
@@ -471,6 +532,46 @@ test_cmgr_response_telit (void *f, gpointer d)
     test_cmgr_response (str, &expected);
 }
 
+static void
+test_cmgr_response_quoted (void *f, gpointer d)
+{
+    const gchar *str =
+        "+CMGR: 1,,50\r\n\"07916163838428F9040B916121021021F7000051905141642"
+        "20A23C4B0BCFD5E8740C4B0BCFD5E83C26E3248196687C9A0301D440DBBC3677918\"\r\n";
+
+    const MM3gppPduInfo expected = {
+        .index = 0,
+        .status = 1,
+        .pdu = (gchar *) "07916163838428F9040B916121021021F7000051905141642"
+        "20A23C4B0BCFD5E8740C4B0BCFD5E83C26E3248196687C9A0301D440DBBC3677918"
+    };
+
+    test_cmgr_response (str, &expected);
+}
+
+static void
+test_cmgr_response_invalid (void *f, gpointer d)
+{
+    static const gchar *invalid[] = {
+        "+CMGR: ",
+        "+CMGR: 1",
+        "+CMGR: 1,,",
+        "+CMGR: 1,,50\r\n",
+        "+CMGR: 99999999999,,50 0791",
+    };
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (invalid); i++) {
+        MM3gppPduInfo *info;
+        GError *error = NULL;
+
+        info = mm_3gpp_parse_cmgr_read_response (invalid[i], 0, &error);
+        g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED);
+        g_assert (info == NULL);
+        g_clear_error (&error);
+    }
+}
+
 /*****************************************************************************/
 /* Test COPS responses */
 
@@ -5379,9 +5480,13 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_cmgl_response_generic_multiple, NULL));
     g_test_suite_add (suite, TESTCASE (test_cmgl_response_pantech, NULL));
     g_test_suite_add (suite, TESTCASE (test_cmgl_response_pantech_multiple, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cmgl_response_quoted, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cmgl_response_invalid, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_cmgr_response_generic, NULL));
     g_test_suite_add (suite, TESTCASE (test_cmgr_response_telit, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cmgr_response_quoted, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cmgr_response_invalid, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_supported_mode_filter, NULL));
 
@@ -0,0 +1,159 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <locale.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+#include "mm-log-test.h"
+#include "mm-modem-info-cache.h"
+
+#define TEST_DEVICE   "/sys/devices/pci0000:00/0000:00:14.0/usb1/1-2"
+#define TEST_PLUGIN   "generic"
+#define TEST_REVISION "FW1.0"
+#define TEST_IMEI     "123456789012345"
+
+/*****************************************************************************/
+
+static gchar *
+build_tmp_filename (void)
+{
+    g_autoptr(GFile)     file = NULL;
+    g_autoptr(GIOStream) stream = NULL;
+    g_autoptr(GError)    error = NULL;
+
+    file = g_file_new_tmp (NULL, (GFileIOStream **)&stream, &error);
+    g_assert_no_error (error);
+    return g_file_get_path (file);
+}
+
+static MmGdbusModem *
+build_skeleton (const gchar *revision,
+                const gchar *equipment_identifier)
+{
+    MmGdbusModem *skeleton;
+
+    skeleton = mm_gdbus_modem_skeleton_new ();
+    mm_gdbus_modem_set_manufacturer (skeleton, "Manufacturer");
+    mm_gdbus_modem_set_model (skeleton, "Model");
+    mm_gdbus_modem_set_revision (skeleton, revision);
+    mm_gdbus_modem_set_equipment_identifier (skeleton, equipment_identifier);
+    return skeleton;
+}
+
+static void
+store_test_info (const gchar *filename)
+{
+    g_autoptr(MMModemInfoCache) cache = NULL;
+    g_autoptr(MmGdbusModem)     skeleton = NULL;
+
+    cache = mm_modem_info_cache_new_for_file (filename);
+    skeleton = build_skeleton (TEST_REVISION, TEST_IMEI);
+    mm_gdbus_modem_set_device_identifier (skeleton, "0123456789abcdef");
+    mm_gdbus_modem_set_supported_ip_families (skeleton, MM_BEARER_IP_FAMILY_IPV4 | MM_BEARER_IP_FAMILY_IPV6);
+    mm_modem_info_cache_store (cache, TEST_DEVICE, TEST_PLUGIN, skeleton);
+}
+
+/*****************************************************************************/
+
+static void
+test_hit (void)
+{
+    g_autofree gchar            *filename = NULL;
+    g_autoptr(MMModemInfoCache)  cache = NULL;
+    g_autoptr(MmGdbusModem)      skeleton = NULL;
+
+    filename = build_tmp_filename ();
+    store_test_info (filename);
+
+    /* New cache object, so that the info is read back from the file */
+    cache = mm_modem_info_cache_new_for_file (filename);
+    skeleton = build_skeleton (TEST_REVISION, TEST_IMEI);
+    g_assert_true (mm_modem_info_cache_lookup (cache, TEST_DEVICE, TEST_PLUGIN, skeleton));
+    g_assert_cmpstr (mm_gdbus_modem_get_device_identifier (skeleton), ==, "0123456789abcdef");
+    g_assert_cmpuint (mm_gdbus_modem_get_supported_ip_families (skeleton), ==,
+                      MM_BEARER_IP_FAMILY_IPV4 | MM_BEARER_IP_FAMILY_IPV6);
+
+    g_unlink (filename);
+}
+
+static void
+test_miss (void)
+{
+    g_autofree gchar            *filename = NULL;
+    g_autoptr(MMModemInfoCache)  cache = NULL;
+    g_autoptr(MmGdbusModem)      skeleton = NULL;
+
+    filename = build_tmp_filename ();
+    store_test_info (filename);
+
+    cache = mm_modem_info_cache_new_for_file (filename);
+
+    /* firmware upgraded */
+    skeleton = build_skeleton ("FW2.0", TEST_IMEI);
+    g_assert_false (mm_modem_info_cache_lookup (cache, TEST_DEVICE, TEST_PLUGIN, skeleton));
+    g_assert_null (mm_gdbus_modem_get_device_identifier (skeleton));
+    g_clear_object (&skeleton);
+
+    /* different model reported */
+    skeleton = build_skeleton (TEST_REVISION, TEST_IMEI);
+    mm_gdbus_modem_set_model (skeleton, "Other model");
+    g_assert_false (mm_modem_info_cache_lookup (cache, TEST_DEVICE, TEST_PLUGIN, skeleton));
+    g_clear_object (&skeleton);
+
+    /* manufacturer not available */
+    skeleton = build_skeleton (TEST_REVISION, TEST_IMEI);
+    mm_gdbus_modem_set_manufacturer (skeleton, NULL);
+    g_assert_false (mm_modem_info_cache_lookup (cache, TEST_DEVICE, TEST_PLUGIN, skeleton));
+    g_clear_object (&skeleton);
+
+    /* different modem in the same physical device */
+    skeleton = build_skeleton (TEST_REVISION, "543210987654321");
+    g_assert_false (mm_modem_info_cache_lookup (cache, TEST_DEVICE, TEST_PLUGIN, skeleton));
+    g_clear_object (&skeleton);
+
+    /* equipment identifier not available */
+    skeleton = build_skeleton (TEST_REVISION, NULL);
+    g_assert_false (mm_modem_info_cache_lookup (cache, TEST_DEVICE, TEST_PLUGIN, skeleton));
+    g_clear_object (&skeleton);
+
+    /* different plugin */
+    skeleton = build_skeleton (TEST_REVISION, TEST_IMEI);
+    g_assert_false (mm_modem_info_cache_lookup (cache, TEST_DEVICE, "other", skeleton));
+
+    /* removed */
+    mm_modem_info_cache_remove (cache, TEST_DEVICE);
+    g_assert_false (mm_modem_info_cache_lookup (cache, TEST_DEVICE, TEST_PLUGIN, skeleton));
+
+    g_unlink (filename);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/modem-info-cache/hit",  test_hit);
+    g_test_add_func ("/MM/modem-info-cache/miss", test_miss);
+
+    return g_test_run ();
+}
@@ -0,0 +1,186 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#include <glib.h>
+#include <locale.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+#include "mm-log-test.h"
+#include "mm-plugin-index.h"
+
+/*****************************************************************************/
+
+static const gchar *tty_subsystems[]     = { "tty", NULL };
+static const gchar *all_subsystems[]     = { "tty", "net", "usbmisc", NULL };
+static const gchar *qmi_drivers[]        = { "qmi_wwan", NULL };
+static const gchar *option_drivers[]     = { "option", "option1", NULL };
+static const guint16 vendor_a[]          = { 0x1199, 0x2c7c, 0 };
+static const mm_uint16_pair product_b[]  = { { 0x12d1, 0x1506 }, { 0, 0 } };
+static const mm_uint16_pair subsys_c[]   = { { 0x8086, 0x1cf8 }, { 0, 0 } };
+static const gchar *tags_d[]             = { "ID_MM_TELIT_PORTS_TAGGED", NULL };
+
+static const MMPluginIndexFilters plugins[] = {
+    /* 0: no filters */
+    { .subsystems = NULL },
+    /* 1: tty only */
+    { .subsystems = tty_subsystems },
+    /* 2: vendor IDs and QMI driver */
+    { .subsystems = all_subsystems, .drivers = qmi_drivers, .vendor_ids = vendor_a },
+    /* 3: product IDs */
+    { .subsystems = all_subsystems, .product_ids = product_b },
+    /* 4: vendor IDs plus subsystem vendor IDs */
+    { .subsystems = all_subsystems, .vendor_ids = vendor_a, .subsystem_vendor_ids = subsys_c },
+    /* 5: udev tags and option driver */
+    { .subsystems = tty_subsystems, .drivers = option_drivers, .udev_tags = tags_d },
+};
+
+static gboolean
+has_tag (const gchar *tag,
+         const gchar *port_tag)
+{
+    return !g_strcmp0 (tag, port_tag);
+}
+
+static MMPluginIndex *
+build_index (void)
+{
+    MMPluginIndex *index;
+    guint          i;
+
+    index = mm_plugin_index_new ();
+    for (i = 0; i < G_N_ELEMENTS (plugins); i++)
+        g_assert_cmpuint (mm_plugin_index_add (index, &plugins[i]), ==, i);
+    g_assert_cmpuint (mm_plugin_index_get_n_plugins (index), ==, G_N_ELEMENTS (plugins));
+    return index;
+}
+
+static void
+check_lookup (MMPluginIndex            *index,
+              const MMPluginIndexQuery *query,
+              const gboolean           *expected)
+{
+    gboolean candidates[G_N_ELEMENTS (plugins)];
+    guint    n_expected = 0;
+    guint    i;
+
+    for (i = 0; i < G_N_ELEMENTS (plugins); i++) {
+        if (expected[i])
+            n_expected++;
+        /* the reference check must agree */
+        g_assert_cmpint (mm_plugin_index_filters_match (&plugins[i], query), ==, expected[i]);
+    }
+
+    g_assert_cmpuint (mm_plugin_index_lookup (index, query, candidates), ==, n_expected);
+    for (i = 0; i < G_N_ELEMENTS (plugins); i++)
+        g_assert_cmpint (candidates[i], ==, expected[i]);
+}
+
+/*****************************************************************************/
+
+static void
+test_lookup (void)
+{
+    g_autoptr(MMPluginIndex) index = NULL;
+
+    index = build_index ();
+
+    /* QMI device from vendor A, tty port */
+    {
+        static const gchar      *drivers[] = { "qmi_wwan", "option", NULL };
+        const MMPluginIndexQuery query = {
+            .subsystem = "tty", .drivers = drivers, .vendor = 0x2c7c, .product = 0x0125,
+            .has_tag = (MMPluginIndexHasTagFn) has_tag,
+        };
+        const gboolean           expected[] = { TRUE, TRUE, TRUE, FALSE, TRUE, FALSE };
+
+        check_lookup (index, &query, expected);
+    }
+
+    /* Product from vendor B, net port */
+    {
+        static const gchar      *drivers[] = { "cdc_ether", NULL };
+        const MMPluginIndexQuery query = {
+            .subsystem = "net", .drivers = drivers, .vendor = 0x12d1, .product = 0x1506,
+            .has_tag = (MMPluginIndexHasTagFn) has_tag,
+        };
+        const gboolean           expected[] = { TRUE, FALSE, FALSE, TRUE, FALSE, FALSE };
+
+        check_lookup (index, &query, expected);
+    }
+
+    /* Other product from vendor B */
+    {
+        static const gchar      *drivers[] = { "cdc_ether", NULL };
+        const MMPluginIndexQuery query = {
+            .subsystem = "net", .drivers = drivers, .vendor = 0x12d1, .product = 0x1001,
+            .has_tag = (MMPluginIndexHasTagFn) has_tag,
+        };
+        const gboolean           expected[] = { TRUE, FALSE, FALSE, FALSE, FALSE, FALSE };
+
+        check_lookup (index, &query, expected);
+    }
+
+    /* PCI device matching the subsystem vendor ID */
+    {
+        static const gchar      *drivers[] = { "mtk_t7xx", NULL };
+        const MMPluginIndexQuery query = {
+            .subsystem = "usbmisc", .drivers = drivers, .vendor = 0x8086, .product = 0x4d75,
+            .has_tag = (MMPluginIndexHasTagFn) has_tag,
+        };
+        const gboolean           expected[] = { TRUE, FALSE, FALSE, FALSE, TRUE, FALSE };
+
+        check_lookup (index, &query, expected);
+    }
+
+    /* Tagged port, with and without tag */
+    {
+        static const gchar      *drivers[] = { "option1", NULL };
+        MMPluginIndexQuery       query = {
+            .subsystem = "tty", .drivers = drivers, .vendor = 0x1bc7, .product = 0x1201,
+            .has_tag = (MMPluginIndexHasTagFn) has_tag,
+            .has_tag_user_data = (gpointer) "ID_MM_TELIT_PORTS_TAGGED",
+        };
+        const gboolean           expected_tagged[] = { TRUE, TRUE, FALSE, FALSE, FALSE, TRUE };
+        const gboolean           expected_untagged[] = { TRUE, TRUE, FALSE, FALSE, FALSE, FALSE };
+
+        check_lookup (index, &query, expected_tagged);
+        query.has_tag_user_data = NULL;
+        check_lookup (index, &query, expected_untagged);
+    }
+
+    /* No drivers, vendor or product */
+    {
+        const MMPluginIndexQuery query = { .subsystem = "tty" };
+        const gboolean           expected[] = { TRUE, TRUE, FALSE, FALSE, FALSE, FALSE };
+
+        check_lookup (index, &query, expected);
+    }
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/plugin-index/lookup", test_lookup);
+
+    return g_test_run ();
+}
@@ -0,0 +1,369 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <locale.h>
+#include <string.h>
+#include <utime.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+#include "mm-log-test.h"
+#include "mm-plugin-manifest.h"
+
+#define TEST_VERSION "1.0.0"
+
+static const gchar          *subsystems[]  = { "tty", "net", NULL };
+static const gchar          *drivers[]     = { "qmi_wwan", "option", NULL };
+static const gchar          *no_drivers[]  = { NULL };
+static const guint16         vendor_ids[]  = { 0x2c7c, 0x1199, 0 };
+static const mm_uint16_pair  product_ids[] = { { 0x12d1, 0x1506 }, { 0x05c6, 0x0000 }, { 0, 0 } };
+static const gchar          *udev_tags[]   = { "ID_MM_QUECTEL_PORTS", NULL };
+
+/*****************************************************************************/
+
+static gchar *
+build_temp_path (void)
+{
+    GError *error = NULL;
+    gchar  *dir;
+    gchar  *path;
+
+    dir = g_dir_make_tmp ("mm-plugin-manifest-XXXXXX", &error);
+    g_assert_no_error (error);
+    path = g_build_filename (dir, MM_PLUGIN_MANIFEST_FILE_NAME, NULL);
+    g_free (dir);
+    return path;
+}
+
+static void
+remove_temp_path (const gchar *path)
+{
+    g_autofree gchar *dir = NULL;
+
+    dir = g_path_get_dirname (path);
+    g_unlink (path);
+    g_rmdir (dir);
+}
+
+/* Module files are created next to the manifest */
+static gchar *
+write_module (const gchar *manifest_path,
+              const gchar *module,
+              const gchar *contents)
+{
+    g_autofree gchar *dir = NULL;
+    GError           *error = NULL;
+    gchar            *path;
+
+    dir = g_path_get_dirname (manifest_path);
+    path = g_build_filename (dir, module, NULL);
+    g_file_set_contents (path, contents, -1, &error);
+    g_assert_no_error (error);
+    return path;
+}
+
+static void
+assert_strv (const gchar * const *strv,
+             const gchar * const *expected)
+{
+    guint i;
+
+    g_assert (strv);
+    for (i = 0; expected[i]; i++)
+        g_assert_cmpstr (strv[i], ==, expected[i]);
+    g_assert (!strv[i]);
+}
+
+static void
+write_manifest (const gchar *path,
+                const gchar *contents)
+{
+    GError *error = NULL;
+
+    g_file_set_contents (path, contents, -1, &error);
+    g_assert_no_error (error);
+}
+
+/*****************************************************************************/
+
+static void
+test_write_read (void)
+{
+    g_autoptr(MMPluginManifest)  manifest = NULL;
+    g_autoptr(MMPluginManifest)  loaded = NULL;
+    g_autofree gchar            *path = NULL;
+    g_autofree gchar            *module_a = NULL;
+    g_autofree gchar            *module_b = NULL;
+    const MMPluginManifestEntry *entry;
+    MMPluginIndexFilters         filters = { 0 };
+    MMPluginIndexFilters         index_filters;
+    GError                      *error = NULL;
+
+    path = build_temp_path ();
+    module_a = write_module (path, "libmm-plugin-a.so", "a");
+    module_b = write_module (path, "libmm-plugin-b.so", "bb");
+
+    manifest = mm_plugin_manifest_new (TEST_VERSION);
+
+    filters.subsystems = subsystems;
+    filters.drivers = drivers;
+    filters.vendor_ids = vendor_ids;
+    filters.product_ids = product_ids;
+    filters.udev_tags = udev_tags;
+    g_assert (mm_plugin_manifest_add (manifest, module_a, "a", &filters, FALSE, &error));
+    g_assert_no_error (error);
+
+    memset (&filters, 0, sizeof (filters));
+    filters.subsystems = subsystems;
+    filters.drivers = no_drivers;
+    filters.vendor_ids = vendor_ids;
+    g_assert (mm_plugin_manifest_add (manifest, module_b, "b", &filters, TRUE, &error));
+    g_assert_no_error (error);
+
+    g_assert_cmpuint (mm_plugin_manifest_get_n_entries (manifest), ==, 2);
+
+    g_assert (mm_plugin_manifest_write (manifest, path, &error));
+    g_assert_no_error (error);
+
+    loaded = mm_plugin_manifest_new_from_file (path, TEST_VERSION, &error);
+    g_assert_no_error (error);
+    g_assert (loaded);
+    g_assert_cmpuint (mm_plugin_manifest_get_n_entries (loaded), ==, 2);
+    g_assert (!mm_plugin_manifest_lookup (loaded, "libmm-plugin-c.so"));
+
+    entry = mm_plugin_manifest_lookup (loaded, "libmm-plugin-a.so");
+    g_assert (entry);
+    g_assert_cmpstr (entry->module, ==, "libmm-plugin-a.so");
+    g_assert_cmpstr (entry->name, ==, "a");
+    g_assert_cmpuint (entry->module_size, ==, 1);
+    g_assert (mm_plugin_manifest_entry_matches_module (entry, module_a));
+    g_assert (!mm_plugin_manifest_entry_matches_module (entry, module_b));
+    g_assert (!entry->probe_strings);
+    assert_strv (entry->filters.subsystems, subsystems);
+    assert_strv (entry->filters.drivers, drivers);
+    assert_strv (entry->filters.udev_tags, udev_tags);
+    g_assert_cmpmem (entry->filters.vendor_ids, sizeof (vendor_ids), vendor_ids, sizeof (vendor_ids));
+    g_assert_cmpmem (entry->filters.product_ids, sizeof (product_ids), product_ids, sizeof (product_ids));
+    g_assert (!entry->filters.subsystem_vendor_ids);
+
+    mm_plugin_manifest_entry_get_index_filters (entry, &index_filters);
+    g_assert (index_filters.vendor_ids == entry->filters.vendor_ids);
+    g_assert (index_filters.product_ids == entry->filters.product_ids);
+
+    /* An empty list of drivers still applies the filter */
+    entry = mm_plugin_manifest_lookup (loaded, "libmm-plugin-b.so");
+    g_assert (entry);
+    g_assert_cmpstr (entry->name, ==, "b");
+    g_assert_cmpuint (entry->module_size, ==, 2);
+    g_assert (entry->probe_strings);
+    g_assert (entry->filters.drivers);
+    g_assert_cmpuint (g_strv_length ((gchar **) entry->filters.drivers), ==, 0);
+    g_assert (!entry->filters.product_ids);
+    g_assert (!entry->filters.udev_tags);
+
+    /* Vendor IDs don't discard ports if strings are probed */
+    mm_plugin_manifest_entry_get_index_filters (entry, &index_filters);
+    g_assert (!index_filters.vendor_ids);
+    g_assert (index_filters.subsystems == entry->filters.subsystems);
+
+    g_unlink (module_a);
+    g_unlink (module_b);
+    remove_temp_path (path);
+}
+
+static void
+test_module_changed (void)
+{
+    g_autoptr(MMPluginManifest)  manifest = NULL;
+    g_autofree gchar            *path = NULL;
+    g_autofree gchar            *module = NULL;
+    const MMPluginManifestEntry *entry;
+    MMPluginIndexFilters         filters = { 0 };
+    struct utimbuf               times = { .actime = 1, .modtime = 1 };
+    GError                      *error = NULL;
+
+    path = build_temp_path ();
+    module = write_module (path, "libmm-plugin-a.so", "a");
+
+    manifest = mm_plugin_manifest_new (TEST_VERSION);
+    filters.subsystems = subsystems;
+    g_assert (mm_plugin_manifest_add (manifest, module, "a", &filters, FALSE, &error));
+    g_assert_no_error (error);
+
+    entry = mm_plugin_manifest_lookup (manifest, "libmm-plugin-a.so");
+    g_assert (entry);
+    g_assert (mm_plugin_manifest_entry_matches_module (entry, module));
+
+    /* Same size, different modification time */
+    g_assert_cmpint (g_utime (module, &times), ==, 0);
+    g_assert (!mm_plugin_manifest_entry_matches_module (entry, module));
+
+    /* Different size */
+    g_unlink (module);
+    g_free (write_module (path, "libmm-plugin-a.so", "aa"));
+    g_assert (!mm_plugin_manifest_entry_matches_module (entry, module));
+
+    /* Removed */
+    g_unlink (module);
+    g_assert (!mm_plugin_manifest_entry_matches_module (entry, module));
+
+    /* Adding a module that doesn't exist fails */
+    g_assert (!mm_plugin_manifest_add (manifest, module, "a", &filters, FALSE, &error));
+    g_assert_error (error, G_FILE_ERROR, G_FILE_ERROR_NOENT);
+    g_clear_error (&error);
+
+    remove_temp_path (path);
+}
+
+static void
+test_add_entry (void)
+{
+    g_autoptr(MMPluginManifest)  manifest = NULL;
+    g_autoptr(MMPluginManifest)  updated = NULL;
+    g_autofree gchar            *path = NULL;
+    g_autofree gchar            *module = NULL;
+    const MMPluginManifestEntry *entry;
+    const MMPluginManifestEntry *copy;
+    MMPluginIndexFilters         filters = { 0 };
+    GError                      *error = NULL;
+
+    path = build_temp_path ();
+    module = write_module (path, "libmm-plugin-a.so", "a");
+
+    manifest = mm_plugin_manifest_new (TEST_VERSION);
+    filters.subsystems = subsystems;
+    filters.vendor_ids = vendor_ids;
+    g_assert (mm_plugin_manifest_add (manifest, module, "a", &filters, TRUE, &error));
+    g_assert_no_error (error);
+    entry = mm_plugin_manifest_lookup (manifest, "libmm-plugin-a.so");
+    g_assert (entry);
+
+    /* Entries kept when the manifest is rewritten are copied as they are */
+    updated = mm_plugin_manifest_new (TEST_VERSION);
+    mm_plugin_manifest_add_entry (updated, entry);
+    g_clear_pointer (&manifest, mm_plugin_manifest_free);
+
+    copy = mm_plugin_manifest_lookup (updated, "libmm-plugin-a.so");
+    g_assert (copy);
+    g_assert_cmpstr (copy->name, ==, "a");
+    g_assert (copy->probe_strings);
+    g_assert (mm_plugin_manifest_entry_matches_module (copy, module));
+    assert_strv (copy->filters.subsystems, subsystems);
+    g_assert_cmpmem (copy->filters.vendor_ids, sizeof (vendor_ids), vendor_ids, sizeof (vendor_ids));
+
+    g_unlink (module);
+    remove_temp_path (path);
+}
+
+static void
+test_version_mismatch (void)
+{
+    g_autoptr(MMPluginManifest)  manifest = NULL;
+    g_autofree gchar            *path = NULL;
+    GError                      *error = NULL;
+
+    path = build_temp_path ();
+    write_manifest (path,
+                    "[ModemManager]\n"
+                    "version=0.9.0\n"
+                    "[libmm-plugin-a.so]\n"
+                    "name=a\n"
+                    "subsystems=tty;\n"
+                    "probe-strings=false\n");
+
+    manifest = mm_plugin_manifest_new_from_file (path, TEST_VERSION, &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED);
+    g_assert (!manifest);
+    g_clear_error (&error);
+
+    remove_temp_path (path);
+}
+
+static void
+test_invalid (void)
+{
+    static const gchar *invalid_entries[] = {
+        /* no name */
+        "module-size=1\nmodule-mtime=1\nsubsystems=tty;\nprobe-strings=false\n",
+        /* no module size */
+        "name=a\nmodule-mtime=1\nsubsystems=tty;\nprobe-strings=false\n",
+        /* no module modification time */
+        "name=a\nmodule-size=1\nsubsystems=tty;\nprobe-strings=false\n",
+        /* no subsystems */
+        "name=a\nmodule-size=1\nmodule-mtime=1\nprobe-strings=false\n",
+        /* invalid vendor ID */
+        "name=a\nmodule-size=1\nmodule-mtime=1\nsubsystems=tty;\nvendor-ids=xyz;\nprobe-strings=false\n",
+        /* vendor ID out of range */
+        "name=a\nmodule-size=1\nmodule-mtime=1\nsubsystems=tty;\nvendor-ids=12345;\nprobe-strings=false\n",
+        /* product ID without vendor */
+        "name=a\nmodule-size=1\nmodule-mtime=1\nsubsystems=tty;\nproduct-ids=1506;\nprobe-strings=false\n",
+    };
+    g_autofree gchar *path = NULL;
+    guint             i;
+
+    path = build_temp_path ();
+    for (i = 0; i < G_N_ELEMENTS (invalid_entries); i++) {
+        g_autoptr(MMPluginManifest)  manifest = NULL;
+        g_autofree gchar            *contents = NULL;
+        GError                      *error = NULL;
+
+        contents = g_strdup_printf ("[ModemManager]\n"
+                                    "version=" TEST_VERSION "\n"
+                                    "[libmm-plugin-a.so]\n"
+                                    "%s",
+                                    invalid_entries[i]);
+        write_manifest (path, contents);
+
+        manifest = mm_plugin_manifest_new_from_file (path, TEST_VERSION, &error);
+        g_assert (error);
+        g_assert (!manifest);
+        g_clear_error (&error);
+    }
+    remove_temp_path (path);
+}
+
+static void
+test_missing (void)
+{
+    g_autoptr(MMPluginManifest) manifest = NULL;
+    GError                     *error = NULL;
+
+    manifest = mm_plugin_manifest_new_from_file ("/nonexistent/" MM_PLUGIN_MANIFEST_FILE_NAME, TEST_VERSION, &error);
+    g_assert_error (error, G_FILE_ERROR, G_FILE_ERROR_NOENT);
+    g_assert (!manifest);
+    g_clear_error (&error);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/plugin-manifest/write-read",       test_write_read);
+    g_test_add_func ("/MM/plugin-manifest/module-changed",   test_module_changed);
+    g_test_add_func ("/MM/plugin-manifest/add-entry",        test_add_entry);
+    g_test_add_func ("/MM/plugin-manifest/version-mismatch", test_version_mismatch);
+    g_test_add_func ("/MM/plugin-manifest/invalid",          test_invalid);
+    g_test_add_func ("/MM/plugin-manifest/missing",          test_missing);
+
+    return g_test_run ();
+}
@@ -0,0 +1,259 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+#include <config.h>
+
+#include <glib.h>
+#include <gio/gio.h>
+#include <locale.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+#include "mm-log-test.h"
+#include "mm-skeleton-batch.h"
+
+#define TEST_OBJECT_PATH "/org/freedesktop/ModemManager1/Modem/0"
+
+/*****************************************************************************/
+
+typedef struct {
+    GTestDBus        *dbus;
+    GDBusConnection  *connection;
+    MmGdbusModem3gpp *skeleton;
+    MmGdbusModem     *modem_skeleton;
+    guint             subscription_id;
+    guint             n_properties_changed;
+} TestFixture;
+
+static void
+properties_changed_cb (GDBusConnection *connection,
+                       const gchar     *sender_name,
+                       const gchar     *object_path,
+                       const gchar     *interface_name,
+                       const gchar     *signal_name,
+                       GVariant        *parameters,
+                       TestFixture     *tf)
+{
+    tf->n_properties_changed++;
+}
+
+/* Run all the pending idle emissions, and make sure all signals emitted so far
+ * have been routed back to us by the bus before counting them */
+static guint
+wait_properties_changed (TestFixture *tf)
+{
+    g_autoptr(GVariant) result = NULL;
+    g_autoptr(GError)   error = NULL;
+    guint               n;
+
+    while (g_main_context_iteration (NULL, FALSE));
+
+    result = g_dbus_connection_call_sync (tf->connection,
+                                          "org.freedesktop.DBus",
+                                          "/org/freedesktop/DBus",
+                                          "org.freedesktop.DBus",
+                                          "GetId",
+                                          NULL,
+                                          NULL,
+                                          G_DBUS_CALL_FLAGS_NONE,
+                                          -1,
+                                          NULL,
+                                          &error);
+    g_assert_no_error (error);
+
+    while (g_main_context_iteration (NULL, FALSE));
+
+    n = tf->n_properties_changed;
+    tf->n_properties_changed = 0;
+    return n;
+}
+
+/*****************************************************************************/
+
+/* Operator code and name loaded in different main loop iterations before
+ * the registration state is updated */
+static void
+test_registration_unbatched (TestFixture   *tf,
+                             gconstpointer  unused)
+{
+    guint n = 0;
+
+    mm_gdbus_modem3gpp_set_operator_code (tf->skeleton, "21401");
+    n += wait_properties_changed (tf);
+    mm_gdbus_modem3gpp_set_operator_name (tf->skeleton, "operator");
+    n += wait_properties_changed (tf);
+    mm_gdbus_modem3gpp_set_registration_state (tf->skeleton, MM_MODEM_3GPP_REGISTRATION_STATE_HOME);
+    mm_gdbus_modem3gpp_set_packet_service_state (tf->skeleton, MM_MODEM_3GPP_PACKET_SERVICE_STATE_ATTACHED);
+    n += wait_properties_changed (tf);
+
+    g_test_message ("unbatched registration change: %u PropertiesChanged signals", n);
+    g_assert_cmpuint (n, ==, 3);
+}
+
+/* Operator info published together with the registration state */
+static void
+test_registration_batched (TestFixture   *tf,
+                           gconstpointer  unused)
+{
+    mm_skeleton_batch_begin (tf->skeleton);
+    mm_gdbus_modem3gpp_set_operator_code (tf->skeleton, "21401");
+    mm_gdbus_modem3gpp_set_operator_name (tf->skeleton, "operator");
+    mm_gdbus_modem3gpp_set_registration_state (tf->skeleton, MM_MODEM_3GPP_REGISTRATION_STATE_HOME);
+    mm_skeleton_batch_flush (tf->skeleton);
+    mm_gdbus_modem3gpp_set_packet_service_state (tf->skeleton, MM_MODEM_3GPP_PACKET_SERVICE_STATE_ATTACHED);
+    mm_skeleton_batch_flush (tf->skeleton);
+    mm_skeleton_batch_end (tf->skeleton);
+
+    g_assert_cmpuint (wait_properties_changed (tf), ==, 1);
+}
+
+/* Signal quality and access technology replies received in different main
+ * loop iterations during the periodic signal check */
+static void
+test_signal_unbatched (TestFixture   *tf,
+                       gconstpointer  unused)
+{
+    guint n = 0;
+
+    mm_gdbus_modem_set_signal_quality (tf->modem_skeleton, g_variant_new ("(ub)", 75, TRUE));
+    n += wait_properties_changed (tf);
+    mm_gdbus_modem_set_access_technologies (tf->modem_skeleton, MM_MODEM_ACCESS_TECHNOLOGY_LTE);
+    n += wait_properties_changed (tf);
+
+    g_assert_cmpuint (n, ==, 2);
+}
+
+/* Signal quality and access technology published together once the check
+ * is done */
+static void
+test_signal_batched (TestFixture   *tf,
+                     gconstpointer  unused)
+{
+    mm_skeleton_batch_begin (tf->modem_skeleton);
+    mm_gdbus_modem_set_signal_quality (tf->modem_skeleton, g_variant_new ("(ub)", 75, TRUE));
+    mm_skeleton_batch_flush (tf->modem_skeleton);
+    mm_gdbus_modem_set_access_technologies (tf->modem_skeleton, MM_MODEM_ACCESS_TECHNOLOGY_LTE);
+    mm_skeleton_batch_flush (tf->modem_skeleton);
+    mm_skeleton_batch_end (tf->modem_skeleton);
+
+    g_assert_cmpuint (wait_properties_changed (tf), ==, 1);
+}
+
+static void
+test_flush_unbatched (TestFixture   *tf,
+                      gconstpointer  unused)
+{
+    mm_gdbus_modem3gpp_set_operator_code (tf->skeleton, "21401");
+    mm_skeleton_batch_flush (tf->skeleton);
+    mm_gdbus_modem3gpp_set_operator_name (tf->skeleton, "operator");
+    mm_skeleton_batch_flush (tf->skeleton);
+
+    g_assert_cmpuint (wait_properties_changed (tf), ==, 2);
+}
+
+static void
+test_flush_nested (TestFixture   *tf,
+                   gconstpointer  unused)
+{
+    mm_skeleton_batch_begin (tf->skeleton);
+    mm_gdbus_modem3gpp_set_operator_code (tf->skeleton, "21401");
+    mm_skeleton_batch_begin (tf->skeleton);
+    mm_gdbus_modem3gpp_set_operator_name (tf->skeleton, "operator");
+    mm_skeleton_batch_flush (tf->skeleton);
+    mm_skeleton_batch_end (tf->skeleton);
+    /* not flushed until the outermost batch ends */
+    mm_gdbus_modem3gpp_set_registration_state (tf->skeleton, MM_MODEM_3GPP_REGISTRATION_STATE_HOME);
+    mm_skeleton_batch_flush (tf->skeleton);
+    mm_skeleton_batch_end (tf->skeleton);
+
+    g_assert_cmpuint (wait_properties_changed (tf), ==, 1);
+}
+
+/*****************************************************************************/
+
+static void
+test_fixture_setup (TestFixture   *tf,
+                    gconstpointer  unused)
+{
+    g_autoptr(GError) error = NULL;
+
+    tf->dbus = g_test_dbus_new (G_TEST_DBUS_NONE);
+    g_test_dbus_up (tf->dbus);
+
+    tf->connection = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, &error);
+    g_assert_no_error (error);
+
+    tf->skeleton = mm_gdbus_modem3gpp_skeleton_new ();
+    g_dbus_interface_skeleton_export (G_DBUS_INTERFACE_SKELETON (tf->skeleton),
+                                      tf->connection,
+                                      TEST_OBJECT_PATH,
+                                      &error);
+    g_assert_no_error (error);
+
+    tf->modem_skeleton = mm_gdbus_modem_skeleton_new ();
+    g_dbus_interface_skeleton_export (G_DBUS_INTERFACE_SKELETON (tf->modem_skeleton),
+                                      tf->connection,
+                                      TEST_OBJECT_PATH,
+                                      &error);
+    g_assert_no_error (error);
+
+    tf->subscription_id = g_dbus_connection_signal_subscribe (tf->connection,
+                                                              NULL,
+                                                              "org.freedesktop.DBus.Properties",
+                                                              "PropertiesChanged",
+                                                              TEST_OBJECT_PATH,
+                                                              NULL,
+                                                              G_DBUS_SIGNAL_FLAGS_NONE,
+                                                              (GDBusSignalCallback) properties_changed_cb,
+                                                              tf,
+                                                              NULL);
+    wait_properties_changed (tf);
+}
+
+static void
+test_fixture_cleanup (TestFixture   *tf,
+                      gconstpointer  unused)
+{
+    g_dbus_connection_signal_unsubscribe (tf->connection, tf->subscription_id);
+    g_dbus_interface_skeleton_unexport (G_DBUS_INTERFACE_SKELETON (tf->skeleton));
+    g_clear_object (&tf->skeleton);
+    g_dbus_interface_skeleton_unexport (G_DBUS_INTERFACE_SKELETON (tf->modem_skeleton));
+    g_clear_object (&tf->modem_skeleton);
+    g_dbus_connection_close_sync (tf->connection, NULL, NULL);
+    g_clear_object (&tf->connection);
+    g_test_dbus_down (tf->dbus);
+    g_clear_object (&tf->dbus);
+}
+
+/*****************************************************************************/
+
+#define TEST_ADD(path, func)                                            \
+    g_test_add (path, TestFixture, NULL, test_fixture_setup, func, test_fixture_cleanup)
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    TEST_ADD ("/MM/skeleton-batch/registration/unbatched", test_registration_unbatched);
+    TEST_ADD ("/MM/skeleton-batch/registration/batched",   test_registration_batched);
+    TEST_ADD ("/MM/skeleton-batch/signal/unbatched",       test_signal_unbatched);
+    TEST_ADD ("/MM/skeleton-batch/signal/batched",         test_signal_batched);
+    TEST_ADD ("/MM/skeleton-batch/flush/unbatched",        test_flush_unbatched);
+    TEST_ADD ("/MM/skeleton-batch/flush/nested",           test_flush_nested);
+
+    return g_test_run ();
+}
@@ -477,6 +477,40 @@ test_pdu_wrong_udh (void)
     common_test_invalid_pdu (pdu, G_N_ELEMENTS (pdu));
 }
 
+static void
+test_pdu_hex_in_place (void)
+{
+    /* Same PDU as in test_pdu1, followed by the rest of the modem response;
+     * only the given length must be parsed */
+    static const gchar response[] =
+        "07912104442961F4040B916171957291F800001120821105050A6AC8B2BC7C9A83C2"
+        "20F6DB7D2ECB41EDF27C1E3E97411BDE06754FD3D1A0F9BB5D0695F1F4B29B5C2683"
+        "C6E8B03C3CA697E5F34D6AE303D1D1F2F7DD0D4ABB59A0797D8C0685E7A00028EC26"
+        "832A960B28EC2683BE6050780EBA97D96C17\r\n\r\nOK\r\n";
+    MMSmsPart *part;
+    GError    *error = NULL;
+
+    part = mm_sms_part_3gpp_new_from_hex_pdu (0, response, 240, NULL, &error);
+    g_assert_no_error (error);
+    g_assert (part != NULL);
+    g_assert_cmpstr (mm_sms_part_get_smsc (part), ==, "+12404492164");
+    g_assert_cmpstr (mm_sms_part_get_number (part), ==, "+16175927198");
+    g_assert_cmpstr (mm_sms_part_get_timestamp (part), ==, "2011-02-28T11:50:50-05");
+    mm_sms_part_free (part);
+
+    /* odd length */
+    part = mm_sms_part_3gpp_new_from_hex_pdu (0, response, 239, NULL, &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS);
+    g_assert (part == NULL);
+    g_clear_error (&error);
+
+    /* trailing data is not hex */
+    part = mm_sms_part_3gpp_new_from_hex_pdu (0, response, 242, NULL, &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS);
+    g_assert (part == NULL);
+    g_clear_error (&error);
+}
+
 /********************* SMS ADDRESS ENCODER TESTS *********************/
 
 static void
@@ -777,6 +811,7 @@ int main (int argc, char **argv)
     g_test_add_func ("/MM/SMS/3GPP/PDU-Parser/pdu-wrong-address-size", test_pdu_wrong_address_size);
     g_test_add_func ("/MM/SMS/3GPP/PDU-Parser/pdu-wrong-user-data-elements-size", test_pdu_wrong_user_data_elements_size);
     g_test_add_func ("/MM/SMS/3GPP/PDU-Parser/pdu-wrong-udh", test_pdu_wrong_udh);
+    g_test_add_func ("/MM/SMS/3GPP/PDU-Parser/pdu-hex-in-place", test_pdu_hex_in_place);
 
     g_test_add_func ("/MM/SMS/3GPP/Address-Encoder/smsc-intl", test_address_encode_smsc_intl);
     g_test_add_func ("/MM/SMS/3GPP/Address-Encoder/smsc-unknown", test_address_encode_smsc_unknown);
@@ -0,0 +1,360 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+/*
+ * Replays a stream of Cell Broadcast pages through the same steps the daemon
+ * runs for each received page (deduplication check, PDU parsing and lookup of
+ * the CBM the page belongs to), and reports how many pages were dropped before
+ * being parsed and how many pages per second were processed.
+ *
+ * Pages are either read from a file, one hex PDU per line, or generated for a
+ * set of messages broadcast repeatedly on several channels, as happens during
+ * emergency alerts.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <locale.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-log.h"
+#include "mm-cbm-dedup.h"
+#include "mm-cbm-part.h"
+
+#define PROGRAM_NAME    "mmcbmreplay"
+#define PROGRAM_VERSION PACKAGE_VERSION
+
+#define CBM_PAGE_SIZE 88
+
+#define DEFAULT_MESSAGES  20
+#define DEFAULT_PAGES     3
+#define DEFAULT_CHANNELS  4
+#define DEFAULT_REPEATS   100
+#define DEFAULT_RATE      5000
+#define DEFAULT_RETENTION 3600
+
+/* Context */
+static gchar    *file;
+static gint      n_messages = DEFAULT_MESSAGES;
+static gint      n_pages = DEFAULT_PAGES;
+static gint      n_channels = DEFAULT_CHANNELS;
+static gint      n_repeats = DEFAULT_REPEATS;
+static gint      rate = DEFAULT_RATE;
+static gint      retention = DEFAULT_RETENTION;
+static gboolean  version_flag;
+
+static GOptionEntry main_entries[] = {
+    { "file", 'f', 0, G_OPTION_ARG_FILENAME, &file,
+      "Replay the hex PDUs in the given file, one per line",
+      "[PATH]"
+    },
+    { "messages", 'm', 0, G_OPTION_ARG_INT, &n_messages,
+      "Number of generated messages (default: " G_STRINGIFY (DEFAULT_MESSAGES) ")",
+      "[N]"
+    },
+    { "pages", 'p', 0, G_OPTION_ARG_INT, &n_pages,
+      "Number of pages per generated message, up to 15 (default: " G_STRINGIFY (DEFAULT_PAGES) ")",
+      "[N]"
+    },
+    { "channels", 'c', 0, G_OPTION_ARG_INT, &n_channels,
+      "Number of channels each message is broadcast on (default: " G_STRINGIFY (DEFAULT_CHANNELS) ")",
+      "[N]"
+    },
+    { "repeats", 'r', 0, G_OPTION_ARG_INT, &n_repeats,
+      "Number of times the whole stream is replayed (default: " G_STRINGIFY (DEFAULT_REPEATS) ")",
+      "[N]"
+    },
+    { "rate", 0, 0, G_OPTION_ARG_INT, &rate,
+      "Simulated number of received pages per second (default: " G_STRINGIFY (DEFAULT_RATE) ")",
+      "[N]"
+    },
+    { "retention", 0, 0, G_OPTION_ARG_INT, &retention,
+      "Deduplication retention window, in seconds (default: " G_STRINGIFY (DEFAULT_RETENTION) ")",
+      "[SECONDS]"
+    },
+    { "version", 'V', 0, G_OPTION_ARG_NONE, &version_flag,
+      "Print version",
+      NULL
+    },
+    { NULL }
+};
+
+static void
+print_version_and_exit (void)
+{
+    g_print ("\n"
+             PROGRAM_NAME " " PROGRAM_VERSION "\n"
+             "Copyright (2026) ModemManager contributors\n"
+             "License GPLv2+: GNU GPL version 2 or later <http://gnu.org/licenses/gpl-2.0.html>\n"
+             "This is free software: you are free to change and redistribute it.\n"
+             "There is NO WARRANTY, to the extent permitted by law.\n"
+             "\n");
+    exit (EXIT_SUCCESS);
+}
+
+/*****************************************************************************/
+/* No logging */
+
+guint32 _mm_log_level_mask = 0;
+
+gboolean
+_mm_log_enabled (gpointer     obj,
+                 const gchar *module,
+                 MMLogLevel   level)
+{
+    return FALSE;
+}
+
+void
+_mm_log (gpointer     obj,
+         const gchar *module,
+         const gchar *loc,
+         const gchar *func,
+         MMLogLevel   level,
+         const gchar *fmt,
+         ...)
+{
+}
+
+/*****************************************************************************/
+
+static GByteArray *
+build_page (guint16 serial,
+            guint16 channel,
+            guint8  part_num,
+            guint8  num_parts)
+{
+    /* "This is a test" in packed GSM7, repeated over the page contents */
+    static const guint8 text[] = {
+        0x54, 0x74, 0x7A, 0x0E, 0x4A, 0xCF, 0x41, 0x61,
+        0x10, 0xBD, 0x3C, 0xA7, 0x83, 0x00 };
+    GByteArray *page;
+    guint8      header[6];
+    guint       i;
+
+    header[0] = serial >> 8;
+    header[1] = serial & 0xFF;
+    header[2] = channel >> 8;
+    header[3] = channel & 0xFF;
+    header[4] = 0x01; /* GSM7, english */
+    header[5] = (part_num << 4) | num_parts;
+
+    page = g_byte_array_sized_new (CBM_PAGE_SIZE);
+    g_byte_array_append (page, header, sizeof (header));
+    for (i = sizeof (header); i < CBM_PAGE_SIZE; i++)
+        g_byte_array_append (page, &text[i % G_N_ELEMENTS (text)], 1);
+    return page;
+}
+
+static GPtrArray *
+generate_pages (void)
+{
+    GPtrArray *pages;
+    gint       message;
+    gint       channel;
+    gint       part;
+
+    pages = g_ptr_array_new_with_free_func ((GDestroyNotify)g_byte_array_unref);
+    for (message = 0; message < n_messages; message++) {
+        /* cell wide, immediate display; message code and update number
+         * derived from the message index */
+        guint16 serial = ((message & 0x3FF) << 4) | (message >> 10 & 0x0F);
+
+        for (channel = 0; channel < n_channels; channel++) {
+            for (part = 1; part <= n_pages; part++)
+                g_ptr_array_add (pages, build_page (serial, 4370 + channel, part, n_pages));
+        }
+    }
+    return pages;
+}
+
+static GPtrArray *
+load_pages (GError **error)
+{
+    g_autofree gchar  *contents = NULL;
+    g_auto(GStrv)      lines = NULL;
+    GPtrArray         *pages;
+    guint              i;
+
+    if (!g_file_get_contents (file, &contents, NULL, error))
+        return NULL;
+
+    pages = g_ptr_array_new_with_free_func ((GDestroyNotify)g_byte_array_unref);
+    lines = g_strsplit (contents, "\n", -1);
+    for (i = 0; lines[i]; i++) {
+        g_autoptr(GError)  inner_error = NULL;
+        guint8            *bin;
+        gsize              bin_len = 0;
+
+        g_strstrip (lines[i]);
+        if (!lines[i][0] || lines[i][0] == '#')
+            continue;
+
+        bin = mm_utils_hexstr2bin (lines[i], -1, &bin_len, &inner_error);
+        if (!bin) {
+            g_printerr ("warning: ignoring line %u: %s\n", i + 1, inner_error->message);
+            continue;
+        }
+        g_ptr_array_add (pages, g_byte_array_new_take (bin, bin_len));
+    }
+    return pages;
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    guint n_pages;
+    guint n_accepted;
+    guint n_dropped;
+    guint n_parsed_duplicates;
+    guint n_errors;
+} ReplayStats;
+
+#define CBM_KEY(serial, channel) GUINT_TO_POINTER (((guint) (serial) << 16) | (channel))
+
+static void
+replay (GPtrArray   *pages,
+        guint        retention_secs,
+        ReplayStats *stats,
+        gdouble     *elapsed)
+{
+    g_autoptr(MMCbmDedup)  dedup = NULL;
+    g_autoptr(GHashTable)  messages = NULL;
+    GTimer                *timer;
+    gint64                 now = 0;
+    gint64                 interval;
+    gint                   repeat;
+    guint                  i;
+
+    memset (stats, 0, sizeof (*stats));
+    dedup = mm_cbm_dedup_new (retention_secs);
+    /* (serial, message id) -> bitmask of the pages received, as in the CBM
+     * list */
+    messages = g_hash_table_new (g_direct_hash, g_direct_equal);
+    interval = G_USEC_PER_SEC / rate;
+
+    timer = g_timer_new ();
+    for (repeat = 0; repeat < n_repeats; repeat++) {
+        for (i = 0; i < pages->len; i++) {
+            GByteArray *page = g_ptr_array_index (pages, i);
+            MMCbmPart  *part;
+            guint16     serial;
+            guint16     channel;
+            guint8      part_num;
+            gpointer    key;
+            guint       received;
+
+            stats->n_pages++;
+            now += interval;
+
+            if (!mm_cbm_part_peek_header (page->data, page->len, &serial, &channel, &part_num)) {
+                stats->n_errors++;
+                continue;
+            }
+            if (mm_cbm_dedup_check (dedup, serial, channel, part_num, now)) {
+                stats->n_dropped++;
+                continue;
+            }
+
+            part = mm_cbm_part_new_from_binary_pdu (page->data, page->len, NULL, NULL);
+            if (!part) {
+                stats->n_errors++;
+                continue;
+            }
+
+            key = CBM_KEY (mm_cbm_part_get_serial (part), mm_cbm_part_get_channel (part));
+            received = GPOINTER_TO_UINT (g_hash_table_lookup (messages, key));
+            if (received & (1 << mm_cbm_part_get_part_num (part)))
+                stats->n_parsed_duplicates++;
+            else {
+                g_hash_table_insert (messages, key, GUINT_TO_POINTER (received | (1 << mm_cbm_part_get_part_num (part))));
+                stats->n_accepted++;
+            }
+            mm_cbm_part_free (part);
+        }
+    }
+    *elapsed = g_timer_elapsed (timer, NULL);
+    g_timer_destroy (timer);
+}
+
+static void
+print_stats (const gchar       *name,
+             const ReplayStats *stats,
+             gdouble            elapsed)
+{
+    g_print ("%-12s %8u pages %8u accepted %8u dropped %8u parsed duplicates %6u errors %12.0f pages/s\n",
+             name,
+             stats->n_pages,
+             stats->n_accepted,
+             stats->n_dropped,
+             stats->n_parsed_duplicates,
+             stats->n_errors,
+             elapsed > 0.0 ? stats->n_pages / elapsed : 0.0);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    GOptionContext       *context;
+    g_autoptr(GPtrArray)  pages = NULL;
+    g_autoptr(GError)     error = NULL;
+    ReplayStats           stats;
+    gdouble               elapsed;
+
+    setlocale (LC_ALL, "");
+
+    /* Setup option context, process it and destroy it */
+    context = g_option_context_new ("- ModemManager CBM replay");
+    g_option_context_add_main_entries (context, main_entries, NULL);
+    g_option_context_parse (context, &argc, &argv, NULL);
+    g_option_context_free (context);
+
+    if (version_flag)
+        print_version_and_exit ();
+
+    if (n_messages <= 0 || n_pages <= 0 || n_pages > 15 || n_channels <= 0 ||
+        n_repeats <= 0 || rate <= 0 || rate > G_USEC_PER_SEC || retention < 0) {
+        g_printerr ("error: invalid options\n");
+        exit (EXIT_FAILURE);
+    }
+
+    if (file) {
+        pages = load_pages (&error);
+        if (!pages) {
+            g_printerr ("error: couldn't load PDUs: %s\n", error->message);
+            exit (EXIT_FAILURE);
+        }
+    } else
+        pages = generate_pages ();
+
+    g_print ("replaying %u pages %d times at %d pages/s...\n", pages->len, n_repeats, rate);
+
+    replay (pages, 0, &stats, &elapsed);
+    print_stats ("no dedup", &stats, elapsed);
+
+    replay (pages, retention, &stats, &elapsed);
+    print_stats ("dedup", &stats, elapsed);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,365 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+/*
+ * Compares the cost of preselecting the plugins that may support a port by
+ * running the filters of every plugin, and by looking up the plugin index,
+ * over a synthetic corpus of plugins and multi-port devices.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <locale.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-log.h"
+#include "mm-plugin-index.h"
+
+#define PROGRAM_NAME    "mmpluginindexbench"
+#define PROGRAM_VERSION PACKAGE_VERSION
+
+#define DEFAULT_PLUGINS    50
+#define DEFAULT_DEVICES    1000
+#define DEFAULT_ITERATIONS 20
+#define DEFAULT_SEED       1
+
+#define N_VENDORS        40
+#define PORTS_PER_DEVICE 4
+
+/* Context */
+static gint     n_plugins = DEFAULT_PLUGINS;
+static gint     n_devices = DEFAULT_DEVICES;
+static gint     iterations = DEFAULT_ITERATIONS;
+static gint     seed = DEFAULT_SEED;
+static gboolean version_flag;
+
+static GOptionEntry main_entries[] = {
+    { "plugins", 'p', 0, G_OPTION_ARG_INT, &n_plugins,
+      "Number of synthetic plugins (default: " G_STRINGIFY (DEFAULT_PLUGINS) ")",
+      "[N]"
+    },
+    { "devices", 'd', 0, G_OPTION_ARG_INT, &n_devices,
+      "Number of synthetic devices, with " G_STRINGIFY (PORTS_PER_DEVICE) " ports each (default: " G_STRINGIFY (DEFAULT_DEVICES) ")",
+      "[N]"
+    },
+    { "iterations", 'n', 0, G_OPTION_ARG_INT, &iterations,
+      "Number of iterations over the whole corpus (default: " G_STRINGIFY (DEFAULT_ITERATIONS) ")",
+      "[N]"
+    },
+    { "seed", 's', 0, G_OPTION_ARG_INT, &seed,
+      "Seed of the corpus generator (default: " G_STRINGIFY (DEFAULT_SEED) ")",
+      "[N]"
+    },
+    { "version", 'V', 0, G_OPTION_ARG_NONE, &version_flag,
+      "Print version",
+      NULL
+    },
+    { NULL }
+};
+
+static void
+print_version_and_exit (void)
+{
+    g_print ("\n"
+             PROGRAM_NAME " " PROGRAM_VERSION "\n"
+             "Copyright (2026) ModemManager contributors\n"
+             "License GPLv2+: GNU GPL version 2 or later <http://gnu.org/licenses/gpl-2.0.html>\n"
+             "This is free software: you are free to change and redistribute it.\n"
+             "There is NO WARRANTY, to the extent permitted by law.\n"
+             "\n");
+    exit (EXIT_SUCCESS);
+}
+
+/*****************************************************************************/
+/* No logging */
+
+guint32 _mm_log_level_mask = 0;
+
+gboolean
+_mm_log_enabled (gpointer     obj,
+                 const gchar *module,
+                 MMLogLevel   level)
+{
+    return FALSE;
+}
+
+void
+_mm_log (gpointer     obj,
+         const gchar *module,
+         const gchar *loc,
+         const gchar *func,
+         MMLogLevel   level,
+         const gchar *fmt,
+         ...)
+{
+}
+
+/*****************************************************************************/
+/* Corpus */
+
+static const gchar *subsystems[] = { "tty", "net", "usbmisc", "wwan" };
+static const gchar *drivers[] = { "option", "qcserial", "qmi_wwan", "cdc_mbim", "cdc_acm", "cdc_ether", "sierra", "mhi-pci-generic" };
+static const gchar *udev_tags[] = { "ID_MM_TELIT_PORTS_TAGGED", "ID_MM_HUAWEI_AT_PORT", "ID_MM_DLINK_PORTS_TAGGED" };
+
+typedef struct {
+    MMPluginIndexFilters  filters;
+    GPtrArray            *strvs;
+    GArray               *vendor_ids;
+    GArray               *product_ids;
+} SyntheticPlugin;
+
+typedef struct {
+    const gchar         *drivers[3];
+    guint16              vendor;
+    guint16              product;
+    const gchar         *tag;
+} SyntheticDevice;
+
+static guint16
+random_vendor (GRand *rand)
+{
+    return 0x1000 + g_rand_int_range (rand, 0, N_VENDORS);
+}
+
+static const gchar * const *
+random_strv (GRand        *rand,
+             GPtrArray    *strvs,
+             const gchar **pool,
+             guint         pool_len,
+             guint         max_items)
+{
+    const gchar **strv;
+    guint         n;
+    guint         i;
+
+    n = g_rand_int_range (rand, 1, max_items + 1);
+    strv = g_new0 (const gchar *, n + 1);
+    for (i = 0; i < n; i++)
+        strv[i] = pool[g_rand_int_range (rand, 0, pool_len)];
+    g_ptr_array_add (strvs, strv);
+    return strv;
+}
+
+static void
+build_plugin (GRand           *rand,
+              SyntheticPlugin *plugin)
+{
+    guint i;
+    guint n;
+
+    memset (plugin, 0, sizeof (*plugin));
+    plugin->strvs = g_ptr_array_new_with_free_func (g_free);
+    plugin->vendor_ids = g_array_new (TRUE, TRUE, sizeof (guint16));
+    plugin->product_ids = g_array_new (TRUE, TRUE, sizeof (mm_uint16_pair));
+
+    plugin->filters.subsystems = random_strv (rand, plugin->strvs, subsystems, G_N_ELEMENTS (subsystems), 3);
+    if (g_rand_boolean (rand))
+        plugin->filters.drivers = random_strv (rand, plugin->strvs, drivers, G_N_ELEMENTS (drivers), 3);
+    if (g_rand_int_range (rand, 0, 10) == 0)
+        plugin->filters.udev_tags = random_strv (rand, plugin->strvs, udev_tags, G_N_ELEMENTS (udev_tags), 1);
+
+    /* Most plugins filter by vendor, some also by product */
+    if (g_rand_int_range (rand, 0, 10) < 8) {
+        n = g_rand_int_range (rand, 1, 4);
+        for (i = 0; i < n; i++) {
+            guint16 vendor = random_vendor (rand);
+
+            g_array_append_val (plugin->vendor_ids, vendor);
+        }
+        plugin->filters.vendor_ids = (const guint16 *) plugin->vendor_ids->data;
+    }
+    if (g_rand_int_range (rand, 0, 10) < 3) {
+        n = g_rand_int_range (rand, 1, 20);
+        for (i = 0; i < n; i++) {
+            mm_uint16_pair pair;
+
+            pair.l = random_vendor (rand);
+            pair.r = g_rand_int_range (rand, 1, 64);
+            g_array_append_val (plugin->product_ids, pair);
+        }
+        plugin->filters.product_ids = (const mm_uint16_pair *) plugin->product_ids->data;
+    }
+}
+
+static void
+clear_plugin (SyntheticPlugin *plugin)
+{
+    g_ptr_array_unref (plugin->strvs);
+    g_array_unref (plugin->vendor_ids);
+    g_array_unref (plugin->product_ids);
+}
+
+static void
+build_device (GRand           *rand,
+              SyntheticDevice *device)
+{
+    memset (device, 0, sizeof (*device));
+    device->drivers[0] = drivers[g_rand_int_range (rand, 0, G_N_ELEMENTS (drivers))];
+    device->drivers[1] = drivers[g_rand_int_range (rand, 0, G_N_ELEMENTS (drivers))];
+    /* some devices from unknown vendors */
+    device->vendor = random_vendor (rand) + (g_rand_int_range (rand, 0, 10) == 0 ? N_VENDORS : 0);
+    device->product = g_rand_int_range (rand, 1, 64);
+    if (g_rand_int_range (rand, 0, 20) == 0)
+        device->tag = udev_tags[g_rand_int_range (rand, 0, G_N_ELEMENTS (udev_tags))];
+}
+
+/*****************************************************************************/
+
+static guint n_tag_checks;
+
+static gboolean
+has_tag (const gchar *tag,
+         const gchar *device_tag)
+{
+    n_tag_checks++;
+    return !g_strcmp0 (tag, device_tag);
+}
+
+static void
+build_query (const SyntheticDevice *device,
+             guint                  port,
+             MMPluginIndexQuery    *query)
+{
+    query->subsystem = subsystems[port % G_N_ELEMENTS (subsystems)];
+    query->drivers = device->drivers;
+    query->vendor = device->vendor;
+    query->product = device->product;
+    query->has_tag = (MMPluginIndexHasTagFn) has_tag;
+    query->has_tag_user_data = (gpointer) device->tag;
+}
+
+int main (int argc, char **argv)
+{
+    GOptionContext   *context;
+    GRand            *rand;
+    SyntheticPlugin  *plugins;
+    SyntheticDevice  *devices;
+    MMPluginIndex    *index;
+    gboolean         *candidates;
+    GTimer           *timer;
+    gdouble           linear_elapsed;
+    gdouble           index_elapsed;
+    guint             linear_tag_checks;
+    guint64           n_lookups;
+    guint64           n_candidates = 0;
+    gint              it;
+    gint              d;
+    gint              p;
+    guint             port;
+
+    setlocale (LC_ALL, "");
+
+    /* Setup option context, process it and destroy it */
+    context = g_option_context_new ("- ModemManager plugin preselection benchmark");
+    g_option_context_add_main_entries (context, main_entries, NULL);
+    g_option_context_parse (context, &argc, &argv, NULL);
+    g_option_context_free (context);
+
+    if (version_flag)
+        print_version_and_exit ();
+
+    if (n_plugins <= 0 || n_devices <= 0 || iterations <= 0) {
+        g_printerr ("error: invalid number of plugins, devices or iterations\n");
+        exit (EXIT_FAILURE);
+    }
+
+    /* Build corpus */
+    rand = g_rand_new_with_seed (seed);
+    plugins = g_new0 (SyntheticPlugin, n_plugins);
+    index = mm_plugin_index_new ();
+    for (p = 0; p < n_plugins; p++) {
+        build_plugin (rand, &plugins[p]);
+        mm_plugin_index_add (index, &plugins[p].filters);
+    }
+    devices = g_new0 (SyntheticDevice, n_devices);
+    for (d = 0; d < n_devices; d++)
+        build_device (rand, &devices[d]);
+    g_rand_free (rand);
+
+    candidates = g_new0 (gboolean, n_plugins);
+    n_lookups = (guint64) iterations * n_devices * PORTS_PER_DEVICE;
+
+    /* Check both methods agree before timing them */
+    for (d = 0; d < n_devices; d++) {
+        for (port = 0; port < PORTS_PER_DEVICE; port++) {
+            MMPluginIndexQuery query;
+
+            build_query (&devices[d], port, &query);
+            mm_plugin_index_lookup (index, &query, candidates);
+            for (p = 0; p < n_plugins; p++) {
+                if (candidates[p] != mm_plugin_index_filters_match (&plugins[p].filters, &query)) {
+                    g_printerr ("error: index and filters disagree for device %d, port %u, plugin %d\n", d, port, p);
+                    exit (EXIT_FAILURE);
+                }
+            }
+        }
+    }
+
+    g_print ("running %d iterations over %d plugins and %d devices (%d ports each)...\n",
+             iterations, n_plugins, n_devices, PORTS_PER_DEVICE);
+
+    n_tag_checks = 0;
+    timer = g_timer_new ();
+    for (it = 0; it < iterations; it++) {
+        for (d = 0; d < n_devices; d++) {
+            for (port = 0; port < PORTS_PER_DEVICE; port++) {
+                MMPluginIndexQuery query;
+
+                build_query (&devices[d], port, &query);
+                for (p = 0; p < n_plugins; p++)
+                    candidates[p] = mm_plugin_index_filters_match (&plugins[p].filters, &query);
+            }
+        }
+    }
+    linear_elapsed = g_timer_elapsed (timer, NULL);
+    linear_tag_checks = n_tag_checks;
+
+    n_tag_checks = 0;
+    g_timer_start (timer);
+    for (it = 0; it < iterations; it++) {
+        for (d = 0; d < n_devices; d++) {
+            for (port = 0; port < PORTS_PER_DEVICE; port++) {
+                MMPluginIndexQuery query;
+
+                build_query (&devices[d], port, &query);
+                n_candidates += mm_plugin_index_lookup (index, &query, candidates);
+            }
+        }
+    }
+    index_elapsed = g_timer_elapsed (timer, NULL);
+    g_timer_destroy (timer);
+
+    g_print ("%-8s %10.1f ns/port %8.2f tag checks/port\n",
+             "linear", (linear_elapsed * 1e9) / n_lookups, (gdouble) linear_tag_checks / n_lookups);
+    g_print ("%-8s %10.1f ns/port %8.2f tag checks/port %8.2f candidates/port\n",
+             "index", (index_elapsed * 1e9) / n_lookups, (gdouble) n_tag_checks / n_lookups,
+             (gdouble) n_candidates / n_lookups);
+
+    for (p = 0; p < n_plugins; p++)
+        clear_plugin (&plugins[p]);
+    g_free (plugins);
+    g_free (devices);
+    g_free (candidates);
+    mm_plugin_index_free (index);
+    return EXIT_SUCCESS;
+}
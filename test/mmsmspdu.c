@@ -177,6 +177,16 @@ print_version_and_exit (void)
     exit (EXIT_SUCCESS);
 }
 
+guint32 _mm_log_level_mask = 0xFFFFFFFF;
+
+gboolean
+_mm_log_enabled (gpointer     obj,
+                 const gchar *module,
+                 MMLogLevel   level)
+{
+    return verbose_flag;
+}
+
 void
 _mm_log (gpointer     obj,
          const gchar *module,
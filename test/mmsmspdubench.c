@@ -0,0 +1,237 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+/*
+ * Compares the cost of parsing a +CMGL response with N stored messages by
+ * first building the list of PDU strings and then parsing each of them, and
+ * by parsing each PDU in place while the response is scanned.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <locale.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-log.h"
+#include "mm-modem-helpers.h"
+#include "mm-sms-part-3gpp.h"
+
+#define PROGRAM_NAME    "mmsmspdubench"
+#define PROGRAM_VERSION PACKAGE_VERSION
+
+#define DEFAULT_MESSAGES   50
+#define DEFAULT_ITERATIONS 1000
+
+/* GSM7 message with extended characters, from the unit tests */
+#define TEST_PDU                                                            \
+    "07912104442961F4040B916171957291F800001120821105050A6AC8B2BC7C9A83C2"  \
+    "20F6DB7D2ECB41EDF27C1E3E97411BDE06754FD3D1A0F9BB5D0695F1F4B29B5C2683"  \
+    "C6E8B03C3CA697E5F34D6AE303D1D1F2F7DD0D4ABB59A0797D8C0685E7A00028EC26"  \
+    "832A960B28EC2683BE6050780EBA97D96C17"
+
+/* Context */
+static gint     n_messages = DEFAULT_MESSAGES;
+static gint     iterations = DEFAULT_ITERATIONS;
+static gboolean version_flag;
+
+static GOptionEntry main_entries[] = {
+    { "messages", 'm', 0, G_OPTION_ARG_INT, &n_messages,
+      "Number of messages in the response (default: " G_STRINGIFY (DEFAULT_MESSAGES) ")",
+      "[N]"
+    },
+    { "iterations", 'n', 0, G_OPTION_ARG_INT, &iterations,
+      "Number of iterations of each method (default: " G_STRINGIFY (DEFAULT_ITERATIONS) ")",
+      "[N]"
+    },
+    { "version", 'V', 0, G_OPTION_ARG_NONE, &version_flag,
+      "Print version",
+      NULL
+    },
+    { NULL }
+};
+
+static void
+print_version_and_exit (void)
+{
+    g_print ("\n"
+             PROGRAM_NAME " " PROGRAM_VERSION "\n"
+             "Copyright (2026) ModemManager contributors\n"
+             "License GPLv2+: GNU GPL version 2 or later <http://gnu.org/licenses/gpl-2.0.html>\n"
+             "This is free software: you are free to change and redistribute it.\n"
+             "There is NO WARRANTY, to the extent permitted by law.\n"
+             "\n");
+    exit (EXIT_SUCCESS);
+}
+
+/*****************************************************************************/
+/* No logging */
+
+guint32 _mm_log_level_mask = 0;
+
+gboolean
+_mm_log_enabled (gpointer     obj,
+                 const gchar *module,
+                 MMLogLevel   level)
+{
+    return FALSE;
+}
+
+void
+_mm_log (gpointer     obj,
+         const gchar *module,
+         const gchar *loc,
+         const gchar *func,
+         MMLogLevel   level,
+         const gchar *fmt,
+         ...)
+{
+}
+
+/*****************************************************************************/
+
+static gchar *
+build_response (void)
+{
+    GString *str;
+    gint     i;
+
+    str = g_string_new (NULL);
+    for (i = 0; i < n_messages; i++)
+        g_string_append_printf (str, "+CMGL: %d,1,,%u\r\n" TEST_PDU "\r\n",
+                                i, (guint) ((strlen (TEST_PDU) / 2) - 8));
+    g_string_append (str, "\r\nOK\r\n");
+    return g_string_free (str, FALSE);
+}
+
+static guint
+run_list (const gchar *response)
+{
+    GList *info_list;
+    GList *l;
+    guint  n_parts = 0;
+
+    info_list = mm_3gpp_parse_pdu_cmgl_response (response, NULL);
+    for (l = info_list; l; l = g_list_next (l)) {
+        MM3gppPduInfo *info = l->data;
+        MMSmsPart     *part;
+
+        part = mm_sms_part_3gpp_new_from_pdu (info->index, info->pdu, NULL, NULL);
+        if (part) {
+            n_parts++;
+            mm_sms_part_free (part);
+        }
+    }
+    mm_3gpp_pdu_info_list_free (info_list);
+    return n_parts;
+}
+
+static void
+foreach_pdu (gint         index,
+             gint         status,
+             const gchar *pdu,
+             gsize        pdu_len,
+             guint       *n_parts)
+{
+    MMSmsPart *part;
+
+    part = mm_sms_part_3gpp_new_from_hex_pdu (index, pdu, pdu_len, NULL, NULL);
+    if (part) {
+        (*n_parts)++;
+        mm_sms_part_free (part);
+    }
+}
+
+static guint
+run_in_place (const gchar *response)
+{
+    guint n_parts = 0;
+
+    mm_3gpp_parse_pdu_cmgl_response_foreach (response,
+                                             (MM3gppPduForeachFn) foreach_pdu,
+                                             &n_parts,
+                                             NULL);
+    return n_parts;
+}
+
+typedef guint (* RunFunc) (const gchar *response);
+
+static void
+benchmark (const gchar *response,
+           const gchar *name,
+           RunFunc      run)
+{
+    GTimer  *timer;
+    gdouble  elapsed;
+    guint    n_parts;
+    gint     i;
+
+    /* warm up, and make sure all messages are parsed */
+    n_parts = run (response);
+    if (n_parts != (guint) n_messages) {
+        g_printerr ("error: %s: parsed %u messages, expected %d\n", name, n_parts, n_messages);
+        exit (EXIT_FAILURE);
+    }
+
+    timer = g_timer_new ();
+    for (i = 0; i < iterations; i++)
+        run (response);
+    elapsed = g_timer_elapsed (timer, NULL);
+    g_timer_destroy (timer);
+
+    g_print ("%-10s %10.3f us/response %10.3f us/message\n",
+             name,
+             (elapsed * 1000000.0) / iterations,
+             (elapsed * 1000000.0) / ((gdouble) iterations * n_messages));
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    GOptionContext   *context;
+    g_autofree gchar *response = NULL;
+
+    setlocale (LC_ALL, "");
+
+    /* Setup option context, process it and destroy it */
+    context = g_option_context_new ("- ModemManager +CMGL/PDU parser benchmark");
+    g_option_context_add_main_entries (context, main_entries, NULL);
+    g_option_context_parse (context, &argc, &argv, NULL);
+    g_option_context_free (context);
+
+    if (version_flag)
+        print_version_and_exit ();
+
+    if (n_messages <= 0 || iterations <= 0) {
+        g_printerr ("error: invalid number of messages or iterations\n");
+        exit (EXIT_FAILURE);
+    }
+
+    response = build_response ();
+
+    g_print ("running %d iterations over %d messages...\n", iterations, n_messages);
+    benchmark (response, "list", run_list);
+    benchmark (response, "in-place", run_in_place);
+
+    return EXIT_SUCCESS;
+}
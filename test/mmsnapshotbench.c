@@ -0,0 +1,263 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 ModemManager contributors
+ */
+
+/*
+ * Compares the cost of retrieving the state of all modems, SIMs and bearers
+ * with the standard object manager interface (GetManagedObjects plus one
+ * GetAll request per SIM and bearer object) and with the GetSnapshot method.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <locale.h>
+
+#include <glib.h>
+#include <gio/gio.h>
+#include <libmm-glib.h>
+
+#define PROGRAM_NAME    "mmsnapshotbench"
+#define PROGRAM_VERSION PACKAGE_VERSION
+
+#define DEFAULT_ITERATIONS 100
+
+/* Context */
+static gboolean session_flag;
+static gint     iterations = DEFAULT_ITERATIONS;
+static gboolean version_flag;
+
+static GOptionEntry main_entries[] = {
+    { "session", 0, 0, G_OPTION_ARG_NONE, &session_flag,
+      "Use the session bus instead of the system bus",
+      NULL
+    },
+    { "iterations", 'n', 0, G_OPTION_ARG_INT, &iterations,
+      "Number of iterations of each method (default: " G_STRINGIFY (DEFAULT_ITERATIONS) ")",
+      "[N]"
+    },
+    { "version", 'V', 0, G_OPTION_ARG_NONE, &version_flag,
+      "Print version",
+      NULL
+    },
+    { NULL }
+};
+
+static void
+print_version_and_exit (void)
+{
+    g_print ("\n"
+             PROGRAM_NAME " " PROGRAM_VERSION "\n"
+             "Copyright (2026) ModemManager contributors\n"
+             "License GPLv2+: GNU GPL version 2 or later <http://gnu.org/licenses/gpl-2.0.html>\n"
+             "This is free software: you are free to change and redistribute it.\n"
+             "There is NO WARRANTY, to the extent permitted by law.\n"
+             "\n");
+    exit (EXIT_SUCCESS);
+}
+
+/*****************************************************************************/
+
+static GVariant *
+call_sync (GDBusConnection     *connection,
+           const gchar         *path,
+           const gchar         *interface,
+           const gchar         *method,
+           GVariant            *parameters,
+           const GVariantType  *reply_type,
+           gsize               *n_bytes)
+{
+    GVariant *reply;
+    GError   *error = NULL;
+
+    reply = g_dbus_connection_call_sync (connection,
+                                         MM_DBUS_SERVICE,
+                                         path,
+                                         interface,
+                                         method,
+                                         parameters,
+                                         reply_type,
+                                         G_DBUS_CALL_FLAGS_NONE,
+                                         -1,
+                                         NULL,
+                                         &error);
+    if (!reply) {
+        g_printerr ("error: %s.%s failed: %s\n", interface, method, error->message);
+        exit (EXIT_FAILURE);
+    }
+    *n_bytes += g_variant_get_size (reply);
+    return reply;
+}
+
+static void
+get_all (GDBusConnection *connection,
+         const gchar     *path,
+         const gchar     *interface,
+         guint           *n_requests,
+         gsize           *n_bytes)
+{
+    GVariant *reply;
+
+    if (!path || g_str_equal (path, "/"))
+        return;
+
+    reply = call_sync (connection, path,
+                       "org.freedesktop.DBus.Properties", "GetAll",
+                       g_variant_new ("(s)", interface),
+                       G_VARIANT_TYPE ("(a{sv})"),
+                       n_bytes);
+    (*n_requests)++;
+    g_variant_unref (reply);
+}
+
+/* Retrieve the same state the daemon reports in the snapshot, using the
+ * standard object manager interface */
+static void
+run_managed_objects (GDBusConnection *connection,
+                     guint           *n_requests,
+                     gsize           *n_bytes)
+{
+    GVariant     *reply;
+    GVariantIter *objects;
+    GVariant     *interfaces;
+
+    reply = call_sync (connection, MM_DBUS_PATH,
+                       "org.freedesktop.DBus.ObjectManager", "GetManagedObjects",
+                       NULL,
+                       G_VARIANT_TYPE ("(a{oa{sa{sv}}})"),
+                       n_bytes);
+    (*n_requests)++;
+
+    g_variant_get (reply, "(a{oa{sa{sv}}})", &objects);
+    while (g_variant_iter_next (objects, "{&o@a{sa{sv}}}", NULL, &interfaces)) {
+        GVariant *modem;
+
+        modem = g_variant_lookup_value (interfaces, MM_DBUS_INTERFACE_MODEM, G_VARIANT_TYPE ("a{sv}"));
+        if (modem) {
+            const gchar  *sim = NULL;
+            const gchar **paths = NULL;
+            guint         i;
+
+            if (g_variant_lookup (modem, "Sim", "&o", &sim))
+                get_all (connection, sim, MM_DBUS_INTERFACE_SIM, n_requests, n_bytes);
+
+            if (g_variant_lookup (modem, "SimSlots", "^a&o", &paths)) {
+                for (i = 0; paths[i]; i++) {
+                    if (g_strcmp0 (paths[i], sim) != 0)
+                        get_all (connection, paths[i], MM_DBUS_INTERFACE_SIM, n_requests, n_bytes);
+                }
+                g_free (paths);
+            }
+
+            if (g_variant_lookup (modem, "Bearers", "^a&o", &paths)) {
+                for (i = 0; paths[i]; i++)
+                    get_all (connection, paths[i], MM_DBUS_INTERFACE_BEARER, n_requests, n_bytes);
+                g_free (paths);
+            }
+            g_variant_unref (modem);
+        }
+        g_variant_unref (interfaces);
+    }
+    g_variant_iter_free (objects);
+    g_variant_unref (reply);
+}
+
+static void
+run_snapshot (GDBusConnection *connection,
+              guint           *n_requests,
+              gsize           *n_bytes)
+{
+    GVariant *reply;
+
+    reply = call_sync (connection, MM_DBUS_PATH,
+                       MM_DBUS_INTERFACE, "GetSnapshot",
+                       NULL,
+                       G_VARIANT_TYPE ("((ua{oa{sa{sv}}}))"),
+                       n_bytes);
+    (*n_requests)++;
+    g_variant_unref (reply);
+}
+
+typedef void (* RunFunc) (GDBusConnection *connection,
+                          guint           *n_requests,
+                          gsize           *n_bytes);
+
+static void
+benchmark (GDBusConnection *connection,
+           const gchar     *name,
+           RunFunc          run)
+{
+    GTimer *timer;
+    guint   n_requests = 0;
+    gsize   n_bytes = 0;
+    gdouble elapsed;
+    gint    i;
+
+    /* warm up, so that the first request does not count */
+    run (connection, &n_requests, &n_bytes);
+    n_requests = 0;
+    n_bytes = 0;
+
+    timer = g_timer_new ();
+    for (i = 0; i < iterations; i++)
+        run (connection, &n_requests, &n_bytes);
+    elapsed = g_timer_elapsed (timer, NULL);
+    g_timer_destroy (timer);
+
+    g_print ("%-20s %10.3f ms/iteration %8.1f requests/iteration %10" G_GSIZE_FORMAT " bytes/iteration\n",
+             name,
+             (elapsed * 1000.0) / iterations,
+             (gdouble) n_requests / iterations,
+             n_bytes / iterations);
+}
+
+/*****************************************************************************/
+
+gint
+main (gint argc, gchar **argv)
+{
+    GOptionContext  *context;
+    GDBusConnection *connection;
+    GError          *error = NULL;
+
+    setlocale (LC_ALL, "");
+
+    /* Setup option context, process it and destroy it */
+    context = g_option_context_new ("- ModemManager snapshot benchmark");
+    g_option_context_add_main_entries (context, main_entries, NULL);
+    g_option_context_parse (context, &argc, &argv, NULL);
+    g_option_context_free (context);
+
+    if (version_flag)
+        print_version_and_exit ();
+
+    if (iterations <= 0) {
+        g_printerr ("error: invalid number of iterations: %d\n", iterations);
+        exit (EXIT_FAILURE);
+    }
+
+    connection = g_bus_get_sync (session_flag ? G_BUS_TYPE_SESSION : G_BUS_TYPE_SYSTEM, NULL, &error);
+    if (!connection) {
+        g_printerr ("error: couldn't get bus: %s\n", error->message);
+        exit (EXIT_FAILURE);
+    }
+
+    g_print ("running %d iterations...\n", iterations);
+    benchmark (connection, "GetManagedObjects", run_managed_objects);
+    benchmark (connection, "GetSnapshot", run_snapshot);
+
+    g_object_unref (connection);
+    return EXIT_SUCCESS;
+}
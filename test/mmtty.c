@@ -265,6 +265,16 @@ start_cb (void)
     return G_SOURCE_REMOVE;
 }
 
+guint32 _mm_log_level_mask = 0xFFFFFFFF;
+
+gboolean
+_mm_log_enabled (gpointer     obj,
+                 const gchar *module,
+                 MMLogLevel   level)
+{
+    return verbose_flag;
+}
+
 void
 _mm_log (gpointer     obj,
          const gchar *module,